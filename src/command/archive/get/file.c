@@ -17,14 +17,75 @@ Archive Get File
 #include "storage/helper.h"
 
 /**********************************************************************************************************************************/
+// Helper to search a repo that was not searched when the file was selected and add the files found to the actual list
+static void
+archiveGetFileSearchRepo(
+    const String *const request, List *const actualList, const ArchiveGetFileSearch *const search, const unsigned int repoIdx,
+    StringList *const warnList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, request);
+        FUNCTION_LOG_PARAM(LIST, actualList);
+        FUNCTION_LOG_PARAM_P(VOID, search);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(STRING_LIST, warnList);
+    FUNCTION_LOG_END();
+
+    ASSERT(request != NULL);
+    ASSERT(actualList != NULL);
+    ASSERT(search != NULL);
+    ASSERT(warnList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StringList *const requestList = strLstNew();
+        strLstAdd(requestList, request);
+
+        TRY_BEGIN()
+        {
+            // Store the find result with the actual list since the files found reference it
+            ArchiveGetFindResult findResult;
+
+            MEM_CONTEXT_BEGIN(lstMemContext(actualList))
+            {
+                findResult = archiveGetFind(repoIdx, search->pgVersion, search->pgSystemId, requestList);
+            }
+            MEM_CONTEXT_END();
+
+            const ArchiveGetFindFile *const file = lstGet(findResult.fileList, 0);
+
+            for (unsigned int matchIdx = 0; matchIdx < lstSize(file->matchList); matchIdx++)
+                lstAdd(actualList, lstGet(file->matchList, matchIdx));
+
+            if (file->errorType != NULL)
+            {
+                strLstAddFmt(
+                    warnList, "%s: [%s] %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), errorTypeName(file->errorType),
+                    strZ(file->errorMessage));
+            }
+        }
+        CATCH_ANY()
+        {
+            strLstAddFmt(
+                warnList, "%s: [%s] %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), errorTypeName(errorType()), errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 FN_EXTERN ArchiveGetFileResult
 archiveGetFile(
-    const Storage *const storage, const String *const request, const List *const actualList, const String *const walDestination)
+    const Storage *const storage, const String *const request, List *const actualList, const ArchiveGetFileSearch *const search,
+    const String *const walDestination)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, storage);
         FUNCTION_LOG_PARAM(STRING, request);
         FUNCTION_LOG_PARAM(LIST, actualList);
+        FUNCTION_LOG_PARAM_P(VOID, search);
         FUNCTION_LOG_PARAM(STRING, walDestination);
     FUNCTION_LOG_END();
 
@@ -36,11 +97,23 @@ archiveGetFile(
 
     ArchiveGetFileResult result = {.warnList = strLstNew()};
 
-    // Check all files in the actual list and return as soon as one is copied
+    // Check all files in the actual list and return as soon as one is copied. If none can be copied then search the repos that were
+    // not searched and try the files found there.
     bool copied = false;
+    unsigned int searchIdx = 0;
 
-    for (unsigned int actualIdx = 0; actualIdx < lstSize(actualList); actualIdx++)
+    for (unsigned int actualIdx = 0; !copied; actualIdx++)
     {
+        while (actualIdx == lstSize(actualList) && search != NULL && searchIdx < lstSize(search->repoIdxList))
+        {
+            archiveGetFileSearchRepo(
+                request, actualList, search, *(unsigned int *)lstGet(search->repoIdxList, searchIdx), result.warnList);
+            searchIdx++;
+        }
+
+        if (actualIdx == lstSize(actualList))
+            break;
+
         const ArchiveGetFile *const actual = lstGet(actualList, actualIdx);
 
         // Is the file compressible during the copy?
@@ -92,10 +165,6 @@ archiveGetFile(
                 errorTypeName(errorType()), errorMessage());
         }
         TRY_END();
-
-        // Stop on success
-        if (copied)
-            break;
     }
 
     // If no file was successfully copied then error
@@ -107,3 +176,231 @@ archiveGetFile(
 
     FUNCTION_LOG_RETURN_STRUCT(result);
 }
+
+/**********************************************************************************************************************************/
+// Cache of paths in an archiveId so multiple requests in the same path only list the path once
+typedef struct ArchiveGetFindCachePath
+{
+    const String *path;                                             // Cached path in the archiveId
+    const StringList *fileList;                                     // List of files in the cache path
+} ArchiveGetFindCachePath;
+
+FN_EXTERN ArchiveGetFindResult
+archiveGetFind(
+    const unsigned int repoIdx, const unsigned int pgVersion, const uint64_t pgSystemId, const StringList *const requestList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(UINT64, pgSystemId);
+        FUNCTION_LOG_PARAM(STRING_LIST, requestList);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_STRUCT();
+
+    ASSERT(requestList != NULL);
+    ASSERT(!strLstEmpty(requestList));
+
+    const TimeMSec timeBegin = timeMSec();
+    ArchiveGetFindResult result = {.fileList = lstNewP(sizeof(ArchiveGetFindFile))};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get the repo storage in case it is remote and encryption settings need to be pulled down
+        storageRepoIdx(repoIdx);
+
+        // Attempt to load the archive info file
+        const InfoArchive *const info = infoArchiveLoadFile(
+            storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, cfgCipherSpecMainIdx(repoIdx));
+
+        // Build cipher spec in the result list context once rather than rebuilding it per candidate file later
+        MEM_CONTEXT_BEGIN(lstMemContext(result.fileList))
+        {
+            result.cipherSpecArchive = cipherSpecDup(infoArchiveCipherSpec(info));
+            result.archiveIdList = strLstNew();
+        }
+        MEM_CONTEXT_END();
+
+        // Loop through pg history and determine which archiveIds to use
+        const StringList *archivePathList = NULL;
+
+        for (unsigned int pgIdx = 0; pgIdx < infoPgDataTotal(infoArchivePg(info)); pgIdx++)
+        {
+            const InfoPgData pgData = infoPgData(infoArchivePg(info), pgIdx);
+
+            // Only use the archive id if it matches the current cluster
+            if (pgData.systemId == pgSystemId && pgData.version == pgVersion)
+            {
+                const String *const archiveId = infoPgArchiveId(infoArchivePg(info), pgIdx);
+
+                // If the archiveId is in the past make sure the path exists
+                if (pgIdx != 0)
+                {
+                    // Get list of archiveId paths in the archive path
+                    if (archivePathList == NULL)
+                        archivePathList = storageListP(storageRepoIdx(repoIdx), STORAGE_REPO_ARCHIVE_STR);
+
+                    if (!strLstExists(archivePathList, archiveId))
+                        continue;
+                }
+
+                // The archiveId is most recent or has files so add it
+                strLstAdd(result.archiveIdList, archiveId);
+            }
+        }
+
+        // Error if no archive id was found -- this indicates a mismatch with the current cluster
+        if (strLstEmpty(result.archiveIdList))
+        {
+            THROW_FMT(
+                ArchiveMismatchError, "unable to retrieve the archive id for database version '%s' and system-id '%" PRIu64 "'",
+                strZ(pgVersionToStr(pgVersion)), pgSystemId);
+        }
+
+        // Paths cached for each archiveId
+        List **const pathListArchive = memNew(sizeof(List *) * strLstSize(result.archiveIdList));
+
+        for (unsigned int archiveIdx = 0; archiveIdx < strLstSize(result.archiveIdList); archiveIdx++)
+            pathListArchive[archiveIdx] = lstNewP(sizeof(ArchiveGetFindCachePath), .comparator = lstComparatorStr);
+
+        // If a single file is requested then optimize by adding a restrictive expression to reduce bandwidth, else multiple files
+        // will be requested so cache list results
+        const bool single = strLstSize(requestList) == 1;
+
+        // Find each request
+        for (unsigned int requestIdx = 0; requestIdx < strLstSize(requestList); requestIdx++)
+        {
+            const String *const request = strLstGet(requestList, requestIdx);
+            ArchiveGetFindFile file;
+
+            MEM_CONTEXT_BEGIN(lstMemContext(result.fileList))
+            {
+                file = (ArchiveGetFindFile){.matchList = lstNewP(sizeof(ArchiveGetFile))};
+            }
+            MEM_CONTEXT_END();
+
+            // Is the archive file a WAL segment?
+            const bool isSegment = walIsSegment(request);
+
+            // Get the WAL segment path
+            const String *const path = isSegment ? strSubN(request, 0, 16) : NULL;
+
+            TRY_BEGIN()
+            {
+                // Check each archiveId
+                for (unsigned int archiveIdx = 0; archiveIdx < strLstSize(result.archiveIdList); archiveIdx++)
+                {
+                    const String *const archiveId = strLstGet(result.archiveIdList, archiveIdx);
+
+                    // If a WAL segment then search among the possible file names
+                    if (isSegment)
+                    {
+                        StringList *segmentList;
+
+                        if (single)
+                        {
+                            segmentList = storageListP(
+                                storageRepoIdx(repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(path)),
+                                .expression = strNewFmt(
+                                    "^%s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(strSubN(request, 0, 24)),
+                                    walIsPartial(request) ? WAL_SEGMENT_PARTIAL_EXT : ""));
+                        }
+                        else
+                        {
+                            // Partial files cannot be in a list with multiple requests
+                            ASSERT(!walIsPartial(request));
+
+                            // If the path does not exist in the cache then fetch it
+                            List *const pathList = pathListArchive[archiveIdx];
+                            const ArchiveGetFindCachePath *cachePath = lstFind(pathList, &path);
+
+                            if (cachePath == NULL)
+                            {
+                                MEM_CONTEXT_BEGIN(lstMemContext(pathList))
+                                {
+                                    const ArchiveGetFindCachePath archiveGetFindCachePath =
+                                    {
+                                        .path = strDup(path),
+                                        .fileList = storageListP(
+                                            storageRepoIdx(repoIdx),
+                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(path)),
+                                            .expression = strNewFmt(
+                                                "^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
+                                    };
+
+                                    cachePath = lstAdd(pathList, &archiveGetFindCachePath);
+                                }
+                                MEM_CONTEXT_END();
+                            }
+
+                            // Get a list of all WAL segments that match
+                            segmentList = strLstNew();
+
+                            for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
+                            {
+                                if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), request))
+                                    strLstAdd(segmentList, strLstGet(cachePath->fileList, fileIdx));
+                            }
+                        }
+
+                        // Add segments to match list
+                        for (unsigned int segmentIdx = 0; segmentIdx < strLstSize(segmentList); segmentIdx++)
+                        {
+                            MEM_CONTEXT_BEGIN(lstMemContext(result.fileList))
+                            {
+                                const ArchiveGetFile archiveGetFile =
+                                {
+                                    .file = strNewFmt(
+                                        "%s/%s/%s", strZ(archiveId), strZ(path), strZ(strLstGet(segmentList, segmentIdx))),
+                                    .repoIdx = repoIdx,
+                                    .archiveId = archiveId,
+                                    .cipherSpecArchive = result.cipherSpecArchive,
+                                };
+
+                                lstAdd(file.matchList, &archiveGetFile);
+                            }
+                            MEM_CONTEXT_END();
+                        }
+                    }
+                    // Else if not a WAL segment, see if it exists in the archiveId path
+                    else if (
+                        storageExistsP(
+                            storageRepoIdx(repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(request))))
+                    {
+                        MEM_CONTEXT_BEGIN(lstMemContext(result.fileList))
+                        {
+                            const ArchiveGetFile archiveGetFile =
+                            {
+                                .file = strNewFmt("%s/%s", strZ(archiveId), strZ(request)),
+                                .repoIdx = repoIdx,
+                                .archiveId = archiveId,
+                                .cipherSpecArchive = result.cipherSpecArchive,
+                            };
+
+                            lstAdd(file.matchList, &archiveGetFile);
+                        }
+                        MEM_CONTEXT_END();
+                    }
+                }
+            }
+            // Return errors with the request so the caller can decide how to report them
+            CATCH_ANY()
+            {
+                MEM_CONTEXT_BEGIN(lstMemContext(result.fileList))
+                {
+                    file.errorType = errorType();
+                    file.errorMessage = strNewZ(errorMessage());
+                }
+                MEM_CONTEXT_END();
+            }
+            TRY_END();
+
+            lstAdd(result.fileList, &file);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    result.latency = timeMSec() - timeBegin;
+
+    FUNCTION_LOG_RETURN_STRUCT(result);
+}
@@ -5,6 +5,7 @@ Archive Get File
 #define COMMAND_ARCHIVE_GET_FILE_H
 
 #include "common/crypto/spec.h"
+#include "common/time.h"
 #include "common/type/string.h"
 #include "storage/storage.h"
 
@@ -20,13 +21,43 @@ typedef struct ArchiveGetFile
     const CipherSpec *cipherSpecArchive;                            // Repo archive cipher spec
 } ArchiveGetFile;
 
+// Repos that were still being searched when the file was selected. They are searched only if the file cannot be copied from a repo
+// in the actual list.
+typedef struct ArchiveGetFileSearch
+{
+    unsigned int pgVersion;                                         // PostgreSQL version
+    uint64_t pgSystemId;                                            // PostgreSQL system id
+    List *repoIdxList;                                              // Repos to search (unsigned int)
+} ArchiveGetFileSearch;
+
 typedef struct ArchiveGetFileResult
 {
     unsigned int actualIdx;                                         // Index of the file from actual list that was retrieved
     StringList *warnList;                                           // Warnings from a successful operation
 } ArchiveGetFileResult;
 
+// Files found by searching the repos in search are added to the actual list
 FN_EXTERN ArchiveGetFileResult archiveGetFile(
-    const Storage *storage, const String *request, const List *actualList, const String *walDestination);
+    const Storage *storage, const String *request, List *actualList, const ArchiveGetFileSearch *search,
+    const String *walDestination);
+
+// Find archive files in a repo
+typedef struct ArchiveGetFindFile
+{
+    List *matchList;                                                // Files found for the request (ArchiveGetFile)
+    const ErrorType *errorType;                                     // Error type if there was an error searching for the request
+    const String *errorMessage;                                     // Error message if there was an error
+} ArchiveGetFindFile;
+
+typedef struct ArchiveGetFindResult
+{
+    const CipherSpec *cipherSpecArchive;                            // Repo archive cipher spec
+    StringList *archiveIdList;                                      // ArchiveIds searched in the repo
+    List *fileList;                                                 // Files found for each request in request order
+    TimeMSec latency;                                               // Time taken to search the repo
+} ArchiveGetFindResult;
+
+FN_EXTERN ArchiveGetFindResult archiveGetFind(
+    unsigned int repoIdx, unsigned int pgVersion, uint64_t pgSystemId, const StringList *requestList);
 
 #endif
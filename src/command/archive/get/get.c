@@ -15,10 +15,14 @@ Archive Get Command
 #include "command/archive/get/protocol.h"
 #include "command/command.h"
 #include "command/lock.h"
+#include "command/restore/timeline.h"
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/time.h"
+#include "common/type/convert.h"
+#include "common/type/hashMap.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -58,6 +62,11 @@ typedef struct ArchiveGetCheckResult
     const String *errorFile;                                        // Error file if there was an error
     const String *errorMessage;                                     // Error message if there was an error
     const StringList *warnList;                                     // Warnings that need to be reported by the async process
+
+    // Repos that were still being searched when the files were selected
+    const ArchiveGetFileSearch *search;                             // Repos to search if a file cannot be copied (NULL if none)
+    ProtocolParallel *searchParallel;                               // Searches to finish once files have been copied
+    const List *searchRepoList;                                     // Repos searched in parallel, pending when still running
 } ArchiveGetCheckResult;
 
 // Helper to add an error to an error list and warn if the error is not already in the list
@@ -78,195 +87,496 @@ archiveGetErrorAdd(
     }
 }
 
-// Helper to find a single archive file in the repository using a cache to speed up the process and minimize storageListP() calls
-typedef struct ArchiveGetFindCachePath
+// Repo to be searched for archive files
+typedef struct ArchiveGetCheckRepo
 {
-    const String *path;                                             // Cached path in the archiveId
-    const StringList *fileList;                                     // List of files in the cache path
-} ArchiveGetFindCachePath;
+    unsigned int repoIdx;                                           // Repo idx
+    TimeMSec latency;                                               // Average time taken to search the repo in prior runs
+    bool pending;                                                   // Is the search still running?
+    const ErrorType *errorType;                                     // Error type if the repo could not be searched
+    const String *errorMessage;                                     // Error message if the repo could not be searched
+    ArchiveGetFindResult find;                                      // Files found in the repo
+    StringList *warnList;                                           // Track repo warnings so each is only reported once
+} ArchiveGetCheckRepo;
 
-typedef struct ArchiveGetFindCacheArchive
+// Helper to order repos by the average time taken to search them. Repos that took the same time remain in priority order.
+static int
+archiveGetCheckRepoComparator(const void *const item1, const void *const item2)
 {
-    const String *archiveId;                                        // ArchiveId in the repo
-    List *pathList;                                                 // List of paths cached for archiveId
-} ArchiveGetFindCacheArchive;
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const ArchiveGetCheckRepo *const repo1 = item1;
+    const ArchiveGetCheckRepo *const repo2 = item2;
+
+    if (repo1->latency != repo2->latency)
+        FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(repo1->latency, repo2->latency));
 
-typedef struct ArchiveGetFindCacheRepo
+    FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(repo1->repoIdx, repo2->repoIdx));
+}
+
+// Repo search times are stored in the spool path so the repos can be searched in order of their average search time. Each line of
+// the file holds a repo key and the average search time in milliseconds separated by an equal sign.
+#define REPO_LATENCY_FILE                                           "in.latency"
+
+// Read search times into the repo list. Repos without a stored time are left at zero so they will be searched first and timed. If
+// the file is invalid then the times are ignored so the repos are searched in the configured order. The times will be rebuilt when
+// the file is written.
+static void
+archiveGetCheckLatencyRead(List *const repoList)
 {
-    unsigned int repoIdx;
-    const CipherSpec *cipherSpecArchive;                            // Repo archive cipher spec
-    List *archiveList;                                              // Cached list of archiveIds and associated paths
-    StringList *warnList;                                           // Track repo warnings so each is only reported once
-} ArchiveGetFindCacheRepo;
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, repoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(repoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Buffer *const content = storageGetP(
+            storageNewReadP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE "/" REPO_LATENCY_FILE), .ignoreMissing = true));
+
+        if (content != NULL)
+        {
+            TRY_BEGIN()
+            {
+                const StringList *const lineList = strLstNewSplitZ(strNewBuf(content), "\n");
+
+                for (unsigned int lineIdx = 0; lineIdx < strLstSize(lineList); lineIdx++)
+                {
+                    const StringList *const valueList = strLstNewSplitZ(strLstGet(lineList, lineIdx), "=");
+
+                    if (strLstSize(valueList) != 2)
+                    {
+                        THROW_FMT(
+                            FormatError, REPO_LATENCY_FILE " line '%s' must be key=time", strZ(strLstGet(lineList, lineIdx)));
+                    }
+
+                    const unsigned int repoKey = cvtZToUInt(strZ(strLstGet(valueList, 0)));
+
+                    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+                    {
+                        ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+
+                        if (cfgOptionGroupIdxToKey(cfgOptGrpRepo, repo->repoIdx) == repoKey)
+                            repo->latency = cvtZToUInt64(strZ(strLstGet(valueList, 1)));
+                    }
+                }
+            }
+            CATCH(FormatError)
+            {
+                LOG_DETAIL_FMT("ignore invalid search times: %s", errorMessage());
+
+                for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+                    ((ArchiveGetCheckRepo *)lstGet(repoList, repoListIdx))->latency = 0;
+            }
+            TRY_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Write search times from the repo list. The new time has a weight of 1/4 so a single slow search does not reorder the repos. Repos
+// that could not be searched keep their prior time. The file does not need to be durable since the times are rebuilt quickly.
+static void
+archiveGetCheckLatencyWrite(const List *const repoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, repoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(repoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        String *const content = strNew();
+
+        for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+        {
+            const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+            TimeMSec latency = repo->latency;
+
+            if (repo->errorType == NULL)
+                latency = latency == 0 ? repo->find.latency : (latency * 3 + repo->find.latency) / 4;
+
+            strCatFmt(
+                content, "%s%u=%" PRIu64, repoListIdx == 0 ? "" : "\n", cfgOptionGroupIdxToKey(cfgOptGrpRepo, repo->repoIdx),
+                latency);
+        }
 
+        storagePutP(
+            storageNewWriteP(
+                storageSpoolWrite(), STRDEF(STORAGE_SPOOL_ARCHIVE "/" REPO_LATENCY_FILE), .noSyncFile = true, .noSyncPath = true),
+            BUFSTR(content));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Helper to search repos in parallel with a local process for each repo
+typedef struct ArchiveGetCheckParallelData
+{
+    const List *repoList;                                           // Repos to search
+    unsigned int repoListIdx;                                       // Next repo to search
+    const PgControl *controlInfo;                                   // Control info for the cluster
+    const StringList *archiveRequestList;                           // Archive files to find
+} ArchiveGetCheckParallelData;
+
+static ProtocolParallelJob *
+archiveGetCheckParallelCallback(void *const data, const unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT, clientIdx);
+    FUNCTION_TEST_END();
+
+    ProtocolParallelJob *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // No special logic based on the client, we'll just get the next job
+        (void)clientIdx;
+
+        // Get a new job if there are any left
+        ArchiveGetCheckParallelData *const jobData = data;
+
+        if (jobData->repoListIdx < lstSize(jobData->repoList))
+        {
+            const ArchiveGetCheckRepo *const repo = lstGet(jobData->repoList, jobData->repoListIdx);
+
+            PackWrite *const param = protocolPackNew();
+
+            pckWriteU32P(param, repo->repoIdx);
+            pckWriteU32P(param, jobData->controlInfo->version);
+            pckWriteU64P(param, jobData->controlInfo->systemId);
+            pckWriteStrLstP(param, jobData->archiveRequestList);
+
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = protocolParallelJobNew(VARUINT(jobData->repoListIdx), PROTOCOL_COMMAND_ARCHIVE_GET_FIND, param);
+            }
+            MEM_CONTEXT_PRIOR_END();
+
+            jobData->repoListIdx++;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
+// Helper to determine if the first request can be selected without waiting for more searches. This is true when the highest
+// priority repo that could be searched has the file or when no repo is still being searched.
 static bool
-archiveGetFind(
-    const String *const archiveFileRequest, ArchiveGetCheckResult *const getCheckResult, List *const cacheRepoList,
-    const StringList *const warnList, const bool single)
+archiveGetCheckParallelReady(const List *const repoList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, repoList);
+    FUNCTION_TEST_END();
+
+    ASSERT(repoList != NULL);
+
+    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+    {
+        const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+
+        if (repo->pending)
+            FUNCTION_TEST_RETURN(BOOL, false);
+
+        if (repo->errorType == NULL && !lstEmpty(((const ArchiveGetFindFile *)lstGet(repo->find.fileList, 0))->matchList))
+            FUNCTION_TEST_RETURN(BOOL, true);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, true);
+}
+
+// Search repos in parallel and return as soon as the first request can be selected. If searches are still running then the parallel
+// executor is returned so the caller can finish the searches once files have been copied, else NULL is returned.
+static ProtocolParallel *
+archiveGetCheckParallel(
+    List *const repoList, const PgControl *const controlInfo, const StringList *const archiveRequestList,
+    MemContext *const memContext)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(STRING, archiveFileRequest);
-        FUNCTION_LOG_PARAM_P(VOID, getCheckResult);
-        FUNCTION_LOG_PARAM(LIST, cacheRepoList);
-        FUNCTION_LOG_PARAM(STRING_LIST, warnList);
-        FUNCTION_LOG_PARAM(BOOL, single);
+        FUNCTION_LOG_PARAM(LIST, repoList);
+        FUNCTION_LOG_PARAM_P(VOID, controlInfo);
+        FUNCTION_LOG_PARAM(STRING_LIST, archiveRequestList);
+        FUNCTION_LOG_PARAM(MEM_CONTEXT, memContext);
     FUNCTION_LOG_END();
 
-    ASSERT(archiveFileRequest != NULL);
-    ASSERT(getCheckResult != NULL);
-    ASSERT(cacheRepoList != NULL);
+    ASSERT(repoList != NULL);
+    ASSERT(controlInfo != NULL);
+    ASSERT(archiveRequestList != NULL);
+    ASSERT(memContext != NULL);
 
-    bool result = false;
+    ProtocolParallel *result = NULL;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Is the archive file a WAL segment?
-        const bool isSegment = walIsSegment(archiveFileRequest);
+        const TimeMSec timeBegin = timeMSec();
 
-        // Get the WAL segment path
-        const String *const path = isSegment ? strSubN(archiveFileRequest, 0, 16) : NULL;
+        // Create the parallel executor with a process for each repo so all repos are searched at the same time. The executor is
+        // created in the caller's context since searches may still be running when this function returns.
+        ProtocolParallel *parallelExec;
 
-        // List to hold matches for the requested file
-        List *const matchList = lstNewP(sizeof(ArchiveGetFile), .comparator = lstComparatorStr);
+        MEM_CONTEXT_BEGIN(memContext)
+        {
+            ArchiveGetCheckParallelData *const jobData = memNew(sizeof(ArchiveGetCheckParallelData));
 
-        // List of file level warnings
-        StringList *const fileWarnList = strLstDup(warnList);
+            *jobData = (ArchiveGetCheckParallelData)
+            {
+                .repoList = repoList,
+                .controlInfo = controlInfo,
+                .archiveRequestList = archiveRequestList,
+            };
 
-        // Errored repo total to track if all repos errored
-        unsigned int repoErrorTotal = 0;
+            parallelExec = protocolParallelNew(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetCheckParallelCallback, jobData);
+        }
+        MEM_CONTEXT_END();
 
-        // Check each repo
-        for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+        // Process ids follow those used to get files so a search that is still running does not delay getting files
+        for (unsigned int processIdx = 1; processIdx <= lstSize(repoList); processIdx++)
         {
-            const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+            ((ArchiveGetCheckRepo *)lstGet(repoList, processIdx - 1))->pending = true;
 
-            TRY_BEGIN()
+            protocolParallelClientAdd(
+                parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, cfgOptionUInt(cfgOptProcessMax) + processIdx));
+        }
+
+        // Process jobs
+        do
+        {
+            const unsigned int completed = protocolParallelProcess(parallelExec);
+
+            for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
             {
-                // Check each archiveId
-                for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList); archiveCacheIdx++)
-                {
-                    const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(cacheRepo->archiveList, archiveCacheIdx);
+                ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                ArchiveGetCheckRepo *const repo = lstGet(repoList, varUInt(protocolParallelJobKey(job)));
+
+                repo->pending = false;
 
-                    // If a WAL segment then search among the possible file names
-                    if (isSegment)
+                MEM_CONTEXT_BEGIN(memContext)
+                {
+                    // The repo was searched
+                    if (protocolParallelJobErrorCode(job) == 0)
                     {
-                        StringList *segmentList;
+                        PackRead *const findResult = protocolParallelJobResult(job);
 
-                        // If a single file is requested then optimize by adding a restrictive expression to reduce bandwidth
-                        if (single)
-                        {
-                            segmentList = storageListP(
-                                storageRepoIdx(cacheRepo->repoIdx),
-                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path)),
-                                .expression = strNewFmt(
-                                    "^%s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(strSubN(archiveFileRequest, 0, 24)),
-                                    walIsPartial(archiveFileRequest) ? WAL_SEGMENT_PARTIAL_EXT : ""));
-                        }
-                        // Else multiple files will be requested so cache list results
-                        else
+                        repo->find.cipherSpecArchive = cipherSpecNewPack(findResult);
+                        repo->find.archiveIdList = pckReadStrLstP(findResult);
+                        repo->find.fileList = lstNewP(sizeof(ArchiveGetFindFile));
+
+                        pckReadArrayBeginP(findResult);
+
+                        while (!pckReadNullP(findResult))
                         {
-                            // Partial files cannot be in a list with multiple requests
-                            ASSERT(!walIsPartial(archiveFileRequest));
+                            pckReadObjBeginP(findResult);
 
-                            // If the path does not exist in the cache then fetch it
-                            const ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
+                            const int errorCode = pckReadI32P(findResult);
+                            ArchiveGetFindFile file = {.errorType = errorCode == 0 ? NULL : errorTypeFromCode(errorCode)};
+                            file.errorMessage = pckReadStrP(findResult);
+                            file.matchList = lstNewP(sizeof(ArchiveGetFile));
 
-                            if (cachePath == NULL)
+                            pckReadArrayBeginP(findResult);
+
+                            while (!pckReadNullP(findResult))
                             {
-                                MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
-                                {
-                                    const ArchiveGetFindCachePath archiveGetFindCachePath =
-                                    {
-                                        .path = strDup(path),
-                                        .fileList = storageListP(
-                                            storageRepoIdx(cacheRepo->repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(path)),
-                                            .expression = strNewFmt(
-                                                "^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
-                                    };
-
-                                    cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
-                                }
-                                MEM_CONTEXT_END();
+                                ArchiveGetFile match = {.file = pckReadStrP(findResult)};
+                                match.repoIdx = repo->repoIdx;
+                                match.archiveId = strLstGet(repo->find.archiveIdList, pckReadU32P(findResult));
+                                match.cipherSpecArchive = repo->find.cipherSpecArchive;
+
+                                lstAdd(file.matchList, &match);
                             }
 
-                            // Get a list of all WAL segments that match
-                            segmentList = strLstNew();
+                            pckReadArrayEndP(findResult);
+                            pckReadObjEndP(findResult);
 
-                            for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
-                            {
-                                if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), archiveFileRequest))
-                                    strLstAdd(segmentList, strLstGet(cachePath->fileList, fileIdx));
-                            }
+                            lstAdd(repo->find.fileList, &file);
                         }
 
-                        // Add segments to match list
-                        for (unsigned int segmentIdx = 0; segmentIdx < strLstSize(segmentList); segmentIdx++)
-                        {
-                            MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
-                            {
-                                const ArchiveGetFile archiveGetFile =
-                                {
-                                    .file = strNewFmt(
-                                        "%s/%s/%s", strZ(cacheArchive->archiveId), strZ(path),
-                                        strZ(strLstGet(segmentList, segmentIdx))),
-                                    .repoIdx = cacheRepo->repoIdx,
-                                    .archiveId = cacheArchive->archiveId,
-                                    .cipherSpecArchive = cacheRepo->cipherSpecArchive,
-                                };
-
-                                lstAdd(matchList, &archiveGetFile);
-                            }
-                            MEM_CONTEXT_END();
-                        }
+                        pckReadArrayEndP(findResult);
+
+                        repo->find.latency = pckReadU64P(findResult);
                     }
-                    // Else if not a WAL segment, see if it exists in the archiveId path
-                    else if (
-                        storageExistsP(
-                            storageRepoIdx(cacheRepo->repoIdx),
-                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(cacheArchive->archiveId), strZ(archiveFileRequest))))
+                    // Else the repo could not be searched
+                    else
                     {
-                        MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
-                        {
-                            const ArchiveGetFile archiveGetFile =
-                            {
-                                .file = strNewFmt("%s/%s", strZ(cacheArchive->archiveId), strZ(archiveFileRequest)),
-                                .repoIdx = cacheRepo->repoIdx,
-                                .archiveId = cacheArchive->archiveId,
-                                .cipherSpecArchive = cacheRepo->cipherSpecArchive,
-                            };
-
-                            lstAdd(matchList, &archiveGetFile);
-                        }
-                        MEM_CONTEXT_END();
+                        repo->errorType = errorTypeFromCode(protocolParallelJobErrorCode(job));
+                        repo->errorMessage = strDup(protocolParallelJobErrorMessage(job));
                     }
                 }
+                MEM_CONTEXT_END();
+
+                protocolParallelJobFree(job);
+            }
+        }
+        while (!archiveGetCheckParallelReady(repoList));
+
+        // If searches are still running then return the executor. Record the time waited as the search time for repos that are
+        // still being searched since their search time will be at least that long.
+        if (!protocolParallelDone(parallelExec))
+        {
+            const TimeMSec latency = timeMSec() - timeBegin;
+
+            for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+            {
+                ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+
+                if (repo->pending)
+                    repo->find.latency = latency;
+            }
+
+            result = parallelExec;
+        }
+        else
+            protocolParallelFree(parallelExec);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PROTOCOL_PARALLEL, result);
+}
+
+// Finish searches that were still running when files were selected. The results are not needed so they are discarded, including
+// errors.
+static void
+archiveGetCheckParallelEnd(ProtocolParallel *const parallelExec)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PROTOCOL_PARALLEL, parallelExec);
+    FUNCTION_LOG_END();
+
+    if (parallelExec != NULL)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            do
+            {
+                const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    protocolParallelJobFree(protocolParallelResult(parallelExec));
+            }
+            while (!protocolParallelDone(parallelExec));
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        protocolParallelFree(parallelExec);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Terminate searches that were still running when the file was selected. The results are not needed so the search processes are
+// terminated rather than waiting for the searches to finish.
+static void
+archiveGetCheckParallelAbandon(ProtocolParallel *const parallelExec, const List *const repoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PROTOCOL_PARALLEL, parallelExec);
+        FUNCTION_LOG_PARAM(LIST, repoList);
+    FUNCTION_LOG_END();
+
+    if (parallelExec != NULL)
+    {
+        ASSERT(repoList != NULL);
+
+        // Each repo was searched by the process following the processes used to get files, in list order
+        for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+        {
+            if (((const ArchiveGetCheckRepo *)lstGet(repoList, repoListIdx))->pending)
+            {
+                protocolHelperTerminate(
+                    protocolLocalGet(protocolStorageTypeRepo, 0, cfgOptionUInt(cfgOptProcessMax) + repoListIdx + 1));
             }
+        }
+
+        // Free the executor once the clients running searches are gone so it does not wait on their results
+        protocolParallelFree(parallelExec);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Helper to check a single archive file against the files found in each repo. Repos are tried in list order. Duplicates are only
+// checked in repos that have been searched, so when searches are pending (i.e. getCheckResult->search is set) a file that was not
+// found in a searched repo may still exist in a repo that is being searched.
+static bool
+archiveGetCheckFile(
+    const String *const archiveFileRequest, const unsigned int requestIdx, ArchiveGetCheckResult *const getCheckResult,
+    const List *const repoList, const StringList *const warnList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, archiveFileRequest);
+        FUNCTION_LOG_PARAM(UINT, requestIdx);
+        FUNCTION_LOG_PARAM_P(VOID, getCheckResult);
+        FUNCTION_LOG_PARAM(LIST, repoList);
+        FUNCTION_LOG_PARAM(STRING_LIST, warnList);
+    FUNCTION_LOG_END();
+
+    ASSERT(archiveFileRequest != NULL);
+    ASSERT(getCheckResult != NULL);
+    ASSERT(repoList != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // List to hold matches for the requested file
+        List *const matchList = lstNewP(sizeof(ArchiveGetFile), .comparator = lstComparatorStr);
+
+        // List of file level warnings
+        StringList *const fileWarnList = strLstDup(warnList);
+
+        // Errored repo total to track if all repos errored
+        unsigned int repoErrorTotal = 0;
+
+        // Check each repo
+        for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+        {
+            const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+            const ArchiveGetFindFile *const file = lstGet(repo->find.fileList, requestIdx);
+
+            for (unsigned int matchIdx = 0; matchIdx < lstSize(file->matchList); matchIdx++)
+                lstAdd(matchList, lstGet(file->matchList, matchIdx));
+
             // Log errors as warnings and continue
-            CATCH_ANY()
+            if (file->errorType != NULL)
             {
                 repoErrorTotal++;
-                archiveGetErrorAdd(cacheRepo->warnList, true, cacheRepo->repoIdx, errorType(), STR(errorMessage()));
-                archiveGetErrorAdd(fileWarnList, false, cacheRepo->repoIdx, errorType(), STR(errorMessage()));
+                archiveGetErrorAdd(repo->warnList, true, repo->repoIdx, file->errorType, file->errorMessage);
+                archiveGetErrorAdd(fileWarnList, false, repo->repoIdx, file->errorType, file->errorMessage);
             }
-            TRY_END();
         }
 
-        // If all repos errored out then set the global error since processing cannot continue past this segment
-        ASSERT(repoErrorTotal <= lstSize(cacheRepoList));
+        // If all repos errored out then set the global error since processing cannot continue past this segment. If searches are
+        // pending then a repo that is being searched may have the file so stop without an error.
+        ASSERT(repoErrorTotal <= lstSize(repoList));
 
-        if (repoErrorTotal == lstSize(cacheRepoList))
+        if (repoErrorTotal == lstSize(repoList))
         {
             ASSERT(!strLstEmpty(fileWarnList));
 
-            MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
+            if (getCheckResult->search == NULL)
             {
-                getCheckResult->errorType = &RepoInvalidError;
-                getCheckResult->errorFile = strDup(archiveFileRequest);
-                getCheckResult->errorMessage = strNewZ(UNABLE_TO_FIND_VALID_REPO_MSG);
-                getCheckResult->warnList = strLstMove(fileWarnList, memContextCurrent());
+                MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
+                {
+                    getCheckResult->errorType = &RepoInvalidError;
+                    getCheckResult->errorFile = strDup(archiveFileRequest);
+                    getCheckResult->errorMessage = strNewZ(UNABLE_TO_FIND_VALID_REPO_MSG);
+                    getCheckResult->warnList = strLstMove(fileWarnList, memContextCurrent());
+                }
+                MEM_CONTEXT_END();
             }
-            MEM_CONTEXT_END();
         }
         // Else if a file was found
         else if (!lstEmpty(matchList))
@@ -274,7 +584,7 @@ archiveGetFind(
             bool error = false;
 
             // If a segment match list is > 1 then check for duplicates
-            if (isSegment && lstSize(matchList) > 1)
+            if (walIsSegment(archiveFileRequest) && lstSize(matchList) > 1)
             {
                 // Count the number of unique hashes
                 StringList *const hashList = strLstNew();
@@ -330,7 +640,7 @@ archiveGetFind(
                 }
             }
 
-            // Files are valid so add them to the map
+            // Files are valid so add them to the map in the order the repos should be tried
             if (!error)
             {
                 MEM_CONTEXT_BEGIN(lstMemContext(getCheckResult->archiveFileMapList))
@@ -342,8 +652,14 @@ archiveGetFind(
                         .warnList = strLstMove(fileWarnList, memContextCurrent()),
                     };
 
-                    for (unsigned int matchIdx = 0; matchIdx < lstSize(matchList); matchIdx++)
-                        lstAdd(map.actualList, lstGet(matchList, matchIdx));
+                    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+                    {
+                        const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+                        const ArchiveGetFindFile *const file = lstGet(repo->find.fileList, requestIdx);
+
+                        for (unsigned int matchIdx = 0; matchIdx < lstSize(file->matchList); matchIdx++)
+                            lstAdd(map.actualList, lstGet(file->matchList, matchIdx));
+                    }
 
                     lstAdd(getCheckResult->archiveFileMapList, &map);
                 }
@@ -388,8 +704,15 @@ archiveGetCheck(const StringList *const archiveRequestList)
                 "HINT: was the backup_label file removed?");
         }
 
-        // Build list of repos/archiveIds where WAL may be found
-        List *const cacheRepoList = lstNewP(sizeof(ArchiveGetFindCacheRepo));
+        // Build list of repos where WAL may be found. The list is stored with the result since searches that are still running when
+        // files are selected reference it.
+        List *repoList;
+
+        MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
+        {
+            repoList = lstNewP(sizeof(ArchiveGetCheckRepo), .comparator = archiveGetCheckRepoComparator);
+        }
+        MEM_CONTEXT_END();
 
         for (unsigned int repoIdx = 0; repoIdx < cfgOptionGroupIdxTotal(cfgOptGrpRepo); repoIdx++)
         {
@@ -397,96 +720,95 @@ archiveGetCheck(const StringList *const archiveRequestList)
             if (cfgOptionTest(cfgOptRepo) && cfgOptionUInt(cfgOptRepo) != cfgOptionGroupIdxToKey(cfgOptGrpRepo, repoIdx))
                 continue;
 
-            TRY_BEGIN()
+            const ArchiveGetCheckRepo repo = {.repoIdx = repoIdx, .warnList = strLstNew()};
+            lstAdd(repoList, &repo);
+        }
+
+        // Search the repos in parallel when there is more than one. Files found are stored in the result list context so they do
+        // not need to be copied into the result.
+        if (cfgOptionBool(cfgOptArchiveGetRepoParallel) && lstSize(repoList) > 1)
+        {
+            // Order the repos by average search time when the search times of prior runs are stored in the spool path
+            if (cfgOptionBool(cfgOptArchiveAsync))
             {
-                // Get the repo storage in case it is remote and encryption settings need to be pulled down
-                storageRepoIdx(repoIdx);
+                archiveGetCheckLatencyRead(repoList);
+                lstSort(repoList, sortOrderAsc);
+            }
 
-                ArchiveGetFindCacheRepo cacheRepo =
-                {
-                    .repoIdx = repoIdx,
-                    .archiveList = lstNewP(sizeof(ArchiveGetFindCacheArchive)),
-                    .warnList = strLstNew(),
-                };
+            result.searchParallel = archiveGetCheckParallel(
+                repoList, &controlInfo, archiveRequestList, lstMemContext(result.archiveFileMapList));
 
-                // Attempt to load the archive info file
-                const InfoArchive *const info = infoArchiveLoadFile(
-                    storageRepoIdx(repoIdx), INFO_ARCHIVE_PATH_FILE_STR, cfgCipherSpecMainIdx(repoIdx));
+            if (cfgOptionBool(cfgOptArchiveAsync))
+                archiveGetCheckLatencyWrite(repoList);
 
-                // Build cipher spec in the result list context once rather than rebuilding it per candidate file later
-                MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
-                {
-                    cacheRepo.cipherSpecArchive = cipherSpecDup(infoArchiveCipherSpec(info));
-                }
-                MEM_CONTEXT_END();
-
-                // Loop through pg history and determine which archiveIds to use
-                const StringList *archivePathList = NULL;
+            // Repos still being searched will be searched again if a file cannot be copied from the repos that were searched
+            if (result.searchParallel != NULL)
+            {
+                result.searchRepoList = repoList;
 
-                for (unsigned int pgIdx = 0; pgIdx < infoPgDataTotal(infoArchivePg(info)); pgIdx++)
+                MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
                 {
-                    InfoPgData pgData = infoPgData(infoArchivePg(info), pgIdx);
+                    ArchiveGetFileSearch *const search = memNew(sizeof(ArchiveGetFileSearch));
 
-                    // Only use the archive id if it matches the current cluster
-                    if (pgData.systemId == controlInfo.systemId && pgData.version == controlInfo.version)
+                    *search = (ArchiveGetFileSearch)
                     {
-                        const String *const archiveId = infoPgArchiveId(infoArchivePg(info), pgIdx);
-                        bool found = true;
-
-                        // If the archiveId is in the past make sure the path exists
-                        if (pgIdx != 0)
-                        {
-                            // Get list of archiveId paths in the archive path
-                            if (archivePathList == NULL)
-                                archivePathList = storageListP(storageRepoIdx(repoIdx), STORAGE_REPO_ARCHIVE_STR);
+                        .pgVersion = controlInfo.version,
+                        .pgSystemId = controlInfo.systemId,
+                        .repoIdxList = lstNewP(sizeof(unsigned int)),
+                    };
 
-                            if (!strLstExists(archivePathList, archiveId))
-                                found = false;
-                        }
+                    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+                    {
+                        const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
 
-                        // If the archiveId is most recent or has files then add it
-                        if (found)
-                        {
-                            ArchiveGetFindCacheArchive cacheArchive =
-                            {
-                                .pathList = lstNewP(sizeof(ArchiveGetFindCachePath), .comparator = lstComparatorStr),
-                            };
+                        if (repo->pending)
+                            lstAdd(search->repoIdxList, &repo->repoIdx);
+                    }
 
-                            // Copy archiveId into the result list context once rather than making a copy per candidate file later
-                            MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
-                            {
-                                cacheArchive.archiveId = strDup(archiveId);
-                            }
-                            MEM_CONTEXT_END();
+                    result.search = search;
+                }
+                MEM_CONTEXT_END();
+            }
+        }
+        // Else search the repos one at a time
+        else
+        {
+            for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+            {
+                ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
 
-                            lstAdd(cacheRepo.archiveList, &cacheArchive);
-                        }
+                TRY_BEGIN()
+                {
+                    MEM_CONTEXT_BEGIN(lstMemContext(result.archiveFileMapList))
+                    {
+                        repo->find = archiveGetFind(repo->repoIdx, controlInfo.version, controlInfo.systemId, archiveRequestList);
                     }
+                    MEM_CONTEXT_END();
                 }
-
-                // Error if no archive id was found -- this indicates a mismatch with the current cluster
-                if (lstEmpty(cacheRepo.archiveList))
+                CATCH_ANY()
                 {
-                    archiveGetErrorAdd(
-                        warnList, true, repoIdx, &ArchiveMismatchError,
-                        strNewFmt(
-                            "unable to retrieve the archive id for database version '%s' and system-id '%" PRIu64 "'",
-                            strZ(pgVersionToStr(controlInfo.version)), controlInfo.systemId));
+                    repo->errorType = errorType();
+                    repo->errorMessage = strNewZ(errorMessage());
                 }
-                // Else add repo to list
-                else
-                    lstAdd(cacheRepoList, &cacheRepo);
+                TRY_END();
             }
-            // Log errors as warnings and continue
-            CATCH_ANY()
-            {
-                archiveGetErrorAdd(warnList, true, repoIdx, errorType(), STR(errorMessage()));
-            }
-            TRY_END();
+        }
+
+        // Log repos that could not be searched as warnings and build the list of repos that were searched
+        List *const repoFindList = lstNewP(sizeof(ArchiveGetCheckRepo));
+
+        for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+        {
+            const ArchiveGetCheckRepo *const repo = lstGet(repoList, repoListIdx);
+
+            if (repo->errorType != NULL)
+                archiveGetErrorAdd(warnList, true, repo->repoIdx, repo->errorType, repo->errorMessage);
+            else if (!repo->pending)
+                lstAdd(repoFindList, repo);
         }
 
         // Error if there are no repos to check
-        if (lstEmpty(cacheRepoList))
+        if (lstEmpty(repoFindList))
         {
             ASSERT(!strLstEmpty(warnList));
 
@@ -511,9 +833,8 @@ archiveGetCheck(const StringList *const archiveRequestList)
             // Find files in the list
             for (unsigned int archiveRequestIdx = 0; archiveRequestIdx < strLstSize(archiveRequestList); archiveRequestIdx++)
             {
-                if (!archiveGetFind(
-                        strLstGet(archiveRequestList, archiveRequestIdx), &result, cacheRepoList, warnList,
-                        strLstSize(archiveRequestList) == 1))
+                if (!archiveGetCheckFile(
+                        strLstGet(archiveRequestList, archiveRequestIdx), archiveRequestIdx, &result, repoFindList, warnList))
                 {
                     break;
                 }
@@ -528,17 +849,308 @@ archiveGetCheck(const StringList *const archiveRequestList)
     FUNCTION_LOG_RETURN_STRUCT(result);
 }
 
+/***********************************************************************************************************************************
+Queue statistics used to adapt the queue size. The main process records the rate that PostgreSQL takes WAL segments from the queue
+and the async process records how long it takes to fetch WAL segments from the repository. Each file holds two values separated by
+a linefeed and is written only by the process that owns it.
+***********************************************************************************************************************************/
+#define QUEUE_STAT_FETCH_FILE                                       "in.fetch"
+#define QUEUE_STAT_REPLAY_FILE                                      "in.replay"
+
+typedef struct QueueStatFetch
+{
+    TimeMSec start;                                                 // Time from async start until the first segment was fetched
+    TimeMSec segment;                                               // Time to fetch each segment after the first
+} QueueStatFetch;
+
+typedef struct QueueStatReplay
+{
+    TimeMSec last;                                                  // Time the last segment was taken from the queue (0 if unknown)
+    TimeMSec interval;                                              // Average time between segments taken from the queue
+} QueueStatReplay;
+
+// Read statistics, returning false if the file does not exist or is invalid. The statistics are only used to size the queue so
+// invalid content, e.g. from a partial write, is ignored rather than failing the command.
+static bool
+queueStatRead(const char *const file, TimeMSec *const value1, TimeMSec *const value2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, file);
+        FUNCTION_TEST_PARAM_P(VOID, value1);
+        FUNCTION_TEST_PARAM_P(VOID, value2);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+    ASSERT(value1 != NULL);
+    ASSERT(value2 != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Buffer *const content = storageGetP(
+            storageNewReadP(storageSpool(), strNewFmt(STORAGE_SPOOL_ARCHIVE "/%s", file), .ignoreMissing = true));
+
+        if (content != NULL)
+        {
+            TRY_BEGIN()
+            {
+                const StringList *const valueList = strLstNewSplitZ(strNewBuf(content), "\n");
+
+                if (strLstSize(valueList) != 2)
+                    THROW_FMT(FormatError, "%s content must have two lines", file);
+
+                const TimeMSec value1Read = cvtZToUInt64(strZ(strLstGet(valueList, 0)));
+                const TimeMSec value2Read = cvtZToUInt64(strZ(strLstGet(valueList, 1)));
+
+                *value1 = value1Read;
+                *value2 = value2Read;
+                result = true;
+            }
+            CATCH(FormatError)
+            {
+                LOG_DETAIL_FMT("ignore invalid queue statistics: %s", errorMessage());
+            }
+            TRY_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+// Write statistics. The file does not need to be durable since the statistics are rebuilt quickly if lost.
+static void
+queueStatWrite(const char *const file, const TimeMSec value1, const TimeMSec value2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, file);
+        FUNCTION_TEST_PARAM(TIME_MSEC, value1);
+        FUNCTION_TEST_PARAM(TIME_MSEC, value2);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        storagePutP(
+            storageNewWriteP(
+                storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE "/%s", file), .noSyncFile = true, .noSyncPath = true),
+            BUFSTR(strNewFmt("%" PRIu64 "\n%" PRIu64, value1, value2)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Update fetch statistics at the end of an async run
+static void
+queueStatFetchUpdate(const TimeMSec timeBegin, const TimeMSec timeFirst, const TimeMSec timeEnd, const unsigned int fetchTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeBegin);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeFirst);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeEnd);
+        FUNCTION_LOG_PARAM(UINT, fetchTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(timeBegin <= timeFirst);
+    ASSERT(timeFirst <= timeEnd);
+    ASSERT(fetchTotal > 0);
+
+    QueueStatFetch fetch = {0};
+
+    // If only one segment was fetched then the time to fetch each additional segment is not known so keep the prior value
+    if (fetchTotal == 1)
+        queueStatRead(QUEUE_STAT_FETCH_FILE, &fetch.start, &fetch.segment);
+    else
+        fetch.segment = (timeEnd - timeFirst) / (fetchTotal - 1);
+
+    fetch.start = timeFirst - timeBegin;
+
+    queueStatWrite(QUEUE_STAT_FETCH_FILE, fetch.start, fetch.segment);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Update replay statistics when PostgreSQL requests a segment
+static void
+queueStatReplayUpdate(const TimeMSec timeNow, const bool found)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeNow);
+        FUNCTION_LOG_PARAM(BOOL, found);
+    FUNCTION_LOG_END();
+
+    QueueStatReplay replay = {0};
+    queueStatRead(QUEUE_STAT_REPLAY_FILE, &replay.last, &replay.interval);
+
+    // If the segment was taken from the queue then update the average interval with a weight of 1/4 for the new interval so bursts
+    // are tracked quickly without a single outlier dominating
+    if (found)
+    {
+        if (replay.last != 0 && timeNow > replay.last)
+        {
+            const TimeMSec interval = timeNow - replay.last;
+
+            replay.interval = replay.interval == 0 ? interval : (replay.interval * 3 + interval) / 4;
+        }
+
+        replay.last = timeNow;
+        queueStatWrite(QUEUE_STAT_REPLAY_FILE, replay.last, replay.interval);
+    }
+    // Else time spent waiting for a segment that was not in the queue does not reflect the replay rate, so do not use it to
+    // calculate the next interval
+    else if (replay.last != 0)
+        queueStatWrite(QUEUE_STAT_REPLAY_FILE, 0, replay.interval);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the maximum number of WAL segments in the queue
+***********************************************************************************************************************************/
+static unsigned int
+queueTotal(const uint64_t queueSize, const size_t walSegmentSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT64, queueSize);
+        FUNCTION_TEST_PARAM(SIZE, walSegmentSize);
+    FUNCTION_TEST_END();
+
+    // The queue total must be at least 2 or it doesn't make sense to have async turned on at all
+    const unsigned int result = (unsigned int)(queueSize / walSegmentSize);
+
+    FUNCTION_TEST_RETURN(UINT, result < 2 ? 2 : result);
+}
+
+/***********************************************************************************************************************************
+Get the number of WAL segments the queue should hold based on the queue statistics
+
+The queue is refilled when it is half empty, so the half that remains must be enough to replay while the async process starts and
+fetches the segments that refill it. If replay is no faster than fetching the queue must be as large as possible. The estimate is
+doubled to allow for replay that is faster than average.
+***********************************************************************************************************************************/
+static unsigned int
+queueDepth(const uint64_t queueSize, const size_t walSegmentSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT64, queueSize);
+        FUNCTION_LOG_PARAM(SIZE, walSegmentSize);
+    FUNCTION_LOG_END();
+
+    unsigned int result = queueTotal(queueSize, walSegmentSize);
+    QueueStatFetch fetch;
+    QueueStatReplay replay;
+
+    if (queueStatRead(QUEUE_STAT_FETCH_FILE, &fetch.start, &fetch.segment) &&
+        queueStatRead(QUEUE_STAT_REPLAY_FILE, &replay.last, &replay.interval) && replay.interval > fetch.segment)
+    {
+        const TimeMSec intervalGain = replay.interval - fetch.segment;
+        const uint64_t depth = (fetch.start * 4 + intervalGain - 1) / intervalGain;
+
+        if (depth < result)
+            result = depth < 2 ? 2 : (unsigned int)depth;
+    }
+
+    FUNCTION_LOG_RETURN(UINT, result);
+}
+
+/***********************************************************************************************************************************
+Get the WAL segments where timelines after the timeline of the requested WAL segment begin
+
+PostgreSQL keeps the history files it restores in pg_wal, so the newest history file that descends from the timeline of the
+requested segment describes the timelines that recovery will follow. An empty list is returned if there is no such history file or
+if the requested segment is not before the first switch, which means recovery is not following the newer timeline.
+***********************************************************************************************************************************/
+static StringList *
+queueTimelineSwitch(const String *const walSegment, const unsigned int pgVersion, const size_t walSegmentSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, walSegment);
+        FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(SIZE, walSegmentSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(walSegment != NULL);
+
+    StringList *const result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const unsigned int timeline = pgTimelineFromWalSegment(walSegment);
+        const StringList *const historyList = strLstSort(
+            storageListP(storagePg(), pgWalPath(pgVersion), .expression = WAL_TIMELINE_HISTORY_REGEXP_STR), sortOrderDesc);
+        StringList *switchList = NULL;
+
+        for (unsigned int historyIdx = 0; historyIdx < strLstSize(historyList); historyIdx++)
+        {
+            const String *const historyFile = strLstGet(historyList, historyIdx);
+            const unsigned int historyTimeline = cvtZSubNToUIntBase(strZ(historyFile), 0, 8, 16);
+
+            // Remaining history files are for the timeline of the requested segment or its ancestors
+            if (historyTimeline <= timeline)
+                break;
+
+            const List *const itemList = timelineHistoryParse(
+                strNewBuf(
+                    storageGetP(
+                        storageNewReadP(storagePg(), strNewFmt("%s/%s", strZ(pgWalPath(pgVersion)), strZ(historyFile))))));
+
+            // Find the timeline of the requested segment. Each item after it is a timeline that follows and the last timeline
+            // follows from the history file itself.
+            for (unsigned int itemIdx = 0; itemIdx < lstSize(itemList); itemIdx++)
+            {
+                const TimelineHistoryItem *const item = lstGet(itemList, itemIdx);
+
+                if (item->timeline == timeline)
+                    switchList = strLstNew();
+
+                if (switchList != NULL)
+                {
+                    const unsigned int timelineNext =
+                        itemIdx + 1 < lstSize(itemList) ?
+                            ((const TimelineHistoryItem *)lstGet(itemList, itemIdx + 1))->timeline : historyTimeline;
+
+                    strLstAdd(switchList, pgLsnToWalSegment(timelineNext, item->lsn, (unsigned int)walSegmentSize));
+                }
+            }
+
+            if (switchList != NULL)
+                break;
+        }
+
+        // Recovery is following the switch only if the requested segment is before it
+        if (switchList != NULL && strCmp(strSub(walSegment, 8), strSub(strLstGet(switchList, 0), 8)) < 0)
+        {
+            for (unsigned int switchIdx = 0; switchIdx < strLstSize(switchList); switchIdx++)
+                strLstAdd(result, strLstGet(switchList, switchIdx));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
 /***********************************************************************************************************************************
 Clean the queue and prepare a list of WAL segments that the async process should get
+
+When queueDepth is not zero the async process is asked for no more than queueDepth segments, but segments already in the queue are
+kept up to the maximum queue size. Segments on or after each segment in timelineSwitchList are queued from the timeline of that
+switch.
 ***********************************************************************************************************************************/
 static StringList *
-queueNeed(const String *const walSegment, const bool found, const uint64_t queueSize, const size_t walSegmentSize)
+queueNeed(
+    const String *const walSegment, const bool found, const uint64_t queueSize, const size_t walSegmentSize,
+    const unsigned int queueDepth, const StringList *const timelineSwitchList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSegment);
         FUNCTION_LOG_PARAM(BOOL, found);
         FUNCTION_LOG_PARAM(UINT64, queueSize);
         FUNCTION_LOG_PARAM(SIZE, walSegmentSize);
+        FUNCTION_LOG_PARAM(UINT, queueDepth);
+        FUNCTION_LOG_PARAM(STRING_LIST, timelineSwitchList);
     FUNCTION_LOG_END();
 
     ASSERT(walSegment != NULL);
@@ -552,23 +1164,43 @@ queueNeed(const String *const walSegment, const bool found, const uint64_t queue
         const String *const walSegmentFirst =
             found ? walSegmentNext(walSegment, walSegmentSize) : walSegment;
 
-        // Determine how many WAL segments should be in the queue. The queue total must be at least 2 or it doesn't make sense to
-        // have async turned on at all.
-        unsigned int walSegmentQueueTotal = (unsigned int)(queueSize / walSegmentSize);
+        // Determine how many WAL segments should be in the queue
+        const unsigned int walSegmentQueueTotal = queueTotal(queueSize, walSegmentSize);
+
+        // Build the ideal queue -- the WAL segments we want in the queue after the async process has run. Segments on or after a
+        // timeline switch are queued from the timeline they will be requested on.
+        const StringList *const rangeQueue = walSegmentRange(walSegmentFirst, walSegmentSize, walSegmentQueueTotal);
+        const unsigned int switchTotal = timelineSwitchList == NULL ? 0 : strLstSize(timelineSwitchList);
+        StringList *const idealQueue = strLstNew();
+
+        for (unsigned int rangeQueueIdx = 0; rangeQueueIdx < strLstSize(rangeQueue); rangeQueueIdx++)
+        {
+            const String *walSegmentIdeal = strLstGet(rangeQueue, rangeQueueIdx);
+
+            for (unsigned int switchIdx = switchTotal; switchIdx > 0; switchIdx--)
+            {
+                const String *const walSegmentSwitch = strLstGet(timelineSwitchList, switchIdx - 1);
 
-        if (walSegmentQueueTotal < 2)
-            walSegmentQueueTotal = 2;
+                if (strCmp(strSub(walSegmentIdeal, 8), strSub(walSegmentSwitch, 8)) >= 0)
+                {
+                    walSegmentIdeal = strNewFmt("%s%s", strZ(strSubN(walSegmentSwitch, 0, 8)), strZ(strSub(walSegmentIdeal, 8)));
+                    break;
+                }
+            }
 
-        // Build the ideal queue -- the WAL segments we want in the queue after the async process has run
-        const StringList *const idealQueue = strLstSort(
-            walSegmentRange(walSegmentFirst, walSegmentSize, walSegmentQueueTotal), sortOrderAsc);
+            strLstAdd(idealQueue, walSegmentIdeal);
+        }
 
         // Get the list of files actually in the queue
         const StringList *const actualQueue = strLstSort(
             storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .errorOnMissing = true), sortOrderAsc);
 
-        // Build a list of WAL segments that are being kept so we can later make a list of what is needed
-        StringList *const keepQueue = strLstNew();
+        // Map the queues so files can be matched without a search for each file
+        const HashMap *const idealQueueMap = hashMapNewStrLst(idealQueue);
+        const HashMap *const actualQueueMap = hashMapNewStrLst(actualQueue);
+
+        // Build a map of WAL segments that are being kept so we can later make a list of what is needed
+        HashMap *const keepQueueMap = hashMapNewP(0, .size = strLstSize(actualQueue));
 
         for (unsigned int actualQueueIdx = 0; actualQueueIdx < strLstSize(actualQueue); actualQueueIdx++)
         {
@@ -576,26 +1208,27 @@ queueNeed(const String *const walSegment, const bool found, const uint64_t queue
             const String *const file = strLstGet(actualQueue, actualQueueIdx);
 
             // Does this match a file we want to preserve?
-            if (strLstExists(idealQueue, file))
+            if (hashMapExists(idealQueueMap, file))
             {
-                strLstAdd(keepQueue, file);
+                hashMapAdd(keepQueueMap, file, NULL);
             }
             // Else delete if it does not match an ok file for a WAL segment that has already been preserved. If an ok file exists
             // in addition to the segment then it contains warnings which need to be preserved.
             else if (
                 !strEndsWithZ(file, STATUS_EXT_OK) ||
-                !strLstExists(actualQueue, strSubN(file, 0, strSize(file) - STATUS_EXT_OK_SIZE)))
+                !hashMapExists(actualQueueMap, strSubN(file, 0, strSize(file) - STATUS_EXT_OK_SIZE)))
             {
                 storageRemoveP(storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(file)), .errorOnMissing = true);
             }
         }
 
-        // Generate a list of the WAL that are needed by removing kept WAL from the ideal queue
-        strLstSort(keepQueue, sortOrderAsc);
+        // Generate a list of the WAL that are needed by removing kept WAL from the ideal queue, up to the queue depth if set
+        const unsigned int needTotal =
+            queueDepth == 0 || queueDepth > strLstSize(idealQueue) ? strLstSize(idealQueue) : queueDepth;
 
-        for (unsigned int idealQueueIdx = 0; idealQueueIdx < strLstSize(idealQueue); idealQueueIdx++)
+        for (unsigned int idealQueueIdx = 0; idealQueueIdx < needTotal; idealQueueIdx++)
         {
-            if (!strLstExists(keepQueue, strLstGet(idealQueue, idealQueueIdx)))
+            if (!hashMapExists(keepQueueMap, strLstGet(idealQueue, idealQueueIdx)))
                 strLstAdd(result, strLstGet(idealQueue, idealQueueIdx));
         }
     }
@@ -642,7 +1275,7 @@ archiveGetSingle(const String *const walSegment, const String *const walDestinat
 
             // Get the file
             const ArchiveGetFileResult fileResult = archiveGetFile(
-                storageLocalWrite(), fileMap->request, fileMap->actualList, walDestination);
+                storageLocalWrite(), fileMap->request, fileMap->actualList, checkResult.search, walDestination);
 
             // Output file warnings
             for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -661,6 +1294,9 @@ archiveGetSingle(const String *const walSegment, const String *const walDestinat
         // Else log that the file was not found
         else
             LOG_INFO_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG, strZ(walSegment));
+
+        // Terminate searches that were still running when the file was selected
+        archiveGetCheckParallelAbandon(checkResult.searchParallel, checkResult.searchRepoList);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -705,6 +1341,9 @@ cmdArchiveGet(void)
         // Async get can only be performed on WAL segments, history or other files must use synchronous mode
         if (cfgOptionBool(cfgOptArchiveAsync) && walIsSegment(walSegment))
         {
+            // Should the queue be adapted to the replay and fetch rates?
+            const bool queueAdapt = cfgOptionBool(cfgOptArchiveGetQueueAdapt);
+
             bool first = true;                                          // Is this the first time the loop has run?
             bool found = false;                                         // Has the WAL segment been found yet?
             bool foundOk = false;                                       // Was an OK file found which confirms the file was missing?
@@ -771,6 +1410,10 @@ cmdArchiveGet(void)
                     LOG_INFO_FMT(FOUND_IN_ARCHIVE_MSG " asynchronously", strZ(walSegment));
                     result = 0;
 
+                    // Record when the WAL segment was taken from the queue so the replay rate can be estimated
+                    if (queueAdapt)
+                        queueStatReplayUpdate(timeMSec(), true);
+
                     // Get a list of WAL segments left in the queue
                     const StringList *const queue = storageListP(
                         storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .expression = WAL_SEGMENT_REGEXP_STR, .errorOnMissing = true);
@@ -780,8 +1423,15 @@ cmdArchiveGet(void)
                         // Get size of the WAL segment
                         const uint64_t walSegmentSize = storageInfoP(storageLocal(), walDestination).size;
 
-                        // Use WAL segment size to estimate queue size and determine if the async process should be launched
-                        queueFull = strLstSize(queue) * walSegmentSize > cfgOptionUInt64(cfgOptArchiveGetQueueMax) / 2;
+                        // Use WAL segment size to estimate queue size and determine if the async process should be launched. When
+                        // the queue is adapted use the number of segments the queue should hold instead.
+                        if (queueAdapt)
+                        {
+                            queueFull =
+                                strLstSize(queue) * 2 > queueDepth(cfgOptionUInt64(cfgOptArchiveGetQueueMax), walSegmentSize);
+                        }
+                        else
+                            queueFull = strLstSize(queue) * walSegmentSize > cfgOptionUInt64(cfgOptArchiveGetQueueMax) / 2;
                     }
                 }
 
@@ -808,8 +1458,11 @@ cmdArchiveGet(void)
 
                     // Clean the current queue using the list of WAL that we ideally want in the queue. queueNeed() will return the
                     // list of WAL needed to fill the queue and this will be passed to the async process.
+                    const uint64_t queueSize = cfgOptionUInt64(cfgOptArchiveGetQueueMax);
                     const StringList *const queue = queueNeed(
-                        walSegment, found, cfgOptionUInt64(cfgOptArchiveGetQueueMax), pgControl.walSegmentSize);
+                        walSegment, found, queueSize, pgControl.walSegmentSize,
+                        queueAdapt ? queueDepth(queueSize, pgControl.walSegmentSize) : 0,
+                        queueAdapt ? queueTimelineSwitch(walSegment, pgControl.version, pgControl.walSegmentSize) : NULL);
 
                     for (unsigned int queueIdx = 0; queueIdx < strLstSize(queue); queueIdx++)
                         strLstAdd(commandExec, strLstGet(queue, queueIdx));
@@ -870,7 +1523,13 @@ cmdArchiveGet(void)
                 }
                 // Else report that the WAL segment could not be found
                 else
+                {
                     LOG_INFO_FMT(UNABLE_TO_FIND_IN_ARCHIVE_MSG " asynchronously", strZ(walSegment));
+
+                    // PostgreSQL will wait before requesting the WAL segment again so the wait must not count as replay time
+                    if (queueAdapt)
+                        queueStatReplayUpdate(timeMSec(), false);
+                }
             }
         }
         // Else perform synchronous get
@@ -886,6 +1545,7 @@ cmdArchiveGet(void)
 typedef struct ArchiveGetAsyncData
 {
     const List *const archiveFileMapList;                           // List of wal segments to process
+    const ArchiveGetFileSearch *const search;                       // Repos to search if a file cannot be copied
     unsigned int archiveFileIdx;                                    // Current index in the list to be processed
 } ArchiveGetAsyncData;
 
@@ -916,6 +1576,23 @@ archiveGetAsyncCallback(void *const data, const unsigned int clientIdx)
 
             pckWriteStrP(param, archiveFileMap->request);
 
+            // Add repos to search if the file cannot be copied from the actual list
+            if (jobData->search != NULL)
+            {
+                pckWriteObjBeginP(param);
+                pckWriteU32P(param, jobData->search->pgVersion);
+                pckWriteU64P(param, jobData->search->pgSystemId);
+                pckWriteArrayBeginP(param);
+
+                for (unsigned int repoIdx = 0; repoIdx < lstSize(jobData->search->repoIdxList); repoIdx++)
+                    pckWriteU32P(param, *(unsigned int *)lstGet(jobData->search->repoIdxList, repoIdx), .defaultWrite = true);
+
+                pckWriteArrayEndP(param);
+                pckWriteObjEndP(param);
+            }
+            else
+                pckWriteNullP(param);
+
             // Add actual files to get
             for (unsigned int actualIdx = 0; actualIdx < lstSize(archiveFileMap->actualList); actualIdx++)
             {
@@ -961,25 +1638,36 @@ cmdArchiveGetAsync(void)
                 strLstSize(cfgCommandParam()) == 1 ?
                     "" : zNewFmt("...%s", strZ(strLstGet(cfgCommandParam(), strLstSize(cfgCommandParam()) - 1))));
 
+            // Time the run so the queue can be adapted to how long it takes to fetch WAL
+            const TimeMSec timeBegin = timeMSec();
+            TimeMSec timeFirst = 0;
+            unsigned int fetchTotal = 0;
+
             // Check for archive files
             const ArchiveGetCheckResult checkResult = archiveGetCheck(cfgCommandParam());
 
-            // If any files are missing get the first one (used to construct the "unable to find" warning)
+            // If any files are missing get the first one (used to construct the "unable to find" warning). Files are not missing
+            // when searches are still running since they may be found in a repo that is being searched.
             const String *archiveFileMissing = NULL;
 
-            if (lstSize(checkResult.archiveFileMapList) < strLstSize(cfgCommandParam()))
+            if (lstSize(checkResult.archiveFileMapList) < strLstSize(cfgCommandParam()) && checkResult.search == NULL)
                 archiveFileMissing = strLstGet(cfgCommandParam(), lstSize(checkResult.archiveFileMapList));
 
             // Get archive files that were found
             if (!lstEmpty(checkResult.archiveFileMapList))
             {
                 // Create the parallel executor
-                ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
+                ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList, .search = checkResult.search};
 
                 ProtocolParallel *const parallelExec = protocolParallelNew(
                     cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                // There is no point in starting more processes than there are files to get
+                const unsigned int processMax =
+                    cfgOptionUInt(cfgOptProcessMax) < lstSize(checkResult.archiveFileMapList) ?
+                        cfgOptionUInt(cfgOptProcessMax) : lstSize(checkResult.archiveFileMapList);
+
+                for (unsigned int processIdx = 1; processIdx <= processMax; processIdx++)
                     protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
                 // Process jobs
@@ -1009,10 +1697,10 @@ cmdArchiveGetAsync(void)
                             // The job was successful
                             if (protocolParallelJobErrorCode(job) == 0)
                             {
-                                // Get the actual file retrieved
+                                // Get the repo and archive id of the file retrieved
                                 PackRead *const fileResult = protocolParallelJobResult(job);
-                                const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
-                                ASSERT(file != NULL);
+                                const unsigned int repoIdx = pckReadU32P(fileResult);
+                                const String *const archiveId = pckReadStrP(fileResult);
 
                                 // Output file warnings
                                 const StringList *const fileWarnList = pckReadStrLstP(fileResult);
@@ -1032,7 +1720,12 @@ cmdArchiveGetAsync(void)
 
                                 LOG_DETAIL_PID_FMT(
                                     processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
-                                    cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
+                                    cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(archiveId));
+
+                                if (fetchTotal == 0)
+                                    timeFirst = timeMSec();
+
+                                fetchTotal++;
 
                                 // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
                                 // is guaranteed to exist before the foreground process finds the WAL segment.
@@ -1067,8 +1760,15 @@ cmdArchiveGetAsync(void)
                     while (!protocolParallelDone(parallelExec));
                 }
                 MEM_CONTEXT_TEMP_END();
+
+                // Record how long it took to fetch WAL so the queue can be adapted
+                if (cfgOptionBool(cfgOptArchiveGetQueueAdapt) && fetchTotal > 0)
+                    queueStatFetchUpdate(timeBegin, timeFirst, timeMSec(), fetchTotal);
             }
 
+            // Finish searches that were still running when the files were selected
+            archiveGetCheckParallelEnd(checkResult.searchParallel);
+
             // Log an error from archiveGetCheck() after any existing files have been fetched. This ordering is important because we
             // need to fetch as many valid files as possible before throwing an error.
             if (checkResult.errorType != NULL)
@@ -30,6 +30,28 @@ archiveGetFileProtocol(PackRead *const param)
         // Get request
         const String *const request = pckReadStrP(param);
 
+        // Get repos to search if the file cannot be copied from the actual list
+        ArchiveGetFileSearch *search = NULL;
+
+        if (!pckReadNullP(param))
+        {
+            search = memNew(sizeof(ArchiveGetFileSearch));
+
+            pckReadObjBeginP(param);
+            *search = (ArchiveGetFileSearch){.pgVersion = pckReadU32P(param), .repoIdxList = lstNewP(sizeof(unsigned int))};
+            search->pgSystemId = pckReadU64P(param);
+            pckReadArrayBeginP(param);
+
+            while (!pckReadNullP(param))
+            {
+                const unsigned int repoIdx = pckReadU32P(param);
+                lstAdd(search->repoIdxList, &repoIdx);
+            }
+
+            pckReadArrayEndP(param);
+            pckReadObjEndP(param);
+        }
+
         // Build the actual list
         List *const actualList = lstNewP(sizeof(ArchiveGetFile));
 
@@ -45,15 +67,78 @@ archiveGetFileProtocol(PackRead *const param)
 
         // Get file
         const ArchiveGetFileResult fileResult = archiveGetFile(
-            storageSpoolWrite(), request, actualList,
+            storageSpoolWrite(), request, actualList, search,
             strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(request)));
 
-        // Return result
+        // Return result. The repo and archive id are returned rather than the index since the file may have been found by a search
+        // that the caller did not see.
+        const ArchiveGetFile *const actual = lstGet(actualList, fileResult.actualIdx);
         PackWrite *const data = protocolServerResultData(result);
-        pckWriteU32P(data, fileResult.actualIdx);
+
+        pckWriteU32P(data, actual->repoIdx);
+        pckWriteStrP(data, actual->archiveId);
         pckWriteStrLstP(data, fileResult.warnList);
     }
     MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN ProtocolServerResult *
+archiveGetFindProtocol(PackRead *const param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+    FUNCTION_LOG_END();
+
+    ASSERT(param != NULL);
+
+    ProtocolServerResult *const result = protocolServerResultNewP();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read parameters
+        const unsigned int repoIdx = pckReadU32P(param);
+        const unsigned int pgVersion = pckReadU32P(param);
+        const uint64_t pgSystemId = pckReadU64P(param);
+        const StringList *const requestList = pckReadStrLstP(param);
+
+        // Find files
+        const ArchiveGetFindResult findResult = archiveGetFind(repoIdx, pgVersion, pgSystemId, requestList);
+
+        // Return result
+        PackWrite *const data = protocolServerResultData(result);
+
+        cipherSpecPack(data, findResult.cipherSpecArchive);
+        pckWriteStrLstP(data, findResult.archiveIdList);
+        pckWriteArrayBeginP(data);
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(findResult.fileList); fileIdx++)
+        {
+            const ArchiveGetFindFile *const file = lstGet(findResult.fileList, fileIdx);
+
+            pckWriteObjBeginP(data);
+            pckWriteI32P(data, file->errorType == NULL ? 0 : errorTypeCode(file->errorType));
+            pckWriteStrP(data, file->errorMessage);
+            pckWriteArrayBeginP(data);
+
+            for (unsigned int matchIdx = 0; matchIdx < lstSize(file->matchList); matchIdx++)
+            {
+                const ArchiveGetFile *const match = lstGet(file->matchList, matchIdx);
+
+                pckWriteStrP(data, match->file);
+                pckWriteU32P(data, strLstFindIdxP(findResult.archiveIdList, match->archiveId, .required = true));
+            }
+
+            pckWriteArrayEndP(data);
+            pckWriteObjEndP(data);
+        }
+
+        pckWriteArrayEndP(data);
+        pckWriteU64P(data, findResult.latency);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, result);
+}
@@ -12,13 +12,16 @@ Functions
 ***********************************************************************************************************************************/
 // Process protocol requests
 FN_EXTERN ProtocolServerResult *archiveGetFileProtocol(PackRead *param);
+FN_EXTERN ProtocolServerResult *archiveGetFindProtocol(PackRead *param);
 
 /***********************************************************************************************************************************
 Protocol commands for ProtocolServerHandler arrays passed to protocolServerProcess()
 ***********************************************************************************************************************************/
 #define PROTOCOL_COMMAND_ARCHIVE_GET_FILE                           STRID5("ag-f", 0x36ce10)
+#define PROTOCOL_COMMAND_ARCHIVE_GET_FIND                           STRID5("ag-fd", 0x436ce10)
 
 #define PROTOCOL_SERVER_HANDLER_ARCHIVE_GET_LIST                                                                                   \
-    {.command = PROTOCOL_COMMAND_ARCHIVE_GET_FILE, .process = archiveGetFileProtocol},
+    {.command = PROTOCOL_COMMAND_ARCHIVE_GET_FILE, .process = archiveGetFileProtocol},                                             \
+    {.command = PROTOCOL_COMMAND_ARCHIVE_GET_FIND, .process = archiveGetFindProtocol},
 
 #endif
@@ -10,13 +10,22 @@ Archive Push File
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/log.h"
+#include "common/wait.h"
 #include "config/config.h"
 #include "postgres/interface.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Max size of a WAL segment to keep in memory so the segment is only read once. When the segment is larger it is read again to copy it
+to the repos. The segment is kept uncompressed and only compressed when it is copied so no compression is done when every repo
+already has the segment.
+***********************************************************************************************************************************/
+#define ARCHIVE_PUSH_BUFFER_MAX                                     ((size_t)16 * 1024 * 1024)
+
 /***********************************************************************************************************************************
 Catch write errors during processing
 
@@ -44,10 +53,31 @@ archivePushErrorAdd(StringList *const errorList, const unsigned int repoIdx)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+// Helper to add a warning when the WAL segment already exists in the repo with the same checksum
+static void
+archivePushDuplicateWarn(StringList *const warnList, const String *const archiveFile, const unsigned int repoIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, warnList);
+        FUNCTION_TEST_PARAM(STRING, archiveFile);
+        FUNCTION_TEST_PARAM(UINT, repoIdx);
+    FUNCTION_TEST_END();
+
+    strLstAddFmt(
+        warnList,
+        "WAL file '%s' already exists in the %s archive with the same checksum"
+        "\nHINT: this is valid in some recovery scenarios but may also indicate a problem.",
+        strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoIdx));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Perform a write operation. An exclusive write that finds the file already in the repo is not an error since the file name
+// includes the checksum, so exists is set instead.
 static bool
 archivePushFileIo(
     const ArchivePushFileIoType type, IoWrite *const write, const Buffer *const buffer, const unsigned int repoIdx,
-    StringList *const errorList)
+    StringList *const errorList, bool *const exists)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(STRING_ID, type);
@@ -55,10 +85,12 @@ archivePushFileIo(
         FUNCTION_TEST_PARAM(BUFFER, buffer);
         FUNCTION_TEST_PARAM(UINT, repoIdx);
         FUNCTION_TEST_PARAM(STRING_LIST, errorList);
+        FUNCTION_TEST_PARAM_P(BOOL, exists);
     FUNCTION_TEST_END();
 
     ASSERT(write != NULL);
     ASSERT(errorList != NULL);
+    ASSERT(exists != NULL);
 
     bool result = true;
 
@@ -81,6 +113,12 @@ archivePushFileIo(
                 break;
         }
     }
+    // The file already exists
+    CATCH(FileExistsError)
+    {
+        *exists = true;
+        result = false;
+    }
     // Handle errors
     CATCH_ANY()
     {
@@ -92,24 +130,56 @@ archivePushFileIo(
     FUNCTION_TEST_RETURN(BOOL, result);
 }
 
+// Wait for another job to write the compressed WAL segment. If it does not appear in time, e.g. because the other job failed, then
+// false is returned and the segment must be compressed by this job.
+static bool
+archivePushFileCompressWait(const String *const compressFile)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, compressFile);
+    FUNCTION_TEST_END();
+
+    ASSERT(compressFile != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        Wait *const wait = waitNew(cfgOptionUInt64(cfgOptIoTimeout));
+
+        do
+        {
+            result = storageExistsP(storageLocal(), compressFile);
+        }
+        while (!result && waitMore(wait));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN ArchivePushFileResult
 archivePushFile(
-    const String *const walSource, const bool headerCheck, const bool modeCheck, const unsigned int pgVersion,
-    const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType, const int compressLevel,
-    const List *const repoList, const StringList *const priorErrorList)
+    const String *const walSource, const bool headerCheck, const bool modeCheck, const bool duplicateCheck,
+    const unsigned int pgVersion, const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType,
+    const int compressLevel, const unsigned int compressThread, const String *const compressFile, const bool compressFileWrite,
+    const List *const repoList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSource);
         FUNCTION_LOG_PARAM(BOOL, headerCheck);
         FUNCTION_LOG_PARAM(BOOL, modeCheck);
+        FUNCTION_LOG_PARAM(BOOL, duplicateCheck);
         FUNCTION_LOG_PARAM(UINT, pgVersion);
         FUNCTION_LOG_PARAM(UINT64, pgSystemId);
         FUNCTION_LOG_PARAM(STRING, archiveFile);
         FUNCTION_LOG_PARAM(ENUM, compressType);
         FUNCTION_LOG_PARAM(INT, compressLevel);
+        FUNCTION_LOG_PARAM(UINT, compressThread);
+        FUNCTION_LOG_PARAM(STRING, compressFile);
+        FUNCTION_LOG_PARAM(BOOL, compressFileWrite);
         FUNCTION_LOG_PARAM_P(VOID, repoList);
-        FUNCTION_LOG_PARAM(STRING_LIST, priorErrorList);
     FUNCTION_LOG_END();
 
     FUNCTION_AUDIT_STRUCT();
@@ -117,33 +187,16 @@ archivePushFile(
     ASSERT(walSource != NULL);
     ASSERT(archiveFile != NULL);
     ASSERT(repoList != NULL);
-    ASSERT(priorErrorList != NULL);
     ASSERT(lstSize(repoList) > 0);
+    ASSERT(compressFile == NULL || (walIsSegment(archiveFile) && compressType != compressTypeNone));
 
-    ArchivePushFileResult result = {.warnList = strLstNew()};
+    ArchivePushFileResult result = {.warnList = strLstNew(), .errorList = strLstNew()};
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        StringList *const errorList = strLstDup(priorErrorList);
-
         // Is this a WAL segment?
         const bool isSegment = walIsSegment(archiveFile);
 
-        // If this is a segment compare archive version and systemId to the WAL header
-        if (headerCheck && isSegment)
-        {
-            const PgWal walInfo = pgWalFromFile(walSource, storageLocal(), cfgOptionStrNull(cfgOptPgVersionForce));
-
-            if (walInfo.version != pgVersion || walInfo.systemId != pgSystemId)
-            {
-                THROW_FMT(
-                    ArchiveMismatchError,
-                    "WAL file '%s' version %s, system-id %" PRIu64 " do not match stanza version %s, system-id %" PRIu64,
-                    strZ(walSource), strZ(pgVersionToStr(walInfo.version)), walInfo.systemId, strZ(pgVersionToStr(pgVersion)),
-                    pgSystemId);
-            }
-        }
-
         // Set archive destination initially to the archive file, this will be updated later for wal segments
         String *const archiveDestination = strCat(strNew(), archiveFile);
 
@@ -154,25 +207,106 @@ archivePushFile(
         for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
             destinationCopy[repoListIdx] = true;
 
+        // Repos where the WAL segment will be written exclusively rather than checked for first, and which of those already had it
+        bool *const destinationExclusive = memNew(sizeof(bool) * lstSize(repoList));
+        bool *const destinationExists = memNew(sizeof(bool) * lstSize(repoList));
+
+        for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+        {
+            destinationExclusive[repoListIdx] = false;
+            destinationExists[repoListIdx] = false;
+        }
+
+        // WAL segment when it was small enough to be kept in memory while reading the segment
+        Buffer *walSegmentBuffer = NULL;
+
         // Get wal segment checksum and compare it to what exists in the repo, if any
+        uint64_t walSegmentSize = 0;
+
         if (isSegment)
         {
             // Assume that no repos need a copy of the WAL segment and update when a repo needing a copy is found
             destinationCopyAny = false;
 
-            // Generate a sha1 checksum for the wal segment
+            // Read the segment once to check the header, generate a sha1 checksum and size, and keep the segment in memory
             IoRead *const read = storageReadIo(storageNewReadP(storageLocal(), walSource));
             ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
-            ioReadDrain(read);
+            ioReadOpen(read);
+
+            const uint64_t walSourceSize = storageInfoP(storageLocal(), walSource).size;
+
+            if (walSourceSize <= ARCHIVE_PUSH_BUFFER_MAX)
+                walSegmentBuffer = bufNew((size_t)walSourceSize);
+
+            Buffer *const buffer = bufNew(ioBufferSize());
+
+            do
+            {
+                ioRead(read, buffer);
+
+                // If this is the first buffer compare archive version and systemId to the WAL header
+                if (headerCheck && walSegmentSize == 0)
+                {
+                    if (bufUsed(buffer) < PG_WAL_HEADER_SIZE)
+                        THROW_FMT(FileReadError, "unable to read %u byte(s) from '%s'", PG_WAL_HEADER_SIZE, strZ(walSource));
+
+                    const PgWal walInfo = pgWalFromBuffer(buffer, cfgOptionStrNull(cfgOptPgVersionForce));
+
+                    if (walInfo.version != pgVersion || walInfo.systemId != pgSystemId)
+                    {
+                        THROW_FMT(
+                            ArchiveMismatchError,
+                            "WAL file '%s' version %s, system-id %" PRIu64 " do not match stanza version %s, system-id %" PRIu64,
+                            strZ(walSource), strZ(pgVersionToStr(walInfo.version)), walInfo.systemId,
+                            strZ(pgVersionToStr(pgVersion)), pgSystemId);
+                    }
+                }
+
+                walSegmentSize += bufUsed(buffer);
+
+                // Keep the segment in memory when it is small enough
+                if (walSegmentBuffer != NULL)
+                    bufCat(walSegmentBuffer, buffer);
+
+                bufUsedZero(buffer);
+            }
+            while (!ioReadEof(read));
+
+            ioReadClose(read);
 
             const String *const walSegmentChecksum = strNewEncode(
                 encodingHex, pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE)));
 
+            // Write the compressed segment for the jobs pushing it to other repos. This is done before checking the repo since the
+            // other jobs are waiting for it.
+            if (compressFileWrite)
+            {
+                StorageWrite *const compressWrite = storageNewWriteP(storageLocalWrite(), compressFile);
+                ioFilterGroupAdd(
+                    ioWriteFilterGroup(storageWriteIo(compressWrite)),
+                    compressFilterP(compressType, compressLevel, .size = walSegmentSize, .threadMax = compressThread));
+
+                if (walSegmentBuffer != NULL)
+                    storagePutP(compressWrite, walSegmentBuffer);
+                else
+                    storageCopyP(storageNewReadP(storageLocal(), walSource), compressWrite);
+            }
+
             // Check each repo for the WAL segment
             for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
             {
                 const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
 
+                // When the duplicate check is disabled and the repo can write exclusively then skip listing the repo. The write
+                // finds the WAL segment if it already exists with the same checksum, which is part of the file name. A WAL segment
+                // with a different checksum will not be found.
+                if (!duplicateCheck && storageFeature(storageRepoIdxWrite(repoData->repoIdx), storageFeatureWriteExclusive))
+                {
+                    destinationExclusive[repoListIdx] = true;
+                    destinationCopyAny = true;
+                    continue;
+                }
+
                 // Check if the WAL segment already exists in the repo
                 const String *walSegmentFile;
 
@@ -182,7 +316,7 @@ archivePushFile(
                 }
                 CATCH_ANY()
                 {
-                    archivePushErrorAdd(errorList, repoData->repoIdx);
+                    archivePushErrorAdd(result.errorList, repoData->repoIdx);
                     destinationCopy[repoListIdx] = false;
                 }
                 TRY_END();
@@ -202,14 +336,7 @@ archivePushFile(
                     if (strEq(walSegmentChecksum, walSegmentRepoChecksum))
                     {
                         if (modeCheck)
-                        {
-                            // Add warning to the result that will be returned to the main process
-                            strLstAddFmt(
-                                result.warnList,
-                                "WAL file '%s' already exists in the %s archive with the same checksum"
-                                "\nHINT: this is valid in some recovery scenarios but may also indicate a problem.",
-                                strZ(archiveFile), cfgOptionGroupName(cfgOptGrpRepo, repoData->repoIdx));
-                        }
+                            archivePushDuplicateWarn(result.warnList, archiveFile, repoData->repoIdx);
 
                         // No need to copy to this repo
                         destinationCopy[repoListIdx] = false;
@@ -235,8 +362,16 @@ archivePushFile(
         // Copy the file if one or more repos require it
         if (destinationCopyAny)
         {
-            // Source file is read once and copied to all repos
-            StorageRead *const source = storageNewReadP(storageLocal(), walSource);
+            // Is the compressed segment shared with other jobs? If so it is the source and is not compressed again.
+            const bool compressShared = compressFile != NULL && (compressFileWrite || archivePushFileCompressWait(compressFile));
+
+            // Source is read once and copied to all repos. When the segment was kept in memory then that is the source, else the
+            // source file is read again.
+            IoRead *const source =
+                compressShared ?
+                    storageReadIo(storageNewReadP(storageLocal(), compressFile)) :
+                    walSegmentBuffer != NULL ?
+                        ioBufferReadNew(walSegmentBuffer) : storageReadIo(storageNewReadP(storageLocal(), walSource));
 
             // Is the file compressible during the copy?
             bool compressible = true;
@@ -245,7 +380,14 @@ archivePushFile(
             if (isSegment && compressType != compressTypeNone)
             {
                 compressExtCat(archiveDestination, compressType);
-                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), compressFilterP(compressType, compressLevel));
+
+                if (!compressShared)
+                {
+                    ioFilterGroupAdd(
+                        ioReadFilterGroup(source),
+                        compressFilterP(compressType, compressLevel, .size = walSegmentSize, .threadMax = compressThread));
+                }
+
                 compressible = false;
             }
 
@@ -263,7 +405,7 @@ archivePushFile(
                     destination[repoListIdx] = storageNewWriteP(
                         storageRepoIdxWrite(repoData->repoIdx),
                         strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(repoData->archiveId), strZ(archiveDestination)),
-                        .compressible = compressible);
+                        .exclusive = destinationExclusive[repoListIdx], .compressible = compressible);
 
                     // If there is a cipher then add the encrypt filter
                     if (cipherSpecType(repoData->cipherSpecArchive) != cipherTypeNone)
@@ -276,7 +418,7 @@ archivePushFile(
             }
 
             // Open source file
-            ioReadOpen(storageReadIo(source));
+            ioReadOpen(source);
 
             // Open the destination files now that we know the source file exists and is readable
             for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
@@ -286,7 +428,8 @@ archivePushFile(
                 if (destinationCopy[repoListIdx])
                 {
                     destinationCopy[repoListIdx] = archivePushFileIo(
-                        archivePushFileIoTypeOpen, storageWriteIo(destination[repoListIdx]), NULL, repoIdx, errorList);
+                        archivePushFileIoTypeOpen, storageWriteIo(destination[repoListIdx]), NULL, repoIdx, result.errorList,
+                        &destinationExists[repoListIdx]);
                 }
             }
 
@@ -296,7 +439,7 @@ archivePushFile(
             do
             {
                 // Read from source
-                ioRead(storageReadIo(source), read);
+                ioRead(source, read);
 
                 // Write to each destination
                 for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
@@ -306,17 +449,18 @@ archivePushFile(
                     if (destinationCopy[repoListIdx])
                     {
                         destinationCopy[repoListIdx] = archivePushFileIo(
-                            archivePushFileIoTypeWrite, storageWriteIo(destination[repoListIdx]), read, repoIdx, errorList);
+                            archivePushFileIoTypeWrite, storageWriteIo(destination[repoListIdx]), read, repoIdx, result.errorList,
+                            &destinationExists[repoListIdx]);
                     }
                 }
 
                 // Clear buffer
                 bufUsedZero(read);
             }
-            while (!ioReadEof(storageReadIo(source)));
+            while (!ioReadEof(source));
 
             // Close the source and destination files
-            ioReadClose(storageReadIo(source));
+            ioReadClose(source);
 
             for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
             {
@@ -325,15 +469,15 @@ archivePushFile(
                 if (destinationCopy[repoListIdx])
                 {
                     destinationCopy[repoListIdx] = archivePushFileIo(
-                        archivePushFileIoTypeClose, storageWriteIo(destination[repoListIdx]), NULL, repoIdx, errorList);
+                        archivePushFileIoTypeClose, storageWriteIo(destination[repoListIdx]), NULL, repoIdx, result.errorList,
+                        &destinationExists[repoListIdx]);
                 }
+
+                // Warn when the exclusive write found the WAL segment already in the repo
+                if (destinationExists[repoListIdx] && modeCheck)
+                    archivePushDuplicateWarn(result.warnList, archiveFile, repoIdx);
             }
         }
-
-        // Throw any errors, even if some pushes were successful. It is important that PostgreSQL receives an error so it does not
-        // remove the file.
-        if (strLstSize(errorList) > 0)
-            THROW_FMT(CommandError, CFGCMD_ARCHIVE_PUSH " command encountered error(s):\n%s", strZ(strLstJoin(errorList, "\n")));
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -26,12 +26,16 @@ Functions
 typedef struct ArchivePushFileResult
 {
     StringList *warnList;                                           // Warnings from a successful operation
+    StringList *errorList;                                          // Errors from repos that could not be pushed to
 } ArchivePushFileResult;
 
-// Copy a file from the source to the archive
+// Copy a file from the source to the archive. Errors writing to a repo do not stop the push to other repos, so they are returned
+// and the caller must report them. When compressFile is set the compressed WAL segment is shared with other jobs pushing the same
+// segment to other repos. The job with compressFileWrite set writes it and the other jobs wait for it rather than compressing the
+// segment again.
 FN_EXTERN ArchivePushFileResult archivePushFile(
-    const String *walSource, bool headerCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
-    const String *archiveFile, CompressType compressType, int compressLevel, const List *repoList,
-    const StringList *priorErrorList);
+    const String *walSource, bool headerCheck, bool modeCheck, bool duplicateCheck, unsigned int pgVersion, uint64_t pgSystemId,
+    const String *archiveFile, CompressType compressType, int compressLevel, unsigned int compressThread,
+    const String *compressFile, bool compressFileWrite, const List *repoList);
 
 #endif
@@ -30,12 +30,15 @@ archivePushFileProtocol(PackRead *const param)
         const String *const walSource = pckReadStrP(param);
         const bool headerCheck = pckReadBoolP(param);
         const bool modeCheck = pckReadBoolP(param);
+        const bool duplicateCheck = pckReadBoolP(param);
         const unsigned int pgVersion = pckReadU32P(param);
         const uint64_t pgSystemId = pckReadU64P(param);
         const String *const archiveFile = pckReadStrP(param);
         const CompressType compressType = pckReadU32P(param);
         const int compressLevel = pckReadI32P(param);
-        const StringList *const priorErrorList = pckReadStrLstP(param);
+        const unsigned int compressThread = pckReadU32P(param);
+        const String *const compressFile = pckReadStrP(param);
+        const bool compressFileWrite = pckReadBoolP(param);
 
         // Read repo data
         List *const repoList = lstNewP(sizeof(ArchivePushFileRepoData));
@@ -58,11 +61,14 @@ archivePushFileProtocol(PackRead *const param)
 
         // Push file
         const ArchivePushFileResult fileResult = archivePushFile(
-            walSource, headerCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel, repoList,
-            priorErrorList);
+            walSource, headerCheck, modeCheck, duplicateCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel,
+            compressThread, compressFile, compressFileWrite, repoList);
 
         // Return result
-        pckWriteStrLstP(protocolServerResultData(result), fileResult.warnList);
+        PackWrite *const data = protocolServerResultData(result);
+
+        pckWriteStrLstP(data, fileResult.warnList);
+        pckWriteStrLstP(data, fileResult.errorList);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -17,6 +17,7 @@ Archive Push Command
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -39,6 +40,27 @@ Ready file extension constants
 #define STATUS_EXT_READY                                            ".ready"
 #define STATUS_EXT_READY_SIZE                                       (sizeof(STATUS_EXT_READY) - 1)
 
+/***********************************************************************************************************************************
+Format the error when one or more repos could not be checked or pushed to
+***********************************************************************************************************************************/
+static String *
+archivePushErrorMessage(const StringList *const errorList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, errorList);
+    FUNCTION_TEST_END();
+
+    ASSERT(errorList != NULL);
+    ASSERT(!strLstEmpty(errorList));
+
+    String *const error = strLstJoin(errorList, "\n");
+    String *const result = strNewFmt(CFGCMD_ARCHIVE_PUSH " command encountered error(s):\n%s", strZ(error));
+
+    strFree(error);
+
+    FUNCTION_TEST_RETURN(STRING, result);
+}
+
 /***********************************************************************************************************************************
 Format the warning when a file is dropped
 ***********************************************************************************************************************************/
@@ -411,9 +433,20 @@ cmdArchivePush(void)
 
                 // Push the file to the archive
                 const ArchivePushFileResult fileResult = archivePushFile(
-                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion,
-                    archiveInfo.pgSystemId, archiveFile, compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
-                    cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList, archiveInfo.errorList);
+                    walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveModeCheck),
+                    cfgOptionBool(cfgOptArchiveDuplicateCheck), archiveInfo.pgVersion, archiveInfo.pgSystemId, archiveFile,
+                    compressTypeEnum(cfgOptionStrId(cfgOptCompressType)), cfgOptionInt(cfgOptCompressLevel),
+                    cfgOptionUInt(cfgOptCompressThread), NULL, false, archiveInfo.repoList);
+
+                // Throw any errors, even if some pushes were successful. It is important that PostgreSQL receives an error so it
+                // does not remove the file.
+                StringList *const errorList = strLstDup(archiveInfo.errorList);
+
+                for (unsigned int errorIdx = 0; errorIdx < strLstSize(fileResult.errorList); errorIdx++)
+                    strLstAdd(errorList, strLstGet(fileResult.errorList, errorIdx));
+
+                if (!strLstEmpty(errorList))
+                    THROW(CommandError, strZ(archivePushErrorMessage(errorList)));
 
                 // If a warning was returned then log it
                 for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -430,13 +463,38 @@ cmdArchivePush(void)
 }
 
 /**********************************************************************************************************************************/
+// Results of the jobs pushing a WAL file to each repo, combined into a single status when all the jobs are complete
+typedef struct ArchivePushAsyncWal
+{
+    unsigned int jobRemaining;                                      // Jobs that are not complete
+    int errorCode;                                                  // Error code of the first job that errored
+    const String *errorMessage;                                     // Error message of the first job that errored
+    const String *compressFile;                                     // Compressed WAL shared by the jobs (NULL when not shared)
+    bool compressFileJob;                                           // Has a job been scheduled to write the compressed WAL?
+    bool *repoDone;                                                 // Is the result for each repo complete?
+    StringList **warnList;                                          // Warnings from each repo
+    StringList **errorList;                                         // Errors from each repo
+} ArchivePushAsyncWal;
+
+// Job each client (process) is running
+typedef struct ArchivePushAsyncClient
+{
+    unsigned int repoListIdx;                                       // Repo the client is pushing to (UINT_MAX when idle)
+    unsigned int walFileIdx;                                        // WAL file the client is pushing
+    TimeMSec timeBegin;                                             // Time the job began
+} ArchivePushAsyncClient;
+
 typedef struct ArchivePushAsyncData
 {
     const String *walPath;                                          // Path to pg_wal/pg_xlog
     StringList *walFileList;                                        // List of wal files to process
-    unsigned int walFileIdx;                                        // Current index in the list to be processed
+    List *walList;                                                  // Results for each WAL file
+    unsigned int *walFileIdx;                                       // Current index in the list to be processed for each repo
+    unsigned int clientTotal;                                       // Total clients (processes) pushing WAL
+    ArchivePushAsyncClient *clientList;                             // Job each client is running
     CompressType compressType;                                      // Type of compression for WAL segments
     int compressLevel;                                              // Compression level for wal files
+    unsigned int compressThread;                                    // Compression threads for large wal files
     ArchivePushCheckResult archiveInfo;                             // Archive info
     bool errorFound;                                                // Has a job errored? If so, stop scheduling new jobs
 } ArchivePushAsyncData;
@@ -453,57 +511,196 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // No special logic based on the client, we'll just get the next job
-        (void)clientIdx;
+        ArchivePushAsyncData *const jobData = data;
+        const unsigned int repoTotal = lstSize(jobData->archiveInfo.repoList);
+
+        // The client is requesting a job so the job it was running, if any, is complete
+        jobData->clientList[clientIdx].repoListIdx = UINT_MAX;
 
         // Get a new job if there are any left. Stop scheduling new jobs as soon as one errors so the async process exits and the
         // next run rechecks the queue. Continuing past an error does not relieve disk pressure since PostgreSQL cannot recycle any
         // WAL past the oldest unarchived segment, so the sooner the queue is rechecked the sooner WAL can be dropped if needed.
-        ArchivePushAsyncData *const jobData = data;
-
-        if (!jobData->errorFound && jobData->walFileIdx < strLstSize(jobData->walFileList))
+        if (!jobData->errorFound)
         {
-            const String *const walFile = strLstGet(jobData->walFileList, jobData->walFileIdx);
-            jobData->walFileIdx++;
+            // Each WAL file is pushed to each repo in a separate job so the repos advance independently. Pick the repo with the
+            // fewest jobs running so a slow repo only holds the clients already pushing to it, then the repo that is furthest
+            // behind so the WAL files are completed in order.
+            const unsigned int walFileTotal = strLstSize(jobData->walFileList);
+            unsigned int repoListIdxNext = UINT_MAX;
+            uint64_t repoPriorityNext = UINT64_MAX;
+
+            for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+            {
+                if (jobData->walFileIdx[repoListIdx] < walFileTotal)
+                {
+                    uint64_t repoJobTotal = 0;
 
-            PackWrite *const param = protocolPackNew();
+                    for (unsigned int clientListIdx = 0; clientListIdx < jobData->clientTotal; clientListIdx++)
+                    {
+                        if (jobData->clientList[clientListIdx].repoListIdx == repoListIdx)
+                            repoJobTotal++;
+                    }
 
-            pckWriteStrP(param, strNewFmt("%s/%s", strZ(jobData->walPath), strZ(walFile)));
-            pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
-            pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
-            pckWriteU32P(param, jobData->archiveInfo.pgVersion);
-            pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
-            pckWriteStrP(param, walFile);
-            pckWriteU32P(param, jobData->compressType);
-            pckWriteI32P(param, jobData->compressLevel);
-            pckWriteStrLstP(param, jobData->archiveInfo.errorList);
+                    // Jobs running outweigh the WAL index since the index is always less than the WAL total
+                    const uint64_t repoPriority = repoJobTotal * walFileTotal + jobData->walFileIdx[repoListIdx];
 
-            // Add data for each repo to push to
-            pckWriteArrayBeginP(param);
+                    if (repoPriority < repoPriorityNext)
+                    {
+                        repoListIdxNext = repoListIdx;
+                        repoPriorityNext = repoPriority;
+                    }
+                }
+            }
 
-            for (unsigned int repoListIdx = 0; repoListIdx < lstSize(jobData->archiveInfo.repoList); repoListIdx++)
+            if (repoListIdxNext != UINT_MAX)
             {
-                ArchivePushFileRepoData *data = lstGet(jobData->archiveInfo.repoList, repoListIdx);
+                const unsigned int walFileIdx = jobData->walFileIdx[repoListIdxNext];
+                const String *const walFile = strLstGet(jobData->walFileList, walFileIdx);
+                const ArchivePushFileRepoData *const repoData = lstGet(jobData->archiveInfo.repoList, repoListIdxNext);
+                ArchivePushAsyncWal *const wal = lstGet(jobData->walList, walFileIdx);
 
+                jobData->walFileIdx[repoListIdxNext]++;
+                jobData->clientList[clientIdx] = (ArchivePushAsyncClient)
+                {
+                    .repoListIdx = repoListIdxNext,
+                    .walFileIdx = walFileIdx,
+                    .timeBegin = timeMSec(),
+                };
+
+                PackWrite *const param = protocolPackNew();
+
+                pckWriteStrP(param, strNewFmt("%s/%s", strZ(jobData->walPath), strZ(walFile)));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveHeaderCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveModeCheck));
+                pckWriteBoolP(param, cfgOptionBool(cfgOptArchiveDuplicateCheck));
+                pckWriteU32P(param, jobData->archiveInfo.pgVersion);
+                pckWriteU64P(param, jobData->archiveInfo.pgSystemId);
+                pckWriteStrP(param, walFile);
+                pckWriteU32P(param, jobData->compressType);
+                pckWriteI32P(param, jobData->compressLevel);
+                pckWriteU32P(param, jobData->compressThread);
+
+                // The first job scheduled for the WAL file writes the compressed WAL and the rest use it
+                pckWriteStrP(
+                    param, wal->compressFile == NULL ? NULL : storagePathP(storageSpool(), wal->compressFile));
+                pckWriteBoolP(param, wal->compressFile != NULL && !wal->compressFileJob);
+
+                wal->compressFileJob = true;
+
+                // Add data for the repo to push to
+                pckWriteArrayBeginP(param);
                 pckWriteObjBeginP(param);
-                pckWriteU32P(param, data->repoIdx);
-                pckWriteStrP(param, data->archiveId);
-                cipherSpecPack(param, data->cipherSpecArchive);
+                pckWriteU32P(param, repoData->repoIdx);
+                pckWriteStrP(param, repoData->archiveId);
+                cipherSpecPack(param, repoData->cipherSpecArchive);
                 pckWriteObjEndP(param);
+                pckWriteArrayEndP(param);
+
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = protocolParallelJobNew(
+                        VARUINT(walFileIdx * repoTotal + repoListIdxNext), PROTOCOL_COMMAND_ARCHIVE_PUSH_FILE, param);
+                }
+                MEM_CONTEXT_PRIOR_END();
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
+// Complete the result for a repo. When the results for all repos are complete then write the status for the WAL file.
+static void
+archivePushAsyncRepoDone(
+    ArchivePushAsyncData *const jobData, const unsigned int walFileIdx, const unsigned int repoListIdx,
+    const unsigned int processId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(UINT, walFileIdx);
+        FUNCTION_TEST_PARAM(UINT, repoListIdx);
+        FUNCTION_TEST_PARAM(UINT, processId);
+    FUNCTION_TEST_END();
+
+    ArchivePushAsyncWal *const wal = lstGet(jobData->walList, walFileIdx);
+    const unsigned int repoTotal = lstSize(jobData->archiveInfo.repoList);
+
+    // Stop scheduling new jobs when the job errored or a repo could not be checked or pushed to
+    if (wal->errorCode != 0 || !strLstEmpty(wal->errorList[repoListIdx]) || !strLstEmpty(jobData->archiveInfo.errorList))
+        jobData->errorFound = true;
+
+    wal->repoDone[repoListIdx] = true;
+    wal->jobRemaining--;
+
+    // Write the status when the WAL file has been pushed to all repos
+    if (wal->jobRemaining == 0)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const String *const walFile = strLstGet(jobData->walFileList, walFileIdx);
+
+            // Combine the errors from repos that could not be checked or pushed to
+            int errorCode = wal->errorCode;
+            const String *errorMessage = wal->errorMessage;
+
+            if (errorCode == 0)
+            {
+                StringList *const errorList = strLstDup(jobData->archiveInfo.errorList);
+
+                for (unsigned int repoErrorIdx = 0; repoErrorIdx < repoTotal; repoErrorIdx++)
+                {
+                    for (unsigned int errorIdx = 0; errorIdx < strLstSize(wal->errorList[repoErrorIdx]); errorIdx++)
+                        strLstAdd(errorList, strLstGet(wal->errorList[repoErrorIdx], errorIdx));
+                }
+
+                if (!strLstEmpty(errorList))
+                {
+                    errorCode = errorTypeCode(&CommandError);
+                    errorMessage = archivePushErrorMessage(errorList);
+                }
             }
 
-            pckWriteArrayEndP(param);
+            // The WAL file was pushed to all repos
+            if (errorCode == 0)
+            {
+                // Output file warnings
+                StringList *const fileWarnList = strLstNew();
+
+                for (unsigned int repoWarnIdx = 0; repoWarnIdx < repoTotal; repoWarnIdx++)
+                {
+                    for (unsigned int warnIdx = 0; warnIdx < strLstSize(wal->warnList[repoWarnIdx]); warnIdx++)
+                    {
+                        strLstAdd(fileWarnList, strLstGet(wal->warnList[repoWarnIdx], warnIdx));
+                        LOG_WARN_PID(processId, strZ(strLstGet(wal->warnList[repoWarnIdx], warnIdx)));
+                    }
+                }
 
-            MEM_CONTEXT_PRIOR_BEGIN()
+                // Log success
+                LOG_DETAIL_PID_FMT(processId, "pushed WAL file '%s' to the archive", strZ(walFile));
+
+                // Write the status file
+                archiveAsyncStatusOkWrite(
+                    archiveModePush, walFile, strLstEmpty(fileWarnList) ? NULL : strLstJoin(fileWarnList, "\n"));
+            }
+            // Else the WAL file could not be pushed to one or more repos
+            else
             {
-                result = protocolParallelJobNew(VARSTR(walFile), PROTOCOL_COMMAND_ARCHIVE_PUSH_FILE, param);
+                LOG_WARN_PID_FMT(
+                    processId, "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strZ(walFile), errorCode,
+                    strZ(errorMessage));
+
+                archiveAsyncStatusErrorWrite(archiveModePush, walFile, errorCode, errorMessage);
             }
-            MEM_CONTEXT_PRIOR_END();
+
+            // Remove the compressed WAL shared by the jobs
+            if (wal->compressFile != NULL)
+                storageRemoveP(storageSpoolWrite(), wal->compressFile);
         }
+        MEM_CONTEXT_TEMP_END();
     }
-    MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+    FUNCTION_TEST_RETURN_VOID();
 }
 
 FN_EXTERN void
@@ -529,6 +726,7 @@ cmdArchivePushAsync(void)
             .walPath = strLstGet(commandParam, 0),
             .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
             .compressLevel = cfgOptionInt(cfgOptCompressLevel),
+            .compressThread = cfgOptionUInt(cfgOptCompressThread),
         };
 
         TRY_BEGIN()
@@ -590,11 +788,61 @@ cmdArchivePushAsync(void)
                 // Check archive info for each repo
                 jobData.archiveInfo = archivePushCheck(true);
 
-                // Create the parallel executor
+                const unsigned int repoTotal = lstSize(jobData.archiveInfo.repoList);
+
+                jobData.walFileIdx = memNew(sizeof(unsigned int) * repoTotal);
+
+                for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+                    jobData.walFileIdx[repoListIdx] = 0;
+
+                jobData.clientTotal = cfgOptionUInt(cfgOptProcessMax);
+                jobData.clientList = memNew(sizeof(ArchivePushAsyncClient) * jobData.clientTotal);
+
+                for (unsigned int clientIdx = 0; clientIdx < jobData.clientTotal; clientIdx++)
+                    jobData.clientList[clientIdx] = (ArchivePushAsyncClient){.repoListIdx = UINT_MAX};
+
+                // Initialize the results for each WAL file. When a WAL segment is pushed to more than one repo then the segment is
+                // compressed once into the spool path and shared by the jobs.
+                jobData.walList = lstNewP(sizeof(ArchivePushAsyncWal));
+
+                MEM_CONTEXT_BEGIN(lstMemContext(jobData.walList))
+                {
+                    for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData.walFileList); walFileIdx++)
+                    {
+                        const String *const walFile = strLstGet(jobData.walFileList, walFileIdx);
+                        ArchivePushAsyncWal wal =
+                        {
+                            .jobRemaining = repoTotal,
+                            .repoDone = memNew(sizeof(bool) * repoTotal),
+                            .warnList = memNewPtrArray(repoTotal),
+                            .errorList = memNewPtrArray(repoTotal),
+                        };
+
+                        for (unsigned int repoListIdx = 0; repoListIdx < repoTotal; repoListIdx++)
+                            wal.repoDone[repoListIdx] = false;
+
+                        if (repoTotal > 1 && jobData.compressType != compressTypeNone && walIsSegment(walFile))
+                        {
+                            String *const compressFile = strCatFmt(strNew(), STORAGE_SPOOL_ARCHIVE_OUT "/%s", strZ(walFile));
+
+                            compressExtCat(compressFile, jobData.compressType);
+                            wal.compressFile = compressFile;
+                        }
+
+                        lstAdd(jobData.walList, &wal);
+                    }
+                }
+                MEM_CONTEXT_END();
+
+                // Create the parallel executor. The executor waits no longer than a fraction of the archive timeout for a job to
+                // complete so jobs that have not completed within the archive timeout are found promptly.
+                const TimeMSec archiveTimeout = cfgOptionUInt64(cfgOptArchiveTimeout);
+                const TimeMSec protocolTimeout = cfgOptionUInt64(cfgOptProtocolTimeout) / 2;
                 ProtocolParallel *const parallelExec = protocolParallelNew(
-                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archivePushAsyncCallback, &jobData);
+                    archiveTimeout / 10 < protocolTimeout ? archiveTimeout / 10 : protocolTimeout, archivePushAsyncCallback,
+                    &jobData);
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                for (unsigned int processIdx = 1; processIdx <= jobData.clientTotal; processIdx++)
                     protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
                 // Process jobs
@@ -608,43 +856,73 @@ cmdArchivePushAsync(void)
                         {
                             protocolKeepAlive();
 
-                            // Get the job and job key
+                            // Get the job and the WAL file and repo it pushed to
                             ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
-                            const unsigned int processId = protocolParallelJobProcessId(job);
-                            const String *const walFile = varStr(protocolParallelJobKey(job));
+                            const unsigned int walFileIdx = varUInt(protocolParallelJobKey(job)) / repoTotal;
+                            const unsigned int repoListIdx = varUInt(protocolParallelJobKey(job)) % repoTotal;
+                            ArchivePushAsyncWal *const wal = lstGet(jobData.walList, walFileIdx);
 
-                            // The job was successful
-                            if (protocolParallelJobErrorCode(job) == 0)
+                            // Store the job result unless the job already timed out
+                            if (!wal->repoDone[repoListIdx])
                             {
-                                // Output file warnings
-                                const StringList *const fileWarnList = pckReadStrLstP(protocolParallelJobResult(job));
+                                const int jobErrorCode = protocolParallelJobErrorCode(job);
+
+                                MEM_CONTEXT_BEGIN(lstMemContext(jobData.walList))
+                                {
+                                    if (jobErrorCode == 0)
+                                    {
+                                        PackRead *const jobResult = protocolParallelJobResult(job);
+
+                                        wal->warnList[repoListIdx] = pckReadStrLstP(jobResult);
+                                        wal->errorList[repoListIdx] = pckReadStrLstP(jobResult);
+                                    }
+                                    else if (wal->errorCode == 0)
+                                    {
+                                        wal->errorCode = jobErrorCode;
+                                        wal->errorMessage = strDup(protocolParallelJobErrorMessage(job));
+                                    }
+                                }
+                                MEM_CONTEXT_END();
+
+                                archivePushAsyncRepoDone(&jobData, walFileIdx, repoListIdx, protocolParallelJobProcessId(job));
+                            }
 
-                                for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
-                                    LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+                            protocolParallelJobFree(job);
+                        }
 
-                                // Log success
-                                LOG_DETAIL_PID_FMT(processId, "pushed WAL file '%s' to the archive", strZ(walFile));
+                        // Jobs that have not completed within the archive timeout are reported as errors so the status is written
+                        // for the WAL file rather than waiting for a repo that may not respond until the protocol timeout. The
+                        // job is left to complete but its result is ignored.
+                        for (unsigned int clientIdx = 0; clientIdx < jobData.clientTotal; clientIdx++)
+                        {
+                            const ArchivePushAsyncClient *const client = &jobData.clientList[clientIdx];
 
-                                // Write the status file
-                                archiveAsyncStatusOkWrite(
-                                    archiveModePush, walFile, strLstEmpty(fileWarnList) ? NULL : strLstJoin(fileWarnList, "\n"));
-                            }
-                            // Else the job errored
-                            else
+                            if (client->repoListIdx != UINT_MAX && timeMSec() - client->timeBegin >= archiveTimeout)
                             {
-                                jobData.errorFound = true;
-
-                                LOG_WARN_PID_FMT(
-                                    processId,
-                                    "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strZ(walFile),
-                                    protocolParallelJobErrorCode(job), strZ(protocolParallelJobErrorMessage(job)));
-
-                                archiveAsyncStatusErrorWrite(
-                                    archiveModePush, walFile, protocolParallelJobErrorCode(job),
-                                    protocolParallelJobErrorMessage(job));
+                                ArchivePushAsyncWal *const wal = lstGet(jobData.walList, client->walFileIdx);
+
+                                if (!wal->repoDone[client->repoListIdx])
+                                {
+                                    const ArchivePushFileRepoData *const repoData = lstGet(
+                                        jobData.archiveInfo.repoList, client->repoListIdx);
+
+                                    MEM_CONTEXT_BEGIN(lstMemContext(jobData.walList))
+                                    {
+                                        wal->errorList[client->repoListIdx] = strLstNew();
+
+                                        strLstAddFmt(
+                                            wal->errorList[client->repoListIdx],
+                                            "%s: [%s] unable to push WAL file '%s' to the repo after %s second(s)",
+                                            cfgOptionGroupName(cfgOptGrpRepo, repoData->repoIdx),
+                                            errorTypeName(&ArchiveTimeoutError),
+                                            strZ(strLstGet(jobData.walFileList, client->walFileIdx)),
+                                            strZ(strNewDivP(archiveTimeout, MSEC_PER_SEC, .precision = 3, .trim = true)));
+                                    }
+                                    MEM_CONTEXT_END();
+
+                                    archivePushAsyncRepoDone(&jobData, client->walFileIdx, client->repoListIdx, clientIdx + 1);
+                                }
                             }
-
-                            protocolParallelJobFree(job);
                         }
 
                         // Reset the memory context occasionally so we don't use too much memory or slow down processing
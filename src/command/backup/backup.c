@@ -22,6 +22,7 @@ Backup Command
 #include "common/io/filter/size.h"
 #include "common/log.h"
 #include "common/regExp.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "common/type/convert.h"
 #include "common/type/json.h"
@@ -39,6 +40,15 @@ Backup Command
 #include "storage/helper.h"
 #include "version.h"
 
+/***********************************************************************************************************************************
+Statistics constants for backup phases
+***********************************************************************************************************************************/
+STRING_STATIC(BACKUP_STAT_ARCHIVE_CHECK_STR,                        "backup.archive-check"); // Check/copy WAL for consistency
+STRING_STATIC(BACKUP_STAT_COPY_STR,                                 "backup.copy");     // Copy files
+STRING_STATIC(BACKUP_STAT_MANIFEST_STR,                             "backup.manifest"); // Build manifest
+STRING_STATIC(BACKUP_STAT_START_STR,                                "backup.start");    // Start backup, including checkpoint
+STRING_STATIC(BACKUP_STAT_STOP_STR,                                 "backup.stop");     // Stop backup
+
 /***********************************************************************************************************************************
 Get the postgres database and storage objects
 ***********************************************************************************************************************************/
@@ -215,13 +225,17 @@ cmdBackup(void)
         // Get the start timestamp which will later be written into the manifest to track total backup time
         const time_t timestampStart = backupTime(backupData, false);
 
-        // Check if there is a prior manifest when backup type is diff/incr
+        // Check if there is a prior manifest when backup type is diff/incr or synthetic full
         Manifest *const manifestPrior = backupBuildIncrPrior(infoBackup);
 
         // Start the backup
+        TimeUSec timeBegin = timeUSec();
         const BackupStartResult backupStartResult = backupStart(backupData);
 
+        statTimeAdd(BACKUP_STAT_START_STR, timeUSec() - timeBegin, 0);
+
         // Build the manifest
+        timeBegin = timeUSec();
         const ManifestBlockIncrMap blockIncrMap = backupBlockIncrMap();
 
         Manifest *const manifest = manifestNewBuild(
@@ -238,6 +252,8 @@ cmdBackup(void)
         if (!backupBuildIncr(manifest, manifestPrior, backupStartResult.walSegmentName))
             manifestCipherSpecSet(manifest, cipherSpecGen(cfgOptionStrId(cfgOptRepoCipherType)));
 
+        statTimeAdd(BACKUP_STAT_MANIFEST_STR, timeUSec() - timeBegin, 0);
+
         // Set delta if it is not already set and the manifest requires it
         if (!cfgOptionBool(cfgOptDelta) && varBool(manifestData(manifest)->backupOptionDelta))
             cfgOptionSet(cfgOptDelta, cfgSourceParam, BOOL_TRUE_VAR);
@@ -245,17 +261,21 @@ cmdBackup(void)
         // Resume a backup when possible
         if (!backupResume(manifest, cipherSpecManifest))
         {
+            // A synthetic full references a prior backup but is labeled like any other full backup
+            const BackupType type = (BackupType)cfgOptionStrId(cfgOptType);
+
             manifestBackupLabelSet(
                 manifest,
-                backupLabelCreate(
-                    (BackupType)cfgOptionStrId(cfgOptType), manifestData(manifest)->backupLabelPrior, timestampStart));
+                backupLabelCreate(type, type == backupTypeFull ? NULL : manifestData(manifest)->backupLabelPrior, timestampStart));
         }
 
         // Save the manifest before processing starts
-        backupManifestSaveCopy(manifest, cipherSpecManifest, false);
+        backupManifestSaveCopy(manifest, cipherSpecManifest);
 
         // Process the backup manifest
+        timeBegin = timeUSec();
         backupProcess(backupData, manifest, cipherSpecManifest);
+        statTimeAdd(BACKUP_STAT_COPY_STR, timeUSec() - timeBegin, 0);
 
         // Check that the clusters are alive and correctly configured after the backup
         backupDbPing(backupData, true);
@@ -268,8 +288,11 @@ cmdBackup(void)
         }
 
         // Stop the backup
+        timeBegin = timeUSec();
         const BackupStopResult backupStopResult = backupStop(backupData, manifest);
 
+        statTimeAdd(BACKUP_STAT_STOP_STR, timeUSec() - timeBegin, 0);
+
         // Complete manifest
         manifestBuildComplete(
             manifest, backupStartResult.lsn, backupStartResult.walSegmentName, backupStopResult.timestamp, backupStopResult.lsn,
@@ -283,7 +306,9 @@ cmdBackup(void)
         dbFree(backupData->dbPrimary);
 
         // Check and copy WAL segments required to make the backup consistent
+        timeBegin = timeUSec();
         backupArchiveCheckCopy(backupData, manifest, cipherSpecManifest);
+        statTimeAdd(BACKUP_STAT_ARCHIVE_CHECK_STR, timeUSec() - timeBegin, 0);
 
         // The primary protocol connection won't be used anymore so free it. This needs to happen after backupArchiveCheckCopy() so
         // the backup lock is held on the remote which allows conditional archiving based on the backup lock. Any further access to
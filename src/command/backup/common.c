@@ -6,8 +6,12 @@ Common Functions and Definitions for Backup and Expire Commands
 #include <unistd.h>
 
 #include "command/backup/common.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/encode.h"
 #include "common/log.h"
+#include "info/manifest/manifest.h"
 #include "storage/helper.h"
 
 /***********************************************************************************************************************************
@@ -25,20 +29,36 @@ backupFileRepoPath(const String *const backupLabel, const BackupFileRepoPathPara
         FUNCTION_TEST_PARAM(UINT64, param.bundleId);
         FUNCTION_TEST_PARAM(ENUM, param.compressType);
         FUNCTION_TEST_PARAM(BOOL, param.blockIncr);
+        FUNCTION_TEST_PARAM_P(VOID, param.dedupChecksum);
     FUNCTION_TEST_END();
 
-    ASSERT(backupLabel != NULL);
-    ASSERT(param.bundleId != 0 || param.manifestName != NULL);
+    ASSERT(backupLabel != NULL || param.dedupChecksum != NULL);
+    ASSERT(param.bundleId != 0 || param.manifestName != NULL || param.dedupChecksum != NULL);
+    ASSERT(param.dedupChecksum == NULL || (param.bundleId == 0 && !param.blockIncr));
 
-    String *const result = strCatFmt(strNew(), STORAGE_REPO_BACKUP "/%s/", strZ(backupLabel));
+    String *result;
+
+    // Files in the dedup store are stored in a path named for the first byte of the checksum to keep the paths a reasonable size
+    if (param.dedupChecksum != NULL)
+    {
+        char checksum[HASH_TYPE_SHA1_SIZE_HEX + 1];
+        encodeToStr(encodingHex, param.dedupChecksum, HASH_TYPE_SHA1_SIZE, checksum);
 
-    if (param.bundleId != 0)
-        strCatFmt(result, MANIFEST_PATH_BUNDLE "/%" PRIu64, param.bundleId);
+        result = strCatFmt(
+            strNew(), STORAGE_PATH_DEDUP "/%.2s/%s%s", checksum, checksum, strZ(compressExtStr(param.compressType)));
+    }
     else
     {
-        strCatFmt(
-            result, "%s%s", strZ(param.manifestName),
-            param.blockIncr ? BACKUP_BLOCK_INCR_EXT : strZ(compressExtStr(param.compressType)));
+        result = strCatFmt(strNew(), STORAGE_REPO_BACKUP "/%s/", strZ(backupLabel));
+
+        if (param.bundleId != 0)
+            strCatFmt(result, MANIFEST_PATH_BUNDLE "/%" PRIu64, param.bundleId);
+        else
+        {
+            strCatFmt(
+                result, "%s%s", strZ(param.manifestName),
+                param.blockIncr ? BACKUP_BLOCK_INCR_EXT : strZ(compressExtStr(param.compressType)));
+        }
     }
 
     FUNCTION_TEST_RETURN(STRING, result);
@@ -171,3 +191,65 @@ backupLinkLatest(const String *const backupLabel, const unsigned int repoIdx)
 
     FUNCTION_TEST_RETURN_VOID();
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+backupManifestSaveFinal(Manifest *const manifest, const CipherSpec *const cipherSpec)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(CIPHER_SPEC, cipherSpec);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const backupLabel = manifestData(manifest)->backupLabel;
+
+        // Validation and final save of the backup manifest. The copy is saved first and then copied to the manifest.
+        // -------------------------------------------------------------------------------------------------------------------------
+        manifestValidate(manifest, true);
+
+        IoWrite *const write = storageWriteIo(
+            storageNewWriteP(
+                storageRepoWrite(),
+                strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, strZ(backupLabel))));
+
+        cipherBlockFilterGroupAdd(ioWriteFilterGroup(write), cipherModeEncrypt, cipherSpec);
+        manifestSave(manifest, write);
+
+        storageCopy(
+            storageNewReadP(
+                storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE INFO_COPY_EXT, strZ(backupLabel))),
+            storageNewWriteP(
+                storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel))));
+
+        // Copy a compressed version of the manifest to history. If the repo is encrypted then the passphrase to open the manifest
+        // is required. We can't just do a straight copy since the destination needs to be compressed and that must happen before
+        // encryption in order to be efficient. Compression will always be gz for compatibility and since it is always available.
+        // -------------------------------------------------------------------------------------------------------------------------
+        StorageRead *const manifestRead = storageNewReadP(
+            storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)));
+
+        cipherBlockFilterGroupAdd(ioReadFilterGroup(storageReadIo(manifestRead)), cipherModeDecrypt, cipherSpec);
+
+        StorageWrite *const manifestWrite = storageNewWriteP(
+            storageRepoWrite(),
+            strNewFmt(
+                STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s/%s.manifest%s", strZ(strSubN(backupLabel, 0, 4)),
+                strZ(backupLabel), strZ(compressExtStr(compressTypeGz))));
+
+        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(manifestWrite)), compressFilterP(compressTypeGz, 9));
+        cipherBlockFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(manifestWrite)), cipherModeEncrypt, cipherSpec);
+
+        storageCopyP(manifestRead, manifestWrite);
+
+        // Sync history path if required
+        if (storageFeature(storageRepoWrite(), storageFeaturePathSync))
+            storagePathSyncP(storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
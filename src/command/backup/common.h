@@ -10,6 +10,7 @@ Common Functions and Definitions for Backup and Expire Commands
 #include "common/compress/helper.h"
 #include "common/type/string.h"
 #include "info/infoBackup.h"
+#include "storage/helper.h"
 
 /***********************************************************************************************************************************
 Backup constants
@@ -17,6 +18,10 @@ Backup constants
 #define BACKUP_PATH_HISTORY                                         "backup.history"
 #define BACKUP_BLOCK_INCR_EXT                                       ".pgbi"
 
+// Expire creates a file named for its stanza in this path while removing files from the dedup store. Backups do not use the store
+// while the path contains any files.
+#define BACKUP_DEDUP_EXPIRE_PATH                                    STORAGE_PATH_DEDUP "/expire"
+
 // Date and time must be in %Y%m%d-%H%M%S format, for example 20220901-193409
 #define DATE_TIME_REGEX                                             "[0-9]{8}\\-[0-9]{6}"
 #define DATE_TIME_LEN                                               (8 + 1 + 6)
@@ -24,13 +29,15 @@ Backup constants
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
-// Determine the path/file where the file is backed up in the repo
+// Determine the path/file where the file is backed up in the repo. Files in the dedup store are shared by all stanzas in the repo
+// and are named by the checksum of the file so the backup label is not used.
 typedef struct BackupFileRepoPathParam
 {
     const String *manifestName;                                     // File name in manifest
     uint64_t bundleId;                                              // Is the file bundled?
     CompressType compressType;                                      // Is the file compressed?
     bool blockIncr;                                                 // Is the file a block incremental?
+    const uint8_t *dedupChecksum;                                   // Checksum of the file when it is in the dedup store
 } BackupFileRepoPathParam;
 
 #define backupFileRepoPathP(backupLabel, ...)                                                                                      \
@@ -58,4 +65,8 @@ FN_EXTERN String *backupRegExp(BackupRegExpParam param);
 // Create a symlink to the specified backup (if symlinks are supported)
 FN_EXTERN void backupLinkLatest(const String *backupLabel, unsigned int repoIdx);
 
+// Save the final backup manifest along with the manifest copy and the compressed manifest in the backup history. The manifest is
+// validated in strict mode first to catch as many potential issues as possible.
+FN_EXTERN void backupManifestSaveFinal(Manifest *manifest, const CipherSpec *cipherSpec);
+
 #endif
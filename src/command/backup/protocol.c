@@ -4,6 +4,7 @@ Backup Protocol Handler
 #include <build.h>
 
 #include "command/backup/blockIncr.h"
+#include "command/backup/common.h"
 #include "command/backup/pageChecksum.h"
 #include "command/backup/protocol.h"
 #include "common/compress/helper.h"
@@ -17,6 +18,7 @@ Backup Protocol Handler
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/time.h"
 #include "common/type/json.h"
 #include "config/config.h"
 #include "storage/helper.h"
@@ -112,9 +114,12 @@ backupFileProtocol(PackRead *const param)
         const String *const repoFile = pckReadStrP(param);
         const uint64_t bundleId = pckReadU64P(param);
         const bool bundleRaw = bundleId != 0 ? pckReadBoolP(param) : false;
+        const bool dedup = bundleId == 0 ? pckReadBoolP(param) : false;
         const unsigned int blockIncrReference = (unsigned int)pckReadU64P(param);
         const CompressType repoFileCompressType = (CompressType)pckReadU32P(param);
         const int repoFileCompressLevel = pckReadI32P(param);
+        const unsigned int repoFileCompressThread = pckReadU32P(param);
+        const bool repoFileCompressAdapt = pckReadBoolP(param);
         const CipherSpec *const cipherSpecBackup = cipherSpecNewPack(param);
         const PgPageSize pageSize = pckReadU32P(param);
         const String *const pgVersionForce = pckReadStrP(param);
@@ -162,8 +167,8 @@ backupFileProtocol(PackRead *const param)
 
         // Backup file
         const List *const resultList = backupFile(
-            repoFile, bundleId, bundleRaw, blockIncrReference, repoFileCompressType, repoFileCompressLevel, cipherSpecBackup,
-            pgVersionForce, pageSize, fileList);
+            repoFile, bundleId, bundleRaw, dedup, blockIncrReference, repoFileCompressType, repoFileCompressLevel,
+            repoFileCompressThread, repoFileCompressAdapt, cipherSpecBackup, pgVersionForce, pageSize, fileList);
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
@@ -185,6 +190,7 @@ backupFileProtocol(PackRead *const param)
             pckWriteU64P(data, fileResult->repoSize);
             pckWriteBinP(data, fileResult->copyChecksum);
             pckWriteBinP(data, fileResult->repoChecksum);
+            pckWriteBoolP(data, fileResult->dedup);
             pckWritePackP(data, fileResult->pageChecksumResult);
         }
     }
@@ -17,6 +17,7 @@ typedef enum
     backupCopyResultSkip,
     backupCopyResultNoOp,
     backupCopyResultTruncate,
+    backupCopyResultDedup,
 } BackupCopyResult;
 
 /***********************************************************************************************************************************
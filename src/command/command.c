@@ -19,6 +19,7 @@ Common Command Routines
 #include "common/type/json.h"
 #include "config/config.intern.h"
 #include "config/parse.h"
+#include "storage/helper.h"
 #include "version.h"
 
 /***********************************************************************************************************************************
@@ -194,6 +195,35 @@ cmdBegin(void)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Write statistics to the stat file. Only warn on error since the command has already completed.
+***********************************************************************************************************************************/
+static void
+cmdStatWrite(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    TRY_BEGIN()
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const String *const statJson = statToJson();
+
+            storagePutP(
+                storageNewWriteP(storageLocalWrite(), cfgOptionStr(cfgOptStatFile)),
+                BUFSTR(statJson == NULL ? STRDEF("{}") : statJson));
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    CATCH_ANY()
+    {
+        LOG_WARN_FMT("unable to write statistics: %s", errorMessage());
+    }
+    TRY_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdEnd(const String *const errorMessage)
@@ -204,6 +234,10 @@ cmdEnd(const String *const errorMessage)
 
     ASSERT(cfgInited());
 
+    // Write statistics to a file when requested
+    if (cfgOptionTest(cfgOptStatFile))
+        cmdStatWrite();
+
     // Skip this log message if it won't be output. It's not too expensive but since we skipped cmdBegin(), may as well.
     if (logAny(cfgLogLevelDefault()))
     {
@@ -0,0 +1,501 @@
+/***********************************************************************************************************************************
+Consolidate Command
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include "command/backup/common.h"
+#include "command/consolidate/consolidate.h"
+#include "command/consolidate/file.h"
+#include "command/consolidate/protocol.h"
+#include "command/control/common.h"
+#include "command/lock.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/type/convert.h"
+#include "common/type/keyValue.h"
+#include "config/config.h"
+#include "info/infoBackup.h"
+#include "info/manifest/manifest.h"
+#include "protocol/helper.h"
+#include "protocol/parallel.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Job to copy one or more files into a repo file in the consolidated backup
+***********************************************************************************************************************************/
+typedef struct ConsolidateJob
+{
+    const String *repoFile;                                         // Repo file to write
+    uint64_t bundleId;                                              // Bundle id (0 if the file is not bundled)
+    List *fileList;                                                 // Files to copy (ConsolidateFile)
+} ConsolidateJob;
+
+typedef struct ConsolidateJobData
+{
+    unsigned int repoIdx;                                           // Repo to consolidate
+    const CipherSpec *cipherSpec;                                   // Cipher used by the backup files
+    const StringList *referenceList;                                // Reference list before consolidation
+    const List *jobList;                                            // Jobs to process (ConsolidateJob)
+    unsigned int jobIdx;                                            // Next job to process
+} ConsolidateJobData;
+
+/***********************************************************************************************************************************
+Order files in a bundle by offset so the source bundle is read sequentially
+***********************************************************************************************************************************/
+static int
+consolidateFileComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    FUNCTION_TEST_RETURN(
+        INT, LST_COMPARATOR_CMP(((const ConsolidateFile *)item1)->offset, ((const ConsolidateFile *)item2)->offset));
+}
+
+/***********************************************************************************************************************************
+Add a job to the job list
+***********************************************************************************************************************************/
+static ConsolidateJob *
+consolidateJobAdd(List *const jobList, const String *const repoFile, const uint64_t bundleId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, jobList);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+        FUNCTION_TEST_PARAM(UINT64, bundleId);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobList != NULL);
+    ASSERT(repoFile != NULL);
+
+    ConsolidateJob *result;
+
+    MEM_CONTEXT_BEGIN(lstMemContext(jobList))
+    {
+        const ConsolidateJob job =
+        {
+            .repoFile = strDup(repoFile),
+            .bundleId = bundleId,
+            .fileList = lstNewP(sizeof(ConsolidateFile), .comparator = consolidateFileComparator),
+        };
+
+        result = lstAdd(jobList, &job);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_TYPE_P(ConsolidateJob, result);
+}
+
+/***********************************************************************************************************************************
+Callback to fetch consolidate jobs for the parallel executor
+***********************************************************************************************************************************/
+static ProtocolParallelJob *
+consolidateJobCallback(void *const data, const unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT, clientIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    ProtocolParallelJob *result = NULL;
+
+    // Jobs are processed in order since they are independent and there is no advantage to assigning them to particular clients
+    (void)clientIdx;
+
+    ConsolidateJobData *const jobData = data;
+
+    if (jobData->jobIdx < lstSize(jobData->jobList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const ConsolidateJob *const job = lstGet(jobData->jobList, jobData->jobIdx);
+            PackWrite *const param = protocolPackNew();
+
+            pckWriteStrP(param, job->repoFile);
+            pckWriteU32P(param, jobData->repoIdx);
+            pckWriteU64P(param, job->bundleId);
+            cipherSpecPack(param, jobData->cipherSpec);
+            pckWriteStrLstP(param, jobData->referenceList);
+
+            for (unsigned int fileIdx = 0; fileIdx < lstSize(job->fileList); fileIdx++)
+            {
+                const ConsolidateFile *const file = lstGet(job->fileList, fileIdx);
+
+                pckWriteStrP(param, file->manifestFile);
+                pckWriteStrP(param, file->repoFile);
+                pckWriteU64P(param, file->offset);
+                pckWriteU64P(param, file->sizeRepo);
+                pckWriteU64P(param, file->blockIncrMapSize);
+
+                if (file->blockIncrMapSize != 0)
+                {
+                    pckWriteU64P(param, file->blockIncrSize);
+                    pckWriteU64P(param, file->blockIncrChecksumSize);
+                }
+            }
+
+            // Assign job to result
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = protocolParallelJobNew(VARUINT(jobData->jobIdx), PROTOCOL_COMMAND_CONSOLIDATE_FILE, param);
+            }
+            MEM_CONTEXT_PRIOR_END();
+
+            jobData->jobIdx++;
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
+/***********************************************************************************************************************************
+Update the manifest with the result of a consolidate job
+***********************************************************************************************************************************/
+static void
+consolidateJobResult(
+    Manifest *const manifest, const List *const jobList, ProtocolParallelJob *const job, const uint64_t sizeTotal,
+    uint64_t *const sizeProgress, unsigned int *const currentPercentComplete)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(LIST, jobList);
+        FUNCTION_LOG_PARAM(PROTOCOL_PARALLEL_JOB, job);
+        FUNCTION_LOG_PARAM(UINT64, sizeTotal);
+        FUNCTION_LOG_PARAM_P(UINT64, sizeProgress);
+        FUNCTION_LOG_PARAM_P(UINT, currentPercentComplete);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+    ASSERT(jobList != NULL);
+    ASSERT(job != NULL);
+
+    // The job was successful
+    if (protocolParallelJobErrorCode(job) == 0)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const unsigned int processId = protocolParallelJobProcessId(job);
+            const ConsolidateJob *const consolidateJob = lstGet(jobList, varUInt(protocolParallelJobKey(job)));
+            PackRead *const jobResult = protocolParallelJobResult(job);
+            unsigned int percentComplete = 0;
+
+            while (!pckReadNullP(jobResult))
+            {
+                ManifestFile file = manifestFileFind(manifest, pckReadStrP(jobResult));
+                const uint64_t bundleOffset = pckReadU64P(jobResult);
+                const uint64_t sizeRepo = pckReadU64P(jobResult);
+                const uint64_t blockIncrMapSize = pckReadU64P(jobResult);
+                const Buffer *const repoChecksum = pckReadBinP(jobResult);
+
+                // Increment progress by the size that was used to generate the total size
+                *sizeProgress += file.sizeRepo;
+                percentComplete = cvtPctToUInt(*sizeProgress, sizeTotal);
+
+                // Log the file
+                String *const logProgress = strNew();
+
+                if (consolidateJob->bundleId != 0)
+                    strCatFmt(logProgress, "bundle %" PRIu64 "/%" PRIu64 ", ", consolidateJob->bundleId, bundleOffset);
+
+                strCatFmt(logProgress, "%s, %s", strZ(strSizeFormat(sizeRepo)), strZ(strNewPct(*sizeProgress, sizeTotal)));
+
+                LOG_DETAIL_PID_FMT(processId, "consolidate file %s (%s)", strZ(file.name), strZ(logProgress));
+
+                // Update the file to reference the consolidated backup. The repo checksum only changes when the block map was
+                // rewritten.
+                file.reference = NULL;
+                file.bundleId = consolidateJob->bundleId;
+                file.bundleOffset = bundleOffset;
+                file.sizeRepo = sizeRepo;
+                file.blockIncrMapSize = blockIncrMapSize;
+
+                if (repoChecksum != NULL)
+                    file.checksumRepoSha1 = bufPtrConst(repoChecksum);
+
+                manifestFileUpdate(manifest, &file);
+            }
+
+            // Update currentPercentComplete and lock file when the change is significant enough
+            if (percentComplete - *currentPercentComplete > 10)
+            {
+                *currentPercentComplete = percentComplete;
+                cmdLockWriteP(
+                    .percentComplete = VARUINT(*currentPercentComplete), .sizeComplete = VARUINT64(*sizeProgress),
+                    .size = VARUINT64(sizeTotal));
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        // Free the job
+        protocolParallelJobFree(job);
+    }
+    // Else the job errored
+    else
+        THROW_CODE(protocolParallelJobErrorCode(job), strZ(protocolParallelJobErrorMessage(job)));
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+cmdConsolidate(void)
+{
+    FUNCTION_LOG_VOID(logLevelDebug);
+
+    // Test for stop file
+    lockStopTest();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const unsigned int repoIdx = cfgOptionGroupIdxDefault(cfgOptGrpRepo);
+
+        // Load backup.info
+        InfoBackup *const infoBackup = infoBackupLoadFileReconstruct(
+            storageRepo(), INFO_BACKUP_PATH_FILE_STR, cfgCipherSpecMain());
+
+        if (infoBackupDataTotal(infoBackup) == 0)
+            THROW(BackupSetInvalidError, "no backup set to consolidate found");
+
+        // Find the backup set to consolidate, which defaults to the latest backup set
+        const String *const backupLabelLatest = infoBackupData(infoBackup, infoBackupDataTotal(infoBackup) - 1).backupLabel;
+        const String *const backupLabel =
+            cfgOptionSource(cfgOptSet) == cfgSourceDefault ? backupLabelLatest : cfgOptionStr(cfgOptSet);
+
+        if (!infoBackupLabelExists(infoBackup, backupLabel))
+            THROW_FMT(BackupSetInvalidError, "backup set %s is not valid", strZ(backupLabel));
+
+        // Load the manifest
+        Manifest *const manifest = manifestLoadFile(
+            storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)),
+            infoBackupCipherSpec(infoBackup));
+        const ManifestData *const data = manifestData(manifest);
+
+        // Nothing to do if the backup does not reference prior backups
+        if (data->backupLabelPrior == NULL)
+        {
+            LOG_INFO_FMT(
+                "%s: backup set %s does not reference prior backups", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
+                strZ(backupLabel));
+        }
+        else
+        {
+            // A synthetic full backup is consolidated in place. A diff/incr backup is consolidated into a new full backup labeled
+            // with the start time of the backup, which will sort after all existing backups only if the backup is the latest.
+            const bool inPlace = data->backupType == backupTypeFull;
+            const String *backupLabelNew = backupLabel;
+
+            if (!inPlace)
+            {
+                if (!strEq(backupLabel, backupLabelLatest))
+                {
+                    THROW_FMT(
+                        BackupSetInvalidError, "backup set %s must be the most recent backup to consolidate into a full backup",
+                        strZ(backupLabel));
+                }
+
+                backupLabelNew = backupLabelFormat(backupTypeFull, NULL, data->backupTimestampStart);
+
+                // Remove any files left behind by a consolidate that did not complete
+                storagePathRemoveP(
+                    storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(backupLabelNew)), .recurse = true);
+
+                LOG_INFO_FMT(
+                    "%s: consolidate backup set %s into full backup %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
+                    strZ(backupLabel), strZ(backupLabelNew));
+            }
+            else
+            {
+                // Backups that depend on the backup may reference files in the prior backups directly, so consolidating in place
+                // would allow expire to remove prior backups that are still needed
+                if (strLstSize(infoBackupDataDependentList(infoBackup, backupLabel)) > 1)
+                {
+                    THROW_FMT(
+                        BackupSetInvalidError, "backup set %s cannot be consolidated in place while other backups depend on it",
+                        strZ(backupLabel));
+                }
+
+                LOG_INFO_FMT("%s: consolidate backup set %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(backupLabel));
+            }
+
+            // Find the first free bundle id in the consolidated backup
+            uint64_t bundleIdNext = 1;
+
+            if (inPlace)
+            {
+                for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+                {
+                    const ManifestFile file = manifestFile(manifest, fileIdx);
+
+                    if (file.reference == NULL && file.bundleId >= bundleIdNext)
+                        bundleIdNext = file.bundleId + 1;
+                }
+            }
+
+            // Build the job list. Bundled files are copied into a new bundle for each source bundle so files stored together remain
+            // together. Block incremental files are always copied into their own bundle since the checksum of the repo file is
+            // used as the checksum of the file.
+            List *const jobList = lstNewP(sizeof(ConsolidateJob));
+            KeyValue *const bundleJobMap = kvNew();
+            uint64_t sizeTotal = 0;
+
+            for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+            {
+                ManifestFile file = manifestFile(manifest, fileIdx);
+                const String *const fileReference = file.reference != NULL ? file.reference : backupLabel;
+
+                // Files in the dedup store and zero-length bundled files are not stored in the backup so only the reference needs
+                // to be removed
+                if (file.dedup || (file.size == 0 && data->bundle))
+                {
+                    if (file.reference != NULL)
+                    {
+                        file.reference = NULL;
+                        manifestFileUpdate(manifest, &file);
+                    }
+
+                    continue;
+                }
+
+                const String *const repoFile = backupFileRepoPathP(
+                    fileReference, .manifestName = file.name, .bundleId = file.bundleId,
+                    .compressType = data->backupOptionCompressType, .blockIncr = file.blockIncrMapSize != 0);
+
+                // Files already stored in the backup being consolidated in place are kept unless the block map must be rewritten.
+                // The prior copy of a rewritten file is left in place and will be removed when the backup set expires.
+                if (inPlace && file.reference == NULL && file.blockIncrMapSize == 0)
+                    continue;
+
+                // Find or create the job for the file
+                ConsolidateJob *job;
+
+                if (file.blockIncrMapSize != 0)
+                {
+                    job = consolidateJobAdd(jobList, backupFileRepoPathP(backupLabelNew, .bundleId = bundleIdNext), bundleIdNext);
+                    bundleIdNext++;
+                }
+                else if (file.bundleId != 0)
+                {
+                    const Variant *const jobIdx = kvGet(bundleJobMap, VARSTR(repoFile));
+
+                    if (jobIdx == NULL)
+                    {
+                        kvPut(bundleJobMap, VARSTR(repoFile), VARUINT(lstSize(jobList)));
+                        job = consolidateJobAdd(
+                            jobList, backupFileRepoPathP(backupLabelNew, .bundleId = bundleIdNext), bundleIdNext);
+                        bundleIdNext++;
+                    }
+                    else
+                        job = lstGet(jobList, varUInt(jobIdx));
+                }
+                else
+                {
+                    job = consolidateJobAdd(
+                        jobList,
+                        backupFileRepoPathP(
+                            backupLabelNew, .manifestName = file.name, .compressType = data->backupOptionCompressType),
+                        0);
+                }
+
+                // Add the file to the job
+                MEM_CONTEXT_BEGIN(lstMemContext(job->fileList))
+                {
+                    const ConsolidateFile consolidateFile =
+                    {
+                        .manifestFile = strDup(file.name),
+                        .repoFile = strDup(repoFile),
+                        .offset = file.bundleOffset,
+                        .sizeRepo = file.sizeRepo,
+                        .blockIncrMapSize = file.blockIncrMapSize,
+                        .blockIncrSize = file.blockIncrSize,
+                        .blockIncrChecksumSize = file.blockIncrChecksumSize,
+                    };
+
+                    lstAdd(job->fileList, &consolidateFile);
+                }
+                MEM_CONTEXT_END();
+
+                sizeTotal += file.sizeRepo;
+            }
+
+            // Sort files in each job so source bundles are read sequentially
+            for (unsigned int jobIdx = 0; jobIdx < lstSize(jobList); jobIdx++)
+                lstSort(((ConsolidateJob *)lstGet(jobList, jobIdx))->fileList, sortOrderAsc);
+
+            // Process jobs
+            if (!lstEmpty(jobList))
+            {
+                ConsolidateJobData jobData =
+                {
+                    .repoIdx = repoIdx,
+                    .cipherSpec = manifestCipherSpec(manifest),
+                    .referenceList = strLstDup(manifestReferenceList(manifest)),
+                    .jobList = jobList,
+                };
+
+                ProtocolParallel *const parallelExec = protocolParallelNew(
+                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, consolidateJobCallback, &jobData);
+
+                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+
+                // Initialize percent complete and bytes completed/total
+                uint64_t sizeProgress = 0;
+                unsigned int currentPercentComplete = 0;
+
+                cmdLockWriteP(
+                    .percentComplete = VARUINT(currentPercentComplete), .sizeComplete = VARUINT64(sizeProgress),
+                    .size = VARUINT64(sizeTotal));
+
+                MEM_CONTEXT_TEMP_RESET_BEGIN()
+                {
+                    do
+                    {
+                        const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                        {
+                            consolidateJobResult(
+                                manifest, jobList, protocolParallelResult(parallelExec), sizeTotal, &sizeProgress,
+                                &currentPercentComplete);
+                        }
+
+                        // A keep-alive is required here for the remote holding open the backup connection
+                        protocolKeepAlive();
+
+                        // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                        MEM_CONTEXT_TEMP_RESET(1000);
+                    }
+                    while (!protocolParallelDone(parallelExec));
+                }
+                MEM_CONTEXT_TEMP_END();
+            }
+
+            // Save the consolidated manifest, which no longer references prior backups
+            manifestBackupFullSet(manifest, backupLabelNew);
+            backupManifestSaveFinal(manifest, infoBackupCipherSpec(infoBackup));
+
+            // Update backup.info
+            if (inPlace)
+                infoBackupDataDelete(infoBackup, backupLabel);
+            else
+                backupLinkLatest(backupLabelNew, repoIdx);
+
+            infoBackupDataAdd(infoBackup, manifest);
+            infoBackupSaveFile(infoBackup, storageRepoWrite(), INFO_BACKUP_PATH_FILE_STR, cfgCipherSpecMain());
+
+            LOG_INFO_FMT(
+                "%s: consolidated backup set %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(backupLabelNew));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,13 @@
+/***********************************************************************************************************************************
+Consolidate Command
+***********************************************************************************************************************************/
+#ifndef COMMAND_CONSOLIDATE_CONSOLIDATE_H
+#define COMMAND_CONSOLIDATE_CONSOLIDATE_H
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Rewrite a backup so it does not reference prior backups
+FN_EXTERN void cmdConsolidate(void);
+
+#endif
@@ -0,0 +1,255 @@
+/***********************************************************************************************************************************
+Consolidate File
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include "command/backup/blockMap.h"
+#include "command/backup/common.h"
+#include "command/consolidate/file.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/hash.h"
+#include "common/debug.h"
+#include "common/io/bufferWrite.h"
+#include "common/io/filter/size.h"
+#include "common/io/io.h"
+#include "common/log.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Copy a range of a repo file to the write and error if the range could not be read completely
+***********************************************************************************************************************************/
+static void
+consolidateFileCopy(
+    const Storage *const storage, const String *const repoFile, const uint64_t offset, const uint64_t size, IoWrite *const write)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(IO_WRITE, write);
+    FUNCTION_TEST_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(repoFile != NULL);
+    ASSERT(write != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        IoRead *const read = storageReadIo(storageNewReadP(storage, repoFile, .offset = offset, .limit = VARUINT64(size)));
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
+
+        ioReadOpen(read);
+        ioCopyP(read, write);
+        ioReadClose(read);
+
+        const uint64_t sizeRead = pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(read), SIZE_FILTER_TYPE));
+
+        if (sizeRead != size)
+        {
+            THROW_FMT(
+                FileReadError, "expected %" PRIu64 " byte(s) from '%s' at offset %" PRIu64 " but read %" PRIu64, size,
+                strZ(storagePathP(storage, repoFile)), offset, sizeRead);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Copy the super blocks of a block incremental file and write the rewritten block map
+***********************************************************************************************************************************/
+static void
+consolidateFileBlockIncr(
+    const Storage *const storage, const ConsolidateFile *const file, const uint64_t bundleId, const CipherSpec *const cipherSpec,
+    const StringList *const referenceList, IoWrite *const write, ConsolidateFileResult *const fileResult)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM_P(VOID, file);
+        FUNCTION_LOG_PARAM(UINT64, bundleId);
+        FUNCTION_LOG_PARAM(CIPHER_SPEC, cipherSpec);
+        FUNCTION_LOG_PARAM(STRING_LIST, referenceList);
+        FUNCTION_LOG_PARAM(IO_WRITE, write);
+        FUNCTION_LOG_PARAM_P(VOID, fileResult);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(file != NULL);
+    ASSERT(file->blockIncrMapSize != 0);
+    ASSERT(bundleId != 0);
+    ASSERT(referenceList != NULL);
+    ASSERT(write != NULL);
+    ASSERT(fileResult != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read the block map, which is stored at the end of the file
+        IoRead *const mapRead = storageReadIo(
+            storageNewReadP(
+                storage, file->repoFile, .offset = file->offset + file->sizeRepo - file->blockIncrMapSize,
+                .limit = VARUINT64(file->blockIncrMapSize)));
+
+        if (cipherSpecType(cipherSpec) != cipherTypeNone)
+            ioFilterGroupAdd(ioReadFilterGroup(mapRead), cipherBlockNewP(cipherModeDecrypt, cipherSpec, .raw = true));
+
+        ioReadOpen(mapRead);
+
+        BlockMap *const blockMap = blockMapNewRead(mapRead, file->blockIncrSize, file->blockIncrChecksumSize);
+
+        ioReadClose(mapRead);
+
+        // Copy super blocks in map order. Consecutive blocks from the same super block share a single copy of the super block, but
+        // a super block that appears again later in the map is copied again since super block offsets must not decrease in the
+        // map. Super blocks from the same reference that are adjacent in the map are stored contiguously so they are copied with a
+        // single read.
+        String *copyFile = NULL;
+        unsigned int copyReference = UINT_MAX;
+        uint64_t copyOffset = 0;
+        uint64_t copySize = 0;
+        BlockMapItem superBlock = {.reference = UINT_MAX};
+        uint64_t offset = fileResult->bundleOffset;
+        uint64_t offsetNew = 0;
+
+        for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+        {
+            BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+
+            // If the block starts a new super block then add the super block to the copy. The bundle id is the same for all blocks
+            // in a reference so it does not need to be compared.
+            if (blockMapItem->reference != superBlock.reference || blockMapItem->offset != superBlock.offset)
+            {
+                superBlock = *blockMapItem;
+
+                // Copy pending super blocks when this super block is in another reference
+                if (superBlock.reference != copyReference)
+                {
+                    if (copyFile != NULL)
+                    {
+                        consolidateFileCopy(storage, copyFile, copyOffset, copySize, write);
+                        strFree(copyFile);
+                    }
+
+                    copyFile = backupFileRepoPathP(
+                        strLstGet(referenceList, superBlock.reference), .manifestName = file->manifestFile,
+                        .bundleId = superBlock.bundleId, .blockIncr = true);
+                    copyReference = superBlock.reference;
+                    copyOffset = superBlock.offset;
+                    copySize = 0;
+                }
+
+                // The block map format only allows a gap between super blocks in the same reference when another reference comes
+                // between them, but check anyway since copying a run that is not contiguous would silently store the wrong data
+                CHECK_FMT(
+                    FormatError, superBlock.offset == copyOffset + copySize,
+                    "super block at offset %" PRIu64 " in '%s' does not follow the prior super block", superBlock.offset,
+                    strZ(copyFile));
+
+                copySize += superBlock.size;
+                offsetNew = offset;
+                offset += superBlock.size;
+            }
+
+            // Update the block to the new location of the super block
+            blockMapItem->reference = 0;
+            blockMapItem->bundleId = bundleId;
+            blockMapItem->offset = offsetNew;
+        }
+
+        consolidateFileCopy(storage, copyFile, copyOffset, copySize, write);
+
+        // Write the rewritten block map
+        Buffer *const map = bufNew(0);
+        IoWrite *const mapWrite = ioBufferWriteNew(map);
+
+        if (cipherSpecType(cipherSpec) != cipherTypeNone)
+            ioFilterGroupAdd(ioWriteFilterGroup(mapWrite), cipherBlockNewP(cipherModeEncrypt, cipherSpec, .raw = true));
+
+        ioWriteOpen(mapWrite);
+        blockMapWrite(blockMap, mapWrite, file->blockIncrSize, file->blockIncrChecksumSize);
+        ioWriteClose(mapWrite);
+
+        ioWrite(write, map);
+
+        fileResult->blockIncrMapSize = bufUsed(map);
+        fileResult->sizeRepo = offset - fileResult->bundleOffset + fileResult->blockIncrMapSize;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN List *
+consolidateFile(
+    const String *const repoFile, const unsigned int repoIdx, const uint64_t bundleId, const CipherSpec *const cipherSpec,
+    const StringList *const referenceList, const List *const fileList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, repoFile);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(UINT64, bundleId);
+        FUNCTION_LOG_PARAM(CIPHER_SPEC, cipherSpec);
+        FUNCTION_LOG_PARAM(STRING_LIST, referenceList);
+        FUNCTION_LOG_PARAM(LIST, fileList);
+    FUNCTION_LOG_END();
+
+    ASSERT(repoFile != NULL);
+    ASSERT(referenceList != NULL);
+    ASSERT(fileList != NULL && !lstEmpty(fileList));
+
+    List *const result = lstNewP(sizeof(ConsolidateFileResult));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Storage *const storage = storageRepoIdx(repoIdx);
+        const bool blockIncr = ((const ConsolidateFile *)lstGet(fileList, 0))->blockIncrMapSize != 0;
+
+        ASSERT(!blockIncr || lstSize(fileList) == 1);
+
+        // Open the repo file for write and checksum it when a block incremental file is rewritten
+        IoWrite *const write = storageWriteIo(storageNewWriteP(storageRepoIdxWrite(repoIdx), repoFile));
+
+        if (blockIncr)
+            ioFilterGroupAdd(ioWriteFilterGroup(write), cryptoHashNew(hashTypeSha1));
+
+        ioWriteOpen(write);
+
+        // Copy files
+        uint64_t bundleOffset = 0;
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
+        {
+            const ConsolidateFile *const file = lstGet(fileList, fileIdx);
+            ConsolidateFileResult fileResult = {.bundleOffset = bundleOffset};
+
+            if (file->blockIncrMapSize != 0)
+                consolidateFileBlockIncr(storage, file, bundleId, cipherSpec, referenceList, write, &fileResult);
+            else
+            {
+                consolidateFileCopy(storage, file->repoFile, file->offset, file->sizeRepo, write);
+                fileResult.sizeRepo = file->sizeRepo;
+            }
+
+            bundleOffset += fileResult.sizeRepo;
+            lstAdd(result, &fileResult);
+        }
+
+        ioWriteClose(write);
+
+        // Return the checksum of the rewritten block incremental file
+        if (blockIncr)
+        {
+            MEM_CONTEXT_BEGIN(lstMemContext(result))
+            {
+                ((ConsolidateFileResult *)lstGet(result, 0))->repoChecksum = pckReadBinP(
+                    ioFilterGroupResultP(ioWriteFilterGroup(write), CRYPTO_HASH_FILTER_TYPE));
+            }
+            MEM_CONTEXT_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
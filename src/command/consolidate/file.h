@@ -0,0 +1,49 @@
+/***********************************************************************************************************************************
+Consolidate File
+
+Copy files from the backups referenced by a backup into the backup being consolidated. Files that are not block incremental are
+copied byte for byte since their size and checksums do not change. The super blocks of block incremental files are also copied byte
+for byte since each super block is compressed and encrypted independently, but the block map must be rewritten to reference the new
+location of each super block.
+***********************************************************************************************************************************/
+#ifndef COMMAND_CONSOLIDATE_FILE_H
+#define COMMAND_CONSOLIDATE_FILE_H
+
+#include "common/crypto/spec.h"
+#include "common/type/list.h"
+#include "common/type/stringList.h"
+
+/***********************************************************************************************************************************
+File to consolidate
+***********************************************************************************************************************************/
+typedef struct ConsolidateFile
+{
+    const String *manifestFile;                                     // Manifest file name
+    const String *repoFile;                                         // Repo file (bundle or standalone) where the file is stored
+    uint64_t offset;                                                // Offset of the file in the repo file
+    uint64_t sizeRepo;                                              // Size of the file in the repo
+    uint64_t blockIncrMapSize;                                      // Block incremental map size (0 if not block incremental)
+    size_t blockIncrSize;                                           // Block incremental size (when map size > 0)
+    size_t blockIncrChecksumSize;                                   // Block incremental checksum size (when map size > 0)
+} ConsolidateFile;
+
+typedef struct ConsolidateFileResult
+{
+    uint64_t bundleOffset;                                          // Offset of the file in the new repo file
+    uint64_t sizeRepo;                                              // Size of the file in the repo
+    uint64_t blockIncrMapSize;                                      // Size of the rewritten block map (0 if not block incremental)
+    const Buffer *repoChecksum;                                     // Checksum of the rewritten file (NULL if copied unchanged)
+} ConsolidateFileResult;
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Copy files into a new repo file and return a ConsolidateFileResult for each file in the same order as the files. Super blocks are
+// read from the backups in the reference list and the rewritten block map references the bundle in the consolidated backup, which
+// is always the first and only backup in its reference list. A block incremental file must be the only file copied into the repo
+// file since the checksum of the repo file is used as the checksum of the rewritten file.
+FN_EXTERN List *consolidateFile(
+    const String *repoFile, unsigned int repoIdx, uint64_t bundleId, const CipherSpec *cipherSpec, const StringList *referenceList,
+    const List *fileList);
+
+#endif
@@ -0,0 +1,74 @@
+/***********************************************************************************************************************************
+Consolidate Protocol Handler
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include "command/consolidate/file.h"
+#include "command/consolidate/protocol.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+
+/**********************************************************************************************************************************/
+FN_EXTERN ProtocolServerResult *
+consolidateFileProtocol(PackRead *const param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+    FUNCTION_LOG_END();
+
+    ASSERT(param != NULL);
+
+    ProtocolServerResult *const result = protocolServerResultNewP();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Consolidate options that apply to all files
+        const String *const repoFile = pckReadStrP(param);
+        const unsigned int repoIdx = pckReadU32P(param);
+        const uint64_t bundleId = pckReadU64P(param);
+        const CipherSpec *const cipherSpec = cipherSpecNewPack(param);
+        const StringList *const referenceList = pckReadStrLstP(param);
+
+        // Build the file list
+        List *const fileList = lstNewP(sizeof(ConsolidateFile));
+
+        while (!pckReadNullP(param))
+        {
+            ConsolidateFile file = {.manifestFile = pckReadStrP(param)};
+            file.repoFile = pckReadStrP(param);
+            file.offset = pckReadU64P(param);
+            file.sizeRepo = pckReadU64P(param);
+            file.blockIncrMapSize = pckReadU64P(param);
+
+            if (file.blockIncrMapSize != 0)
+            {
+                file.blockIncrSize = (size_t)pckReadU64P(param);
+                file.blockIncrChecksumSize = (size_t)pckReadU64P(param);
+            }
+
+            lstAdd(fileList, &file);
+        }
+
+        // Consolidate files
+        const List *const resultList = consolidateFile(repoFile, repoIdx, bundleId, cipherSpec, referenceList, fileList);
+
+        // Return result
+        PackWrite *const data = protocolServerResultData(result);
+
+        for (unsigned int resultIdx = 0; resultIdx < lstSize(resultList); resultIdx++)
+        {
+            const ConsolidateFile *const file = lstGet(fileList, resultIdx);
+            const ConsolidateFileResult *const fileResult = lstGet(resultList, resultIdx);
+
+            pckWriteStrP(data, file->manifestFile);
+            pckWriteU64P(data, fileResult->bundleOffset);
+            pckWriteU64P(data, fileResult->sizeRepo);
+            pckWriteU64P(data, fileResult->blockIncrMapSize);
+            pckWriteBinP(data, fileResult->repoChecksum);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, result);
+}
@@ -0,0 +1,24 @@
+/***********************************************************************************************************************************
+Consolidate Protocol Handler
+***********************************************************************************************************************************/
+#ifndef COMMAND_CONSOLIDATE_PROTOCOL_H
+#define COMMAND_CONSOLIDATE_PROTOCOL_H
+
+#include "common/type/pack.h"
+#include "protocol/server.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Process protocol requests
+FN_EXTERN ProtocolServerResult *consolidateFileProtocol(PackRead *param);
+
+/***********************************************************************************************************************************
+Protocol commands for ProtocolServerHandler arrays passed to protocolServerProcess()
+***********************************************************************************************************************************/
+#define PROTOCOL_COMMAND_CONSOLIDATE_FILE                           STRID5("cs-f", 0x36e630)
+
+#define PROTOCOL_SERVER_HANDLER_CONSOLIDATE_LIST                                                                                   \
+    {.command = PROTOCOL_COMMAND_CONSOLIDATE_FILE, .process = consolidateFileProtocol},
+
+#endif
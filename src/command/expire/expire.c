@@ -7,6 +7,8 @@ Expire Command
 #include "command/backup/common.h"
 #include "command/control/common.h"
 #include "command/expire/expire.h"
+#include "command/expire/file.h"
+#include "command/expire/protocol.h"
 #include "common/debug.h"
 #include "common/regExp.h"
 #include "common/time.h"
@@ -15,6 +17,7 @@ Expire Command
 #include "info/infoArchive.h"
 #include "info/infoBackup.h"
 #include "protocol/helper.h"
+#include "protocol/parallel.h"
 #include "storage/helper.h"
 
 #include <stdlib.h>
@@ -35,6 +38,154 @@ typedef struct ArchiveRange
     const String *stop;
 } ArchiveRange;
 
+/***********************************************************************************************************************************
+Paths and files to remove. Removals are planned first and then executed together so they can be split into jobs for local processes
+and files can be removed in batches.
+***********************************************************************************************************************************/
+// Maximum files to remove in a single job
+#define EXPIRE_FILE_JOB_MAX                                         1000
+
+typedef struct ExpireRemove
+{
+    StringList *pathList;                                           // Paths to remove recursively
+    StringList *fileList;                                           // Files to remove
+} ExpireRemove;
+
+typedef struct ExpireJobData
+{
+    unsigned int repoIdx;                                           // Repo to remove from
+    const ExpireRemove *removeList;                                 // Paths and files to remove
+    unsigned int pathIdx;                                           // Next path to remove
+    unsigned int fileIdx;                                           // Next file to remove
+    unsigned int jobIdx;                                            // Next job index
+} ExpireJobData;
+
+/***********************************************************************************************************************************
+Callback to fetch expire jobs for the parallel executor
+***********************************************************************************************************************************/
+static ProtocolParallelJob *
+expireJobCallback(void *const data, const unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT, clientIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    ProtocolParallelJob *result = NULL;
+
+    // Jobs are processed in order since they are independent and there is no advantage to assigning them to particular clients
+    (void)clientIdx;
+
+    ExpireJobData *const jobData = data;
+
+    if (jobData->pathIdx < strLstSize(jobData->removeList->pathList) ||
+        jobData->fileIdx < strLstSize(jobData->removeList->fileList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            StringList *const pathList = strLstNew();
+            StringList *const fileList = strLstNew();
+
+            // Remove one path per job since a path may contain many files
+            if (jobData->pathIdx < strLstSize(jobData->removeList->pathList))
+            {
+                strLstAdd(pathList, strLstGet(jobData->removeList->pathList, jobData->pathIdx));
+                jobData->pathIdx++;
+            }
+            // Else remove a batch of files
+            else
+            {
+                do
+                {
+                    strLstAdd(fileList, strLstGet(jobData->removeList->fileList, jobData->fileIdx));
+                    jobData->fileIdx++;
+                }
+                while (jobData->fileIdx < strLstSize(jobData->removeList->fileList) && strLstSize(fileList) < EXPIRE_FILE_JOB_MAX);
+            }
+
+            PackWrite *const param = protocolPackNew();
+
+            pckWriteU32P(param, jobData->repoIdx);
+            pckWriteStrLstP(param, pathList);
+            pckWriteStrLstP(param, fileList);
+
+            // Assign job to result
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = protocolParallelJobNew(VARUINT(jobData->jobIdx), PROTOCOL_COMMAND_EXPIRE_FILE, param);
+            }
+            MEM_CONTEXT_PRIOR_END();
+
+            jobData->jobIdx++;
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
+/***********************************************************************************************************************************
+Remove the planned paths and files. The removal is done by local processes when process-max > 1, otherwise by this process.
+***********************************************************************************************************************************/
+static void
+expireRemove(const ExpireRemove *const removeList, const unsigned int repoIdx)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, removeList);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+    FUNCTION_LOG_END();
+
+    ASSERT(removeList != NULL);
+
+    // Execute the real expiration and deletion only if the dry-run mode is disabled and there is something to remove
+    if ((!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun)) &&
+        (!strLstEmpty(removeList->pathList) || !strLstEmpty(removeList->fileList)))
+    {
+        // Remove in this process
+        if (cfgOptionUInt(cfgOptProcessMax) == 1)
+            expireFile(repoIdx, removeList->pathList, removeList->fileList);
+        // Else remove in local processes
+        else
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                ExpireJobData jobData = {.repoIdx = repoIdx, .removeList = removeList};
+
+                ProtocolParallel *const parallelExec = protocolParallelNew(
+                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, expireJobCallback, &jobData);
+
+                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+
+                do
+                {
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+
+                        // Error if the job failed
+                        if (protocolParallelJobErrorCode(job) != 0)
+                            THROW_CODE(protocolParallelJobErrorCode(job), strZ(protocolParallelJobErrorMessage(job)));
+
+                        protocolParallelJobFree(job);
+                    }
+
+                    // A keep-alive is required here for the remote holding open the backup connection
+                    protocolKeepAlive();
+                }
+                while (!protocolParallelDone(parallelExec));
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Given a backup label, expire a backup and all its dependents (if any).
 ***********************************************************************************************************************************/
@@ -89,6 +240,47 @@ expireBackup(InfoBackup *const infoBackup, const String *const backupLabel, cons
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
 
+/***********************************************************************************************************************************
+Find a dependent full backup that prevents a backup from being expired. A synthetic full backup references the backups it was built
+from, so expiring any of them would also expire the synthetic full. Dependent full backups with labels at or after retainLabel are
+retained (all dependent full backups are retained when retainLabel is NULL).
+***********************************************************************************************************************************/
+static const String *
+expireBackupHeld(const InfoBackup *const infoBackup, const String *const backupLabel, const String *const retainLabel)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_LOG_PARAM(STRING, backupLabel);
+        FUNCTION_LOG_PARAM(STRING, retainLabel);
+    FUNCTION_LOG_END();
+
+    ASSERT(infoBackup != NULL);
+    ASSERT(backupLabel != NULL);
+
+    const String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const StringList *const backupList = infoBackupDataDependentList(infoBackup, backupLabel);
+
+        // Skip the first label since it is the backup itself
+        for (unsigned int backupIdx = 1; backupIdx < strLstSize(backupList); backupIdx++)
+        {
+            const InfoBackupData *const backupData = infoBackupDataByLabel(infoBackup, strLstGet(backupList, backupIdx));
+
+            if (backupData->backupType == backupTypeFull &&
+                (retainLabel == NULL || strCmp(backupData->backupLabel, retainLabel) >= 0))
+            {
+                result = backupData->backupLabel;
+                break;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_CONST(STRING, result);
+}
+
 /***********************************************************************************************************************************
 Function to expire a selected backup (and all its dependents) regardless of retention rules.
 ***********************************************************************************************************************************/
@@ -205,6 +397,18 @@ expireDiffBackup(InfoBackup *const infoBackup, const unsigned int repoIdx)
                     if (regExpMatchOne(backupRegExpP(.full = true), strLstGet(currentBackupList, diffIdx)))
                         continue;
 
+                    // Skip if a synthetic full backup depends on the differential
+                    const String *const backupHeld = expireBackupHeld(infoBackup, strLstGet(currentBackupList, diffIdx), NULL);
+
+                    if (backupHeld != NULL)
+                    {
+                        LOG_INFO_FMT(
+                            "%s: diff backup %s is referenced by synthetic full backup %s and will not be expired",
+                            cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(strLstGet(currentBackupList, diffIdx)),
+                            strZ(backupHeld));
+                        continue;
+                    }
+
                     // Expire the differential and any dependent backups
                     const StringList *const backupExpired = expireBackup(
                         infoBackup, strLstGet(currentBackupList, diffIdx), repoIdx);
@@ -256,6 +460,20 @@ expireFullBackup(InfoBackup *const infoBackup, const unsigned int repoIdx)
                 // Expire all backups that depend on the full backup
                 for (unsigned int fullIdx = 0; fullIdx < strLstSize(currentBackupList) - fullRetention; fullIdx++)
                 {
+                    // Skip if a synthetic full backup that is being retained depends on the full backup
+                    const String *const backupHeld = expireBackupHeld(
+                        infoBackup, strLstGet(currentBackupList, fullIdx),
+                        strLstGet(currentBackupList, strLstSize(currentBackupList) - fullRetention));
+
+                    if (backupHeld != NULL)
+                    {
+                        LOG_INFO_FMT(
+                            "%s: full backup %s is referenced by synthetic full backup %s and will not be expired",
+                            cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(strLstGet(currentBackupList, fullIdx)),
+                            strZ(backupHeld));
+                        continue;
+                    }
+
                     // Expire the full backup and all its dependents
                     const StringList *const backupExpired = expireBackup(
                         infoBackup, strLstGet(currentBackupList, fullIdx), repoIdx);
@@ -331,6 +549,19 @@ expireTimeBasedBackup(InfoBackup *const infoBackup, const time_t minTimestamp, c
                 // is always the oldest so if it is not the backup to retain then we can remove it
                 while (!strEq(infoBackupData(infoBackup, 0).backupLabel, retentionMetBackupLabel))
                 {
+                    // Stop if a synthetic full backup that is being retained depends on the oldest backup
+                    const String *const backupHeld = expireBackupHeld(
+                        infoBackup, infoBackupData(infoBackup, 0).backupLabel, retentionMetBackupLabel);
+
+                    if (backupHeld != NULL)
+                    {
+                        LOG_INFO_FMT(
+                            "%s: full backup %s is referenced by synthetic full backup %s and will not be expired",
+                            cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(infoBackupData(infoBackup, 0).backupLabel),
+                            strZ(backupHeld));
+                        break;
+                    }
+
                     const StringList *const backupExpired = expireBackup(
                         infoBackup, infoBackupData(infoBackup, 0).backupLabel, repoIdx);
 
@@ -382,17 +613,19 @@ Expire WAL for a single archive id, removing everything not covered by the suppl
 static void
 expireArchiveId(
     const String *const archiveId, const List *const archiveRangeList, const String *const archiveExpireMax,
-    const unsigned int repoIdx)
+    ExpireRemove *const removeList, const unsigned int repoIdx)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, archiveId);
         FUNCTION_LOG_PARAM(LIST, archiveRangeList);
         FUNCTION_LOG_PARAM(STRING, archiveExpireMax);
+        FUNCTION_LOG_PARAM_P(VOID, removeList);
         FUNCTION_LOG_PARAM(UINT, repoIdx);
     FUNCTION_LOG_END();
 
     ASSERT(archiveId != NULL);
     ASSERT(archiveRangeList != NULL);
+    ASSERT(removeList != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -427,13 +660,7 @@ expireArchiveId(
             // Remove the entire directory if all archive is expired
             if (removeArchive)
             {
-                // Execute the real expiration and deletion only if the dry-run mode is disabled
-                if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                {
-                    storagePathRemoveP(
-                        storageRepoIdxWrite(repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath)),
-                        .recurse = true);
-                }
+                strLstAddFmt(removeList->pathList, STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath));
 
                 LOG_DETAIL_FMT(
                     "%s: %s remove archive path %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(archiveId), strZ(walPath));
@@ -479,13 +706,9 @@ expireArchiveId(
                     // Remove archive log if it is not used in a backup
                     if (removeArchive)
                     {
-                        // Execute the real expiration and deletion only if the dry-run mode is disabled
-                        if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                        {
-                            storageRemoveP(
-                                storageRepoIdxWrite(repoIdx),
-                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveId), strZ(walPath), strZ(walSubPath)));
-                        }
+                        strLstAddFmt(
+                            removeList->fileList, STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveId), strZ(walPath),
+                            strZ(walSubPath));
 
                         // Track that this archive was removed
                         archiveExpire.total++;
@@ -528,6 +751,8 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
+        ExpireRemove removeList = {.pathList = strLstNew(), .fileList = strLstNew()};
+
         // Get the retention options. repo-archive-retention-type always has a value as it defaults to "full"
         const BackupType archiveRetentionType = (BackupType)cfgOptionIdxStrId(cfgOptRepoRetentionArchiveType, repoIdx);
         const unsigned int archiveRetention = cfgOptionIdxTest(
@@ -674,7 +899,7 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 ArchiveRange archiveRange = {.start = strDup(walExpireBefore), .stop = NULL};
                                 lstAdd(archiveRangeList, &archiveRange);
 
-                                expireArchiveId(archiveId, archiveRangeList, NULL, repoIdx);
+                                expireArchiveId(archiveId, archiveRangeList, NULL, &removeList, repoIdx);
                             }
                             // Otherwise, if this is not the current database, delete the whole archive directory. The current DB
                             // archive directory is the live destination for archive-push and must not be deleted.
@@ -686,9 +911,7 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 LOG_INFO_FMT(
                                     "%s: remove archive path %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(fullPath));
 
-                                // Execute the real expiration and deletion only if the dry-run option is disabled
-                                if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                                    storagePathRemoveP(storageRepoIdxWrite(repoIdx), fullPath, .recurse = true);
+                                strLstAdd(removeList.pathList, fullPath);
                             }
 
                             // Continue to next directory
@@ -801,7 +1024,7 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                             }
 
                             // Expire WAL for this archive id according to the retention ranges computed above
-                            expireArchiveId(archiveId, archiveRangeList, archiveExpireMax, repoIdx);
+                            expireArchiveId(archiveId, archiveRangeList, archiveExpireMax, &removeList, repoIdx);
 
                             // Look for history files to expire based on the timeline of backupArchiveStart
                             const String *const backupArchiveStartTimeline = strSubN(
@@ -821,13 +1044,8 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                 // Expire history files older than the oldest retained timeline
                                 if (strCmp(strSubN(historyFile, 0, 8), backupArchiveStartTimeline) < 0)
                                 {
-                                    // Execute the real expiration and deletion only if the dry-run mode is disabled
-                                    if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                                    {
-                                        storageRemoveP(
-                                            storageRepoIdxWrite(repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(historyFile)));
-                                    }
+                                    strLstAddFmt(
+                                        removeList.fileList, STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(historyFile));
 
                                     LOG_INFO_FMT(
                                         "%s: %s remove history file %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
@@ -839,6 +1057,9 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                 }
             }
         }
+
+        // Remove expired archive
+        expireRemove(&removeList, repoIdx);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -861,6 +1082,8 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
+        ExpireRemove removeList = {.pathList = strLstNew(), .fileList = strLstNew()};
+
         // Get all the current backups in backup.info - these will not be expired
         const StringList *const currentBackupList = strLstSort(infoBackupDataLabelList(infoBackup, NULL), sortOrderDesc);
 
@@ -914,15 +1137,12 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
                     "%s: remove expired backup %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
                     strZ(strLstGet(backupList, backupIdx)));
 
-                // Execute the real expiration and deletion only if the dry-run mode is disabled
-                if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                {
-                    storagePathRemoveP(
-                        storageRepoIdxWrite(repoIdx), strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(strLstGet(backupList, backupIdx))),
-                        .recurse = true);
-                }
+                strLstAddFmt(removeList.pathList, STORAGE_REPO_BACKUP "/%s", strZ(strLstGet(backupList, backupIdx)));
             }
         }
+
+        // Remove expired backups
+        expireRemove(&removeList, repoIdx);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -944,6 +1164,8 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
+        ExpireRemove removeList = {.pathList = strLstNew(), .fileList = strLstNew()};
+
         if (cfgOptionIdxTest(cfgOptRepoRetentionHistory, repoIdx))
         {
             // Get current backups in backup.info - these will not be expired
@@ -971,13 +1193,7 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
                     LOG_INFO_FMT(
                         "%s: remove expired backup history path %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(historyYear));
 
-                    // Execute the real expiration and deletion only if the dry-run mode is disabled
-                    if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                    {
-                        storagePathRemoveP(
-                            storageRepoIdxWrite(repoIdx),
-                            strNewFmt(STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s", strZ(historyYear)), .recurse = true);
-                    }
+                    strLstAddFmt(removeList.pathList, STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s", strZ(historyYear));
                 }
                 // Else find and remove individual files
                 else if (strEq(historyYear, strSubN(minBackupLabel, 0, 4)))
@@ -1003,15 +1219,9 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
                                 "%s: remove expired backup history manifest %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
                                 strZ(historyBackupFile));
 
-                            // Execute the real expiration and deletion only if the dry-run mode is disabled
-                            if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                            {
-                                storageRemoveP(
-                                    storageRepoIdxWrite(repoIdx),
-                                    strNewFmt(
-                                        STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s/%s",
-                                        strZ(historyYear), strZ(historyBackupFile)));
-                            }
+                            strLstAddFmt(
+                                removeList.fileList, STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s/%s", strZ(historyYear),
+                                strZ(historyBackupFile));
                         }
                     }
                 }
@@ -1019,6 +1229,285 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
                     break;
             }
         }
+
+        // Remove expired history
+        expireRemove(&removeList, repoIdx);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Remove files from the dedup store that are no longer referenced by any backup in any stanza
+
+The store is shared by all stanzas in the repo so the manifests of all current backups in all stanzas are read to find the files
+that are still referenced. A backup in progress may reference files in the store that are not yet recorded in its manifest so
+nothing is removed while any stanza has a backup on disk that is not in backup.info.
+
+A backup in another stanza may also start while the manifests are being read and reference a file that appears to be unreferenced.
+To guard against this, expire creates a file for its stanza in BACKUP_DEDUP_EXPIRE_PATH and then lists the backups on disk again.
+Nothing is removed if any backup has started since the manifests were read. A backup that starts after the second listing will find
+the expire file and keep its files in the backup rather than use the store, so it cannot reference a file that is being removed. The
+expire file is removed when the sweep is done. In addition, unreferenced files are only removed when they were also unreferenced in
+the prior expire, so a file must remain unreferenced for a full expire cycle before it is removed. The files that are unreferenced
+are stored in the candidate file for the next expire.
+***********************************************************************************************************************************/
+#define EXPIRE_DEDUP_CANDIDATE_FILE                                 STORAGE_PATH_DEDUP "/expire.candidate"
+
+// Get a list of all backups on disk in all stanzas
+static StringList *
+expireDedupBackupList(const Storage *const storageRepo)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storageRepo);
+    FUNCTION_LOG_END();
+
+    ASSERT(storageRepo != NULL);
+
+    StringList *const result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const StringList *const stanzaList = strLstSort(storageListP(storageRepo, STORAGE_PATH_BACKUP_STR), sortOrderAsc);
+
+        for (unsigned int stanzaIdx = 0; stanzaIdx < strLstSize(stanzaList); stanzaIdx++)
+        {
+            const String *const stanza = strLstGet(stanzaList, stanzaIdx);
+            const StringList *const backupList = strLstSort(
+                storageListP(
+                    storageRepo, strNewFmt(STORAGE_PATH_BACKUP "/%s", strZ(stanza)),
+                    .expression = backupRegExpP(.full = true, .differential = true, .incremental = true)),
+                sortOrderAsc);
+
+            for (unsigned int backupIdx = 0; backupIdx < strLstSize(backupList); backupIdx++)
+                strLstAddFmt(result, "%s/%s", strZ(stanza), strZ(strLstGet(backupList, backupIdx)));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
+// Add the store files referenced by the backups in the list to the reference list. The backup that is in progress, if any, is
+// returned and no more backups are read.
+static String *
+expireDedupReference(
+    const Storage *const storageRepo, const unsigned int repoIdx, const StringList *const backupList,
+    StringList *const referenceList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storageRepo);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(STRING_LIST, backupList);
+        FUNCTION_LOG_PARAM(STRING_LIST, referenceList);
+    FUNCTION_LOG_END();
+
+    ASSERT(storageRepo != NULL);
+    ASSERT(backupList != NULL);
+    ASSERT(referenceList != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *stanzaLast = NULL;
+        const InfoBackup *infoBackup = NULL;
+
+        for (unsigned int backupIdx = 0; backupIdx < strLstSize(backupList); backupIdx++)
+        {
+            const String *const stanzaBackup = strLstGet(backupList, backupIdx);
+            const String *const stanza = strPath(stanzaBackup);
+            const String *const backupLabel = strBase(stanzaBackup);
+
+            // Load backup.info when the stanza changes. A stanza without backup.info has no current backups.
+            if (!strEq(stanza, stanzaLast))
+            {
+                const String *const infoFile = strNewFmt(STORAGE_PATH_BACKUP "/%s/" INFO_BACKUP_FILE, strZ(stanza));
+
+                infoBackup =
+                    storageExistsP(storageRepo, infoFile) ||
+                        storageExistsP(storageRepo, strNewFmt("%s" INFO_COPY_EXT, strZ(infoFile))) ?
+                        infoBackupLoadFile(storageRepo, infoFile, cfgCipherSpecMainIdx(repoIdx)) : NULL;
+                stanzaLast = stanza;
+            }
+
+            // Stop when a backup on disk is not current since it may be in progress
+            if (infoBackup == NULL || !infoBackupLabelExists(infoBackup, backupLabel))
+            {
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = strDup(stanzaBackup);
+                }
+                MEM_CONTEXT_PRIOR_END();
+
+                break;
+            }
+
+            const Manifest *const manifest = manifestLoadFile(
+                storageRepo, strNewFmt(STORAGE_PATH_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(stanzaBackup)),
+                infoBackupCipherSpec(infoBackup));
+
+            for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+            {
+                const ManifestFile file = manifestFile(manifest, fileIdx);
+
+                if (file.dedup)
+                {
+                    strLstAdd(
+                        referenceList,
+                        backupFileRepoPathP(
+                            NULL, .compressType = manifestData(manifest)->backupOptionCompressType,
+                            .dedupChecksum = file.checksumSha1));
+                }
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING, result);
+}
+
+// Remove files that are not referenced and were also not referenced in the prior expire, including any left behind by failed
+// writes. Nothing is removed if the backups on disk no longer match the list of backups that were read for references.
+static void
+expireDedupSweep(
+    const unsigned int repoIdx, const bool dryRun, const StringList *const backupList, const StringList *const referenceList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(BOOL, dryRun);
+        FUNCTION_LOG_PARAM(STRING_LIST, backupList);
+        FUNCTION_LOG_PARAM(STRING_LIST, referenceList);
+    FUNCTION_LOG_END();
+
+    ASSERT(backupList != NULL);
+    ASSERT(referenceList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ExpireRemove removeList = {.pathList = strLstNew(), .fileList = strLstNew()};
+        const Storage *const storageRepo = storageRepoIdx(repoIdx);
+        const String *const expireFile = strNewFmt(BACKUP_DEDUP_EXPIRE_PATH "/%s", strZ(cfgOptionStr(cfgOptStanza)));
+
+        // Stop backups that start from now on from using the store
+        if (!dryRun)
+            storagePutP(storageNewWriteP(storageRepoIdxWrite(repoIdx), expireFile), NULL);
+
+        TRY_BEGIN()
+        {
+            // Check again for backups that started while the references were being read since they may reference files that
+            // appear to be unreferenced
+            if (!strEq(strLstJoin(expireDedupBackupList(storageRepo), "\n"), strLstJoin(backupList, "\n")))
+            {
+                LOG_INFO_FMT(
+                    "%s: skip dedup store expiration since a backup started while references were being read",
+                    cfgOptionGroupName(cfgOptGrpRepo, repoIdx));
+            }
+            else
+            {
+                // Load the files that were unreferenced in the prior expire
+                const Buffer *const candidateBuffer = storageGetP(
+                    storageNewReadP(storageRepo, STRDEF(EXPIRE_DEDUP_CANDIDATE_FILE), .ignoreMissing = true));
+                const StringList *const candidatePriorList = strLstSort(
+                    candidateBuffer == NULL ? strLstNew() : strLstNewSplitZ(strNewBuf(candidateBuffer), "\n"),
+                    sortOrderAsc);
+                StringList *const candidateList = strLstNew();
+
+                StorageIterator *const storageItr = storageNewItrP(
+                    storageRepo, STORAGE_PATH_DEDUP_STR, .recurse = true, .sortOrder = sortOrderAsc);
+
+                while (storageItrMore(storageItr))
+                {
+                    const StorageInfo info = storageItrNext(storageItr);
+
+                    if (info.type == storageTypeFile)
+                    {
+                        const String *const file = strNewFmt(STORAGE_PATH_DEDUP "/%s", strZ(info.name));
+
+                        // Skip the candidate and expire files since they are not in the store
+                        if (!strEqZ(file, EXPIRE_DEDUP_CANDIDATE_FILE) && !strBeginsWithZ(file, BACKUP_DEDUP_EXPIRE_PATH "/") &&
+                            !strLstExists(referenceList, file))
+                        {
+                            // Remove the file if it was also unreferenced in the prior expire
+                            if (strLstExists(candidatePriorList, file))
+                            {
+                                LOG_DETAIL_FMT(
+                                    "%s: remove unreferenced dedup file %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx),
+                                    strZ(file));
+
+                                strLstAdd(removeList.fileList, file);
+                            }
+                            // Else remove the file in the next expire if it is still unreferenced
+                            else
+                            {
+                                LOG_DETAIL_FMT(
+                                    "%s: dedup file %s is unreferenced and will be removed by the next expire",
+                                    cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(file));
+
+                                strLstAdd(candidateList, file);
+                            }
+                        }
+                    }
+                }
+
+                // Remove unreferenced dedup files
+                expireRemove(&removeList, repoIdx);
+
+                // Save the unreferenced files for the next expire
+                if (!dryRun)
+                {
+                    if (strLstEmpty(candidateList))
+                        storageRemoveP(storageRepoIdxWrite(repoIdx), STRDEF(EXPIRE_DEDUP_CANDIDATE_FILE));
+                    else
+                    {
+                        storagePutP(
+                            storageNewWriteP(storageRepoIdxWrite(repoIdx), STRDEF(EXPIRE_DEDUP_CANDIDATE_FILE)),
+                            BUFSTR(strLstJoin(candidateList, "\n")));
+                    }
+                }
+            }
+        }
+        FINALLY()
+        {
+            if (!dryRun)
+                storageRemoveP(storageRepoIdxWrite(repoIdx), expireFile);
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+static void
+removeExpiredDedup(const unsigned int repoIdx, const bool dryRun)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(BOOL, dryRun);
+    FUNCTION_LOG_END();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Storage *const storageRepo = storageRepoIdx(repoIdx);
+
+        if (storagePathExistsP(storageRepo, STORAGE_PATH_DEDUP_STR))
+        {
+            // Get files referenced by the current backups of all stanzas
+            const StringList *const backupList = expireDedupBackupList(storageRepo);
+            StringList *const referenceList = strLstNew();
+            const String *const backupInProgress = expireDedupReference(storageRepo, repoIdx, backupList, referenceList);
+
+            if (backupInProgress != NULL)
+            {
+                LOG_INFO_FMT(
+                    "%s: skip dedup store expiration while backup %s is in progress or resumable",
+                    cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(backupInProgress));
+            }
+            else
+                expireDedupSweep(repoIdx, dryRun, backupList, strLstSort(referenceList, sortOrderAsc));
+        }
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -1054,6 +1543,9 @@ cmdExpire(void)
         // Check if this run should expire the --oldest backup set
         const bool expireOldest = cfgOptionValid(cfgOptOldest) ? cfgOptionBool(cfgOptOldest) : false;
 
+        // Check if this is a dry-run. The option is not valid when expire is called by backup.
+        const bool dryRun = cfgOptionValid(cfgOptDryRun) && cfgOptionBool(cfgOptDryRun);
+
         // If the --set option is valid (i.e. expire is called on its own) then check the label format
         if (cfgOptionTest(cfgOptSet))
         {
@@ -1173,7 +1665,7 @@ cmdExpire(void)
                 }
 
                 // Store the new backup info only if the dry-run mode is disabled
-                if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
+                if (!dryRun)
                 {
                     infoBackupSaveFile(
                         infoBackup, storageRepoIdxWrite(repoIdx), INFO_BACKUP_PATH_FILE_STR, cfgCipherSpecMainIdx(repoIdx));
@@ -1183,6 +1675,7 @@ cmdExpire(void)
                 removeExpiredBackup(infoBackup, adhocBackupLabel, repoIdx);
                 removeExpiredArchive(infoBackup, timeBasedFullRetention, repoIdx);
                 removeExpiredHistory(infoBackup, repoIdx);
+                removeExpiredDedup(repoIdx, dryRun);
             }
             CATCH_ANY()
             {
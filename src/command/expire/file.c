@@ -0,0 +1,35 @@
+/***********************************************************************************************************************************
+Expire File
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include "command/expire/file.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "storage/helper.h"
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+expireFile(const unsigned int repoIdx, const StringList *const pathList, const StringList *const fileList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(STRING_LIST, pathList);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+    FUNCTION_LOG_END();
+
+    ASSERT(pathList != NULL);
+    ASSERT(fileList != NULL);
+
+    const Storage *const storageRepo = storageRepoIdxWrite(repoIdx);
+
+    // Remove paths
+    for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+        storagePathRemoveP(storageRepo, strLstGet(pathList, pathIdx), .recurse = true);
+
+    // Remove files
+    if (!strLstEmpty(fileList))
+        storageRemoveListP(storageRepo, fileList);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
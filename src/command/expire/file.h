@@ -0,0 +1,18 @@
+/***********************************************************************************************************************************
+Expire File
+
+Remove the paths and files planned for removal by expire. Paths are removed recursively and files are removed in a batch so storage
+that supports batch removal (e.g. S3) needs fewer requests.
+***********************************************************************************************************************************/
+#ifndef COMMAND_EXPIRE_FILE_H
+#define COMMAND_EXPIRE_FILE_H
+
+#include "common/type/stringList.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Remove paths and files from a repo
+FN_EXTERN void expireFile(unsigned int repoIdx, const StringList *pathList, const StringList *fileList);
+
+#endif
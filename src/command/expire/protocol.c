@@ -0,0 +1,33 @@
+/***********************************************************************************************************************************
+Expire Protocol Handler
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include "command/expire/file.h"
+#include "command/expire/protocol.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+
+/**********************************************************************************************************************************/
+FN_EXTERN ProtocolServerResult *
+expireFileProtocol(PackRead *const param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+    FUNCTION_LOG_END();
+
+    ASSERT(param != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const unsigned int repoIdx = pckReadU32P(param);
+        const StringList *const pathList = pckReadStrLstP(param);
+        const StringList *const fileList = pckReadStrLstP(param);
+
+        expireFile(repoIdx, pathList, fileList);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, NULL);
+}
@@ -0,0 +1,24 @@
+/***********************************************************************************************************************************
+Expire Protocol Handler
+***********************************************************************************************************************************/
+#ifndef COMMAND_EXPIRE_PROTOCOL_H
+#define COMMAND_EXPIRE_PROTOCOL_H
+
+#include "common/type/pack.h"
+#include "protocol/server.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Process protocol requests
+FN_EXTERN ProtocolServerResult *expireFileProtocol(PackRead *param);
+
+/***********************************************************************************************************************************
+Protocol commands for ProtocolServerHandler arrays passed to protocolServerProcess()
+***********************************************************************************************************************************/
+#define PROTOCOL_COMMAND_EXPIRE_FILE                                STRID5("ex-r", 0x96f050)
+
+#define PROTOCOL_SERVER_HANDLER_EXPIRE_LIST                                                                                        \
+    {.command = PROTOCOL_COMMAND_EXPIRE_FILE, .process = expireFileProtocol},
+
+#endif
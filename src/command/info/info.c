@@ -504,14 +504,12 @@ archiveDbList(
 }
 
 /***********************************************************************************************************************************
-Add the backup data to the backup section
+Get the backup data for the backup section
 ***********************************************************************************************************************************/
-static void
-backupListAdd(
-    VariantList *backupSection, InfoBackupData *backupData, const String *backupLabel, InfoRepoData *repoData)
+static Variant *
+backupListAdd(InfoBackupData *backupData, const String *backupLabel, InfoRepoData *repoData)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(VARIANT_LIST, backupSection);           // The section to add the backup data to
         FUNCTION_TEST_PARAM_P(INFO_BACKUP_DATA, backupData);        // The data for the backup
         FUNCTION_TEST_PARAM(STRING, backupLabel);                   // Backup label to filter if requested by the user
         FUNCTION_TEST_PARAM(INFO_REPO_DATA, repoData);              // The repo data where this backup is located
@@ -519,7 +517,6 @@ backupListAdd(
 
     FUNCTION_AUDIT_HELPER();
 
-    ASSERT(backupSection != NULL);
     ASSERT(backupData != NULL);
     ASSERT(repoData != NULL);
 
@@ -729,21 +726,21 @@ backupListAdd(
         repoData->manifest = NULL;
     }
 
-    varLstAdd(backupSection, backupInfo);
-
-    FUNCTION_TEST_RETURN_VOID();
+    FUNCTION_TEST_RETURN(VARIANT, backupInfo);
 }
 
 /***********************************************************************************************************************************
-For each current backup in the backup.info file of the stanza, set the data for the backup section
+For each current backup in the backup.info file of the stanza, set the data for the backup section. When json is set each backup is
+written to the json output as soon as it is gathered and then freed so only the output grows with the number of backups.
 ***********************************************************************************************************************************/
 static void
 backupList(
-    VariantList *const backupSection, InfoStanzaRepo *const stanzaData, const String *const backupLabel,
+    VariantList *const backupSection, JsonWrite *const json, InfoStanzaRepo *const stanzaData, const String *const backupLabel,
     const unsigned int repoIdxMin, const unsigned int repoIdxMax)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(VARIANT_LIST, backupSection);           // The section to add the backup data to
+        FUNCTION_TEST_PARAM(JSON_WRITE, json);                      // Or the json to write the backup data to
         FUNCTION_TEST_PARAM(INFO_STANZA_REPO, stanzaData);          // The data for the stanza
         FUNCTION_TEST_PARAM(STRING, backupLabel);                   // Backup label to filter if requested by the user
         FUNCTION_TEST_PARAM(UINT, repoIdxMin);                      // The start index of the repo array to begin checking
@@ -752,7 +749,7 @@ backupList(
 
     FUNCTION_AUDIT_HELPER();
 
-    ASSERT(backupSection != NULL);
+    ASSERT((backupSection != NULL) != (json != NULL));
     ASSERT(stanzaData != NULL);
 
     unsigned int backupNextRepoIdx = 0;
@@ -803,184 +800,247 @@ backupList(
         if (backupLabel != NULL && !strEq(backupData.backupLabel, backupLabel))
             continue;
 
-        // Add the backup data to the backup section
-        if (!cfgOptionTest(cfgOptType) || cfgOptionStrId(cfgOptType) == backupData.backupType)
-            backupListAdd(backupSection, &backupData, backupLabel, repoData);
+        // Skip the backup if it does not match the requested type
+        if (cfgOptionTest(cfgOptType) && cfgOptionStrId(cfgOptType) != backupData.backupType)
+            continue;
+
+        // Write the backup data to json
+        if (json != NULL)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                jsonWriteVar(json, backupListAdd(&backupData, backupLabel, repoData));
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+        // Else add the backup data to the backup section
+        else
+            varLstAdd(backupSection, backupListAdd(&backupData, backupLabel, repoData));
     }
 
     FUNCTION_TEST_RETURN_VOID();
 }
 
 /***********************************************************************************************************************************
-Set the stanza data for each stanza found in the repo
+Set the stanza data for a stanza found in the repo. The backup section is only added when requested since json output writes it
+separately.
 ***********************************************************************************************************************************/
-static VariantList *
-stanzaInfoList(
-    List *const stanzaRepoList, const String *const backupLabel, const unsigned int repoIdxMin, const unsigned int repoIdxMax)
+static Variant *
+stanzaInfo(
+    InfoStanzaRepo *const stanzaData, const String *const backupLabel, const unsigned int repoIdxMin,
+    const unsigned int repoIdxMax, const bool backup)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(LIST, stanzaRepoList);
+        FUNCTION_TEST_PARAM(INFO_STANZA_REPO, stanzaData);
         FUNCTION_TEST_PARAM(STRING, backupLabel);
         FUNCTION_TEST_PARAM(UINT, repoIdxMin);
         FUNCTION_TEST_PARAM(UINT, repoIdxMax);
+        FUNCTION_TEST_PARAM(BOOL, backup);
     FUNCTION_TEST_END();
 
     FUNCTION_AUDIT_HELPER();
 
-    ASSERT(stanzaRepoList != NULL);
+    ASSERT(stanzaData != NULL);
 
     // Is full output requested?
     const bool outputFull = cfgOptionSeq(cfgOptDetailLevel) == CFGOPTVAL_DETAIL_LEVEL_FULL;
 
-    VariantList *const result = varLstNew();
+    // Create the stanzaInfo and section variables
+    Variant *const result = varNewKv(kvNew());
+    VariantList *const dbSection = varLstNew();
+    VariantList *const archiveSection = varLstNew();
+    VariantList *const repoSection = varLstNew();
 
-    // Sort the list of stanzas
-    lstSort(stanzaRepoList, sortOrderAsc);
+    int stanzaStatusCode = -1;
+    uint64_t stanzaCipherType = cipherTypeNone;
 
-    // Process each stanza requested
-    for (unsigned int idx = 0; idx < lstSize(stanzaRepoList); idx++)
-    {
-        InfoStanzaRepo *const stanzaData = lstGet(stanzaRepoList, idx);
-
-        // Create the stanzaInfo and section variables
-        Variant *const stanzaInfo = varNewKv(kvNew());
-        VariantList *const dbSection = varLstNew();
-        VariantList *const backupSection = varLstNew();
-        VariantList *const archiveSection = varLstNew();
-        VariantList *const repoSection = varLstNew();
+    // Set the stanza name and initialize the overall stanza variables
+    kvPut(varKv(result), KEY_NAME_VAR, VARSTR(stanzaData->name));
 
-        int stanzaStatusCode = -1;
-        uint64_t stanzaCipherType = cipherTypeNone;
-
-        // Set the stanza name and initialize the overall stanza variables
-        kvPut(varKv(stanzaInfo), KEY_NAME_VAR, VARSTR(stanzaData->name));
+    // Get the stanza for each requested repo
+    for (unsigned int repoIdx = repoIdxMin; repoIdx <= repoIdxMax; repoIdx++)
+    {
+        InfoRepoData *const repoData = &stanzaData->repoList[repoIdx];
 
-        // Get the stanza for each requested repo
-        for (unsigned int repoIdx = repoIdxMin; repoIdx <= repoIdxMax; repoIdx++)
+        // When full output is not requested (progress mode), skip collecting detailed information and only update status code
+        if (!outputFull)
         {
-            InfoRepoData *const repoData = &stanzaData->repoList[repoIdx];
-
-            // When full output is not requested (progress mode), skip collecting detailed information and only update status code
-            if (!outputFull)
+            if (repoIdx == repoIdxMin)
+                stanzaStatusCode = repoData->stanzaStatus;
+            else
             {
-                if (repoIdx == repoIdxMin)
-                    stanzaStatusCode = repoData->stanzaStatus;
-                else
-                {
-                    stanzaStatusCode =
-                        stanzaStatusCode != repoData->stanzaStatus ? INFO_STANZA_STATUS_CODE_MIXED : repoData->stanzaStatus;
-                }
-
-                continue;
+                stanzaStatusCode =
+                    stanzaStatusCode != repoData->stanzaStatus ? INFO_STANZA_STATUS_CODE_MIXED : repoData->stanzaStatus;
             }
 
-            Variant *const repoInfo = varNewKv(kvNew());
-            kvPut(varKv(repoInfo), REPO_KEY_KEY_VAR, VARUINT(repoData->key));
-            kvPut(varKv(repoInfo), KEY_CIPHER_VAR, VARSTR(strNewStrId(repoData->cipher)));
+            continue;
+        }
 
-            // If the stanza on this repo has the default status of ok but the backupInfo was not read, then the stanza exists on
-            // other repos but not this one
-            if (repoData->stanzaStatus == INFO_STANZA_STATUS_CODE_OK && repoData->backupInfo == NULL)
-                repoData->stanzaStatus = INFO_STANZA_STATUS_CODE_MISSING_STANZA_PATH;
+        Variant *const repoInfo = varNewKv(kvNew());
+        kvPut(varKv(repoInfo), REPO_KEY_KEY_VAR, VARUINT(repoData->key));
+        kvPut(varKv(repoInfo), KEY_CIPHER_VAR, VARSTR(strNewStrId(repoData->cipher)));
 
-            TRY_BEGIN()
+        // If the stanza on this repo has the default status of ok but the backupInfo was not read, then the stanza exists on
+        // other repos but not this one
+        if (repoData->stanzaStatus == INFO_STANZA_STATUS_CODE_OK && repoData->backupInfo == NULL)
+            repoData->stanzaStatus = INFO_STANZA_STATUS_CODE_MISSING_STANZA_PATH;
+
+        TRY_BEGIN()
+        {
+            // If the backup.info file has been read, then get the backup and archive information on this repo
+            if (repoData->backupInfo != NULL)
             {
-                // If the backup.info file has been read, then get the backup and archive information on this repo
-                if (repoData->backupInfo != NULL)
+                // If the backup.info file exists, get the database history information (oldest to newest) and corresponding
+                // archive
+                for (unsigned int pgIdx = infoPgDataTotal(infoBackupPg(repoData->backupInfo)) - 1; (int)pgIdx >= 0; pgIdx--)
                 {
-                    // If the backup.info file exists, get the database history information (oldest to newest) and corresponding
-                    // archive
-                    for (unsigned int pgIdx = infoPgDataTotal(infoBackupPg(repoData->backupInfo)) - 1; (int)pgIdx >= 0; pgIdx--)
-                    {
-                        const InfoPgData pgData = infoPgData(infoBackupPg(repoData->backupInfo), pgIdx);
-                        Variant *const pgInfo = varNewKv(kvNew());
+                    const InfoPgData pgData = infoPgData(infoBackupPg(repoData->backupInfo), pgIdx);
+                    Variant *const pgInfo = varNewKv(kvNew());
 
-                        kvPut(varKv(pgInfo), DB_KEY_ID_VAR, VARUINT(pgData.id));
-                        kvPut(varKv(pgInfo), DB_KEY_SYSTEM_ID_VAR, VARUINT64(pgData.systemId));
-                        kvPut(varKv(pgInfo), DB_KEY_VERSION_VAR, VARSTR(pgVersionToStr(pgData.version)));
-                        kvPut(varKv(pgInfo), KEY_REPO_KEY_VAR, VARUINT(repoData->key));
+                    kvPut(varKv(pgInfo), DB_KEY_ID_VAR, VARUINT(pgData.id));
+                    kvPut(varKv(pgInfo), DB_KEY_SYSTEM_ID_VAR, VARUINT64(pgData.systemId));
+                    kvPut(varKv(pgInfo), DB_KEY_VERSION_VAR, VARSTR(pgVersionToStr(pgData.version)));
+                    kvPut(varKv(pgInfo), KEY_REPO_KEY_VAR, VARUINT(repoData->key));
 
-                        varLstAdd(dbSection, pgInfo);
+                    varLstAdd(dbSection, pgInfo);
 
-                        // Get the archive info for the DB from the archive.info file
-                        archiveDbList(
-                            stanzaData->name, &pgData, archiveSection, repoData->archiveInfo, (pgIdx == 0 ? true : false),
-                            repoIdx, repoData->key);
-                    }
-
-                    // Set stanza status if the current db sections do not match across repos
-                    const InfoPgData backupInfoCurrentPg = infoPgData(
-                        infoBackupPg(repoData->backupInfo), infoPgDataCurrentId(infoBackupPg(repoData->backupInfo)));
-
-                    // The current PG system and version must match across repos for the stanza, if not, a failure may have occurred
-                    // during an upgrade or the repo may have been disabled during the stanza upgrade to protect from error
-                    // propagation
-                    if (stanzaData->currentPgVersion != backupInfoCurrentPg.version ||
-                        stanzaData->currentPgSystemId != backupInfoCurrentPg.systemId)
-                    {
-                        stanzaStatusCode = INFO_STANZA_STATUS_CODE_PG_MISMATCH;
-                    }
+                    // Get the archive info for the DB from the archive.info file
+                    archiveDbList(
+                        stanzaData->name, &pgData, archiveSection, repoData->archiveInfo, (pgIdx == 0 ? true : false),
+                        repoIdx, repoData->key);
                 }
-            }
-            CATCH_ANY()
-            {
-                infoStanzaErrorAdd(repoData, errorType(), STR(errorMessage()));
-            }
-            TRY_END();
 
-            // If there are no current backups on this repo then set status to no backup
-            if (repoData->stanzaStatus == INFO_STANZA_STATUS_CODE_OK && infoBackupDataTotal(repoData->backupInfo) == 0)
-                repoData->stanzaStatus = INFO_STANZA_STATUS_CODE_NO_BACKUP;
+                // Set stanza status if the current db sections do not match across repos
+                const InfoPgData backupInfoCurrentPg = infoPgData(
+                    infoBackupPg(repoData->backupInfo), infoPgDataCurrentId(infoBackupPg(repoData->backupInfo)));
 
-            // Track the status over all repos if the status for the stanza has not already been determined
-            if (stanzaStatusCode != INFO_STANZA_STATUS_CODE_PG_MISMATCH)
-            {
-                if (repoIdx == repoIdxMin)
-                    stanzaStatusCode = repoData->stanzaStatus;
-                else
+                // The current PG system and version must match across repos for the stanza, if not, a failure may have occurred
+                // during an upgrade or the repo may have been disabled during the stanza upgrade to protect from error
+                // propagation
+                if (stanzaData->currentPgVersion != backupInfoCurrentPg.version ||
+                    stanzaData->currentPgSystemId != backupInfoCurrentPg.systemId)
                 {
-                    stanzaStatusCode =
-                        stanzaStatusCode != repoData->stanzaStatus ? INFO_STANZA_STATUS_CODE_MIXED : repoData->stanzaStatus;
+                    stanzaStatusCode = INFO_STANZA_STATUS_CODE_PG_MISMATCH;
                 }
             }
+        }
+        CATCH_ANY()
+        {
+            infoStanzaErrorAdd(repoData, errorType(), STR(errorMessage()));
+        }
+        TRY_END();
+
+        // If there are no current backups on this repo then set status to no backup
+        if (repoData->stanzaStatus == INFO_STANZA_STATUS_CODE_OK && infoBackupDataTotal(repoData->backupInfo) == 0)
+            repoData->stanzaStatus = INFO_STANZA_STATUS_CODE_NO_BACKUP;
 
-            // Track cipher type over all repos
+        // Track the status over all repos if the status for the stanza has not already been determined
+        if (stanzaStatusCode != INFO_STANZA_STATUS_CODE_PG_MISMATCH)
+        {
             if (repoIdx == repoIdxMin)
-                stanzaCipherType = repoData->cipher;
+                stanzaStatusCode = repoData->stanzaStatus;
             else
-                stanzaCipherType = stanzaCipherType != repoData->cipher ? INFO_STANZA_STATUS_CODE_MIXED : repoData->cipher;
+            {
+                stanzaStatusCode =
+                    stanzaStatusCode != repoData->stanzaStatus ? INFO_STANZA_STATUS_CODE_MIXED : repoData->stanzaStatus;
+            }
+        }
 
-            // Add the status of the stanza on the repo to the repo section, and the repo to the repo array
-            repoStanzaStatus(repoData->stanzaStatus, repoInfo, repoData);
-            varLstAdd(repoSection, repoInfo);
+        // Track cipher type over all repos
+        if (repoIdx == repoIdxMin)
+            stanzaCipherType = repoData->cipher;
+        else
+            stanzaCipherType = stanzaCipherType != repoData->cipher ? INFO_STANZA_STATUS_CODE_MIXED : repoData->cipher;
 
-            // Add the database history, backup, archive and repo arrays to the stanza info
-            kvPut(varKv(stanzaInfo), STANZA_KEY_DB_VAR, varNewVarLst(dbSection));
-            kvPut(varKv(stanzaInfo), KEY_ARCHIVE_VAR, varNewVarLst(archiveSection));
-            kvPut(varKv(stanzaInfo), STANZA_KEY_REPO_VAR, varNewVarLst(repoSection));
-        }
+        // Add the status of the stanza on the repo to the repo section, and the repo to the repo array
+        repoStanzaStatus(repoData->stanzaStatus, repoInfo, repoData);
+        varLstAdd(repoSection, repoInfo);
 
-        // Collect backup and cipher data if full output is requested
-        if (outputFull)
+        // Add the database history, backup, archive and repo arrays to the stanza info
+        kvPut(varKv(result), STANZA_KEY_DB_VAR, varNewVarLst(dbSection));
+        kvPut(varKv(result), KEY_ARCHIVE_VAR, varNewVarLst(archiveSection));
+        kvPut(varKv(result), STANZA_KEY_REPO_VAR, varNewVarLst(repoSection));
+    }
+
+    // Collect backup and cipher data if full output is requested
+    if (outputFull)
+    {
+        // Get a sorted list of the data for all existing backups for this stanza over all repos
+        if (backup)
         {
-            // Get a sorted list of the data for all existing backups for this stanza over all repos
-            backupList(backupSection, stanzaData, backupLabel, repoIdxMin, repoIdxMax);
-            kvPut(varKv(stanzaInfo), STANZA_KEY_BACKUP_VAR, varNewVarLst(backupSection));
+            VariantList *const backupSection = varLstNew();
 
-            // Set the overall cipher type
-            if (stanzaCipherType != INFO_STANZA_STATUS_CODE_MIXED)
-                kvPut(varKv(stanzaInfo), KEY_CIPHER_VAR, VARSTR(strNewStrId(stanzaCipherType)));
-            else
-                kvPut(varKv(stanzaInfo), KEY_CIPHER_VAR, VARSTRDEF(INFO_STANZA_MIXED));
+            backupList(backupSection, NULL, stanzaData, backupLabel, repoIdxMin, repoIdxMax);
+            kvPut(varKv(result), STANZA_KEY_BACKUP_VAR, varNewVarLst(backupSection));
         }
 
-        // Set the overall stanza status and gather progress information
-        stanzaStatus(stanzaStatusCode, stanzaData, stanzaInfo, repoIdxMin, repoIdxMax);
+        // Set the overall cipher type
+        if (stanzaCipherType != INFO_STANZA_STATUS_CODE_MIXED)
+            kvPut(varKv(result), KEY_CIPHER_VAR, VARSTR(strNewStrId(stanzaCipherType)));
+        else
+            kvPut(varKv(result), KEY_CIPHER_VAR, VARSTRDEF(INFO_STANZA_MIXED));
+    }
+
+    // Set the overall stanza status and gather progress information
+    stanzaStatus(stanzaStatusCode, stanzaData, result, repoIdxMin, repoIdxMax);
+
+    FUNCTION_TEST_RETURN(VARIANT, result);
+}
+
+/***********************************************************************************************************************************
+Write the stanza data for a stanza found in the repo to json. Keys are written in sorted order (as jsonFromVar() would) but the
+backups are written from the info files rather than being gathered into a list first.
+***********************************************************************************************************************************/
+static void
+stanzaInfoJson(
+    JsonWrite *const json, InfoStanzaRepo *const stanzaData, const String *const backupLabel, const unsigned int repoIdxMin,
+    const unsigned int repoIdxMax)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, json);
+        FUNCTION_TEST_PARAM(INFO_STANZA_REPO, stanzaData);
+        FUNCTION_TEST_PARAM(STRING, backupLabel);
+        FUNCTION_TEST_PARAM(UINT, repoIdxMin);
+        FUNCTION_TEST_PARAM(UINT, repoIdxMax);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(json != NULL);
+    ASSERT(stanzaData != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const KeyValue *const stanzaKv = varKv(stanzaInfo(stanzaData, backupLabel, repoIdxMin, repoIdxMax, false));
+        const StringList *const keyList = strLstSort(strLstNewVarLst(kvKeyList(stanzaKv)), sortOrderAsc);
+
+        // Backups are only output when full output is requested
+        bool backupWrite = cfgOptionSeq(cfgOptDetailLevel) == CFGOPTVAL_DETAIL_LEVEL_FULL;
+
+        jsonWriteObjectBegin(json);
+
+        for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+        {
+            const String *const key = strLstGet(keyList, keyIdx);
 
-        varLstAdd(result, stanzaInfo);
+            // Write the backups once all keys sorting before them have been written. There is always a name key after them.
+            if (backupWrite && strCmp(key, varStr(STANZA_KEY_BACKUP_VAR)) > 0)
+            {
+                jsonWriteArrayBegin(jsonWriteKey(json, varStr(STANZA_KEY_BACKUP_VAR)));
+                backupList(NULL, json, stanzaData, backupLabel, repoIdxMin, repoIdxMax);
+                jsonWriteArrayEnd(json);
+
+                backupWrite = false;
+            }
+
+            jsonWriteVar(jsonWriteKey(json, key), kvGet(stanzaKv, VARSTR(key)));
+        }
+
+        jsonWriteObjectEnd(json);
     }
+    MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_TEST_RETURN(VARIANT_LIST, result);
+    FUNCTION_TEST_RETURN_VOID();
 }
 
 /***********************************************************************************************************************************
@@ -1692,7 +1752,7 @@ infoRender(void)
             TRY_END();
         }
 
-        VariantList *infoList = varLstNew();
+        VariantList *const infoList = varLstNew();
         String *resultStr = strNew();
 
         // Record any repository-level errors with each stanza -- if there are no stanzas and one was not requested, then create an
@@ -1746,13 +1806,16 @@ infoRender(void)
             }
         }
 
-        // If the backup storage exists, then search for and process any stanzas
-        if (!lstEmpty(stanzaRepoList))
-            infoList = stanzaInfoList(stanzaRepoList, backupLabel, repoIdxMin, repoIdxMax);
+        // Sort the list of stanzas
+        lstSort(stanzaRepoList, sortOrderAsc);
 
         // Format text output
         if (cfgOptionSeq(cfgOptOutput) == CFGOPTVAL_OUTPUT_TEXT)
         {
+            // If the backup storage exists, then search for and process any stanzas
+            for (unsigned int idx = 0; idx < lstSize(stanzaRepoList); idx++)
+                varLstAdd(infoList, stanzaInfo(lstGet(stanzaRepoList, idx), backupLabel, repoIdxMin, repoIdxMax, true));
+
             // Process any stanza directories
             if (!varLstEmpty(infoList))
             {
@@ -1936,11 +1999,17 @@ infoRender(void)
             else
                 resultStr = strNewZ("No stanzas exist in the repository.\n");
         }
-        // Format json output
+        // Format json output. Each stanza is written as it is processed rather than gathering all stanzas into a variant first.
         else
         {
             ASSERT(cfgOptionSeq(cfgOptOutput) == CFGOPTVAL_OUTPUT_JSON);
-            resultStr = jsonFromVar(varNewVarLst(infoList));
+
+            JsonWrite *const json = jsonWriteArrayBegin(jsonWriteNewP(.json = resultStr));
+
+            for (unsigned int idx = 0; idx < lstSize(stanzaRepoList); idx++)
+                stanzaInfoJson(json, lstGet(stanzaRepoList, idx), backupLabel, repoIdxMin, repoIdxMax);
+
+            jsonWriteArrayEnd(json);
         }
 
         MEM_CONTEXT_PRIOR_BEGIN()
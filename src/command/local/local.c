@@ -6,6 +6,8 @@ Local Command
 #include "command/archive/get/protocol.h"
 #include "command/archive/push/protocol.h"
 #include "command/backup/protocol.h"
+#include "command/consolidate/protocol.h"
+#include "command/expire/protocol.h"
 #include "command/local/local.h"
 #include "command/restore/protocol.h"
 #include "command/verify/protocol.h"
@@ -24,6 +26,8 @@ static const ProtocolServerHandler commandLocalHandler[] =
     PROTOCOL_SERVER_HANDLER_ARCHIVE_GET_LIST
     PROTOCOL_SERVER_HANDLER_ARCHIVE_PUSH_LIST
     PROTOCOL_SERVER_HANDLER_BACKUP_LIST
+    PROTOCOL_SERVER_HANDLER_CONSOLIDATE_LIST
+    PROTOCOL_SERVER_HANDLER_EXPIRE_LIST
     PROTOCOL_SERVER_HANDLER_RESTORE_LIST
     PROTOCOL_SERVER_HANDLER_VERIFY_LIST
 };
@@ -79,6 +79,7 @@ restoreFileProtocol(PackRead *const param)
             }
 
             file.manifestFile = pckReadStrP(param);
+            file.repoFile = pckReadStrP(param);
 
             lstAdd(fileList, &file);
         }
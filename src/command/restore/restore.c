@@ -55,7 +55,7 @@ cmdRestore(void)
         const RestoreBackupData backupData = restoreBackupSet();
 
         // Load manifest
-        RestoreJobData jobData = {.repoIdx = backupData.repoIdx};
+        RestoreJobData jobData = {.repoIdx = backupData.repoIdx, .bundleMax = restoreJobBundleMax(backupData.repoIdx)};
 
         jobData.manifest = manifestLoadFile(
             storageRepoIdx(backupData.repoIdx),
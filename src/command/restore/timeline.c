@@ -16,23 +16,15 @@ Timeline Management
 #include "postgres/version.h"
 #include "storage/helper.h"
 
-/***********************************************************************************************************************************
-Parse history file
-***********************************************************************************************************************************/
-typedef struct HistoryItem
-{
-    unsigned int timeline;                                          // Parent timeline
-    uint64_t lsn;                                                   // Boundary lsn
-} HistoryItem;
-
-static List *
-historyParse(const String *const history)
+/**********************************************************************************************************************************/
+FN_EXTERN List *
+timelineHistoryParse(const String *const history)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, history);
     FUNCTION_LOG_END();
 
-    List *const result = lstNewP(sizeof(HistoryItem));
+    List *const result = lstNewP(sizeof(TimelineHistoryItem));
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -56,7 +48,7 @@ historyParse(const String *const history)
             if (strLstSize(split) < 2)
                 THROW_FMT(FormatError, "invalid history line format '%s'", strZ(strLstGet(historyList, historyIdx)));
 
-            const HistoryItem historyItem =
+            const TimelineHistoryItem historyItem =
             {
                 .timeline = cvtZToUInt(strZ(strLstGet(split, 0))),
                 .lsn = pgLsnFromStr(strLstGet(split, 1)),
@@ -99,7 +91,7 @@ historyLoad(
 
         TRY_BEGIN()
         {
-            result = lstMove(historyParse(strNewBuf(history)), memContextPrior());
+            result = lstMove(timelineHistoryParse(strNewBuf(history)), memContextPrior());
         }
         CATCH_ANY()
         {
@@ -226,7 +218,7 @@ timelineVerify(
 
                 for (unsigned int historyIdx = 0; historyIdx < lstSize(historyList); historyIdx++)
                 {
-                    const HistoryItem *const historyItem = lstGet(historyList, historyIdx);
+                    const TimelineHistoryItem *const historyItem = lstGet(historyList, historyIdx);
 
                     // If backup timeline exists in the target timeline's history before the fork LSN then restore can proceed
                     if (historyItem->timeline == timelineBackup && lsnBackup < historyItem->lsn)
@@ -244,7 +236,7 @@ timelineVerify(
                     // Check if timeline exists but did not fork off when expected
                     for (unsigned int historyIdx = 0; historyIdx < lstSize(historyList); historyIdx++)
                     {
-                        const HistoryItem *const historyItem = lstGet(historyList, historyIdx);
+                        const TimelineHistoryItem *const historyItem = lstGet(historyList, historyIdx);
 
                         if (historyItem->timeline == timelineBackup)
                         {
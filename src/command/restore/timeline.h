@@ -7,9 +7,21 @@ Timeline Management
 #include "common/crypto/spec.h"
 #include "storage/storage.h"
 
+/***********************************************************************************************************************************
+Types
+***********************************************************************************************************************************/
+typedef struct TimelineHistoryItem
+{
+    unsigned int timeline;                                          // Parent timeline
+    uint64_t lsn;                                                   // Boundary lsn
+} TimelineHistoryItem;
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+// Parse history file into a list of TimelineHistoryItem
+FN_EXTERN List *timelineHistoryParse(const String *history);
+
 // Verify that target timeline is valid for a backup
 FN_EXTERN void timelineVerify(
     const Storage *storageRepo, const String *archiveId, unsigned int pgVersion, unsigned int timelineBackup, uint64_t lsnBackup,
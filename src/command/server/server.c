@@ -3,7 +3,10 @@ Server Command
 ***********************************************************************************************************************************/
 #include <build.h>
 
+#include <fcntl.h>
+#include <sys/select.h>
 #include <sys/wait.h>
+#include <unistd.h>
 #ifdef HAVE_LIBSYSTEMD
 #include <systemd/sd-daemon.h>
 #endif
@@ -22,6 +25,12 @@ Server Command
 /***********************************************************************************************************************************
 Local variables
 ***********************************************************************************************************************************/
+typedef struct ServerProcess
+{
+    pid_t pid;                                                      // Process id
+    bool ready;                                                     // Is the process in the pool waiting for a connection?
+} ServerProcess;
+
 static struct ServerLocal
 {
     MemContext *memContext;                                         // Mem context for server
@@ -36,6 +45,9 @@ static struct ServerLocal
 
     IoServer *socketServer;                                         // Socket server
     IoServer *tlsServer;                                            // TLS server
+
+    int poolPipe[2];                                                // Pool processes send their pid when a connection is accepted
+    int generationPipe[2];                                          // Closed on reload to end the current pool generation
 } serverLocal;
 
 /***********************************************************************************************************************************
@@ -52,12 +64,27 @@ cmdServerInit(void)
             MEM_CONTEXT_NEW_BEGIN(Server, .childQty = MEM_CONTEXT_QTY_MAX)
             {
                 serverLocal.memContext = MEM_CONTEXT_NEW();
-                serverLocal.processList = lstNewP(sizeof(pid_t));
+                serverLocal.processList = lstNewP(sizeof(ServerProcess));
             }
             MEM_CONTEXT_NEW_END();
         }
         MEM_CONTEXT_END();
+
+        // Create pool pipe. The read end is non-blocking so all pending notifications can be read without waiting.
+        THROW_ON_SYS_ERROR(pipe(serverLocal.poolPipe) == -1, KernelError, "unable to create pool pipe");
+        THROW_ON_SYS_ERROR(
+            fcntl(serverLocal.poolPipe[0], F_SETFL, O_NONBLOCK) == -1, KernelError, "unable to set pool pipe non-blocking");
     }
+    // Else end the prior pool generation. Pool processes waiting for a connection see the end of the pipe and exit, which releases
+    // the listening socket so the address can be bound again. Pool processes that have accepted a connection serve it first.
+    else
+    {
+        close(serverLocal.generationPipe[0]);
+        close(serverLocal.generationPipe[1]);
+    }
+
+    // Create generation pipe for the pool processes started with this configuration
+    THROW_ON_SYS_ERROR(pipe(serverLocal.generationPipe) == -1, KernelError, "unable to create generation pipe");
 
     MEM_CONTEXT_BEGIN(serverLocal.memContext)
     {
@@ -68,11 +95,21 @@ cmdServerInit(void)
         // Create new servers
         serverLocal.socketServer = sckServerNew(
             cfgOptionStr(cfgOptTlsServerAddress), cfgOptionUInt(cfgOptTlsServerPort), cfgOptionUInt64(cfgOptProtocolTimeout));
-        serverLocal.tlsServer = tlsServerNew(
+        serverLocal.tlsServer = tlsServerNewP(
             cfgOptionStr(cfgOptTlsServerAddress), cfgOptionStr(cfgOptTlsServerCaFile), cfgOptionStr(cfgOptTlsServerKeyFile),
-            cfgOptionStr(cfgOptTlsServerCertFile), cfgOptionUInt64(cfgOptProtocolTimeout));
+            cfgOptionStr(cfgOptTlsServerCertFile), cfgOptionUInt64(cfgOptProtocolTimeout),
+            .resume = cfgOptionBool(cfgOptTlsServerResume));
     }
     MEM_CONTEXT_END();
+
+    // Pool processes wait for a connection and the end of their generation at the same time so accept must not block when another
+    // pool process has accepted the connection first
+    if (cfgOptionUInt(cfgOptTlsServerPool) > 0)
+    {
+        THROW_ON_SYS_ERROR(
+            fcntl(ioServerFd(serverLocal.socketServer), F_SETFL, O_NONBLOCK) == -1, KernelError,
+            "unable to set server socket non-blocking");
+    }
 }
 
 /***********************************************************************************************************************************
@@ -104,7 +141,7 @@ cmdServerSigChild(const int signalType, siginfo_t *const signalInfo, void *const
     // Find the process and remove it
     for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
     {
-        if (*(int *)lstGet(serverLocal.processList, processIdx) == signalInfo->si_pid)
+        if (((ServerProcess *)lstGet(serverLocal.processList, processIdx))->pid == signalInfo->si_pid)
         {
             ASSERT(signalInfo->si_code == CLD_EXITED);
             lstRemoveIdx(serverLocal.processList, processIdx);
@@ -112,6 +149,197 @@ cmdServerSigChild(const int signalType, siginfo_t *const signalInfo, void *const
     }
 }
 
+/***********************************************************************************************************************************
+Block the signals handled by the server so the process list is not modified by the SIGCHLD handler while it is being updated and so
+the pool can wait for a notification without missing a signal. The prior signal mask is returned.
+***********************************************************************************************************************************/
+static sigset_t
+cmdServerSignalBlock(void)
+{
+    FUNCTION_TEST_VOID();
+
+    sigset_t signalSet;
+    sigset_t result;
+
+    sigemptyset(&signalSet);
+    sigaddset(&signalSet, SIGCHLD);
+    sigaddset(&signalSet, SIGHUP);
+    sigaddset(&signalSet, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signalSet, &result);
+
+    FUNCTION_TEST_RETURN_TYPE(sigset_t, result);
+}
+
+/***********************************************************************************************************************************
+Initialize a child process and serve a connection
+***********************************************************************************************************************************/
+static void
+cmdServerChildInit(void)
+{
+    FUNCTION_TEST_VOID();
+
+    // Reset SIGCHLD to default
+    sigaction(SIGCHLD, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
+
+    // Close the write end of the generation pipe so the end of the generation is seen when the parent closes it
+    close(serverLocal.generationPipe[1]);
+
+    // Set standard signal handlers
+    exitInit();
+
+    // Disable logging and close log file
+    logClose();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+cmdServerChildRun(IoSession *const socketSession)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_SESSION, socketSession);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    // Close the server socket so we don't hold the port open if the parent exits first
+    ioServerFree(serverLocal.socketServer);
+
+    // Start standard remote processing if a server is returned
+    ProtocolServer *server = protocolServer(serverLocal.tlsServer, socketSession);
+
+    if (server != NULL)
+        cmdRemote(server);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read notifications from pool processes that have accepted a connection and mark them as no longer waiting
+***********************************************************************************************************************************/
+static void
+cmdServerPoolAccepted(void)
+{
+    FUNCTION_TEST_VOID();
+
+    pid_t pid;
+    ssize_t readSize;
+
+    while ((readSize = read(serverLocal.poolPipe[0], &pid, sizeof(pid))) == sizeof(pid))
+    {
+        for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
+        {
+            ServerProcess *const process = lstGet(serverLocal.processList, processIdx);
+
+            if (process->pid == pid)
+                process->ready = false;
+        }
+    }
+
+    THROW_ON_SYS_ERROR(readSize != -1 || errno != EAGAIN, FileReadError, "unable to read from pool pipe");
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Start processes until the pool is full and then wait for a pool process to accept a connection or for a signal. Forking in advance
+means the cost of the fork is not paid while the client is waiting. Each pool process serves a single connection since the
+configuration is loaded from the client for each connection. Returns true in a pool process after the connection has been served or
+the generation has ended.
+***********************************************************************************************************************************/
+static bool
+cmdServerPool(void)
+{
+    FUNCTION_TEST_VOID();
+
+    FUNCTION_AUDIT_HELPER();
+
+    bool result = false;
+    const sigset_t signalMask = cmdServerSignalBlock();
+
+    // Count processes that are waiting for a connection
+    unsigned int readyTotal = 0;
+
+    for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
+    {
+        if (((ServerProcess *)lstGet(serverLocal.processList, processIdx))->ready)
+            readyTotal++;
+    }
+
+    // Start processes until the pool is full
+    for (; readyTotal < cfgOptionUInt(cfgOptTlsServerPool); readyTotal++)
+    {
+        const pid_t pid = forkSafe();
+
+        if (pid == 0)
+        {
+            // Signals are unblocked only after the standard handlers are set so a SIGTERM sent by the parent cannot be lost
+            cmdServerChildInit();
+            sigprocmask(SIG_SETMASK, &signalMask, NULL);
+
+            // Wait for a connection or the end of the generation
+            const int socketFd = ioServerFd(serverLocal.socketServer);
+            const int generationFd = serverLocal.generationPipe[0];
+            IoSession *socketSession = NULL;
+
+            do
+            {
+                fd_set readSet;
+                FD_ZERO(&readSet);
+                FD_SET(socketFd, &readSet);
+                FD_SET(generationFd, &readSet);
+
+                THROW_ON_SYS_ERROR(
+                    select((socketFd > generationFd ? socketFd : generationFd) + 1, &readSet, NULL, NULL, NULL) == -1, KernelError,
+                    "unable to wait for connection");
+
+                // Exit without serving a connection when the configuration has been reloaded
+                if (FD_ISSET(generationFd, &readSet))
+                    break;
+
+                // No session is returned when another pool process accepted the connection first
+                socketSession = ioServerAccept(serverLocal.socketServer, NULL);
+            }
+            while (socketSession == NULL);                          // {uncovered_branch - connection accepted by another process}
+
+            // Serve the connection unless the generation ended first
+            if (socketSession != NULL)
+            {
+                // Notify the parent that this process is no longer waiting so it can be replaced
+                const pid_t poolPid = getpid();
+
+                THROW_ON_SYS_ERROR(
+                    write(serverLocal.poolPipe[1], &poolPid, sizeof(poolPid)) != sizeof(poolPid), FileWriteError,
+                    "unable to write to pool pipe");
+
+                cmdServerChildRun(socketSession);
+            }
+
+            result = true;
+            break;
+        }
+
+        lstAdd(serverLocal.processList, &(ServerProcess){.pid = pid, .ready = true});
+    }
+
+    // Wait for a notification from a pool process with the prior signal mask so any signal that is caught interrupts the wait
+    if (!result && !serverLocal.sigHup && !serverLocal.sigTerm)        // {uncovered_branch - signal caught before signals blocked}
+    {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(serverLocal.poolPipe[0], &readSet);
+
+        if (pselect(serverLocal.poolPipe[0] + 1, &readSet, NULL, NULL, NULL, &signalMask) == 1)
+            cmdServerPoolAccepted();
+        else
+            THROW_ON_SYS_ERROR(errno != EINTR, KernelError, "unable to wait for pool pipe");
+    }
+
+    sigprocmask(SIG_SETMASK, &signalMask, NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdServer(const unsigned int argListSize, const char *argList[])
@@ -145,42 +373,36 @@ cmdServer(const unsigned int argListSize, const char *argList[])
         // Accept connections indefinitely. The only way to exit this loop is for the process to receive a signal.
         do
         {
-            // Accept a new connection
-            IoSession *const socketSession = ioServerAccept(serverLocal.socketServer, NULL);
-
-            if (socketSession != NULL)
+            // Start pool processes and wait for a connection to be accepted
+            if (cfgOptionUInt(cfgOptTlsServerPool) > 0)
             {
-                // Fork off the child process
-                pid_t pid = forkSafe();
+                if (cmdServerPool())
+                    break;
+            }
+            // Else accept a new connection and fork a process to serve it
+            else
+            {
+                IoSession *const socketSession = ioServerAccept(serverLocal.socketServer, NULL);
 
-                if (pid == 0)
+                if (socketSession != NULL)
                 {
-                    // Reset SIGCHLD to default
-                    sigaction(SIGCHLD, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
-
-                    // Set standard signal handlers
-                    exitInit();
-
-                    // Close the server socket so we don't hold the port open if the parent exits first
-                    ioServerFree(serverLocal.socketServer);
-
-                    // Disable logging and close log file
-                    logClose();
-
-                    // Start standard remote processing if a server is returned
-                    ProtocolServer *server = protocolServer(serverLocal.tlsServer, socketSession);
-
-                    if (server != NULL)
-                        cmdRemote(server);
-
-                    break;
+                    // Fork off the child process
+                    pid_t pid = forkSafe();
+
+                    if (pid == 0)
+                    {
+                        cmdServerChildInit();
+                        cmdServerChildRun(socketSession);
+
+                        break;
+                    }
+                    // Add process to list
+                    else
+                        lstAdd(serverLocal.processList, &(ServerProcess){.pid = pid});
+
+                    // Free the socket since the child is now using it
+                    ioSessionFree(socketSession);
                 }
-                // Add process to list
-                else
-                    lstAdd(serverLocal.processList, &pid);
-
-                // Free the socket since the child is now using it
-                ioSessionFree(socketSession);
             }
 
             // Reload configuration
@@ -188,6 +410,15 @@ cmdServer(const unsigned int argListSize, const char *argList[])
             {
                 LOG_DETAIL("configuration reload begin");
 
+                // Pool processes started with the prior configuration exit when their generation ends in cmdServerInit(). They are
+                // no longer counted as waiting so the pool will be refilled with processes using the new configuration.
+                const sigset_t signalMask = cmdServerSignalBlock();
+
+                for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
+                    ((ServerProcess *)lstGet(serverLocal.processList, processIdx))->ready = false;
+
+                sigprocmask(SIG_SETMASK, &signalMask, NULL);
+
                 // Reload configuration
                 cfgLoad(serverLocal.argListSize, serverLocal.argList);
 
@@ -216,10 +447,13 @@ cmdServer(const unsigned int argListSize, const char *argList[])
 
         for (unsigned int processIdx = 0; processIdx < lstSize(serverLocal.processList); processIdx++)
         {
-            pid_t pid = *(int *)lstGet(serverLocal.processList, processIdx);
+            const ServerProcess *const process = lstGet(serverLocal.processList, processIdx);
+
+            // Only warn for processes that are serving a connection
+            if (!process->ready)
+                LOG_WARN_FMT("terminate child process %d", process->pid);
 
-            LOG_WARN_FMT("terminate child process %d", pid);
-            kill(pid, SIGTERM);
+            kill(process->pid, SIGTERM);
         }
     }
 
@@ -11,19 +11,85 @@ Verify File
 #include "common/io/filter/sink.h"
 #include "common/io/filter/size.h"
 #include "common/io/io.h"
+#include "common/io/limitRead.h"
 #include "common/log.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Add filters required to verify a file
+***********************************************************************************************************************************/
+static void
+verifyFilterGroupAdd(IoFilterGroup *const filterGroup, const CompressType compressType, const CipherSpec *const cipherSpec)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_FILTER_GROUP, filterGroup);
+        FUNCTION_TEST_PARAM(ENUM, compressType);
+        FUNCTION_TEST_PARAM(CIPHER_SPEC, cipherSpec);
+    FUNCTION_TEST_END();
+
+    ASSERT(filterGroup != NULL);
+
+    // Add decryption filter
+    if (cipherSpecType(cipherSpec) != cipherTypeNone)
+        ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherSpec));
+
+    // Add decompression filter
+    if (compressType != compressTypeNone)
+        ioFilterGroupAdd(filterGroup, decompressFilterP(compressType));
+
+    // Add sha1 filter
+    ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+
+    // Add size filter
+    ioFilterGroupAdd(filterGroup, ioSizeNew());
+
+    // Add IoSink so the file data is not transmitted from the remote
+    ioFilterGroupAdd(filterGroup, ioSinkNew());
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Check the checksum/size of a file that has been read
+***********************************************************************************************************************************/
+static VerifyResult
+verifyFilterGroupResult(const IoFilterGroup *const filterGroup, const Buffer *const fileChecksum, const uint64_t fileSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_FILTER_GROUP, filterGroup);
+        FUNCTION_TEST_PARAM(BUFFER, fileChecksum);
+        FUNCTION_TEST_PARAM(UINT64, fileSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(filterGroup != NULL);
+    ASSERT(fileChecksum != NULL);
+
+    VerifyResult result = verifyOk;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Validate checksum
+        if (!bufEq(fileChecksum, pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE))))
+        {
+            result = verifyChecksumMismatch;
+        }
+        // If the size can be checked, do so
+        else if (fileSize != pckReadU64P(ioFilterGroupResultP(filterGroup, SIZE_FILTER_TYPE)))
+            result = verifySizeInvalid;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(ENUM, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN VerifyResult
 verifyFile(
-    const String *const filePathName, const uint64_t offset, const Variant *const limit, const CompressType compressType,
-    const Buffer *const fileChecksum, const uint64_t fileSize, const CipherSpec *const cipherSpec)
+    const String *const filePathName, const CompressType compressType, const Buffer *const fileChecksum, const uint64_t fileSize,
+    const CipherSpec *const cipherSpec)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, filePathName);                   // Fully qualified file name
-        FUNCTION_LOG_PARAM(UINT64, offset);                         // Offset to read in file
-        FUNCTION_LOG_PARAM(VARIANT, limit);                         // Limit to read from file
         FUNCTION_LOG_PARAM(ENUM, compressType);                     // Compression type
         FUNCTION_LOG_PARAM(BUFFER, fileChecksum);                   // Checksum for the file
         FUNCTION_LOG_PARAM(UINT64, fileSize);                       // Size of file
@@ -32,7 +98,6 @@ verifyFile(
 
     ASSERT(filePathName != NULL);
     ASSERT(fileChecksum != NULL);
-    ASSERT(limit == NULL || varType(limit) == varTypeUInt64);
 
     // Is the file valid?
     VerifyResult result = verifyOk;
@@ -41,42 +106,135 @@ verifyFile(
     {
         // Prepare the file for reading
         IoRead *const read = storageReadIo(
-            storageNewReadP(storageRepo(), filePathName, .ignoreMissing = true, .offset = offset, .limit = limit));
-        IoFilterGroup *const filterGroup = ioReadFilterGroup(read);
+            storageNewReadP(storageRepo(), filePathName, .ignoreMissing = true));
+        verifyFilterGroupAdd(ioReadFilterGroup(read), compressType, cipherSpec);
 
-        // Add decryption filter
-        if (cipherSpecType(cipherSpec) != cipherTypeNone)
-            ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherSpec));
+        // If the file exists check the checksum/size
+        if (ioReadDrain(read))
+            result = verifyFilterGroupResult(ioReadFilterGroup(read), fileChecksum, fileSize);
+        else
+            result = verifyFileMissing;
+    }
+    MEM_CONTEXT_TEMP_END();
 
-        // Add decompression filter
-        if (compressType != compressTypeNone)
-            ioFilterGroupAdd(filterGroup, decompressFilterP(compressType));
+    FUNCTION_LOG_RETURN_STRUCT(result);
+}
 
-        // Add sha1 filter
-        ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+/***********************************************************************************************************************************
+Open the bundle for reading from the offset to the end of the last file. NULL is returned when the bundle is missing.
+***********************************************************************************************************************************/
+static StorageRead *
+verifyBundleOpen(const String *const bundlePathName, const uint64_t offset, const uint64_t offsetEnd)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, bundlePathName);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, offsetEnd);
+    FUNCTION_TEST_END();
 
-        // Add size filter
-        ioFilterGroupAdd(filterGroup, ioSizeNew());
+    ASSERT(bundlePathName != NULL);
+    ASSERT(offsetEnd > offset);
 
-        // Add IoSink so the file data is not transmitted from the remote
-        ioFilterGroupAdd(filterGroup, ioSinkNew());
+    StorageRead *result = storageNewReadP(
+        storageRepo(), bundlePathName, .ignoreMissing = true, .offset = offset, .limit = VARUINT64(offsetEnd - offset));
 
-        // If the file exists check the checksum/size
-        if (ioReadDrain(read))
+    if (!ioReadOpen(storageReadIo(result)))
+    {
+        storageReadFree(result);
+        result = NULL;
+    }
+
+    FUNCTION_TEST_RETURN(STORAGE_READ, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN List *
+verifyBundle(
+    const String *const bundlePathName, const CompressType compressType, const CipherSpec *const cipherSpec,
+    const List *const fileList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, bundlePathName);                 // Fully qualified bundle name
+        FUNCTION_LOG_PARAM(ENUM, compressType);                     // Compression type
+        FUNCTION_LOG_PARAM(CIPHER_SPEC, cipherSpec);                // Cipher spec to access the repo files if encrypted
+        FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to verify
+    FUNCTION_LOG_END();
+
+    ASSERT(bundlePathName != NULL);
+    ASSERT(fileList != NULL);
+    ASSERT(!lstEmpty(fileList));
+
+    List *const result = lstNewP(sizeof(VerifyBundleResult));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read the bundle from the first file to the end of the last file in a single read
+        const VerifyBundleFile *const fileFirst = lstGet(fileList, 0);
+        const VerifyBundleFile *const fileLast = lstGetLast(fileList);
+        const uint64_t offsetEnd = fileLast->offset + fileLast->sizeRepo;
+        uint64_t offset = fileFirst->offset;
+        StorageRead *read = verifyBundleOpen(bundlePathName, offset, offsetEnd);
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
         {
-            // Validate checksum
-            if (!bufEq(fileChecksum, pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE))))
+            const VerifyBundleFile *const file = lstGet(fileList, fileIdx);
+            ASSERT(file->offset >= offset);
+
+            VerifyBundleResult fileResult = {.result = verifyFileMissing};
+
+            // If the bundle exists then split the file from the read and check the checksum/size
+            if (read != NULL)
             {
-                result = verifyChecksumMismatch;
+                TRY_BEGIN()
+                {
+                    // Use a per-file mem context to reduce memory usage
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        // Skip data between files, e.g. files in the bundle that are no longer referenced by the manifest
+                        if (file->offset > offset)
+                            ioReadDrain(ioLimitReadNew(storageReadIo(read), file->offset - offset));
+
+                        IoRead *const fileRead = ioLimitReadNew(storageReadIo(read), file->sizeRepo);
+
+                        verifyFilterGroupAdd(
+                            ioReadFilterGroup(fileRead), file->checksumRepo ? compressTypeNone : compressType,
+                            file->checksumRepo ? cipherSpecNewNone() : cipherSpec);
+                        ioReadDrain(fileRead);
+
+                        fileResult.result = verifyFilterGroupResult(ioReadFilterGroup(fileRead), file->checksum, file->size);
+                    }
+                    MEM_CONTEXT_TEMP_END();
+                }
+                // An error only invalidates this file, e.g. corrupt compressed data, so report it and continue with the next file
+                CATCH_ANY()
+                {
+                    fileResult.result = verifyOtherError;
+
+                    MEM_CONTEXT_BEGIN(lstMemContext(result))
+                    {
+                        fileResult.error = strNewFmt("[%d] %s", errorCode(), errorMessage());
+                    }
+                    MEM_CONTEXT_END();
+                }
+                TRY_END();
+
+                offset = file->offset + file->sizeRepo;
+
+                // The error may have left the read anywhere inside the file so reopen the bundle after the file
+                if (fileResult.result == verifyOtherError)
+                {
+                    storageReadFree(read);
+                    read = offset < offsetEnd ? verifyBundleOpen(bundlePathName, offset, offsetEnd) : NULL;
+                }
             }
-            // If the size can be checked, do so
-            else if (fileSize != pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(read), SIZE_FILTER_TYPE)))
-                result = verifySizeInvalid;
+
+            lstAdd(result, &fileResult);
         }
-        else
-            result = verifyFileMissing;
+
+        if (read != NULL)
+            ioReadClose(storageReadIo(read));
     }
     MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_LOG_RETURN_STRUCT(result);
+    FUNCTION_LOG_RETURN(LIST, result);
 }
@@ -6,6 +6,7 @@ Verify File
 
 #include "common/compress/helper.h"
 #include "common/crypto/spec.h"
+#include "common/type/list.h"
 
 /***********************************************************************************************************************************
 File result
@@ -19,12 +20,40 @@ typedef enum
     verifyOtherError,
 } VerifyResult;
 
+/***********************************************************************************************************************************
+Bundled file to verify
+***********************************************************************************************************************************/
+typedef struct VerifyBundleFile
+{
+    const String *name;                                             // File name used to report the result
+    uint64_t offset;                                                // Offset of the file in the bundle
+    uint64_t sizeRepo;                                              // Size of the file in the bundle
+    bool checksumRepo;                                              // Is the checksum for the repo file (no decrypt/decompress)?
+    const Buffer *checksum;                                         // Checksum for the file
+    uint64_t size;                                                  // Size of file
+} VerifyBundleFile;
+
+/***********************************************************************************************************************************
+Result for a bundled file
+***********************************************************************************************************************************/
+typedef struct VerifyBundleResult
+{
+    VerifyResult result;                                            // Result of the verify
+    const String *error;                                            // Error when the result is verifyOtherError
+} VerifyBundleResult;
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 // Verify a file in the pgBackRest repository
 FN_EXTERN VerifyResult verifyFile(
-    const String *filePathName, uint64_t offset, const Variant *limit, CompressType compressType, const Buffer *fileChecksum,
-    uint64_t fileSize, const CipherSpec *cipherSpec);
+    const String *filePathName, CompressType compressType, const Buffer *fileChecksum, uint64_t fileSize,
+    const CipherSpec *cipherSpec);
+
+// Verify the files in a bundle with a single read of the bundle. Files must be sorted by offset and the result is a list of
+// VerifyBundleResult in the same order as the files. An error while verifying a file is returned as verifyOtherError for the file
+// and the bundle is reopened after the file so the remaining files are still verified.
+FN_EXTERN List *verifyBundle(
+    const String *bundlePathName, CompressType compressType, const CipherSpec *cipherSpec, const List *fileList);
 
 #endif
@@ -0,0 +1,588 @@
+/***********************************************************************************************************************************
+Verify Ledger
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include <string.h>
+#include <time.h>
+
+#include "command/verify/ledger.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/common.h"
+#include "common/crypto/hash.h"
+#include "common/debug.h"
+#include "common/encode.h"
+#include "common/io/io.h"
+#include "common/log.h"
+#include "common/type/hashMap.h"
+#include "common/type/json.h"
+#include "common/type/stringList.h"
+#include "config/config.h"
+#include "info/info.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+STRING_EXTERN(VERIFY_LEDGER_PATH_FILE_STR,                          VERIFY_LEDGER_PATH_FILE);
+
+#define VERIFY_LEDGER_SECTION_ARCHIVE                               "archive"
+#define VERIFY_LEDGER_SECTION_BACKUP                                "backup"
+
+#define VERIFY_LEDGER_KEY_CHECKSUM                                  "checksum"
+#define VERIFY_LEDGER_KEY_REPO_SIZE                                 "repo-size"
+#define VERIFY_LEDGER_KEY_REPO_TIME                                 "repo-time"
+#define VERIFY_LEDGER_KEY_SIZE                                      "size"
+#define VERIFY_LEDGER_KEY_TIME                                      "time"
+
+#define VERIFY_LEDGER_TYPE_TOTAL                                    (verifyLedgerTypeBackup + 1)
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct VerifyLedgerFile
+{
+    uint8_t checksum[HASH_TYPE_SHA1_SIZE];                          // Checksum the file was verified against
+    uint64_t size;                                                  // Size the file was verified against
+    uint64_t repoSize;                                              // Size of the repo file (or bundle) when verified
+    time_t repoTime;                                                // Modification time of the repo file (or bundle) when verified
+    time_t timeVerified;                                            // Time the file was verified
+    bool valid;                                                     // Was the file found to be valid?
+} VerifyLedgerFile;
+
+// Size and modification time of a file in the repo
+typedef struct VerifyLedgerRepoFile
+{
+    uint64_t size;                                                  // Size of the file
+    time_t timeModified;                                            // Modification time of the file
+} VerifyLedgerRepoFile;
+
+struct VerifyLedger
+{
+    VerifyLedgerPub pub;                                            // Publicly accessible variables
+    const CipherSpec *cipherSpec;                                   // Cipher spec to load and save the ledger
+    unsigned int sample;                                            // Percentage of files in the ledger to verify again
+    uint32_t sampleRandom;                                          // State of the generator used to select files for the sample
+    StringList *loadKeyList[VERIFY_LEDGER_TYPE_TOTAL];              // Keys of the files loaded from the ledger
+    HashMap *loadMap[VERIFY_LEDGER_TYPE_TOTAL];                     // Files loaded from the ledger
+    StringList *saveKeyList[VERIFY_LEDGER_TYPE_TOTAL];              // Keys of the files seen during this run
+    HashMap *saveMap[VERIFY_LEDGER_TYPE_TOTAL];                     // Files seen during this run
+    StringList *repoKeyList;                                        // Keys of the repo paths and files that have been listed
+    HashMap *repoPathMap;                                           // Repo paths that have been listed
+    HashMap *repoFileMap;                                           // Repo files found in the listed paths
+};
+
+/***********************************************************************************************************************************
+Add a file to a key list and map. The key is copied into the key list and the copy is used as the map key.
+***********************************************************************************************************************************/
+static void
+verifyLedgerFileAdd(StringList *const keyList, HashMap *const map, const String *const key, const VerifyLedgerFile *const file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, keyList);
+        FUNCTION_TEST_PARAM(HASH_MAP, map);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM_P(VOID, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(keyList != NULL);
+    ASSERT(map != NULL);
+    ASSERT(key != NULL);
+    ASSERT(file != NULL);
+
+    VerifyLedgerFile *const fileExisting = hashMapGet(map, key);
+
+    if (fileExisting == NULL)
+        hashMapAdd(map, strLstAdd(keyList, key), file);
+    else
+        *fileExisting = *file;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Load the ledger
+***********************************************************************************************************************************/
+static void
+verifyLedgerLoadCallback(void *const data, const String *const section, const String *const key, JsonRead *const json)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(JSON_READ, json);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(data != NULL);
+    ASSERT(section != NULL);
+    ASSERT(key != NULL);
+    ASSERT(json != NULL);
+
+    VerifyLedger *const this = data;
+    VerifyLedgerType type;
+
+    if (strEqZ(section, VERIFY_LEDGER_SECTION_ARCHIVE))
+        type = verifyLedgerTypeArchive;
+    else
+    {
+        CHECK_FMT(FormatError, strEqZ(section, VERIFY_LEDGER_SECTION_BACKUP), "invalid section '%s'", strZ(section));
+        type = verifyLedgerTypeBackup;
+    }
+
+    VerifyLedgerFile file = {.valid = true};
+
+    jsonReadObjectBegin(json);
+
+    const String *const checksum = jsonReadStr(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_CHECKSUM));
+    CHECK_FMT(FormatError, strSize(checksum) == HASH_TYPE_SHA1_SIZE_HEX, "invalid checksum for '%s'", strZ(key));
+    decodeToBin(encodingHex, strZ(checksum), file.checksum);
+
+    file.repoSize = jsonReadUInt64(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_REPO_SIZE));
+    file.repoTime = (time_t)jsonReadInt64(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_REPO_TIME));
+    file.size = jsonReadUInt64(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_SIZE));
+    file.timeVerified = (time_t)jsonReadInt64(jsonReadKeyRequireZ(json, VERIFY_LEDGER_KEY_TIME));
+
+    jsonReadObjectEnd(json);
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        verifyLedgerFileAdd(this->loadKeyList[type], this->loadMap[type], key, &file);
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN VerifyLedger *
+verifyLedgerNewLoad(const CipherSpec *const cipherSpec, const unsigned int sample)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(CIPHER_SPEC, cipherSpec);
+        FUNCTION_LOG_PARAM(UINT, sample);
+    FUNCTION_LOG_END();
+
+    ASSERT(cipherSpec != NULL);
+    ASSERT(sample <= 100);
+
+    OBJ_NEW_BEGIN(VerifyLedger, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (VerifyLedger)
+        {
+            .cipherSpec = cipherSpec,
+            .sample = sample,
+        };
+
+        for (unsigned int typeIdx = 0; typeIdx < VERIFY_LEDGER_TYPE_TOTAL; typeIdx++)
+        {
+            this->loadKeyList[typeIdx] = strLstNew();
+            this->loadMap[typeIdx] = hashMapNewP(sizeof(VerifyLedgerFile));
+            this->saveKeyList[typeIdx] = strLstNew();
+            this->saveMap[typeIdx] = hashMapNewP(sizeof(VerifyLedgerFile));
+        }
+
+        this->repoKeyList = strLstNew();
+        this->repoPathMap = hashMapNewP(0);
+        this->repoFileMap = hashMapNewP(sizeof(VerifyLedgerRepoFile));
+
+        // Seed the generator used to select the sample. The seed must not be zero or the generator will only return zero.
+        if (sample > 0)
+        {
+            cryptoRandomBytes((uint8_t *)&this->sampleRandom, sizeof(this->sampleRandom));
+            this->sampleRandom |= 1;
+        }
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            TRY_BEGIN()
+            {
+                // Stream the ledger rather than loading it into memory since it can be large
+                if (storageExistsP(storageRepo(), VERIFY_LEDGER_PATH_FILE_STR))
+                {
+                    IoRead *const read = storageReadIo(storageNewReadP(storageRepo(), VERIFY_LEDGER_PATH_FILE_STR));
+                    cipherBlockFilterGroupAdd(ioReadFilterGroup(read), cipherModeDecrypt, cipherSpec);
+
+                    infoNewLoad(read, cipherSpec, verifyLedgerLoadCallback, this);
+                }
+            }
+            CATCH_ANY()
+            {
+                LOG_WARN_FMT("unable to load verify ledger, all files will be verified: %s", errorMessage());
+
+                // Discard any files that were loaded before the error
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    for (unsigned int typeIdx = 0; typeIdx < VERIFY_LEDGER_TYPE_TOTAL; typeIdx++)
+                    {
+                        strLstFree(this->loadKeyList[typeIdx]);
+                        hashMapFree(this->loadMap[typeIdx]);
+
+                        this->loadKeyList[typeIdx] = strLstNew();
+                        this->loadMap[typeIdx] = hashMapNewP(sizeof(VerifyLedgerFile));
+                    }
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+            TRY_END();
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        LOG_DETAIL_FMT(
+            "verify ledger contains %u archive and %u backup file(s)", hashMapSize(this->loadMap[verifyLedgerTypeArchive]),
+            hashMapSize(this->loadMap[verifyLedgerTypeBackup]));
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(VERIFY_LEDGER, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN StringList *
+verifyLedgerRepoList(VerifyLedger *const this, const String *const path, const String *const expression)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING, expression);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+
+    StringList *const result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageIterator *const storageItr = storageNewItrP(
+            storageRepo(), path, .level = storageInfoLevelBasic, .expression = expression);
+
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            hashMapAdd(this->repoPathMap, strLstAdd(this->repoKeyList, path), NULL);
+        }
+        MEM_CONTEXT_OBJ_END();
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            while (storageItrMore(storageItr))
+            {
+                const StorageInfo info = storageItrNext(storageItr);
+
+                if (info.type == storageTypeFile)
+                {
+                    strLstAdd(result, info.name);
+
+                    const String *const file = strNewFmt("%s/%s", strZ(path), strZ(info.name));
+
+                    MEM_CONTEXT_OBJ_BEGIN(this)
+                    {
+                        hashMapAdd(
+                            this->repoFileMap, strLstAdd(this->repoKeyList, file),
+                            &(VerifyLedgerRepoFile){.size = info.size, .timeModified = info.timeModified});
+                    }
+                    MEM_CONTEXT_OBJ_END();
+                }
+
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
+/***********************************************************************************************************************************
+Get the size and modification time of a repo file. The path of the file is listed if it has not been listed already. A missing file
+has zero size and time so it will not match a file in the ledger.
+***********************************************************************************************************************************/
+static VerifyLedgerRepoFile
+verifyLedgerRepoFile(VerifyLedger *const this, const String *const repoFile)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(repoFile != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const path = strPath(repoFile);
+
+        if (!hashMapExists(this->repoPathMap, path))
+            verifyLedgerRepoList(this, path, NULL);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    VerifyLedgerRepoFile result = {0};
+    const VerifyLedgerRepoFile *const repoFileFound = hashMapGet(this->repoFileMap, repoFile);
+
+    if (repoFileFound != NULL)
+        result = *repoFileFound;
+
+    FUNCTION_TEST_RETURN_TYPE(VerifyLedgerRepoFile, result);
+}
+
+/***********************************************************************************************************************************
+Get the next number used to select files for the sample. A xorshift generator is good enough for sampling and avoids getting random
+bytes from the crypto library for every file in the ledger.
+***********************************************************************************************************************************/
+static uint32_t
+verifyLedgerSampleRandom(VerifyLedger *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->sampleRandom != 0);
+
+    this->sampleRandom ^= this->sampleRandom << 13;
+    this->sampleRandom ^= this->sampleRandom >> 17;
+    this->sampleRandom ^= this->sampleRandom << 5;
+
+    FUNCTION_TEST_RETURN(UINT32, this->sampleRandom);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+verifyLedgerSkip(
+    VerifyLedger *const this, const VerifyLedgerType type, const String *const key, const String *const repoFile,
+    const Buffer *const checksum, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(ENUM, type);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+        FUNCTION_TEST_PARAM(BUFFER, checksum);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(type < VERIFY_LEDGER_TYPE_TOTAL);
+    ASSERT(key != NULL);
+    ASSERT(repoFile != NULL);
+    ASSERT(checksum != NULL);
+    ASSERT(bufUsed(checksum) == HASH_TYPE_SHA1_SIZE);
+
+    bool result = false;
+    const VerifyLedgerRepoFile repoFileInfo = verifyLedgerRepoFile(this, repoFile);
+    const VerifyLedgerFile *const fileLoad = hashMapGet(this->loadMap[type], key);
+
+    // Skip the file if it was verified against the same checksum and size and the repo file has not been replaced since, unless it
+    // has been selected for the sample
+    if (fileLoad != NULL && fileLoad->size == size && memcmp(fileLoad->checksum, bufPtrConst(checksum), HASH_TYPE_SHA1_SIZE) == 0 &&
+        fileLoad->repoSize == repoFileInfo.size && fileLoad->repoTime == repoFileInfo.timeModified)
+    {
+        uint32_t random = 0;
+
+        if (this->sample > 0)
+            random = verifyLedgerSampleRandom(this);
+
+        result = random % 100 >= this->sample;
+    }
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        // Carry the file forward when skipped
+        if (result)
+        {
+            verifyLedgerFileAdd(this->saveKeyList[type], this->saveMap[type], key, fileLoad);
+            this->pub.skipTotal++;
+        }
+        // Else add the file so the result of verification can be recorded
+        else
+        {
+            VerifyLedgerFile file = {.size = size, .repoSize = repoFileInfo.size, .repoTime = repoFileInfo.timeModified};
+            memcpy(file.checksum, bufPtrConst(checksum), HASH_TYPE_SHA1_SIZE);
+
+            verifyLedgerFileAdd(this->saveKeyList[type], this->saveMap[type], key, &file);
+        }
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+verifyLedgerValid(VerifyLedger *const this, const VerifyLedgerType type, const String *const key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_TEST_PARAM(ENUM, type);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(type < VERIFY_LEDGER_TYPE_TOTAL);
+    ASSERT(key != NULL);
+
+    VerifyLedgerFile *const file = hashMapGet(this->saveMap[type], key);
+    ASSERT(file != NULL);
+
+    file->timeVerified = time(NULL);
+    file->valid = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Save the ledger
+***********************************************************************************************************************************/
+typedef struct VerifyLedgerSaveData
+{
+    const VerifyLedger *ledger;                                     // Ledger to save
+    bool prune;                                                     // Prune files not seen during this run?
+} VerifyLedgerSaveData;
+
+static void
+verifyLedgerSaveSection(
+    const VerifyLedgerSaveData *const saveData, InfoSave *const infoSaveData, const char *const section,
+    const VerifyLedgerType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, saveData);
+        FUNCTION_TEST_PARAM(INFO_SAVE, infoSaveData);
+        FUNCTION_TEST_PARAM(STRINGZ, section);
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(saveData != NULL);
+    ASSERT(infoSaveData != NULL);
+    ASSERT(section != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const VerifyLedger *const ledger = saveData->ledger;
+        StringList *const keyList = strLstDup(ledger->saveKeyList[type]);
+
+        // Add files that were loaded but not seen during this run
+        if (!saveData->prune)
+        {
+            for (unsigned int keyIdx = 0; keyIdx < strLstSize(ledger->loadKeyList[type]); keyIdx++)
+            {
+                const String *const key = strLstGet(ledger->loadKeyList[type], keyIdx);
+
+                if (!hashMapExists(ledger->saveMap[type], key))
+                    strLstAdd(keyList, key);
+            }
+        }
+
+        // Save files in key order
+        strLstSort(keyList, sortOrderAsc);
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+            {
+                const String *const key = strLstGet(keyList, keyIdx);
+                const VerifyLedgerFile *file = hashMapGet(ledger->saveMap[type], key);
+
+                if (file == NULL)
+                    file = hashMapGet(ledger->loadMap[type], key);
+
+                if (file->valid)
+                {
+                    JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP());
+
+                    jsonWriteStr(
+                        jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_CHECKSUM),
+                        strNewEncode(encodingHex, BUF(file->checksum, HASH_TYPE_SHA1_SIZE)));
+                    jsonWriteUInt64(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_REPO_SIZE), file->repoSize);
+                    jsonWriteInt64(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_REPO_TIME), file->repoTime);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_SIZE), file->size);
+                    jsonWriteInt64(jsonWriteKeyZ(json, VERIFY_LEDGER_KEY_TIME), file->timeVerified);
+
+                    infoSaveValue(infoSaveData, section, strZ(key), jsonWriteResult(jsonWriteObjectEnd(json)));
+                }
+
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+verifyLedgerSaveCallback(void *const data, const String *const sectionNext, InfoSave *const infoSaveData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, sectionNext);
+        FUNCTION_TEST_PARAM(INFO_SAVE, infoSaveData);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(data != NULL);
+    ASSERT(infoSaveData != NULL);
+
+    if (infoSaveSection(infoSaveData, VERIFY_LEDGER_SECTION_ARCHIVE, sectionNext))
+        verifyLedgerSaveSection(data, infoSaveData, VERIFY_LEDGER_SECTION_ARCHIVE, verifyLedgerTypeArchive);
+
+    if (infoSaveSection(infoSaveData, VERIFY_LEDGER_SECTION_BACKUP, sectionNext))
+        verifyLedgerSaveSection(data, infoSaveData, VERIFY_LEDGER_SECTION_BACKUP, verifyLedgerTypeBackup);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN void
+verifyLedgerSave(VerifyLedger *const this, const bool prune)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(VERIFY_LEDGER, this);
+        FUNCTION_LOG_PARAM(BOOL, prune);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Write the ledger to a file unique to this process and then move it into place so verify commands running at the same time
+        // do not write to the same file and a partial ledger is never written to the repository
+        const String *const fileTemp = strNewFmt(VERIFY_LEDGER_PATH_FILE ".%s.tmp", strZ(cfgOptionStr(cfgOptExecId)));
+
+        TRY_BEGIN()
+        {
+            // Stream the ledger rather than building it in memory since it can be large
+            IoWrite *const write = storageWriteIo(storageNewWriteP(storageRepoWrite(), fileTemp, .noAtomic = true));
+            cipherBlockFilterGroupAdd(ioWriteFilterGroup(write), cipherModeEncrypt, this->cipherSpec);
+
+            VerifyLedgerSaveData saveData = {.ledger = this, .prune = prune};
+            infoSave(infoNew(NULL), write, verifyLedgerSaveCallback, &saveData);
+
+            storageMoveP(
+                storageRepoWrite(), storageNewReadP(storageRepoWrite(), fileTemp),
+                storageNewWriteP(storageRepoWrite(), VERIFY_LEDGER_PATH_FILE_STR));
+        }
+        // The ledger only allows files to be skipped so an error saving it should not fail the verify
+        CATCH_ANY()
+        {
+            LOG_WARN_FMT("unable to save verify ledger: %s", errorMessage());
+            storageRemoveP(storageRepoWrite(), fileTemp);
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+verifyLedgerToLog(const VerifyLedger *const this, StringStatic *const debugLog)
+{
+    strStcFmt(
+        debugLog, "{archive: %u, backup: %u, skipTotal: %u}", hashMapSize(this->saveMap[verifyLedgerTypeArchive]),
+        hashMapSize(this->saveMap[verifyLedgerTypeBackup]), verifyLedgerSkipTotal(this));
+}
@@ -0,0 +1,92 @@
+/***********************************************************************************************************************************
+Verify Ledger
+
+The ledger records the repository files that verify found to be valid so later runs can skip them. A file is only skipped when the
+checksum and size it would be verified against match the ledger and the size and modification time of the repo file (or the bundle
+that contains it) match the repo listing, so a file that has been replaced is verified again even when the manifest is unchanged. A
+random sample of the files in the ledger is verified on every run to detect files that have been damaged since they were last
+verified.
+***********************************************************************************************************************************/
+#ifndef COMMAND_VERIFY_LEDGER_H
+#define COMMAND_VERIFY_LEDGER_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct VerifyLedger VerifyLedger;
+
+#include "common/crypto/spec.h"
+#include "common/type/buffer.h"
+#include "common/type/object.h"
+#include "common/type/string.h"
+#include "common/type/stringList.h"
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define VERIFY_LEDGER_FILE                                          "verify.ledger"
+#define VERIFY_LEDGER_PATH_FILE                                     STORAGE_REPO_BACKUP "/" VERIFY_LEDGER_FILE
+STRING_DECLARE(VERIFY_LEDGER_PATH_FILE_STR);
+
+/***********************************************************************************************************************************
+Type of file recorded in the ledger
+***********************************************************************************************************************************/
+typedef enum
+{
+    verifyLedgerTypeArchive,                                        // WAL segment keyed by archive id/path/file
+    verifyLedgerTypeBackup,                                         // Backup file keyed by label/name
+} VerifyLedgerType;
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// Load the ledger from the repository. A missing ledger is empty and a ledger that cannot be loaded is logged and ignored since the
+// only consequence is that all files will be verified. The sample is the percentage of files in the ledger to verify again.
+FN_EXTERN VerifyLedger *verifyLedgerNewLoad(const CipherSpec *cipherSpec, unsigned int sample);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+typedef struct VerifyLedgerPub
+{
+    unsigned int skipTotal;                                         // Total files skipped because they are in the ledger
+} VerifyLedgerPub;
+
+// Total files skipped because they are in the ledger
+FN_INLINE_ALWAYS unsigned int
+verifyLedgerSkipTotal(const VerifyLedger *const this)
+{
+    return THIS_PUB(VerifyLedger)->skipTotal;
+}
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// List files in a repo path. The size and modification time of each file are recorded for verifyLedgerSkip() so a path listed here
+// is not listed again. When an expression is used only matching files are recorded.
+FN_EXTERN StringList *verifyLedgerRepoList(VerifyLedger *this, const String *path, const String *expression);
+
+// Can verification of the file be skipped? The repo file is the file (or bundle) that will be read to verify the file. If the file
+// cannot be skipped it is added to the ledger so the result of verification can be recorded with verifyLedgerValid().
+FN_EXTERN bool verifyLedgerSkip(
+    VerifyLedger *this, VerifyLedgerType type, const String *key, const String *repoFile, const Buffer *checksum, uint64_t size);
+
+// Record that a file added by verifyLedgerSkip() is valid
+FN_EXTERN void verifyLedgerValid(VerifyLedger *this, VerifyLedgerType type, const String *key);
+
+// Save the valid files to the repository. When prune is false the files that were loaded but not seen during this run are also
+// saved, e.g. when only a single backup set was verified. An error saving the ledger is logged as a warning.
+FN_EXTERN void verifyLedgerSave(VerifyLedger *this, bool prune);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+FN_EXTERN void verifyLedgerToLog(const VerifyLedger *this, StringStatic *debugLog);
+
+#define FUNCTION_LOG_VERIFY_LEDGER_TYPE                                                                                            \
+    VerifyLedger *
+#define FUNCTION_LOG_VERIFY_LEDGER_FORMAT(value, buffer, bufferSize)                                                               \
+    FUNCTION_LOG_OBJECT_FORMAT(value, verifyLedgerToLog, buffer, bufferSize)
+
+#endif
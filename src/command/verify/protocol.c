@@ -29,15 +29,6 @@ verifyFileProtocol(PackRead *const param)
         // Verify file
         const String *const filePathName = pckReadStrP(param);
 
-        uint64_t offset = 0;
-        const Variant *limit = NULL;
-
-        if (pckReadBoolP(param))
-        {
-            offset = pckReadU64P(param);
-            limit = varNewUInt64(pckReadU64P(param));
-        }
-
         const CompressType compressType = (CompressType)pckReadU32P(param);
         const Buffer *const fileChecksum = pckReadBinP(param);
         const uint64_t fileSize = pckReadU64P(param);
@@ -46,7 +37,61 @@ verifyFileProtocol(PackRead *const param)
         // Return result
         pckWriteU32P(
             protocolServerResultData(result),
-            verifyFile(filePathName, offset, limit, compressType, fileChecksum, fileSize, cipherSpec));
+            verifyFile(filePathName, compressType, fileChecksum, fileSize, cipherSpec));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN ProtocolServerResult *
+verifyBundleProtocol(PackRead *const param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PACK_READ, param);
+    FUNCTION_LOG_END();
+
+    ASSERT(param != NULL);
+
+    ProtocolServerResult *const result = protocolServerResultNewP();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Verify bundle
+        const String *const bundlePathName = pckReadStrP(param);
+        const CompressType compressType = (CompressType)pckReadU32P(param);
+        const CipherSpec *const cipherSpec = cipherSpecNewPack(param);
+
+        // Build the file list
+        List *const fileList = lstNewP(sizeof(VerifyBundleFile));
+
+        while (!pckReadNullP(param))
+        {
+            VerifyBundleFile file = {.name = pckReadStrP(param)};
+            file.offset = pckReadU64P(param);
+            file.sizeRepo = pckReadU64P(param);
+            file.checksumRepo = pckReadBoolP(param);
+            file.checksum = pckReadBinP(param);
+            file.size = pckReadU64P(param);
+
+            lstAdd(fileList, &file);
+        }
+
+        const List *const resultList = verifyBundle(bundlePathName, compressType, cipherSpec, fileList);
+
+        // Return result
+        PackWrite *const data = protocolServerResultData(result);
+
+        for (unsigned int resultIdx = 0; resultIdx < lstSize(resultList); resultIdx++)
+        {
+            const VerifyBundleFile *const file = lstGet(fileList, resultIdx);
+            const VerifyBundleResult *const fileResult = lstGet(resultList, resultIdx);
+
+            pckWriteStrP(data, file->name);
+            pckWriteU32P(data, fileResult->result);
+            pckWriteStrP(data, fileResult->error);
+        }
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -12,13 +12,16 @@ Functions
 ***********************************************************************************************************************************/
 // Process protocol requests
 FN_EXTERN ProtocolServerResult *verifyFileProtocol(PackRead *param);
+FN_EXTERN ProtocolServerResult *verifyBundleProtocol(PackRead *param);
 
 /***********************************************************************************************************************************
 Protocol commands for ProtocolServerHandler arrays passed to protocolServerProcess()
 ***********************************************************************************************************************************/
 #define PROTOCOL_COMMAND_VERIFY_FILE                                STRID5("vf-f", 0x36cd60)
+#define PROTOCOL_COMMAND_VERIFY_BUNDLE                              STRID5("vf-b", 0x16cd60)
 
 #define PROTOCOL_SERVER_HANDLER_VERIFY_LIST                                                                                        \
-    {.command = PROTOCOL_COMMAND_VERIFY_FILE, .process = verifyFileProtocol},
+    {.command = PROTOCOL_COMMAND_VERIFY_FILE, .process = verifyFileProtocol},                                                      \
+    {.command = PROTOCOL_COMMAND_VERIFY_BUNDLE, .process = verifyBundleProtocol},
 
 #endif
@@ -12,6 +12,7 @@ Verify contents of the repository.
 #include "command/archive/common.h"
 #include "command/check/common.h"
 #include "command/verify/file.h"
+#include "command/verify/ledger.h"
 #include "command/verify/protocol.h"
 #include "command/verify/verify.h"
 #include "common/compress/helper.h"
@@ -110,6 +111,15 @@ typedef struct VerifyBackupResult
     List *invalidFileList;                                          // List of invalid files found in the backup
 } VerifyBackupResult;
 
+// Bundled file in a manifest to verify. Files are sorted by bundle and offset so each bundle can be verified with a single read.
+typedef struct VerifyBundleManifestFile
+{
+    const String *reference;                                        // Backup label where the bundle is stored
+    uint64_t bundleId;                                              // Bundle id
+    uint64_t bundleOffset;                                          // Offset of the file in the bundle
+    unsigned int manifestFileIdx;                                   // Index of the file within the manifest file list
+} VerifyBundleManifestFile;
+
 // Job data structure for processing and results collection
 typedef struct VerifyJobData
 {
@@ -120,6 +130,8 @@ typedef struct VerifyJobData
     StringList *backupList;                                         // List of backups to verify
     Manifest *manifest;                                             // Manifest contents with list of files to verify
     unsigned int manifestFileIdx;                                   // Index of the file within the manifest file list to process
+    List *bundleFileList;                                           // Bundled files in the manifest to verify
+    unsigned int bundleFileIdx;                                     // Index of the file within the bundle file list to process
     String *currentBackup;                                          // In progress backup, if any
     const InfoPg *pgHistory;                                        // Database history list
     bool backupProcessing;                                          // Are we processing WAL or are we processing backups
@@ -131,6 +143,7 @@ typedef struct VerifyJobData
     bool enableArchiveFilter;                                       // Only check archives in the specified range
     const String *archiveStart;                                     // Start of the WAL range to be verified
     const String *archiveStop;                                      // End of the WAL range to be verified
+    VerifyLedger *ledger;                                           // Ledger of verified files (NULL when not incremental)
 } VerifyJobData;
 
 /***********************************************************************************************************************************
@@ -782,10 +795,14 @@ verifyArchive(VerifyJobData *const jobData)
                         const String *const walFilePath = strNewFmt(
                             STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveResult->archiveId), strZ(walPath));
 
+                        // Get the list from the ledger when present so the size and time of the WAL files are recorded
                         MEM_CONTEXT_BEGIN(jobData->memContext)
                         {
                             jobData->walFileList = strLstSort(
-                                storageListP(storageRepo(), walFilePath, .expression = WAL_SEGMENT_FILE_REGEXP_STR), sortOrderAsc);
+                                jobData->ledger != NULL ?
+                                    verifyLedgerRepoList(jobData->ledger, walFilePath, WAL_SEGMENT_FILE_REGEXP_STR) :
+                                    storageListP(storageRepo(), walFilePath, .expression = WAL_SEGMENT_FILE_REGEXP_STR),
+                                sortOrderAsc);
                         }
                         MEM_CONTEXT_END();
 
@@ -857,24 +874,37 @@ verifyArchive(VerifyJobData *const jobData)
                         const Buffer *const checksum = bufNewDecode(
                             encodingHex, strSubN(fileName, WAL_SEGMENT_NAME_SIZE + 1, HASH_TYPE_SHA1_SIZE_HEX));
 
-                        // Set up the job
-                        PackWrite *const param = protocolPackNew();
+                        // Skip the WAL file if it has already been verified
+                        if (jobData->ledger != NULL &&
+                            verifyLedgerSkip(
+                                jobData->ledger, verifyLedgerTypeArchive,
+                                strNewFmt("%s/%s/%s", strZ(archiveResult->archiveId), strZ(walPath), strZ(fileName)),
+                                filePathName, checksum, archiveResult->pgWalInfo.size))
+                        {
+                            archiveResult->totalValidWal++;
+                        }
+                        // Else verify the WAL file
+                        else
+                        {
+                            // Set up the job
+                            PackWrite *const param = protocolPackNew();
 
-                        pckWriteStrP(param, filePathName);
-                        pckWriteBoolP(param, false);
-                        pckWriteU32P(param, compressTypeFromName(filePathName));
-                        pckWriteBinP(param, checksum);
-                        pckWriteU64P(param, archiveResult->pgWalInfo.size);
-                        cipherSpecPack(param, jobData->cipherSpecArchive);
+                            pckWriteStrP(param, filePathName);
+                            pckWriteU32P(param, compressTypeFromName(filePathName));
+                            pckWriteBinP(param, checksum);
+                            pckWriteU64P(param, archiveResult->pgWalInfo.size);
+                            cipherSpecPack(param, jobData->cipherSpecArchive);
 
-                        // Assign job to result, prepending the archiveId to the key for consistency with backup processing
-                        const String *const jobKey = strNewFmt("%s/%s", strZ(archiveResult->archiveId), strZ(filePathName));
+                            // Assign job to result, prepending the archiveId to the key for consistency with backup processing
+                            const String *const jobKey = strNewFmt(
+                                "%s/%s", strZ(archiveResult->archiveId), strZ(filePathName));
 
-                        MEM_CONTEXT_PRIOR_BEGIN()
-                        {
-                            result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                            MEM_CONTEXT_PRIOR_BEGIN()
+                            {
+                                result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                            }
+                            MEM_CONTEXT_PRIOR_END();
                         }
-                        MEM_CONTEXT_PRIOR_END();
 
                         // Remove the file to process from the list
                         strLstRemoveIdx(jobData->walFileList, 0);
@@ -919,6 +949,155 @@ verifyArchive(VerifyJobData *const jobData)
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
+/***********************************************************************************************************************************
+Comparator to sort bundled files by bundle and offset
+***********************************************************************************************************************************/
+static int
+verifyBundleManifestFileComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const VerifyBundleManifestFile *const file1 = item1;
+    const VerifyBundleManifestFile *const file2 = item2;
+
+    // If the reference differs that is enough to determine order
+    const int result = strCmp(file1->reference, file2->reference);
+
+    if (result != 0)
+        FUNCTION_TEST_RETURN(INT, result);
+
+    // If the bundle id differs that is enough to determine order
+    if (file1->bundleId < file2->bundleId)
+        FUNCTION_TEST_RETURN(INT, -1);
+    else if (file1->bundleId > file2->bundleId)
+        FUNCTION_TEST_RETURN(INT, 1);
+
+    // Else order by offset (offsets must be unique within a bundle)
+    ASSERT(file1->bundleOffset != file2->bundleOffset);
+    FUNCTION_TEST_RETURN(INT, file1->bundleOffset < file2->bundleOffset ? -1 : 1);
+}
+
+/***********************************************************************************************************************************
+Get the label of the backup where a file must be verified. NULL is returned when the file was already verified in the prior backup
+it references, in which case the result of that verification is added to this backup's result.
+***********************************************************************************************************************************/
+static const String *
+verifyBackupFileLabel(
+    const VerifyJobData *const jobData, VerifyBackupResult *const backupResult, const ManifestFile *const fileData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, backupResult);
+        FUNCTION_TEST_PARAM_P(VOID, fileData);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(backupResult != NULL);
+    ASSERT(fileData != NULL);
+
+    // Check if the file is referenced in a prior backup
+    const String *result = NULL;
+
+    if (fileData->reference != NULL)
+    {
+        // If the prior backup is not in the result list, then that backup was never processed (likely due to the --set option) so
+        // verify the file
+        const unsigned int backupPriorIdx = lstFindIdx(jobData->backupResultList, &fileData->reference);
+
+        if (backupPriorIdx == LIST_NOT_FOUND)
+        {
+            result = fileData->reference;
+        }
+        // Else the backup this file references has a result so check the processing state for the referenced backup
+        else
+        {
+            const VerifyBackupResult *const backupResultPrior = lstGet(jobData->backupResultList, backupPriorIdx);
+
+            // If the verify-state of the backup is not complete then verify the file
+            if (!backupResultPrior->fileVerifyComplete)
+            {
+                result = fileData->reference;
+            }
+            // Else skip verification
+            else
+            {
+                const String *const priorFile = strNewFmt(
+                    "%s/%s%s", strZ(fileData->reference), strZ(fileData->name),
+                    fileData->bundleId != 0 ?
+                        "" : strZ(compressExtStr((manifestData(jobData->manifest))->backupOptionCompressType)));
+                const unsigned int backupPriorInvalidIdx = lstFindIdx(backupResultPrior->invalidFileList, &priorFile);
+
+                // If the file is in the invalid file list of the prior backup where it is referenced then add the file as invalid
+                // to this backup result and set the backup result status; since already logged an error on this file, don't log
+                // again
+                if (backupPriorInvalidIdx != LIST_NOT_FOUND)
+                {
+                    const VerifyInvalidFile *const invalidFile = lstGet(backupResultPrior->invalidFileList, backupPriorInvalidIdx);
+
+                    verifyInvalidFileAdd(backupResult->invalidFileList, invalidFile->reason, invalidFile->fileName);
+                    backupResult->status = backupInvalid;
+                }
+                // Else file in prior backup was valid so increment total valid files for this backup
+                else
+                    backupResult->totalFileValid++;
+            }
+        }
+    }
+    // Else file is not referenced in a prior backup
+    else
+        result = backupResult->backupLabel;
+
+    FUNCTION_TEST_RETURN_CONST(STRING, result);
+}
+
+/***********************************************************************************************************************************
+Skip a backup file that has already been verified. The file is counted as valid when skipped. The repo file is the file (or bundle)
+that will be read to verify the file.
+***********************************************************************************************************************************/
+static bool
+verifyBackupFileSkip(
+    const VerifyJobData *const jobData, VerifyBackupResult *const backupResult, const String *const fileName,
+    const String *const repoFile, const ManifestFile *const fileData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, backupResult);
+        FUNCTION_TEST_PARAM(STRING, fileName);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+        FUNCTION_TEST_PARAM_P(VOID, fileData);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(backupResult != NULL);
+    ASSERT(fileName != NULL);
+    ASSERT(repoFile != NULL);
+    ASSERT(fileData != NULL);
+
+    bool result = false;
+
+    if (jobData->ledger != NULL)
+    {
+        // Use the same checksum and size the file will be verified against
+        const bool checksumRepo = fileData->checksumRepoSha1 != NULL;
+
+        result = verifyLedgerSkip(
+            jobData->ledger, verifyLedgerTypeBackup, fileName, repoFile,
+            BUF(checksumRepo ? fileData->checksumRepoSha1 : fileData->checksumSha1, HASH_TYPE_SHA1_SIZE),
+            checksumRepo ? fileData->sizeRepo : fileData->size);
+
+        if (result)
+            backupResult->totalFileValid++;
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Verify the job data backups
 ***********************************************************************************************************************************/
@@ -983,6 +1162,14 @@ verifyBackup(VerifyJobData *const jobData)
                     // Move the manifest to the jobData for processing
                     jobData->manifest = manifestMove(manifest, jobData->memContext);
                     jobData->manifestFileIdx = 0;
+                    jobData->bundleFileIdx = 0;
+
+                    MEM_CONTEXT_BEGIN(jobData->memContext)
+                    {
+                        jobData->bundleFileList = lstNewP(
+                            sizeof(VerifyBundleManifestFile), .comparator = verifyBundleManifestFileComparator);
+                    }
+                    MEM_CONTEXT_END();
 
                     const ManifestData *const manData = manifestData(jobData->manifest);
 
@@ -1002,138 +1189,196 @@ verifyBackup(VerifyJobData *const jobData)
             VerifyBackupResult *const backupResult = lstGetLast(jobData->backupResultList);
 
             // Process any files in the manifest
-            if (jobData->manifestFileIdx < manifestFileTotal(jobData->manifest))
+            if (backupResult->totalFileManifest != 0)
             {
                 do
                 {
-                    const ManifestFile fileData = manifestFile(jobData->manifest, jobData->manifestFileIdx);
-
-                    // Track the files verified in order to determine when the processing of the backup is complete
-                    backupResult->totalFileVerify++;
-
-                    // Check the file if it is not zero-length or not bundled
-                    if (fileData.size != 0 || !manifestData(jobData->manifest)->bundle)
+                    // Process files in manifest order
+                    if (jobData->manifestFileIdx < backupResult->totalFileManifest)
                     {
-                        // Check if the file is referenced in a prior backup
-                        const String *fileBackupLabel = NULL;
+                        const ManifestFile fileData = manifestFile(jobData->manifest, jobData->manifestFileIdx);
 
-                        if (fileData.reference != NULL)
+                        // Mark the zero-length file as valid if it is bundled since it is not stored in the repo
+                        if (fileData.size == 0 && manifestData(jobData->manifest)->bundle)
                         {
-                            // If the prior backup is not in the result list, then that backup was never processed (likely due to
-                            // the --set option) so verify the file
-                            const unsigned int backupPriorIdx = lstFindIdx(jobData->backupResultList, &fileData.reference);
-
-                            if (backupPriorIdx == LIST_NOT_FOUND)
-                            {
-                                fileBackupLabel = fileData.reference;
-                            }
-                            // Else the backup this file references has a result so check the processing state for the referenced
-                            // backup
-                            else
+                            backupResult->totalFileVerify++;
+                            backupResult->totalFileValid++;
+                        }
+                        // Else collect bundled files so each bundle can be verified with a single read once the manifest has been
+                        // processed. Files in a bundle are generally not adjacent in the manifest since it is sorted by name.
+                        else if (fileData.bundleId != 0)
+                        {
+                            const VerifyBundleManifestFile bundleFile =
                             {
-                                const VerifyBackupResult *const backupResultPrior = lstGet(
-                                    jobData->backupResultList, backupPriorIdx);
+                                .reference = fileData.reference != NULL ? fileData.reference : backupResult->backupLabel,
+                                .bundleId = fileData.bundleId,
+                                .bundleOffset = fileData.bundleOffset,
+                                .manifestFileIdx = jobData->manifestFileIdx,
+                            };
 
-                                // If the verify-state of the backup is not complete then verify the file
-                                if (!backupResultPrior->fileVerifyComplete)
-                                {
-                                    fileBackupLabel = fileData.reference;
-                                }
-                                // Else skip verification
-                                else
+                            lstAdd(jobData->bundleFileList, &bundleFile);
+                        }
+                        // Else verify the file
+                        else
+                        {
+                            // Track the files verified in order to determine when the processing of the backup is complete
+                            backupResult->totalFileVerify++;
+
+                            // If backup label is not null then send it off for processing
+                            const String *const fileBackupLabel = verifyBackupFileLabel(jobData, backupResult, &fileData);
+
+                            if (fileBackupLabel != NULL)
+                            {
+                                const String *const filePathName = backupFileRepoPathP(
+                                    fileBackupLabel, .manifestName = fileData.name,
+                                    .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
+                                    .blockIncr = fileData.blockIncrMapSize != 0,
+                                    .dedupChecksum = fileData.dedup ? fileData.checksumSha1 : NULL);
+
+                                // Skip the file if it has already been verified. The name excludes the repo backup path to match
+                                // the name reported in the result. Files in the dedup store are reported relative to the repo.
+                                const String *const fileName =
+                                    fileData.dedup ? filePathName : strSub(filePathName, sizeof(STORAGE_REPO_BACKUP));
+
+                                if (!verifyBackupFileSkip(jobData, backupResult, fileName, filePathName, &fileData))
                                 {
-                                    const String *const priorFile = strNewFmt(
-                                        "%s/%s%s", strZ(fileData.reference), strZ(fileData.name),
-                                        strZ(compressExtStr((manifestData(jobData->manifest))->backupOptionCompressType)));
-                                    const unsigned int backupPriorInvalidIdx = lstFindIdx(
-                                        backupResultPrior->invalidFileList, &priorFile);
-
-                                    // If the file is in the invalid file list of the prior backup where it is referenced then add
-                                    // the file as invalid to this backup result and set the backup result status; since already
-                                    // logged an error on this file, don't log again
-                                    if (backupPriorInvalidIdx != LIST_NOT_FOUND)
+                                    // Set up the job
+                                    PackWrite *const param = protocolPackNew();
+
+                                    pckWriteStrP(param, filePathName);
+
+                                    // Use the repo checksum when present
+                                    if (fileData.checksumRepoSha1 != NULL)
                                     {
-                                        VerifyInvalidFile *invalidFile = lstGet(
-                                            backupResultPrior->invalidFileList, backupPriorInvalidIdx);
-                                        verifyInvalidFileAdd(
-                                            backupResult->invalidFileList, invalidFile->reason, invalidFile->fileName);
-                                        backupResult->status = backupInvalid;
+                                        pckWriteU32P(param, compressTypeNone);
+                                        pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
+                                        pckWriteU64P(param, fileData.sizeRepo);
+                                        cipherSpecPack(param, cipherSpecNewNone());
                                     }
-                                    // Else file in prior backup was valid so increment total valid files for this backup
+                                    // Else use the file checksum, which may require additional filters, e.g. decompression
                                     else
                                     {
-                                        backupResult->totalFileValid++;
+                                        pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
+                                        pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
+                                        pckWriteU64P(param, fileData.size);
+                                        cipherSpecPack(param, manifestCipherSpec(jobData->manifest));
                                     }
+
+                                    // Assign job to result (prepend backup label being processed to the key since some files are
+                                    // in a prior backup)
+                                    const String *const jobKey = strNewFmt(
+                                        "%s/" STORAGE_REPO_BACKUP "/%s", strZ(backupResult->backupLabel), strZ(fileName));
+
+                                    MEM_CONTEXT_PRIOR_BEGIN()
+                                    {
+                                        result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                                    }
+                                    MEM_CONTEXT_PRIOR_END();
                                 }
                             }
                         }
-                        // Else file is not referenced in a prior backup
-                        else
-                            fileBackupLabel = backupResult->backupLabel;
 
-                        // If backup label is not null then send it off for processing
-                        if (fileBackupLabel != NULL)
-                        {
-                            // Set up the job
-                            PackWrite *const param = protocolPackNew();
+                        // Increment the index to point to the next file
+                        jobData->manifestFileIdx++;
 
-                            const String *const filePathName = backupFileRepoPathP(
-                                fileBackupLabel, .manifestName = fileData.name, .bundleId = fileData.bundleId,
-                                .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
-                                .blockIncr = fileData.blockIncrMapSize != 0);
+                        // Sort the bundled files by bundle and offset once all the files in the manifest have been processed
+                        if (jobData->manifestFileIdx == backupResult->totalFileManifest)
+                            lstSort(jobData->bundleFileList, sortOrderAsc);
+                    }
+                    // Else verify the next bundle
+                    else
+                    {
+                        const VerifyBundleManifestFile bundleFirst = *(VerifyBundleManifestFile *)lstGet(
+                            jobData->bundleFileList, jobData->bundleFileIdx);
+                        unsigned int bundleFileTotal = 0;
 
-                            pckWriteStrP(param, filePathName);
+                        // Set up the job
+                        PackWrite *const param = protocolPackNew();
+
+                        const String *const bundlePathName = backupFileRepoPathP(
+                            bundleFirst.reference, .bundleId = bundleFirst.bundleId);
+
+                        pckWriteStrP(param, bundlePathName);
+                        pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
+                        cipherSpecPack(param, manifestCipherSpec(jobData->manifest));
+
+                        // Add the files in the bundle
+                        do
+                        {
+                            const VerifyBundleManifestFile *const bundleFile = lstGet(
+                                jobData->bundleFileList, jobData->bundleFileIdx);
 
-                            if (fileData.bundleId != 0)
+                            if (bundleFile->bundleId != bundleFirst.bundleId ||
+                                !strEq(bundleFile->reference, bundleFirst.reference))
                             {
-                                pckWriteBoolP(param, true);
-                                pckWriteU64P(param, fileData.bundleOffset);
-                                pckWriteU64P(param, fileData.sizeRepo);
+                                break;
                             }
-                            else
-                                pckWriteBoolP(param, false);
 
-                            // Use the repo checksum when present
-                            if (fileData.checksumRepoSha1 != NULL)
+                            const ManifestFile fileData = manifestFile(jobData->manifest, bundleFile->manifestFileIdx);
+
+                            // Track the files verified in order to determine when the processing of the backup is complete
+                            backupResult->totalFileVerify++;
+
+                            // Get the label of the backup where the file must be verified, if any
+                            const String *const bundleBackupLabel = verifyBackupFileLabel(jobData, backupResult, &fileData);
+                            const String *const fileName =
+                                bundleBackupLabel != NULL ? strNewFmt("%s/%s", strZ(bundleBackupLabel), strZ(fileData.name)) : NULL;
+
+                            // Add the file unless it has already been verified
+                            if (fileName != NULL &&
+                                !verifyBackupFileSkip(jobData, backupResult, fileName, bundlePathName, &fileData))
                             {
-                                pckWriteU32P(param, compressTypeNone);
-                                pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
+                                pckWriteStrP(param, fileName);
+                                pckWriteU64P(param, fileData.bundleOffset);
                                 pckWriteU64P(param, fileData.sizeRepo);
-                                cipherSpecPack(param, cipherSpecNewNone());
-                            }
-                            // Else use the file checksum, which may require additional filters, e.g. decompression
-                            else
-                            {
-                                pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
-                                pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
-                                pckWriteU64P(param, fileData.size);
-                                cipherSpecPack(param, manifestCipherSpec(jobData->manifest));
+
+                                // Use the repo checksum when present
+                                if (fileData.checksumRepoSha1 != NULL)
+                                {
+                                    pckWriteBoolP(param, true);
+                                    pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
+                                    pckWriteU64P(param, fileData.sizeRepo);
+                                }
+                                // Else use the file checksum, which may require additional filters, e.g. decompression
+                                else
+                                {
+                                    pckWriteBoolP(param, false);
+                                    pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
+                                    pckWriteU64P(param, fileData.size);
+                                }
+
+                                bundleFileTotal++;
                             }
 
-                            // Assign job to result (prepend backup label being processed to the key since some files are in a prior
-                            // backup)
-                            const String *const jobKey = strNewFmt("%s/%s", strZ(backupResult->backupLabel), strZ(filePathName));
+                            jobData->bundleFileIdx++;
+                        }
+                        while (jobData->bundleFileIdx < lstSize(jobData->bundleFileList));
+
+                        // If there are files to verify then send the bundle off for processing
+                        if (bundleFileTotal > 0)
+                        {
+                            // Assign job to result (prepend backup label being processed to the key since some bundles are in a
+                            // prior backup)
+                            const String *const jobKey = strNewFmt(
+                                "%s/%s", strZ(backupResult->backupLabel), strZ(bundlePathName));
 
                             MEM_CONTEXT_PRIOR_BEGIN()
                             {
-                                result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_FILE, param);
+                                result = protocolParallelJobNew(VARSTR(jobKey), PROTOCOL_COMMAND_VERIFY_BUNDLE, param);
                             }
                             MEM_CONTEXT_PRIOR_END();
                         }
                     }
-                    // Else mark the zero-length file as valid
-                    else
-                        backupResult->totalFileValid++;
-
-                    // Increment the index to point to the next file
-                    jobData->manifestFileIdx++;
 
                     // If this was the last file to process for this backup, then free the manifest and remove this backup from the
                     // processing list
-                    if (jobData->manifestFileIdx == backupResult->totalFileManifest)
+                    if (jobData->manifestFileIdx == backupResult->totalFileManifest &&
+                        jobData->bundleFileIdx == lstSize(jobData->bundleFileList))
                     {
                         manifestFree(jobData->manifest);
                         jobData->manifest = NULL;
+                        lstFree(jobData->bundleFileList);
+                        jobData->bundleFileList = NULL;
                         strLstRemoveIdx(jobData->backupList, 0);
                     }
 
@@ -1141,7 +1386,7 @@ verifyBackup(VerifyJobData *const jobData)
                     if (result != NULL)
                         break;
                 }
-                while (jobData->manifestFileIdx < backupResult->totalFileManifest);
+                while (jobData->manifest != NULL);
             }
             else
             {
@@ -1153,6 +1398,8 @@ verifyBackup(VerifyJobData *const jobData)
 
                 manifestFree(jobData->manifest);
                 jobData->manifest = NULL;
+                lstFree(jobData->bundleFileList);
+                jobData->bundleFileList = NULL;
 
                 backupResult->status = backupInvalid;
 
@@ -1262,6 +1509,44 @@ verifyLogInvalidResult(
     FUNCTION_TEST_RETURN(UINT, 1);
 }
 
+/***********************************************************************************************************************************
+Helper function to update the backup result for a file and return an error count
+***********************************************************************************************************************************/
+static unsigned int
+verifyBackupFileResult(
+    VerifyBackupResult *const backupResult, VerifyLedger *const ledger, const VerifyResult verifyResult,
+    const unsigned int processId, const String *const filePathName)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, backupResult);                  // Backup result to update
+        FUNCTION_TEST_PARAM(VERIFY_LEDGER, ledger);                 // Ledger to record valid files in, if any
+        FUNCTION_TEST_PARAM(ENUM, verifyResult);                    // Result code from the verifyFile()/verifyBundle() function
+        FUNCTION_TEST_PARAM(UINT, processId);                       // Process Id reporting the result
+        FUNCTION_TEST_PARAM(STRING, filePathName);                  // File for which results are being reported
+    FUNCTION_TEST_END();
+
+    ASSERT(backupResult != NULL);
+    ASSERT(filePathName != NULL);
+
+    unsigned int result = 0;
+
+    if (verifyResult == verifyOk)
+    {
+        backupResult->totalFileValid++;
+
+        if (ledger != NULL)
+            verifyLedgerValid(ledger, verifyLedgerTypeBackup, filePathName);
+    }
+    else
+    {
+        result = verifyLogInvalidResult(STORAGE_REPO_BACKUP_STR, verifyResult, processId, filePathName);
+        backupResult->status = backupInvalid;
+        verifyInvalidFileAdd(backupResult->invalidFileList, verifyResult, filePathName);
+    }
+
+    FUNCTION_TEST_RETURN(UINT, result);
+}
+
 /***********************************************************************************************************************************
 Helper function to set the currently processing backup label, if any, and check that the archiveIds are in the db history
 ***********************************************************************************************************************************/
@@ -1723,6 +2008,10 @@ verifyProcess(const bool verboseText)
                 jobData.currentBackup = verifySetBackupCheckArchive(
                     jobData.backupList, backupInfo, jobData.archiveIdList, jobData.pgHistory, &jobData.jobErrorTotal);
 
+                // Load the ledger of verified files when verify is incremental
+                if (cfgOptionBool(cfgOptVerifyIncremental))
+                    jobData.ledger = verifyLedgerNewLoad(cfgCipherSpecMain(), cfgOptionUInt(cfgOptVerifySample));
+
                 // Create the parallel executor
                 ProtocolParallel *const parallelExec = protocolParallelNew(
                     cfgOptionUInt64(cfgOptProtocolTimeout) / 2, verifyJobCallback, &jobData);
@@ -1777,13 +2066,20 @@ verifyProcess(const bool verboseText)
                             // The job was successful
                             if (protocolParallelJobErrorCode(job) == 0)
                             {
-                                const VerifyResult verifyResult = (VerifyResult)pckReadU32P(protocolParallelJobResult(job));
+                                PackRead *const jobResult = protocolParallelJobResult(job);
 
                                 // Update the result set for the type of file being processed
                                 if (strEq(fileType, STORAGE_REPO_ARCHIVE_STR))
                                 {
+                                    const VerifyResult verifyResult = (VerifyResult)pckReadU32P(jobResult);
+
                                     if (verifyResult == verifyOk)
+                                    {
                                         archiveIdResult->totalValidWal++;
+
+                                        if (jobData.ledger != NULL)
+                                            verifyLedgerValid(jobData.ledger, verifyLedgerTypeArchive, filePathName);
+                                    }
                                     else
                                     {
                                         jobData.jobErrorTotal += verifyLogInvalidResult(
@@ -1796,18 +2092,39 @@ verifyProcess(const bool verboseText)
                                                 strLstGet(filePathLst, strLstSize(filePathLst) - 1), 0, WAL_SEGMENT_NAME_SIZE));
                                     }
                                 }
-                                else
+                                // Else a bundle returns a result for each file in the bundle
+                                else if (protocolParallelJobCommand(job) == PROTOCOL_COMMAND_VERIFY_BUNDLE)
                                 {
-                                    if (verifyResult == verifyOk)
-                                        backupResult->totalFileValid++;
-                                    else
+                                    while (!pckReadNullP(jobResult))
                                     {
-                                        jobData.jobErrorTotal += verifyLogInvalidResult(
-                                            fileType, verifyResult, processId, filePathName);
-                                        backupResult->status = backupInvalid;
-                                        verifyInvalidFileAdd(backupResult->invalidFileList, verifyResult, filePathName);
+                                        const String *const fileName = pckReadStrP(jobResult);
+                                        const VerifyResult verifyResult = (VerifyResult)pckReadU32P(jobResult);
+                                        const String *const error = pckReadStrP(jobResult);
+
+                                        // An error while verifying the file is reported like a job error but only for the file
+                                        if (verifyResult == verifyOtherError)
+                                        {
+                                            LOG_INFO_PID_FMT(
+                                                processId, "%s %s: %s", verifyErrorMsg(verifyOtherError), strZ(fileName),
+                                                strZ(error));
+
+                                            jobData.jobErrorTotal++;
+                                            backupResult->status = backupInvalid;
+                                            verifyInvalidFileAdd(backupResult->invalidFileList, verifyOtherError, fileName);
+                                        }
+                                        else
+                                        {
+                                            jobData.jobErrorTotal += verifyBackupFileResult(
+                                                backupResult, jobData.ledger, verifyResult, processId, fileName);
+                                        }
                                     }
                                 }
+                                else
+                                {
+                                    jobData.jobErrorTotal += verifyBackupFileResult(
+                                        backupResult, jobData.ledger, (VerifyResult)pckReadU32P(jobResult), processId,
+                                        filePathName);
+                                }
                             }
                             // Else the job errored
                             else
@@ -1853,6 +2170,13 @@ verifyProcess(const bool verboseText)
                 }
                 MEM_CONTEXT_TEMP_END();
 
+                // Save the ledger. Files not seen are pruned unless only a single backup set was verified.
+                if (jobData.ledger != NULL)
+                {
+                    verifyLedgerSave(jobData.ledger, backupLabel == NULL);
+                    LOG_DETAIL_FMT("skipped %u file(s) found in the verify ledger", verifyLedgerSkipTotal(jobData.ledger));
+                }
+
                 // ??? Need to do the final reconciliation - checking backup required WAL against, valid WAL
 
                 // Report results
@@ -86,8 +86,8 @@ static const struct CompressHelperLocal
         .type = STRDEF(ZST_EXT),
         .ext = STRDEF("." ZST_EXT),
 #ifdef HAVE_LIBZST
+        // Compression filter is created directly with zstCompressNewP() since it has advanced parameters
         .compressType = ZST_COMPRESS_FILTER_TYPE,
-        .compressNew = zstCompressNew,
         .decompressType = ZST_DECOMPRESS_FILTER_TYPE,
         .decompressNew = zstDecompressNew,
 #endif
@@ -100,6 +100,29 @@ static const struct CompressHelperLocal
     },
 };
 
+#ifdef HAVE_LIBZST
+
+/***********************************************************************************************************************************
+Advanced parameters by the size of the data to compress, used only when worker threads are enabled with compress-thread so output
+and memory usage are unchanged by default. The map is searched in order and the first entry where the size >= map size is used. The
+window is kept at or below the size every zst decompressor accepts by default (the decompressor needs memory equal to the window, so
+up to 32MiB per file) and is smaller for smaller files to limit memory usage since many files may be compressed in parallel. Only
+the largest files are split into jobs for worker threads since each job is at least several windows in size.
+***********************************************************************************************************************************/
+static const struct CompressSizeMap
+{
+    uint64_t size;                                                  // Min size of data to compress
+    unsigned int windowLog;                                         // Window size as a power of two
+    bool longDistance;                                              // Enable long distance matching
+    bool thread;                                                    // Compress with worker threads
+} compressSizeMap[] =
+{
+    {.size = 256 * 1024 * 1024, .windowLog = 25, .longDistance = true, .thread = true},
+    {.size = 64 * 1024 * 1024, .windowLog = 24, .longDistance = true},
+};
+
+#endif // HAVE_LIBZST
+
 /**********************************************************************************************************************************/
 FN_EXTERN CompressType
 compressTypeEnum(const StringId type)
@@ -134,7 +157,7 @@ compressTypePresent(const CompressType type)
 
     ASSERT(type < LENGTH_OF(compressHelperLocal));
 
-    if (type != compressTypeNone && compressHelperLocal[type].compressNew == NULL)
+    if (type != compressTypeNone && compressHelperLocal[type].compressType == 0)
         THROW_FMT(OptionInvalidValueError, PROJECT_NAME " not built with %s support", strZ(compressHelperLocal[type].type));
 
     FUNCTION_TEST_RETURN_VOID();
@@ -183,13 +206,44 @@ compressFilter(const CompressType type, const int level, const CompressFilterPar
         FUNCTION_TEST_PARAM(ENUM, type);
         FUNCTION_TEST_PARAM(INT, level);
         FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT64, param.size);
+        FUNCTION_TEST_PARAM(UINT, param.threadMax);
     FUNCTION_TEST_END();
 
     ASSERT(type < LENGTH_OF(compressHelperLocal));
     ASSERT(type != compressTypeNone);
     compressTypePresent(type);
 
-    FUNCTION_TEST_RETURN(IO_FILTER, compressHelperLocal[type].compressNew(level, param.raw));
+    IoFilter *result;
+
+#ifdef HAVE_LIBZST
+    // Zst is the only type with advanced parameters, which are selected by size when worker threads are enabled
+    if (type == compressTypeZst)
+    {
+        unsigned int sizeIdx = param.threadMax > 0 ? 0 : LENGTH_OF(compressSizeMap);
+
+        for (; sizeIdx < LENGTH_OF(compressSizeMap); sizeIdx++)
+        {
+            if (param.size >= compressSizeMap[sizeIdx].size)
+                break;
+        }
+
+        if (sizeIdx < LENGTH_OF(compressSizeMap))
+        {
+            const struct CompressSizeMap *const sizeMap = &compressSizeMap[sizeIdx];
+
+            result = zstCompressNewP(
+                level, param.raw, .thread = sizeMap->thread ? param.threadMax : 0, .windowLog = sizeMap->windowLog,
+                .longDistance = sizeMap->longDistance);
+        }
+        else
+            result = zstCompressNewP(level, param.raw);
+    }
+    else
+#endif // HAVE_LIBZST
+        result = compressHelperLocal[type].compressNew(level, param.raw);
+
+    FUNCTION_TEST_RETURN(IO_FILTER, result);
 }
 
 /**********************************************************************************************************************************/
@@ -219,7 +273,22 @@ compressFilterPack(const StringId filterType, const Pack *const filterParam)
                 const int level = pckReadI32P(paramRead);
                 const bool raw = pckReadBoolP(paramRead);
 
-                result = ioFilterMove(compress->compressNew(level, raw), memContextPrior());
+#ifdef HAVE_LIBZST
+                // Zst advanced parameters were selected when the filter was created so pass them as is
+                if (compressIdx == compressTypeZst)
+                {
+                    const unsigned int thread = pckReadU32P(paramRead);
+                    const unsigned int windowLog = pckReadU32P(paramRead);
+                    const bool longDistance = pckReadBoolP(paramRead);
+
+                    result = ioFilterMove(
+                        zstCompressNewP(level, raw, .thread = thread, .windowLog = windowLog, .longDistance = longDistance),
+                        memContextPrior());
+                }
+                else
+#endif // HAVE_LIBZST
+                    result = ioFilterMove(compress->compressNew(level, raw), memContextPrior());
+
                 break;
             }
             else if (filterType == compress->decompressType)
@@ -8,6 +8,7 @@ type. All compress calls should use this module rather than the individual filte
 #define COMMON_COMPRESS_HELPER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /***********************************************************************************************************************************
 Available compression types
@@ -50,10 +51,16 @@ FN_EXTERN const String *compressTypeStr(CompressType type);
 FN_EXTERN CompressType compressTypeFromName(const String *name);
 
 // Compression filter for the specified type. Error when compress type is none or invalid.
+//
+// When the size of the data to be compressed is known and threadMax > 0 it is used to select advanced parameters for compression
+// types that support them (currently only zst). Larger files get a larger window and long distance matching so matches further
+// apart can be found, and the largest files are split into jobs compressed by up to threadMax worker threads.
 typedef struct CompressFilterParam
 {
     VAR_PARAM_HEADER;
     bool raw;                                                       // Omit headers, checksum, etc. when possible
+    uint64_t size;                                                  // Expected size of the data to compress (0 if unknown)
+    unsigned int threadMax;                                         // Max worker threads for large files (0 to disable)
 } CompressFilterParam;
 
 #define compressFilterP(type, level, ...)                                                                                          \
@@ -7,7 +7,6 @@ ZST Compress
 
 #include <zstd.h>
 
-#include "common/compress/common.h"
 #include "common/compress/zst/common.h"
 #include "common/compress/zst/compress.h"
 #include "common/debug.h"
@@ -21,8 +20,11 @@ Object type
 ***********************************************************************************************************************************/
 typedef struct ZstCompress
 {
-    ZSTD_CStream *context;                                          // Compression context
+    ZSTD_CCtx *context;                                             // Compression context
     int level;                                                      // Compression level
+    unsigned int thread;                                            // Worker threads
+    unsigned int windowLog;                                         // Window log
+    bool longDistance;                                              // Long distance matching
 
     bool inputSame;                                                 // Is the same input required on the next process call?
     size_t inputOffset;                                             // Current offset in input buffer
@@ -36,7 +38,8 @@ static void
 zstCompressToLog(const ZstCompress *const this, StringStatic *const debugLog)
 {
     strStcFmt(
-        debugLog, "{level: %d, inputSame: %s, inputOffset: %zu, flushing: %s}", this->level, cvtBoolToConstZ(this->inputSame),
+        debugLog, "{level: %d, thread: %u, windowLog: %u, longDistance: %s, inputSame: %s, inputOffset: %zu, flushing: %s}",
+        this->level, this->thread, this->windowLog, cvtBoolToConstZ(this->longDistance), cvtBoolToConstZ(this->inputSame),
         this->inputOffset, cvtBoolToConstZ(this->flushing));
 }
 
@@ -59,7 +62,7 @@ zstCompressFreeResource(THIS_VOID)
 
     ASSERT(this != NULL);
 
-    ZSTD_freeCStream(this->context);
+    ZSTD_freeCCtx(this->context);
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -91,7 +94,7 @@ zstCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const co
     if (uncompressed == NULL)
     {
         this->flushing = true;
-        this->inputSame = zstError(ZSTD_endStream(this->context, &out)) != 0;
+        this->inputSame = zstError(ZSTD_compressStream2(this->context, &out, &(ZSTD_inBuffer){0}, ZSTD_e_end)) != 0;
     }
     // Else still have input data
     else
@@ -104,13 +107,14 @@ zstCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const co
         };
 
         // Perform compression
-        zstError(ZSTD_compressStream(this->context, &out, &in));
+        zstError(ZSTD_compressStream2(this->context, &out, &in, ZSTD_e_continue));
 
-        // If the input buffer was not entirely consumed then set inputSame and store the offset where processing will restart
+        // If the input buffer was not entirely consumed then set inputSame and store the offset where processing will restart. When
+        // compressing in the calling thread this only happens when the output buffer is full, but worker threads may return early
+        // when all their jobs are busy.
         if (in.pos < in.size)
         {
-            // Output buffer should be completely full
-            ASSERT(out.pos == out.size);
+            ASSERT(this->thread > 0 || out.pos == out.size);
 
             this->inputSame = true;
             this->inputOffset += in.pos;
@@ -162,37 +166,84 @@ zstCompressInputSame(const THIS_VOID)
     FUNCTION_TEST_RETURN(BOOL, this->inputSame);
 }
 
+/***********************************************************************************************************************************
+Build the filter parameter list. The advanced parameters follow the common parameters so compressFilterPack() can create the filter
+with the same parameters on a remote.
+***********************************************************************************************************************************/
+static Pack *
+zstCompressParamList(const ZstCompress *const this, const bool raw)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_COMPRESS, this);
+        FUNCTION_TEST_PARAM(BOOL, raw);
+    FUNCTION_TEST_END();
+
+    Pack *result;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteI32P(packWrite, this->level);
+        pckWriteBoolP(packWrite, raw);
+        pckWriteU32P(packWrite, this->thread);
+        pckWriteU32P(packWrite, this->windowLog);
+        pckWriteBoolP(packWrite, this->longDistance);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PACK, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-zstCompressNew(const int level, const bool raw)
+zstCompressNew(const int level, const bool raw, const ZstCompressNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
         (void)raw;                                                  // Raw unsupported
+        FUNCTION_LOG_PARAM(UINT, param.thread);
+        FUNCTION_LOG_PARAM(UINT, param.windowLog);
+        FUNCTION_LOG_PARAM(BOOL, param.longDistance);
     FUNCTION_LOG_END();
 
     ASSERT(level >= ZST_COMPRESS_LEVEL_MIN && level <= ZST_COMPRESS_LEVEL_MAX);
+    ASSERT(
+        param.windowLog == 0 || (param.windowLog >= ZST_COMPRESS_WINDOW_LOG_MIN && param.windowLog <= ZST_COMPRESS_WINDOW_LOG_MAX));
 
     OBJ_NEW_BEGIN(ZstCompress, .childQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
     {
         *this = (ZstCompress)
         {
-            .context = ZSTD_createCStream(),
+            .context = ZSTD_createCCtx(),
             .level = level,
+            .thread = param.thread,
+            .windowLog = param.windowLog,
+            .longDistance = param.longDistance,
         };
 
         // Set callback to ensure zst context is freed
         memContextCallbackSet(objMemContext(this), zstCompressFreeResource, this);
 
-        // Initialize context
-        zstError(ZSTD_initCStream(this->context, this->level));
+        // Initialize context. A window log of zero selects the default for the level.
+        zstError(ZSTD_CCtx_setParameter(this->context, ZSTD_c_compressionLevel, this->level));
+        zstError(ZSTD_CCtx_setParameter(this->context, ZSTD_c_windowLog, (int)this->windowLog));
+        zstError(ZSTD_CCtx_setParameter(this->context, ZSTD_c_enableLongDistanceMatching, this->longDistance));
+
+        // Worker threads are only available when libzstd was built with thread support, so error rather than silently compressing
+        // in the calling thread when threads were requested
+        if (this->thread > 0)
+            zstError(ZSTD_CCtx_setParameter(this->context, ZSTD_c_nbWorkers, (int)this->thread));
     }
     OBJ_NEW_END();
 
     FUNCTION_LOG_RETURN(
         IO_FILTER,
         ioFilterNewP(
-            ZST_COMPRESS_FILTER_TYPE, this, compressParamList(level, raw), .done = zstCompressDone, .inOut = zstCompressProcess,
+            ZST_COMPRESS_FILTER_TYPE, this, zstCompressParamList(this, raw), .done = zstCompressDone, .inOut = zstCompressProcess,
             .inputSame = zstCompressInputSame));
 }
 
@@ -9,6 +9,7 @@ Compress IO to the zst format.
 #define COMMON_COMPRESS_ZST_COMPRESS_H
 
 #include "common/io/filter/filter.h"
+#include "common/type/param.h"
 
 /***********************************************************************************************************************************
 Filter type constant
@@ -21,10 +22,28 @@ Level constants
 #define ZST_COMPRESS_LEVEL_MIN                                      -7
 #define ZST_COMPRESS_LEVEL_MAX                                      22
 
+/***********************************************************************************************************************************
+Window log constants. The max is the largest window zst will decompress without being told to allow more memory, so every version
+of the decompressor can read what is written.
+***********************************************************************************************************************************/
+#define ZST_COMPRESS_WINDOW_LOG_MIN                                 10
+#define ZST_COMPRESS_WINDOW_LOG_MAX                                 27
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN IoFilter *zstCompressNew(int level, bool raw);
+typedef struct ZstCompressNewParam
+{
+    VAR_PARAM_HEADER;
+    unsigned int thread;                                            // Worker threads (0 to compress in the calling thread)
+    unsigned int windowLog;                                         // Window size as a power of two (0 for the level default)
+    bool longDistance;                                              // Enable long distance matching
+} ZstCompressNewParam;
+
+#define zstCompressNewP(level, raw, ...)                                                                                           \
+    zstCompressNew(level, raw, (ZstCompressNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN IoFilter *zstCompressNew(int level, bool raw, ZstCompressNewParam param);
 
 #endif
 
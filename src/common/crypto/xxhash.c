@@ -153,3 +153,17 @@ xxHashOne(const size_t size, const Buffer *const message)
 
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint64_t
+xxHash64(const void *const data, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL || size == 0);
+
+    FUNCTION_TEST_RETURN(UINT64, XXH3_64bits(data, size));
+}
@@ -35,4 +35,7 @@ Helper functions
 // Get hash for one buffer
 FN_EXTERN Buffer *xxHashOne(size_t size, const Buffer *message);
 
+// Get 64-bit hash for a block of memory, e.g. to distribute keys in a hash table
+FN_EXTERN uint64_t xxHash64(const void *data, size_t size);
+
 #endif
@@ -3,6 +3,7 @@ Execute Process
 ***********************************************************************************************************************************/
 #include <build.h>
 
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -401,6 +402,23 @@ execOpen(Exec *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+execTerminate(Exec *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(EXEC, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    // Kill the process if it is still running. The process is still waited on when it is freed.
+    if (this->processId != 0)
+        THROW_ON_SYS_ERROR_FMT(kill(this->processId, SIGKILL) == -1, ExecuteError, "unable to terminate %s", strZ(this->name));
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 execOne(const StringList *const list)
@@ -68,6 +68,9 @@ Functions
 // Execute command
 FN_EXTERN void execOpen(Exec *this);
 
+// Terminate the process without waiting for it to finish its work
+FN_EXTERN void execTerminate(Exec *this);
+
 /***********************************************************************************************************************************
 Helper Functions
 ***********************************************************************************************************************************/
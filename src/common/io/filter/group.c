@@ -11,6 +11,8 @@ IO Filter Group
 #include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/log.h"
+#include "common/stat.h"
+#include "common/time.h"
 #include "common/type/list.h"
 
 /***********************************************************************************************************************************
@@ -24,6 +26,8 @@ typedef struct IoFilterData
     Buffer *inputLocal;                                             // Non-null if a locally created buffer that can be cleared
     IoFilter *filter;                                               // Filter to apply
     Buffer *output;                                                 // Output buffer for filter
+    TimeUSec time;                                                  // Time spent processing
+    uint64_t size;                                                  // Bytes of input processed
 } IoFilterData;
 
 // Macros for logging
@@ -292,11 +296,17 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
             // Process the filter if it is not done
             if (!ioFilterDone(filterData->filter))
             {
+                const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
+                const size_t inputSize = *filterData->input == NULL ? 0 : bufUsed(*filterData->input);
+
                 // If the filter produces output
                 if (ioFilterOutput(filterData->filter))
                 {
                     ioFilterProcessInOut(filterData->filter, *filterData->input, filterData->output);
 
+                    if (timeBegin != 0)
+                        filterData->time += timeUSec() - timeBegin;
+
                     // If inputSame is set then the output buffer for this filter is full and it will need to be re-processed with
                     // the same input once the output buffer is cleared
                     if (ioFilterInputSame(filterData->filter))
@@ -305,8 +315,13 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
                     }
                     // Else clear the buffer if it was locally allocated. If the input buffer was passed in then the caller is
                     // responsible for clearing it.
-                    else if (filterData->inputLocal != NULL)
-                        bufUsedZero(filterData->inputLocal);
+                    else
+                    {
+                        filterData->size += inputSize;
+
+                        if (filterData->inputLocal != NULL)
+                            bufUsedZero(filterData->inputLocal);
+                    }
 
                     // If the output buffer is not full and the filter is not done then more data is required
                     if (!bufFull(filterData->output) && !ioFilterDone(filterData->filter))
@@ -314,7 +329,14 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
                 }
                 // Else the filter does not produce output
                 else
+                {
                     ioFilterProcessIn(filterData->filter, *filterData->input);
+
+                    if (timeBegin != 0)
+                        filterData->time += timeUSec() - timeBegin;
+
+                    filterData->size += inputSize;
+                }
             }
 
             // If the filter is done and has no more output then null the output buffer. Downstream filters have a pointer to this
@@ -362,16 +384,28 @@ ioFilterGroupClose(IoFilterGroup *this)
     ASSERT(this != NULL);
     ASSERT(this->pub.opened && !this->pub.closed);
 
-    // Gather results from the filters
+    // Gather results and stats from the filters
     for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
     {
-        const IoFilter *const filter = ioFilterGroupGet(this, filterIdx)->filter;
+        const IoFilterData *const filterData = ioFilterGroupGet(this, filterIdx);
+        const IoFilter *const filter = filterData->filter;
 
         MEM_CONTEXT_BEGIN(lstMemContext(this->filterResult))
         {
             lstAdd(this->filterResult, &(IoFilterResult){.type = ioFilterType(filter), .result = ioFilterResult(filter)});
         }
         MEM_CONTEXT_END();
+
+        if (statTimeEnabled())
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                statTimeAdd(
+                    strNewFmt(IO_FILTER_STAT_PREFIX "%s", strZ(strNewStrId(ioFilterType(filter)))), filterData->time,
+                    filterData->size);
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
     }
 
     // Filter group is open
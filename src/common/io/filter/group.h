@@ -21,6 +21,11 @@ typedef struct IoFilterGroup IoFilterGroup;
 #include "common/type/pack.h"
 #include "common/type/stringId.h"
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+#define IO_FILTER_STAT_PREFIX                                       "filter."   // Time/bytes processed, e.g. filter.gz-cmp
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
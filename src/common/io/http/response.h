@@ -25,6 +25,8 @@ HTTP Response Constants
 #define HTTP_RESPONSE_CODE_FORBIDDEN                                403
 #define HTTP_RESPONSE_CODE_NOT_FOUND                                404
 #define HTTP_RESPONSE_CODE_REQUEST_TIMEOUT                          408
+#define HTTP_RESPONSE_CODE_CONFLICT                                 409
+#define HTTP_RESPONSE_CODE_PRECONDITION_FAILED                      412
 #define HTTP_RESPONSE_CODE_TOO_MANY_REQUESTS                        429
 
 // 2xx indicates success
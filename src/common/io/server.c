@@ -48,6 +48,19 @@ ioServerNew(void *const driver, const IoServerInterface *const interface)
     FUNCTION_LOG_RETURN(IO_SERVER, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN int
+ioServerFd(IoServer *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_SERVER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(INT, this->pub.interface->fd == NULL ? -1 : this->pub.interface->fd(this->pub.driver));
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 ioServerToLog(const IoServer *const this, StringStatic *const debugLog)
@@ -42,6 +42,9 @@ ioServerMove(IoServer *const this, MemContext *const parentNew)
     return objMove(this, parentNew);
 }
 
+// Server file descriptor, -1 if none
+FN_EXTERN int ioServerFd(IoServer *this);
+
 // Open session
 FN_INLINE_ALWAYS IoSession *
 ioServerAccept(IoServer *const this, IoSession *const session)
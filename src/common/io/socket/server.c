@@ -110,14 +110,30 @@ sckServerAccept(THIS_VOID, IoSession *const session)
 
             statInc(SOCKET_STAT_SESSION_STR);
         }
+        // Else no connection when interrupted or when the socket is non-blocking and another process accepted the connection first
         else
-            THROW_ON_SYS_ERROR(errno != EINTR, FileOpenError, "unable to accept socket");
+            THROW_ON_SYS_ERROR(errno != EINTR && errno != EAGAIN, FileOpenError, "unable to accept socket");
     }
     MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN(IO_SESSION, result);
 }
 
+/**********************************************************************************************************************************/
+static int
+sckServerFd(THIS_VOID)
+{
+    THIS(SocketServer);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SOCKET_SERVER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(INT, this->socket);
+}
+
 /**********************************************************************************************************************************/
 static const String *
 sckServerName(THIS_VOID)                                                                                            // {vm_covered}
@@ -139,6 +155,7 @@ static const IoServerInterface sckServerInterface =
     .type = IO_SERVER_SOCKET_TYPE,
     .name = sckServerName,
     .accept = sckServerAccept,
+    .fd = sckServerFd,
     .toLog = sckServerToLog,
 };
 
@@ -27,6 +27,7 @@ TLS Client
 Statistics constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(TLS_STAT_CLIENT_STR,                                  TLS_STAT_CLIENT);
+STRING_EXTERN(TLS_STAT_RESUME_STR,                                  TLS_STAT_RESUME);
 STRING_EXTERN(TLS_STAT_RETRY_STR,                                   TLS_STAT_RETRY);
 STRING_EXTERN(TLS_STAT_SESSION_STR,                                 TLS_STAT_SESSION);
 
@@ -42,6 +43,7 @@ typedef struct TlsClient
     IoClient *ioClient;                                             // Underlying client (usually a SocketClient)
 
     SSL_CTX *context;                                               // TLS context
+    SSL_SESSION *session;                                           // Most recent session (resumed by the next open)
 } TlsClient;
 
 /***********************************************************************************************************************************
@@ -79,6 +81,7 @@ tlsClientFreeResource(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    SSL_SESSION_free(this->session);
     SSL_CTX_free(this->context);
 
     FUNCTION_LOG_RETURN_VOID();
@@ -289,6 +292,27 @@ tlsClientAuth(const TlsClient *const this, SSL *const tlsSession)
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Store a new session so it can be resumed by the next open. A callback is required because TLS 1.3 servers send session tickets after
+the handshake has completed.
+***********************************************************************************************************************************/
+static int
+tlsClientSessionNew(SSL *const tlsSession, SSL_SESSION *const session)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, tlsSession);
+        FUNCTION_TEST_PARAM_P(VOID, session);
+    FUNCTION_TEST_END();
+
+    TlsClient *const this = SSL_CTX_get_app_data(SSL_get_SSL_CTX(tlsSession));
+
+    SSL_SESSION_free(this->session);
+    this->session = session;
+
+    // Return 1 to indicate that this client now holds the reference to the session
+    FUNCTION_TEST_RETURN(INT, 1);
+}
+
 /***********************************************************************************************************************************
 Open TLS session on a socket
 ***********************************************************************************************************************************/
@@ -320,6 +344,10 @@ tlsClientOpen(THIS_VOID)
             tlsSession = SSL_new(this->context);
             cryptoError(tlsSession == NULL, "unable to create TLS session");
 
+            // Offer the most recent session for resumption. If the server declines then a full handshake is done.
+            if (this->session != NULL)
+                cryptoError(SSL_set_session(tlsSession, this->session) != 1, "unable to set TLS session");
+
             // Set server host name used for validation. The exception here is necessary for MacOS which for some reason defines the
             // host name parameter as void * rather than const char * as on most platforms.
 #pragma GCC diagnostic push
@@ -366,10 +394,14 @@ tlsClientOpen(THIS_VOID)
         }
         while (retry);
 
-        // Authenticate TLS session
+        // Authenticate TLS session. A resumed session retains the server certificate and verification result of the session it
+        // resumed so authentication works the same way.
         ASSERT(result != NULL);
         ioSessionAuthenticatedSet(result, tlsClientAuth(this, tlsSession));
 
+        if (SSL_session_reused(tlsSession))
+            statInc(TLS_STAT_RESUME_STR);
+
         // Move session
         ioSessionMove(result, memContextPrior());
     }
@@ -445,6 +477,14 @@ tlsClientNew(
         // Enable safe compatibility options
         SSL_CTX_set_options(this->context, SSL_OP_ALL);
 
+        // Keep the most recent session in this client rather than in the OpenSSL internal cache when resume is enabled
+        if (param.resume)
+        {
+            SSL_CTX_set_app_data(this->context, this);
+            SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(this->context, tlsClientSessionNew);
+        }
+
         // Set location of CA certificates if the server certificate will be verified
         if (this->verifyPeer)
         {
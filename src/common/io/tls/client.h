@@ -4,7 +4,9 @@ TLS Client
 A simple, secure TLS client intended to allow access to services that are exposed via HTTPS. We call it TLS instead of SSL because
 SSL methods are disabled so only TLS connections are allowed.
 
-This object is intended to be used for multiple TLS sessions so ioClientOpen() can be called each time a new session is needed.
+This object is intended to be used for multiple TLS sessions so ioClientOpen() can be called each time a new session is needed. When
+resume is enabled the most recent session is kept so that it can be resumed by the next open when the server allows resumption,
+which avoids a full handshake.
 ***********************************************************************************************************************************/
 #ifndef COMMON_IO_TLS_CLIENT_H
 #define COMMON_IO_TLS_CLIENT_H
@@ -22,6 +24,8 @@ Statistics constants
 ***********************************************************************************************************************************/
 #define TLS_STAT_CLIENT                                             "tls.client"        // Clients created
 STRING_DECLARE(TLS_STAT_CLIENT_STR);
+#define TLS_STAT_RESUME                                             "tls.resume"        // Sessions resumed
+STRING_DECLARE(TLS_STAT_RESUME_STR);
 #define TLS_STAT_RETRY                                              "tls.retry"         // Connection retries
 STRING_DECLARE(TLS_STAT_RETRY_STR);
 #define TLS_STAT_SESSION                                            "tls.session"       // Sessions created
@@ -37,6 +41,7 @@ typedef struct TlsClientNewParam
     const String *caPath;
     const String *certFile;
     const String *keyFile;
+    bool resume;                                                    // Offer the most recent session on the next open?
 } TlsClientNewParam;
 
 #define tlsClientNewP(ioClient, host, timeoutConnect, timeoutSession, verifyPeer, ...)                                             \
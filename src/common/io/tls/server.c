@@ -19,6 +19,7 @@ TLS Server
 #include "common/log.h"
 #include "common/stat.h"
 #include "common/type/object.h"
+#include "version.h"
 
 /***********************************************************************************************************************************
 Statistics constants
@@ -179,7 +180,7 @@ static const IoServerInterface tlsServerInterface =
 FN_EXTERN IoServer *
 tlsServerNew(
     const String *const host, const String *const caFile, const String *const keyFile, const String *const certFile,
-    const TimeMSec timeout)
+    const TimeMSec timeout, const TlsServerNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, host);
@@ -187,6 +188,7 @@ tlsServerNew(
         FUNCTION_LOG_PARAM(STRING, keyFile);
         FUNCTION_LOG_PARAM(STRING, certFile);
         FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+        FUNCTION_LOG_PARAM(BOOL, param.resume);
     FUNCTION_LOG_END();
 
     ASSERT(host != NULL);
@@ -215,11 +217,24 @@ tlsServerNew(
             // no support for renegotiation.
             SSL_OP_NO_RENEGOTIATION |
 #endif
-            // Disable session tickets
-            SSL_OP_NO_TICKET);
+            // Disable session tickets unless resumption is allowed
+            (param.resume ? 0 : SSL_OP_NO_TICKET));
+
+        // Disable session caching unless resumption is allowed
+        if (!param.resume)
+            SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_OFF);
+        // Else allow resumption with session tickets. Tickets are stateless so no server-side cache is required, and the ticket
+        // keys are generated with the context so they are shared by all processes forked after the context is created. The session
+        // id context must be set for resumption to succeed when client certificates are verified.
+        else
+        {
+            SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL_STORE);
 
-        // Disable session caching
-        SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_OFF);
+            cryptoError(
+                SSL_CTX_set_session_id_context(
+                    this->context, (const unsigned char *)PROJECT_NAME, (unsigned int)strlen(PROJECT_NAME)) != 1,
+                "unable to set TLS session id context");
+        }
 
         // Set parameters for generating ephemeral DH keys. Auto selects parameters that match the strength of the certificate key.
         // Also see https://weakdh.org and https://en.wikipedia.org/wiki/Logjam_(computer_security).
@@ -24,7 +24,17 @@ STRING_DECLARE(TLS_STAT_SERVER_STR);
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+typedef struct TlsServerNewParam
+{
+    VAR_PARAM_HEADER;
+    bool resume;                                                    // Allow clients to resume sessions with session tickets?
+} TlsServerNewParam;
+
+#define tlsServerNewP(host, caFile, keyFile, certFile, timeout, ...)                                                               \
+    tlsServerNew(host, caFile, keyFile, certFile, timeout, (TlsServerNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 FN_EXTERN IoServer *tlsServerNew(
-    const String *host, const String *caFile, const String *keyFile, const String *certFile, TimeMSec timeout);
+    const String *host, const String *caFile, const String *keyFile, const String *certFile, TimeMSec timeout,
+    TlsServerNewParam param);
 
 #endif
@@ -3,6 +3,7 @@ Memory Context Manager
 ***********************************************************************************************************************************/
 #include <build.h>
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -47,6 +48,14 @@ typedef enum
     memQtyMany = 2,                                                 // Many for this type
 } MemQty;
 
+// Is the context memory allocated from an arena?
+typedef enum
+{
+    memArenaNone = 0,                                               // Context and allocations use malloc()
+    memArenaOwner = 1,                                              // Context owns an arena that allocations are made from
+    memArenaMember = 2,                                             // Context and allocations are made from an ancestor's arena
+} MemArena;
+
 // Main structure required by every mem context
 struct MemContext
 {
@@ -61,6 +70,7 @@ struct MemContext
     bool allocInitialized : 1;                                      // Has the allocation list been initialized?
     MemQty callbackQty : 2;                                         // How many callbacks can this context have?
     bool callbackInitialized : 1;                                   // Has the callback been initialized?
+    MemArena arena : 2;                                             // Is the context memory allocated from an arena?
     size_t allocExtra : 16;                                         // Size of extra allocation (1kB max)
 
     unsigned int contextParentIdx;                                  // Index in the parent context list
@@ -102,6 +112,22 @@ typedef struct MemContextCallbackOne
     void *argument;                                                 // Argument to pass to callback function
 } MemContextCallbackOne;
 
+// Arena chunk. Chunks are linked so they can all be freed with the arena owner.
+typedef struct MemArenaChunk
+{
+    struct MemArenaChunk *prior;                                    // Prior chunk
+    size_t size;                                                    // Total chunk size (including header)
+    size_t used;                                                    // Bytes used after the header
+    alignas(max_align_t) uint8_t data[];                            // Allocations (aligned for any type)
+} MemArenaChunk;
+
+// Mem context that owns an arena
+typedef struct MemContextArena
+{
+    MemArenaChunk *chunk;                                           // Current chunk that allocations are made from
+    size_t chunkSize;                                               // Size of the next chunk
+} MemContextArena;
+
 /***********************************************************************************************************************************
 Possible sizes for the manifest based on options
 ***********************************************************************************************************************************/
@@ -184,6 +210,16 @@ memContextCallbackOne(MemContext *const memContext)
          memContextSizePossible[memContext->childQty][memContext->allocQty][0] + memContext->allocExtra);
 }
 
+// Get pointer to arena part (only valid for the arena owner)
+static MemContextArena *
+memContextArena(MemContext *const memContext)
+{
+    return
+        (MemContextArena *)
+        ((uint8_t *)(memContext + 1) +
+         memContextSizePossible[memContext->childQty][memContext->allocQty][memContext->callbackQty] + memContext->allocExtra);
+}
+
 /***********************************************************************************************************************************
 Top context
 
@@ -574,17 +610,15 @@ memAllocReuse(const size_t size)
 Free, retaining large blocks for reuse instead of returning them to the allocator
 ***********************************************************************************************************************************/
 static void
-memFreeReuse(MemContextAlloc *const alloc)
+memFreeReuse(void *const alloc, const size_t size)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM_P(VOID, alloc);
+        FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
     ASSERT(alloc != NULL);
 
-    // Read the size before the block is poisoned for Valgrind
-    const size_t size = alloc->size;
-
     // Retain the block for reuse when large enough and the retained memory limit will not be exceeded
     if (size >= MEM_FREE_LIST_THRESHOLD && memFreeList.size + size <= MEM_FREE_LIST_BYTE_MAX)
     {
@@ -676,6 +710,211 @@ memContextFreeListReserve(const size_t size)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Arena for short-lived contexts
+
+Contexts that create many small objects, e.g. the temp context of a parse loop, spend much of their time in malloc() and free() for
+each object and allocation. An arena context instead carves its allocations, and the contexts created in it along with their
+allocations, from chunks that are freed together when the arena context is freed. Memory freed or resized in the arena is not
+reclaimed until then, except for the last allocation in the current chunk, so an arena is only a good fit for a context that is
+freed soon after the allocations are made.
+
+Chunks start small so an arena that allocates little costs little and grow with each new chunk. Allocations too large for a chunk
+get a dedicated chunk. Chunks are allocated with memAllocReuse() so the larger chunks are recycled by the free list.
+***********************************************************************************************************************************/
+#define MEM_ARENA_CHUNK_SIZE_MIN                                    ((size_t)(8 * 1024))
+#define MEM_ARENA_CHUNK_SIZE_MAX                                    ((size_t)(1024 * 1024))
+
+// Round size up so allocations in the arena have the same alignment as allocations returned by malloc()
+#define MEM_ARENA_ALIGN(size)                                                                                                      \
+    (((size) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1))
+
+// Arenas may be disabled in tests to compare performance with and without them. While disabled, a context requested with an arena
+// is created as a regular context. The flag is not needed in production builds so it only exists when the test harness includes
+// memory contexts. DEBUG cannot be used to guard the flag since the performance test is built without it.
+#if defined(HRN_INTEST_MEMCONTEXT) || defined(HRN_FEATURE_MEMCONTEXT)
+static bool memArenaDisabled = false;
+#define MEM_ARENA_DISABLED()                                        memArenaDisabled
+#else
+#define MEM_ARENA_DISABLED()                                        false
+#endif
+
+/***********************************************************************************************************************************
+Find the arena owner and the arena that a context allocates from
+***********************************************************************************************************************************/
+static MemContext *
+memArenaOwnerFind(MemContext *memContext)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+    FUNCTION_TEST_END();
+
+    ASSERT(memContext != NULL);
+    ASSERT(memContext->arena != memArenaNone);
+
+    // Members can only be moved inside the arena owner so the owner is always an ancestor
+    while (memContext->arena != memArenaOwner)
+    {
+        memContext = memContext->contextParent;
+        ASSERT(memContext != NULL);
+    }
+
+    FUNCTION_TEST_RETURN(MEM_CONTEXT, memContext);
+}
+
+static MemContextArena *
+memArenaFind(MemContext *const memContext)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN_TYPE_P(MemContextArena, memContextArena(memArenaOwnerFind(memContext)));
+}
+
+/***********************************************************************************************************************************
+Allocate from the arena
+***********************************************************************************************************************************/
+static void *
+memArenaAlloc(MemContextArena *const arena, const size_t sizeRequested)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, arena);
+        FUNCTION_TEST_PARAM(SIZE, sizeRequested);
+    FUNCTION_TEST_END();
+
+    ASSERT(arena != NULL);
+
+    const size_t size = MEM_ARENA_ALIGN(sizeRequested);
+
+    // If there is not enough space in the current chunk
+    if (arena->chunk == NULL || arena->chunk->size - sizeof(MemArenaChunk) - arena->chunk->used < size)
+    {
+        // Allocations that would fill more than half the next chunk get a dedicated chunk. The dedicated chunk is placed behind the
+        // current chunk so the space remaining in the current chunk can still be used.
+        if (size > (arena->chunkSize - sizeof(MemArenaChunk)) / 2)
+        {
+            MemArenaChunk *const chunk = memAllocReuse(sizeof(MemArenaChunk) + size);
+            *chunk = (MemArenaChunk){.size = sizeof(MemArenaChunk) + size, .used = size};
+
+            if (arena->chunk == NULL)
+                arena->chunk = chunk;
+            else
+            {
+                chunk->prior = arena->chunk->prior;
+                arena->chunk->prior = chunk;
+            }
+
+            FUNCTION_TEST_RETURN_P(VOID, chunk->data);
+        }
+
+        // Else start a new chunk and grow the size of the next chunk
+        MemArenaChunk *const chunk = memAllocReuse(arena->chunkSize);
+        *chunk = (MemArenaChunk){.prior = arena->chunk, .size = arena->chunkSize};
+        arena->chunk = chunk;
+
+        if (arena->chunkSize < MEM_ARENA_CHUNK_SIZE_MAX)
+            arena->chunkSize *= 2;
+    }
+
+    // Allocate from the current chunk
+    void *const result = arena->chunk->data + arena->chunk->used;
+    arena->chunk->used += size;
+
+    // Space returned to the chunk was poisoned so make it available again
+    VALGRIND_MAKE_MEM_UNDEFINED(result, size);
+
+    FUNCTION_TEST_RETURN_P(VOID, result);
+}
+
+/***********************************************************************************************************************************
+Is the allocation the last one in the current chunk? Only this allocation can be resized in place or returned to the chunk.
+***********************************************************************************************************************************/
+static bool
+memArenaAllocLast(const MemContextArena *const arena, const MemContextAlloc *const alloc)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, arena);
+        FUNCTION_TEST_PARAM_P(VOID, alloc);
+    FUNCTION_TEST_END();
+
+    ASSERT(arena != NULL);
+    ASSERT(arena->chunk != NULL);
+    ASSERT(alloc != NULL);
+
+    FUNCTION_TEST_RETURN(
+        BOOL, (const uint8_t *)alloc + MEM_ARENA_ALIGN(alloc->size) == arena->chunk->data + arena->chunk->used);
+}
+
+/***********************************************************************************************************************************
+Resize an allocation in the arena, in place when possible
+***********************************************************************************************************************************/
+static MemContextAlloc *
+memArenaResize(MemContextArena *const arena, MemContextAlloc *const alloc, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, arena);
+        FUNCTION_TEST_PARAM_P(VOID, alloc);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(arena != NULL);
+    ASSERT(alloc != NULL);
+
+    const size_t sizeOld = MEM_ARENA_ALIGN(alloc->size);
+    const size_t sizeNew = MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + size);
+
+    // Resize in place when this is the last allocation in the current chunk and there is room
+    if (memArenaAllocLast(arena, alloc) && arena->chunk->used - sizeOld + sizeNew <= arena->chunk->size - sizeof(MemArenaChunk))
+    {
+        if (sizeNew > sizeOld)
+        {
+            VALGRIND_MAKE_MEM_UNDEFINED((uint8_t *)alloc + sizeOld, sizeNew - sizeOld);
+        }
+
+        arena->chunk->used = arena->chunk->used - sizeOld + sizeNew;
+        alloc->size = (unsigned int)(sizeof(MemContextAlloc) + size);
+
+        FUNCTION_TEST_RETURN_TYPE_P(MemContextAlloc, alloc);
+    }
+
+    // Else copy to a new allocation. The old allocation is freed with the arena.
+    MemContextAlloc *const result = memArenaAlloc(arena, sizeof(MemContextAlloc) + size);
+    const size_t sizeCopy = alloc->size - sizeof(MemContextAlloc);
+
+    *result = (MemContextAlloc){.size = (unsigned int)(sizeof(MemContextAlloc) + size)};
+    memcpy(result + 1, alloc + 1, sizeCopy < size ? sizeCopy : size);
+
+    VALGRIND_MAKE_MEM_NOACCESS(alloc, sizeOld);
+
+    FUNCTION_TEST_RETURN_TYPE_P(MemContextAlloc, result);
+}
+
+/***********************************************************************************************************************************
+Free an allocation in the arena. The space is only returned to the chunk for the last allocation in the current chunk.
+***********************************************************************************************************************************/
+static void
+memArenaFree(MemContextArena *const arena, MemContextAlloc *const alloc)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, arena);
+        FUNCTION_TEST_PARAM_P(VOID, alloc);
+    FUNCTION_TEST_END();
+
+    ASSERT(arena != NULL);
+    ASSERT(alloc != NULL);
+
+    const size_t size = MEM_ARENA_ALIGN(alloc->size);
+
+    if (memArenaAllocLast(arena, alloc))
+        arena->chunk->used -= size;
+
+    // Poison so use-after-free is still detected
+    VALGRIND_MAKE_MEM_NOACCESS(alloc, size);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Find space for a new mem context
 ***********************************************************************************************************************************/
@@ -741,6 +980,7 @@ memContextNew(
         FUNCTION_TEST_PARAM(UINT, param.allocQty);
         FUNCTION_TEST_PARAM(UINT, param.callbackQty);
         FUNCTION_TEST_PARAM(SIZE, param.allocExtra);
+        FUNCTION_TEST_PARAM(BOOL, param.arena);
     FUNCTION_TEST_END();
 
     ASSERT(name != NULL);
@@ -765,8 +1005,28 @@ memContextNew(
     const MemQty allocQty = param.allocQty > 1 ? memQtyMany : (MemQty)param.allocQty;
     const MemQty callbackQty = (MemQty)param.callbackQty;
 
-    MemContext *const this = memAllocInternal(
-        sizeof(MemContext) + allocExtra + memContextSizePossible[childQty][allocQty][callbackQty]);
+    const size_t size = sizeof(MemContext) + allocExtra + memContextSizePossible[childQty][allocQty][callbackQty];
+    MemContext *this;
+    MemArena arena;
+
+    // Contexts created in an arena context are allocated from the arena
+    if (contextCurrent->arena != memArenaNone)
+    {
+        this = memArenaAlloc(memArenaFind(contextCurrent), size);
+        arena = memArenaMember;
+    }
+    // Else create an arena owner
+    else if (param.arena && !MEM_ARENA_DISABLED())
+    {
+        this = memAllocInternal(size + sizeof(MemContextArena));
+        arena = memArenaOwner;
+    }
+    // Else allocate the context
+    else
+    {
+        this = memAllocInternal(size);
+        arena = memArenaNone;
+    }
 
     *this = (MemContext)
     {
@@ -784,6 +1044,7 @@ memContextNew(
         .childQty = childQty,
         .allocQty = allocQty,
         .callbackQty = callbackQty,
+        .arena = arena,
 
         // Set extra allocation
         .allocExtra = (uint16_t)allocExtra,
@@ -792,6 +1053,10 @@ memContextNew(
         .contextParent = contextCurrent,
     };
 
+    // Initialize arena
+    if (arena == memArenaOwner)
+        *memContextArena(this) = (MemContextArena){.chunkSize = MEM_ARENA_CHUNK_SIZE_MIN};
+
     // Find space for the new context
     if (contextCurrent->childQty == memQtyOne)
     {
@@ -912,12 +1177,22 @@ memContextAllocNew(const size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
+    MemContext *const contextCurrent = memContextStack[memContextCurrentStackIdx].memContext;
+    ASSERT(contextCurrent->allocQty != memQtyNone);
+
+    // Allocate from the arena. Allocations in an arena are not tracked since they are freed with the arena.
+    if (contextCurrent->arena != memArenaNone)
+    {
+        MemContextAlloc *const result = memArenaAlloc(memArenaFind(contextCurrent), sizeof(MemContextAlloc) + size);
+        *result = (MemContextAlloc){.size = (unsigned int)(sizeof(MemContextAlloc) + size)};
+
+        FUNCTION_TEST_RETURN_TYPE_P(MemContextAlloc, result);
+    }
+
     // Allocate memory
     MemContextAlloc *const result = memAllocReuse(sizeof(MemContextAlloc) + size);
 
     // Find space for the new allocation
-    MemContext *const contextCurrent = memContextStack[memContextCurrentStackIdx].memContext;
-    ASSERT(contextCurrent->allocQty != memQtyNone);
 
     if (contextCurrent->allocQty == memQtyOne)
     {
@@ -992,13 +1267,18 @@ memContextAllocResize(MemContextAlloc *alloc, const size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
+    MemContext *const currentContext = memContextStack[memContextCurrentStackIdx].memContext;
+    ASSERT(currentContext->allocQty != memQtyNone);
+
+    // Resize in the arena
+    if (currentContext->arena != memArenaNone)
+        FUNCTION_TEST_RETURN_TYPE_P(MemContextAlloc, memArenaResize(memArenaFind(currentContext), alloc, size));
+
     // Resize the allocation
     alloc = memReAllocInternal(alloc, sizeof(MemContextAlloc) + size);
     alloc->size = (unsigned int)(sizeof(MemContextAlloc) + size);
 
     // Update pointer in allocation list in case the realloc moved the allocation
-    MemContext *const currentContext = memContextStack[memContextCurrentStackIdx].memContext;
-    ASSERT(currentContext->allocQty != memQtyNone);
     ASSERT(currentContext->allocInitialized);
 
     if (currentContext->allocQty == memQtyOne)
@@ -1069,9 +1349,17 @@ memFree(void *const buffer)
     // Get the allocation
     MemContext *const contextCurrent = memContextStack[memContextCurrentStackIdx].memContext;
     ASSERT(contextCurrent->allocQty != memQtyNone);
-    ASSERT(contextCurrent->allocInitialized);
     MemContextAlloc *const alloc = MEM_CONTEXT_ALLOC_HEADER(buffer);
 
+    // Free in the arena
+    if (contextCurrent->arena != memArenaNone)
+    {
+        memArenaFree(memArenaFind(contextCurrent), alloc);
+        FUNCTION_TEST_RETURN_VOID();
+    }
+
+    ASSERT(contextCurrent->allocInitialized);
+
     // Remove allocation from the context
     if (contextCurrent->allocQty == memQtyOne)
     {
@@ -1094,7 +1382,7 @@ memFree(void *const buffer)
     }
 
     // Free the allocation, retaining it for reuse if large enough
-    memFreeReuse(alloc);
+    memFreeReuse(alloc, alloc->size);
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -1113,6 +1401,18 @@ memContextMove(MemContext *const this, MemContext *const parentNew)
     // Only move if a valid mem context is provided and the old and new parents are not the same
     if (this != NULL && this->contextParent != parentNew)
     {
+        // A context allocated from an arena would be freed with the arena so it cannot be moved out of the arena owner
+        if (this->arena == memArenaMember)
+        {
+            const MemContext *const owner = memArenaOwnerFind(this);
+            const MemContext *parentFind = parentNew;
+
+            while (parentFind != NULL && parentFind != owner)
+                parentFind = parentFind->contextParent;
+
+            CHECK(AssertError, parentFind != NULL, "cannot move context allocated from an arena out of the arena");
+        }
+
         ASSERT(this->active);
         ASSERT(this->contextParent->active);
         ASSERT(this->contextParent->childQty != memQtyNone);
@@ -1375,6 +1675,20 @@ memContextSize(const MemContext *const this)
     if (this->callbackQty != memQtyNone)
         offset += sizeof(MemContextCallbackOne);
 
+    // Size of arena chunks, which include the contexts and allocations of arena members
+    if (this->arena == memArenaOwner)
+    {
+        const MemContextArena *const arena = (const MemContextArena *const)offset;
+
+        for (const MemArenaChunk *chunk = arena->chunk; chunk != NULL; chunk = chunk->prior)
+            total += chunk->size;
+
+        offset += sizeof(MemContextArena);
+    }
+    // Else the size of an arena member is included in the arena owner's chunks
+    else if (this->arena == memArenaMember)
+        offset = (const uint8_t *)this;
+
     FUNCTION_TEST_RETURN(SIZE, (size_t)(offset - (const uint8_t *)this) + total);
 }
 
@@ -1518,7 +1832,7 @@ memContextFreeRecurse(MemContext *const this)
             MemContextAllocOne *const contextAlloc = memContextAllocOne(this);
 
             if (contextAlloc->alloc != NULL)
-                memFreeReuse(contextAlloc->alloc);
+                memFreeReuse(contextAlloc->alloc, contextAlloc->alloc->size);
         }
         else
         {
@@ -1528,12 +1842,26 @@ memContextFreeRecurse(MemContext *const this)
 
             for (unsigned int allocIdx = 0; allocIdx < contextAlloc->listSize; allocIdx++)
                 if (contextAlloc->list[allocIdx] != NULL)
-                    memFreeReuse(contextAlloc->list[allocIdx]);
+                    memFreeReuse(contextAlloc->list[allocIdx], contextAlloc->list[allocIdx]->size);
 
             memFreeInternal(contextAlloc->list);
         }
     }
 
+    // Free arena chunks after the child contexts since arena members may be allocated from them
+    if (this->arena == memArenaOwner)
+    {
+        MemArenaChunk *chunk = memContextArena(this)->chunk;
+
+        while (chunk != NULL)
+        {
+            MemArenaChunk *const chunkPrior = chunk->prior;
+
+            memFreeReuse(chunk, chunk->size);
+            chunk = chunkPrior;
+        }
+    }
+
     // Free the memory context so the slot can be reused (if not the top mem context)
     if (this != memContextTop())
     {
@@ -1554,7 +1882,9 @@ memContextFreeRecurse(MemContext *const this)
             memContextChildMany(this->contextParent)->list[this->contextParentIdx] = NULL;
         }
 
-        memFreeInternal(this);
+        // Free the context unless it was allocated from an arena, in which case it is freed with the arena
+        if (this->arena != memArenaMember)
+            memFreeInternal(this);
     }
     // Else reset top context. In practice it is uncommon for the top mem context to be freed and then used again.
     else
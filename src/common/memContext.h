@@ -174,19 +174,37 @@ MEM_CONTEXT_TEMP_END();
 
 <Prior memory context is restored>
 <Temp memory context is freed>
+
+MEM_CONTEXT_TEMP_ARENA_BEGIN() creates the temp context with an arena (see memContextNewP() arena parameter). This is useful for
+loops that create many small objects, especially with MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN(). Objects created in the temp context
+cannot be moved out of it, so results must be created in the prior context.
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_TEMP()                                                                                                         \
     MEM_CONTEXT_TEMP_memContext
 
+#define MEM_CONTEXT_TEMP_NEW(arenaParam)                                                                                           \
+    memContextNewP("temporary", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX, .arena = arenaParam)
+
 #define MEM_CONTEXT_TEMP_BEGIN()                                                                                                   \
     do                                                                                                                             \
     {                                                                                                                              \
-        MemContext *MEM_CONTEXT_TEMP() = memContextNewP(                                                                           \
-            "temporary", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX);                                        \
+        MemContext *MEM_CONTEXT_TEMP() = MEM_CONTEXT_TEMP_NEW(false);                                                              \
+        memContextSwitch(MEM_CONTEXT_TEMP());
+
+#define MEM_CONTEXT_TEMP_ARENA_BEGIN()                                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        MemContext *MEM_CONTEXT_TEMP() = MEM_CONTEXT_TEMP_NEW(true);                                                               \
         memContextSwitch(MEM_CONTEXT_TEMP());
 
 #define MEM_CONTEXT_TEMP_RESET_BEGIN()                                                                                             \
     MEM_CONTEXT_TEMP_BEGIN()                                                                                                       \
+    const bool MEM_CONTEXT_TEMP_arena = false;                                                                                     \
+    unsigned int MEM_CONTEXT_TEMP_loopTotal = 0;
+
+#define MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN()                                                                                       \
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()                                                                                                 \
+    const bool MEM_CONTEXT_TEMP_arena = true;                                                                                      \
     unsigned int MEM_CONTEXT_TEMP_loopTotal = 0;
 
 #define MEM_CONTEXT_TEMP_RESET(resetTotal)                                                                                         \
@@ -198,7 +216,7 @@ MEM_CONTEXT_TEMP_END();
         {                                                                                                                          \
             memContextSwitchBack();                                                                                                \
             memContextDiscard();                                                                                                   \
-            MEM_CONTEXT_TEMP() = memContextNewP("temporary", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX);    \
+            MEM_CONTEXT_TEMP() = MEM_CONTEXT_TEMP_NEW(MEM_CONTEXT_TEMP_arena);                                                     \
             memContextSwitch(MEM_CONTEXT_TEMP());                                                                                  \
             MEM_CONTEXT_TEMP_loopTotal = 0;                                                                                        \
         }                                                                                                                          \
@@ -240,6 +258,12 @@ typedef struct MemContextNewParam
     uint8_t allocQty;                                               // How many allocations can this context have?
     uint8_t callbackQty;                                            // How many callbacks can this context have?
     uint16_t allocExtra;                                            // Extra memory to allocate with the context
+
+    // Allocate this context's allocations and child contexts (and their allocations, etc.) from chunks that are freed all at once
+    // when the context is freed rather than calling malloc()/free() for each. Memory freed in the arena is not reclaimed until the
+    // context is freed and contexts allocated from the arena cannot be moved out of it. Contexts created in an arena context are
+    // always allocated from the arena so this option has no effect for them.
+    bool arena;
 } MemContextNewParam;
 
 // Maximum amount of extra memory that can be allocated with the context using allocExtra
@@ -9,13 +9,27 @@ Statistics Collector
 #include "common/type/json.h"
 #include "common/type/list.h"
 
+/***********************************************************************************************************************************
+Histogram buckets for timed stats. Each bucket is ten times the size of the prior bucket and the last bucket holds all times greater
+than or equal to the upper bound of the prior bucket.
+***********************************************************************************************************************************/
+#define STAT_HISTOGRAM_TOTAL                                        6
+
+// Times less than the max are in the bucket
+static const TimeUSec statHistogramMax[STAT_HISTOGRAM_TOTAL] = {1000, 10000, 100000, 1000000, 10000000, UINT64_MAX};
+
 /***********************************************************************************************************************************
 Cumulative statistics
 ***********************************************************************************************************************************/
 typedef struct Stat
 {
     const String *key;
-    uint64_t total;
+    uint64_t total;                                                 // Total operations
+    bool timed;                                                     // Has timing been recorded?
+    TimeUSec time;                                                  // Total time of all operations
+    TimeUSec timeMax;                                               // Max time of a single operation
+    uint64_t size;                                                  // Total bytes processed by all operations
+    uint64_t histogram[STAT_HISTOGRAM_TOTAL];                       // Operation count for each histogram bucket
 } Stat;
 
 /***********************************************************************************************************************************
@@ -25,6 +39,7 @@ static struct
 {
     MemContext *memContext;                                         // Mem context to store data in this struct
     List *stat;                                                     // Cumulative stats
+    bool timeEnabled;                                               // Is timing of filters and storage enabled?
 } statLocalData;
 
 /**********************************************************************************************************************************/
@@ -101,6 +116,142 @@ statInc(const String *const key)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statTimeEnabledSet(const bool enabled)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, enabled);
+    FUNCTION_TEST_END();
+
+    statLocalData.timeEnabled = enabled;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+statTimeEnabled(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN(BOOL, statLocalData.timeEnabled);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statTimeAdd(const String *const key, const TimeUSec time, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(UINT64, time);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(key != NULL);
+
+    Stat *const stat = statGetOrCreate(key);
+
+    stat->total++;
+    stat->timed = true;
+    stat->time += time;
+    stat->size += size;
+
+    if (time > stat->timeMax)
+        stat->timeMax = time;
+
+    // Find the histogram bucket for the time
+    unsigned int histogramIdx = 0;
+
+    while (time >= statHistogramMax[histogramIdx])
+        histogramIdx++;
+
+    stat->histogram[histogramIdx]++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statToPack(PackWrite *const pack)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_WRITE, pack);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(pack != NULL);
+
+    pckWriteArrayBeginP(pack);
+
+    for (unsigned int statIdx = 0; statIdx < lstSize(statLocalData.stat); statIdx++)
+    {
+        const Stat *const stat = lstGet(statLocalData.stat, statIdx);
+
+        pckWriteObjBeginP(pack);
+        pckWriteStrP(pack, stat->key);
+        pckWriteU64P(pack, stat->total);
+        pckWriteBoolP(pack, stat->timed);
+        pckWriteU64P(pack, stat->time);
+        pckWriteU64P(pack, stat->timeMax);
+        pckWriteU64P(pack, stat->size);
+
+        for (unsigned int histogramIdx = 0; histogramIdx < STAT_HISTOGRAM_TOTAL; histogramIdx++)
+            pckWriteU64P(pack, stat->histogram[histogramIdx]);
+
+        pckWriteObjEndP(pack);
+    }
+
+    pckWriteArrayEndP(pack);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statFromPack(PackRead *const pack)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK_READ, pack);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(pack != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        pckReadArrayBeginP(pack);
+
+        while (pckReadNext(pack))
+        {
+            pckReadObjBeginP(pack);
+
+            Stat *const stat = statGetOrCreate(pckReadStrP(pack));
+
+            stat->total += pckReadU64P(pack);
+            stat->timed |= pckReadBoolP(pack);
+            stat->time += pckReadU64P(pack);
+
+            const TimeUSec timeMax = pckReadU64P(pack);
+
+            if (timeMax > stat->timeMax)
+                stat->timeMax = timeMax;
+
+            stat->size += pckReadU64P(pack);
+
+            for (unsigned int histogramIdx = 0; histogramIdx < STAT_HISTOGRAM_TOTAL; histogramIdx++)
+                stat->histogram[histogramIdx] += pckReadU64P(pack);
+
+            pckReadObjEndP(pack);
+        }
+
+        pckReadArrayEndP(pack);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 statToJson(void)
@@ -124,6 +275,21 @@ statToJson(void)
                 const Stat *const stat = lstGet(statLocalData.stat, statIdx);
 
                 jsonWriteObjectBegin(jsonWriteKey(json, stat->key));
+
+                // Output histogram, size, and time for timed stats
+                if (stat->timed)
+                {
+                    jsonWriteArrayBegin(jsonWriteKeyZ(json, "histogram"));
+
+                    for (unsigned int histogramIdx = 0; histogramIdx < STAT_HISTOGRAM_TOTAL; histogramIdx++)
+                        jsonWriteUInt64(json, stat->histogram[histogramIdx]);
+
+                    jsonWriteArrayEnd(json);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, "size"), stat->size);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, "time"), stat->time);
+                    jsonWriteUInt64(jsonWriteKeyZ(json, "timeMax"), stat->timeMax);
+                }
+
                 jsonWriteUInt64(jsonWriteKeyZ(json, "total"), stat->total);
                 jsonWriteObjectEnd(json);
             }
@@ -8,10 +8,17 @@ needed at runtime. However, statInit() must be called before any other stat*() f
 NOTE: Statistics are held in a sorted list so there is some cost involved in each lookup. In general, statistics should be used for
 relatively important or high-latency operations where measurements are critical. For instance, using statistics to count the
 iterations of a loop would likely be a bad idea.
+
+Timed stats also record the total time in microseconds, the max time of a single operation, the bytes processed, and a histogram of
+operation times. The histogram is output as an array of counts for the buckets <1ms, <10ms, <100ms, <1s, <10s, and >=10s. Stats
+from other processes (e.g. local and remote processes) can be merged via statToPack() and statFromPack() so the main process reports
+stats for the entire command.
 ***********************************************************************************************************************************/
 #ifndef COMMON_STAT_H
 #define COMMON_STAT_H
 
+#include "common/time.h"
+#include "common/type/pack.h"
 #include "common/type/string.h"
 
 /***********************************************************************************************************************************
@@ -23,6 +30,22 @@ FN_EXTERN void statInit(void);
 // Increment stat by one
 FN_EXTERN void statInc(const String *key);
 
+// Enable timing of filters and storage operations. Timing is disabled by default since it adds overhead to every buffer processed
+// and is only useful when the stats will be output, i.e. when the stat-file option is set or detail logging is enabled.
+FN_EXTERN void statTimeEnabledSet(bool enabled);
+
+// Is timing enabled?
+FN_EXTERN bool statTimeEnabled(void);
+
+// Add a timed operation to a stat. The time is in microseconds and size is the number of bytes processed by the operation (if any).
+FN_EXTERN void statTimeAdd(const String *key, TimeUSec time, uint64_t size);
+
+// Write stats to a pack so they can be sent to another process
+FN_EXTERN void statToPack(PackWrite *pack);
+
+// Merge stats from a pack written by statToPack() into the stats for this process
+FN_EXTERN void statFromPack(PackRead *pack);
+
 // Output stats to JSON
 FN_EXTERN String *statToJson(void);
 
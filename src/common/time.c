@@ -26,6 +26,18 @@ timeMSec(void)
     FUNCTION_TEST_RETURN(TIME_MSEC, ((TimeMSec)currentTime.tv_sec * MSEC_PER_SEC) + (TimeMSec)currentTime.tv_usec / MSEC_PER_USEC);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN TimeUSec
+timeUSec(void)
+{
+    FUNCTION_TEST_VOID();
+
+    struct timeval currentTime;
+    gettimeofday(&currentTime, NULL);
+
+    FUNCTION_TEST_RETURN(UINT64, ((TimeUSec)currentTime.tv_sec * MSEC_PER_SEC * MSEC_PER_USEC) + (TimeUSec)currentTime.tv_usec);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 sleepMSec(const TimeMSec sleepMSec)
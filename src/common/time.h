@@ -12,6 +12,7 @@ Time Management
 Time types
 ***********************************************************************************************************************************/
 typedef uint64_t TimeMSec;
+typedef uint64_t TimeUSec;
 
 /***********************************************************************************************************************************
 Constants describing number of sub-units in an interval
@@ -28,6 +29,9 @@ FN_EXTERN void sleepMSec(TimeMSec sleepMSec);
 // Epoch time in milliseconds
 FN_EXTERN TimeMSec timeMSec(void);
 
+// Epoch time in microseconds
+FN_EXTERN TimeUSec timeUSec(void);
+
 // Are the date parts valid? (year >= 1970, month 1-12, day 1-31)
 FN_EXTERN void datePartsValid(int year, int month, int day);
 
@@ -0,0 +1,275 @@
+/***********************************************************************************************************************************
+Hash Map Handler
+***********************************************************************************************************************************/
+#include <build.h>
+
+#include <string.h>
+
+#include "common/crypto/xxhash.h"
+#include "common/debug.h"
+#include "common/type/hashMap.h"
+
+/***********************************************************************************************************************************
+Initial number of slots and max load factor (as a percentage of slots used) before the slots are doubled
+***********************************************************************************************************************************/
+#define HASH_MAP_SLOT_INITIAL                                       16
+#define HASH_MAP_LOAD_MAX                                           75
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct HashMapSlot
+{
+    uint64_t hash;                                                  // Hash of the key
+    const String *key;                                              // Key (NULL when the slot is empty)
+} HashMapSlot;
+
+struct HashMap
+{
+    HashMapPub pub;                                                 // Publicly accessible variables
+    unsigned int slotMax;                                           // Number of slots (always a power of two)
+    HashMapSlot *slotList;                                          // Slots
+    uint8_t *itemList;                                              // Items stored in the same order as the slots
+};
+
+/***********************************************************************************************************************************
+Hash a key
+***********************************************************************************************************************************/
+static uint64_t
+hashMapHash(const String *const key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(UINT64, xxHash64(strZ(key), strSize(key)));
+}
+
+/***********************************************************************************************************************************
+Find the slot for a key. Returns the slot containing the key when it exists, else the empty slot where the key would be added.
+***********************************************************************************************************************************/
+static unsigned int
+hashMapSlotFind(const HashMap *const this, const String *const key, const uint64_t hash)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HASH_MAP, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(UINT64, hash);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    // Since the slots are never full, probing will always find the key or an empty slot
+    unsigned int slotIdx = (unsigned int)(hash & (this->slotMax - 1));
+
+    while (true)
+    {
+        const HashMapSlot *const slot = &this->slotList[slotIdx];
+
+        if (slot->key == NULL || (slot->hash == hash && strEq(slot->key, key)))
+            break;
+
+        slotIdx = (slotIdx + 1) & (this->slotMax - 1);
+    }
+
+    FUNCTION_TEST_RETURN(UINT, slotIdx);
+}
+
+/***********************************************************************************************************************************
+Allocate slots and items, moving existing keys and items into the new slots
+***********************************************************************************************************************************/
+static void
+hashMapResize(HashMap *const this, const unsigned int slotMax)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HASH_MAP, this);
+        FUNCTION_TEST_PARAM(UINT, slotMax);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(slotMax > this->slotMax);
+    ASSERT((slotMax & (slotMax - 1)) == 0);
+
+    HashMapSlot *const slotListOld = this->slotList;
+    uint8_t *const itemListOld = this->itemList;
+    const unsigned int slotMaxOld = this->slotMax;
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        this->slotMax = slotMax;
+        this->slotList = memNew(sizeof(HashMapSlot) * slotMax);
+        memset(this->slotList, 0, sizeof(HashMapSlot) * slotMax);
+
+        if (this->pub.itemSize != 0)
+            this->itemList = memNew(this->pub.itemSize * slotMax);
+
+        // Move keys and items into the new slots
+        for (unsigned int slotOldIdx = 0; slotOldIdx < slotMaxOld; slotOldIdx++)
+        {
+            const HashMapSlot *const slotOld = &slotListOld[slotOldIdx];
+
+            if (slotOld->key != NULL)
+            {
+                const unsigned int slotIdx = hashMapSlotFind(this, slotOld->key, slotOld->hash);
+
+                this->slotList[slotIdx] = *slotOld;
+
+                if (this->pub.itemSize != 0)
+                {
+                    memcpy(
+                        this->itemList + slotIdx * this->pub.itemSize, itemListOld + slotOldIdx * this->pub.itemSize,
+                        this->pub.itemSize);
+                }
+            }
+        }
+
+        // Free old slots and items
+        if (slotListOld != NULL)
+        {
+            memFree(slotListOld);
+
+            if (itemListOld != NULL)
+                memFree(itemListOld);
+        }
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN HashMap *
+hashMapNew(const size_t itemSize, const HashMapParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SIZE, itemSize);
+        FUNCTION_TEST_PARAM(UINT, param.size);
+    FUNCTION_TEST_END();
+
+    OBJ_NEW_BEGIN(HashMap, .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (HashMap)
+        {
+            .pub =
+            {
+                .itemSize = itemSize,
+            },
+        };
+
+        // Allocate enough slots to hold the expected number of keys without exceeding the max load
+        unsigned int slotMax = HASH_MAP_SLOT_INITIAL;
+
+        while ((uint64_t)param.size * 100 > (uint64_t)slotMax * HASH_MAP_LOAD_MAX)
+            slotMax *= 2;
+
+        hashMapResize(this, slotMax);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_TEST_RETURN(HASH_MAP, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN HashMap *
+hashMapNewStrLst(const StringList *const keyList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, keyList);
+    FUNCTION_TEST_END();
+
+    ASSERT(keyList != NULL);
+
+    HashMap *const this = hashMapNewP(0, .size = strLstSize(keyList));
+
+    for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+        hashMapAdd(this, strLstGet(keyList, keyIdx), NULL);
+
+    FUNCTION_TEST_RETURN(HASH_MAP, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void *
+hashMapAdd(HashMap *const this, const String *const key, const void *const item)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HASH_MAP, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM_P(VOID, item);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+    ASSERT(this->pub.itemSize == 0 || item != NULL);
+
+    const uint64_t hash = hashMapHash(key);
+    unsigned int slotIdx = hashMapSlotFind(this, key, hash);
+
+    // If the key is new then add it
+    if (this->slotList[slotIdx].key == NULL)
+    {
+        // Double the slots when adding the key would exceed the max load
+        if ((uint64_t)(hashMapSize(this) + 1) * 100 > (uint64_t)this->slotMax * HASH_MAP_LOAD_MAX)
+        {
+            hashMapResize(this, this->slotMax * 2);
+            slotIdx = hashMapSlotFind(this, key, hash);
+        }
+
+        this->slotList[slotIdx] = (HashMapSlot){.hash = hash, .key = key};
+        this->pub.size++;
+    }
+
+    // Copy the item
+    void *result = NULL;
+
+    if (this->pub.itemSize != 0)
+    {
+        result = this->itemList + slotIdx * this->pub.itemSize;
+        memcpy(result, item, this->pub.itemSize);
+    }
+
+    FUNCTION_TEST_RETURN_P(VOID, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void *
+hashMapGet(const HashMap *const this, const String *const key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HASH_MAP, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->pub.itemSize != 0);
+    ASSERT(key != NULL);
+
+    const unsigned int slotIdx = hashMapSlotFind(this, key, hashMapHash(key));
+
+    FUNCTION_TEST_RETURN_P(
+        VOID, this->slotList[slotIdx].key == NULL ? NULL : this->itemList + slotIdx * this->pub.itemSize);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+hashMapExists(const HashMap *const this, const String *const key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HASH_MAP, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->slotList[hashMapSlotFind(this, key, hashMapHash(key))].key != NULL);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+hashMapToLog(const HashMap *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{size: %u}", hashMapSize(this));
+}
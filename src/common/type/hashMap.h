@@ -0,0 +1,104 @@
+/***********************************************************************************************************************************
+Hash Map Handler
+
+Map String keys to fixed-size items using open addressing with linear probing. Keys are hashed with xxHash so lookups are constant
+time on average rather than the O(log n) string comparisons required to bsearch() a sorted List or StringList. This makes a hash map
+a better choice for lookups done in a loop over a large number of keys, e.g. matching the files of a prior manifest.
+
+Keys are not copied, so they must remain valid for the lifetime of the hash map. This is generally the case when the keys are
+Strings stored in another object, e.g. a StringList or the files in a Manifest, and avoids duplicating a large number of keys. An
+item size of zero may be used when the hash map is only needed to test for the existence of keys.
+***********************************************************************************************************************************/
+#ifndef COMMON_TYPE_HASHMAP_H
+#define COMMON_TYPE_HASHMAP_H
+
+/***********************************************************************************************************************************
+Hash map object
+***********************************************************************************************************************************/
+typedef struct HashMap HashMap;
+
+#include "common/type/object.h"
+#include "common/type/param.h"
+#include "common/type/string.h"
+#include "common/type/stringList.h"
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+typedef struct HashMapParam
+{
+    VAR_PARAM_HEADER;
+    unsigned int size;                                              // Expected number of keys (avoids resizing while adding)
+} HashMapParam;
+
+#define hashMapNewP(itemSize, ...)                                                                                                 \
+    hashMapNew(itemSize, (HashMapParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN HashMap *hashMapNew(size_t itemSize, HashMapParam param);
+
+// Create a hash map with the Strings in a StringList as keys (and no items) to test for existence of keys
+FN_EXTERN HashMap *hashMapNewStrLst(const StringList *keyList);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+typedef struct HashMapPub
+{
+    unsigned int size;                                              // Number of keys in the hash map
+    size_t itemSize;                                                // Size of item stored with each key
+} HashMapPub;
+
+// Number of keys in the hash map
+FN_INLINE_ALWAYS unsigned int
+hashMapSize(const HashMap *const this)
+{
+    return THIS_PUB(HashMap)->size;
+}
+
+// Is the hash map empty?
+FN_INLINE_ALWAYS bool
+hashMapEmpty(const HashMap *const this)
+{
+    return hashMapSize(this) == 0;
+}
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Add a key and item (the item must be NULL when the item size is zero). If the key already exists then the item is replaced.
+// Returns a pointer to the item stored in the hash map (NULL when the item size is zero).
+FN_EXTERN void *hashMapAdd(HashMap *this, const String *key, const void *item);
+
+// Get the item for a key or NULL if the key does not exist (the item size must not be zero)
+FN_EXTERN void *hashMapGet(const HashMap *this, const String *key);
+
+// Does the key exist?
+FN_EXTERN bool hashMapExists(const HashMap *this, const String *key);
+
+// Move to a new parent mem context
+FN_INLINE_ALWAYS HashMap *
+hashMapMove(HashMap *const this, MemContext *const parentNew)
+{
+    return objMove(this, parentNew);
+}
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+hashMapFree(HashMap *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+FN_EXTERN void hashMapToLog(const HashMap *this, StringStatic *debugLog);
+
+#define FUNCTION_LOG_HASH_MAP_TYPE                                                                                                 \
+    HashMap *
+#define FUNCTION_LOG_HASH_MAP_FORMAT(value, buffer, bufferSize)                                                                    \
+    FUNCTION_LOG_OBJECT_FORMAT(value, hashMapToLog, buffer, bufferSize)
+
+#endif
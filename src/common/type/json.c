@@ -953,7 +953,9 @@ jsonReadStr(JsonRead *const this)
     // Read string
     jsonReadPush(this, jsonTypeString, false);
 
-    String *const result = strNew();
+    // The string is only created when an escape is found. Strings without escapes, which are most strings, are created with a fixed
+    // size buffer so they require a single allocation.
+    String *result = NULL;
 
     // Skip the beginning "
     ASSERT(*this->json == '"');
@@ -968,6 +970,9 @@ jsonReadStr(JsonRead *const this)
         if (*this->json == '\\')
         {
             // Copy portion of string without escapes
+            if (result == NULL)
+                result = strNew();
+
             if (noEscapeSize > 0)
             {
                 strCatZN(result, noEscape, noEscapeSize);
@@ -1045,8 +1050,10 @@ jsonReadStr(JsonRead *const this)
         this->json++;
     }
 
-    // Copy portion of string without escapes
-    if (noEscapeSize > 0)
+    // Create the string if there were no escapes, else copy portion of string without escapes
+    if (result == NULL)
+        result = strNewZN(noEscapeSize > 0 ? noEscape : "", noEscapeSize);
+    else if (noEscapeSize > 0)
         strCatZN(result, noEscape, noEscapeSize);
 
     // Advance the character array pointer to the next element after the string
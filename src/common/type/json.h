@@ -77,7 +77,8 @@ FN_EXTERN void jsonReadObjectEnd(JsonRead *this);
 // Skip value
 FN_EXTERN void jsonReadSkip(JsonRead *this);
 
-// Read string
+// Read string. The string may be fixed length (see strNew() for details) so it must not be modified. Use strCat(strNew(), ...) to
+// get a copy that can be modified.
 FN_EXTERN String *jsonReadStr(JsonRead *this);
 FN_EXTERN StringId jsonReadStrId(JsonRead *this);
 FN_EXTERN StringList *jsonReadStrLst(JsonRead *this);
@@ -736,13 +736,11 @@ strEq(const String *const this, const String *const compare)
 
     bool result = false;
 
-    if (this != NULL && compare != NULL)
-    {
-        if (strSize(this) == strSize(compare))
-            result = strcmp(strZ(this), strZ(compare)) == 0;
-    }
-    else
-        result = this == NULL && compare == NULL;
+    // Interned strings, e.g. user and group names, are often compared with themselves
+    if (this == compare)
+        result = true;
+    else if (this != NULL && compare != NULL && strSize(this) == strSize(compare))
+        result = strcmp(strZ(this), strZ(compare)) == 0;
 
     FUNCTION_TEST_RETURN(BOOL, result);
 }
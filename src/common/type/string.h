@@ -53,7 +53,8 @@ String *example = strCatZ(strNew(), "example");
 This syntax signals that the string will be modified so the string is allocated separately from the object so it can be resized when
 needed. Most strings never need to be modified and can be stored more efficiently by allocating their memory with the object.
 ***********************************************************************************************************************************/
-// Create a new empty string for concatenation
+// Create a new empty string for concatenation. Strings created by the other constructors are fixed length and may not grow, so use
+// strCatFmt(strNew(), ...) rather than strNewFmt() to create a formatted string that will be concatenated.
 FN_EXTERN String *strNew(void);
 
 // Create a new fixed length string from a zero-terminated string
@@ -9,6 +9,7 @@ System User/Group Management
 
 #include "common/debug.h"
 #include "common/memContext.h"
+#include "common/type/list.h"
 #include "common/user.h"
 
 /***********************************************************************************************************************************
@@ -18,15 +19,11 @@ On systems where uid/gid lookups are routed to a remote name service (sssd, syst
 call costs a Unix-socket round-trip plus its own audit-and-syscall overhead. Profiling shows this can dominate the manifest-build
 phase for clusters with millions of files even though the data files almost always share a single owner (typically "postgres").
 
-The cache is a small fixed-size array because the working set of unique ids on a PG host is tiny (usually 1-3). Linear scan is
-faster than a hash table at this size and avoids any allocation in the hot path. The cached String lives in memContextTop() so it
-survives the caller's context.
-
-Cache misses past USER_NAME_CACHE_SIZE fall through to an uncached lookup (correct but slow); in practice we never exceed the table
-for a backup of a normally-configured cluster.
+The cache is a list because the working set of unique ids on a PG host is tiny (usually 1-3). Linear scan is faster than a hash
+table at this size and avoids any allocation in the hot path. Every id that is looked up is cached, so the cache is bounded by the
+number of ids on the host. The cached String lives in memContextTop() so it survives the caller's context and callers always share
+the same String for an id.
 ***********************************************************************************************************************************/
-#define USER_NAME_CACHE_SIZE                                        16
-
 typedef struct UserNameCache
 {
     uid_t id;                                                       // The uid that was looked up
@@ -49,13 +46,11 @@ static struct
     uid_t userId;                                                   // Real user id of the calling process from getuid()
     bool userRoot;                                                  // Is this the root user?
     const String *userName;                                         // User name if it exists
-    UserNameCache userNameCache[USER_NAME_CACHE_SIZE];              // User name cache
-    unsigned int userNameCacheTotal;                                // User cache total
+    List *userNameCache;                                            // User name cache
 
     gid_t groupId;                                                  // Real group id of the calling process from getgid()
     const String *groupName;                                        // Group name if it exists
-    GroupNameCache groupNameCache[USER_NAME_CACHE_SIZE];            // Group name cache
-    unsigned int groupNameCacheTotal;                               // Group name cache total
+    List *groupNameCache;                                           // Group name cache
 
 #ifdef HAVE_LIBSSH2
     const String *userHome;                                         // User home directory
@@ -138,42 +133,44 @@ groupName(void)
 }
 
 /**********************************************************************************************************************************/
-FN_EXTERN String *
+FN_EXTERN const String *
 groupNameFromId(const gid_t groupId)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(UINT, groupId);
     FUNCTION_TEST_END();
 
-    // Cache lookup on a small fixed-size table -- linear scan is fastest at this size
-    for (unsigned int groupIdx = 0; groupIdx < userLocalData.groupNameCacheTotal; groupIdx++)
+    // Cache lookup -- linear scan is fastest for the few ids on a host
+    if (userLocalData.groupNameCache != NULL)
     {
-        if (userLocalData.groupNameCache[groupIdx].id == groupId)
-            FUNCTION_TEST_RETURN(STRING, strDup(userLocalData.groupNameCache[groupIdx].name));
+        for (unsigned int groupIdx = 0; groupIdx < lstSize(userLocalData.groupNameCache); groupIdx++)
+        {
+            const GroupNameCache *const cache = lstGet(userLocalData.groupNameCache, groupIdx);
+
+            if (cache->id == groupId)
+                FUNCTION_TEST_RETURN_CONST(STRING, cache->name);
+        }
     }
 
     // Cache miss -- do the actual lookup
     const struct group *const groupData = getgrgid(groupId);
-    String *const result = groupData != NULL ? strNewZ(groupData->gr_name) : NULL;
 
-    // Record the answer (including the negative case) so we never look this id up again. Past USER_NAME_CACHE_SIZE we just fall
-    // back to per-call lookup, which is correct -- only slower for the unusual case of many distinct owners.
-    if (userLocalData.groupNameCacheTotal < USER_NAME_CACHE_SIZE)
+    // Record the answer (including the negative case) so we never look this id up again and return the cached name so all
+    // callers share it
+    const GroupNameCache *cache;
+
+    MEM_CONTEXT_BEGIN(memContextTop())
     {
-        MEM_CONTEXT_BEGIN(memContextTop())
-        {
-            userLocalData.groupNameCache[userLocalData.groupNameCacheTotal] = (GroupNameCache)
-            {
-                .id = groupId,
-                .name = strDup(result),
-            };
-        }
-        MEM_CONTEXT_END();
+        if (userLocalData.groupNameCache == NULL)
+            userLocalData.groupNameCache = lstNewP(sizeof(GroupNameCache));
 
-        userLocalData.groupNameCacheTotal++;
+        cache = lstAdd(
+            userLocalData.groupNameCache,
+            &(GroupNameCache){.id = groupId, .name = groupData != NULL ? strNewZ(groupData->gr_name) : NULL});
     }
+    MEM_CONTEXT_END();
 
-    FUNCTION_TEST_RETURN(STRING, result);
+    FUNCTION_TEST_RETURN_CONST(STRING, cache->name);
 }
 
 /**********************************************************************************************************************************/
@@ -241,42 +238,44 @@ userName(void)
 }
 
 /**********************************************************************************************************************************/
-FN_EXTERN String *
+FN_EXTERN const String *
 userNameFromId(const uid_t userId)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(UINT, userId);
     FUNCTION_TEST_END();
 
-    // Cache lookup on a small fixed-size table -- linear scan is fastest at this size
-    for (unsigned int userIdx = 0; userIdx < userLocalData.userNameCacheTotal; userIdx++)
+    // Cache lookup -- linear scan is fastest for the few ids on a host
+    if (userLocalData.userNameCache != NULL)
     {
-        if (userLocalData.userNameCache[userIdx].id == userId)
-            FUNCTION_TEST_RETURN(STRING, strDup(userLocalData.userNameCache[userIdx].name));
+        for (unsigned int userIdx = 0; userIdx < lstSize(userLocalData.userNameCache); userIdx++)
+        {
+            const UserNameCache *const cache = lstGet(userLocalData.userNameCache, userIdx);
+
+            if (cache->id == userId)
+                FUNCTION_TEST_RETURN_CONST(STRING, cache->name);
+        }
     }
 
     // Cache miss -- do the actual lookup
     const struct passwd *const userData = getpwuid(userId);
-    String *const result = userData != NULL ? strNewZ(userData->pw_name) : NULL;
 
-    // Record the answer (including the negative case) so we never look this id up again. Past USER_NAME_CACHE_SIZE we just fall
-    // back to per-call lookup, which is correct -- only slower for the unusual case of many distinct owners.
-    if (userLocalData.userNameCacheTotal < USER_NAME_CACHE_SIZE)
+    // Record the answer (including the negative case) so we never look this id up again and return the cached name so all
+    // callers share it
+    const UserNameCache *cache;
+
+    MEM_CONTEXT_BEGIN(memContextTop())
     {
-        MEM_CONTEXT_BEGIN(memContextTop())
-        {
-            userLocalData.userNameCache[userLocalData.userNameCacheTotal] = (UserNameCache)
-            {
-                .id = userId,
-                .name = strDup(result),
-            };
-        }
-        MEM_CONTEXT_END();
+        if (userLocalData.userNameCache == NULL)
+            userLocalData.userNameCache = lstNewP(sizeof(UserNameCache));
 
-        userLocalData.userNameCacheTotal++;
+        cache = lstAdd(
+            userLocalData.userNameCache,
+            &(UserNameCache){.id = userId, .name = userData != NULL ? strNewZ(userData->pw_name) : NULL});
     }
+    MEM_CONTEXT_END();
 
-    FUNCTION_TEST_RETURN(STRING, result);
+    FUNCTION_TEST_RETURN_CONST(STRING, cache->name);
 }
 
 /**********************************************************************************************************************************/
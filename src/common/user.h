@@ -23,8 +23,9 @@ FN_EXTERN gid_t groupIdFromName(const String *groupName);
 // Get the primary group name of the current user. Returns NULL if there is no mapping.
 FN_EXTERN const String *groupName(void);
 
-// Get the group name from a group id. Returns NULL if the group id is invalid or there is no mapping.
-FN_EXTERN String *groupNameFromId(gid_t groupId);
+// Get the group name from a group id. Returns NULL if the group id is invalid or there is no mapping. Names are cached so the same
+// String is returned for the same id and must not be freed.
+FN_EXTERN const String *groupNameFromId(gid_t groupId);
 
 #ifdef HAVE_LIBSSH2
 
@@ -45,8 +46,9 @@ FN_EXTERN uid_t userIdFromName(const String *userName);
 // Get the name of the current user. Returns NULL if there is no mapping.
 FN_EXTERN const String *userName(void);
 
-// Get the user name from a user id. Returns NULL if the user id is invalid or there is no mapping.
-FN_EXTERN String *userNameFromId(uid_t userId);
+// Get the user name from a user id. Returns NULL if the user id is invalid or there is no mapping. Names are cached so the same
+// String is returned for the same id and must not be freed.
+FN_EXTERN const String *userNameFromId(uid_t userId);
 
 // Is the current user the root user?
 FN_EXTERN bool userRoot(void);
@@ -14,6 +14,7 @@ Command constants
 #define CFGCMD_ARCHIVE_PUSH                                         "archive-push"
 #define CFGCMD_BACKUP                                               "backup"
 #define CFGCMD_CHECK                                                "check"
+#define CFGCMD_CONSOLIDATE                                          "consolidate"
 #define CFGCMD_EXPIRE                                               "expire"
 #define CFGCMD_HELP                                                 "help"
 #define CFGCMD_INFO                                                 "info"
@@ -32,7 +33,7 @@ Command constants
 #define CFGCMD_VERIFY                                               "verify"
 #define CFGCMD_VERSION                                              "version"
 
-#define CFG_COMMAND_TOTAL                                           22
+#define CFG_COMMAND_TOTAL                                           23
 
 /***********************************************************************************************************************************
 Option group constants
@@ -47,8 +48,11 @@ Option constants
 #define CFGOPT_ARCHIVE_ASYNC                                        "archive-async"
 #define CFGOPT_ARCHIVE_CHECK                                        "archive-check"
 #define CFGOPT_ARCHIVE_COPY                                         "archive-copy"
+#define CFGOPT_ARCHIVE_DUPLICATE_CHECK                              "archive-duplicate-check"
 #define CFGOPT_ARCHIVE_EXPIRE_BEFORE                                "archive-expire-before"
+#define CFGOPT_ARCHIVE_GET_QUEUE_ADAPT                              "archive-get-queue-adapt"
 #define CFGOPT_ARCHIVE_GET_QUEUE_MAX                                "archive-get-queue-max"
+#define CFGOPT_ARCHIVE_GET_REPO_PARALLEL                            "archive-get-repo-parallel"
 #define CFGOPT_ARCHIVE_HEADER_CHECK                                 "archive-header-check"
 #define CFGOPT_ARCHIVE_MISSING_RETRY                                "archive-missing-retry"
 #define CFGOPT_ARCHIVE_MODE                                         "archive-mode"
@@ -62,9 +66,12 @@ Option constants
 #define CFGOPT_CHECKSUM_PAGE                                        "checksum-page"
 #define CFGOPT_CMD                                                  "cmd"
 #define CFGOPT_CMD_SSH                                              "cmd-ssh"
+#define CFGOPT_CMD_SSH_MULTIPLEX                                    "cmd-ssh-multiplex"
 #define CFGOPT_COMPRESS                                             "compress"
 #define CFGOPT_COMPRESS_LEVEL                                       "compress-level"
+#define CFGOPT_COMPRESS_LEVEL_ADAPT                                 "compress-level-adapt"
 #define CFGOPT_COMPRESS_LEVEL_NETWORK                               "compress-level-network"
+#define CFGOPT_COMPRESS_THREAD                                      "compress-thread"
 #define CFGOPT_COMPRESS_TYPE                                        "compress-type"
 #define CFGOPT_CONFIG                                               "config"
 #define CFGOPT_CONFIG_INCLUDE_PATH                                  "config-include-path"
@@ -123,6 +130,8 @@ Option constants
 #define CFGOPT_SPOOL_PATH                                           "spool-path"
 #define CFGOPT_STANZA                                               "stanza"
 #define CFGOPT_START_FAST                                           "start-fast"
+#define CFGOPT_STAT                                                 "stat"
+#define CFGOPT_STAT_FILE                                            "stat-file"
 #define CFGOPT_STOP_AUTO                                            "stop-auto"
 #define CFGOPT_TABLESPACE_MAP                                       "tablespace-map"
 #define CFGOPT_TABLESPACE_MAP_ALL                                   "tablespace-map-all"
@@ -140,12 +149,16 @@ Option constants
 #define CFGOPT_TLS_SERVER_CA_FILE                                   "tls-server-ca-file"
 #define CFGOPT_TLS_SERVER_CERT_FILE                                 "tls-server-cert-file"
 #define CFGOPT_TLS_SERVER_KEY_FILE                                  "tls-server-key-file"
+#define CFGOPT_TLS_SERVER_POOL                                      "tls-server-pool"
 #define CFGOPT_TLS_SERVER_PORT                                      "tls-server-port"
+#define CFGOPT_TLS_SERVER_RESUME                                    "tls-server-resume"
 #define CFGOPT_TYPE                                                 "type"
 #define CFGOPT_VERBOSE                                              "verbose"
+#define CFGOPT_VERIFY_INCREMENTAL                                   "verify-incremental"
+#define CFGOPT_VERIFY_SAMPLE                                        "verify-sample"
 #define CFGOPT_VERSION                                              "version"
 
-#define CFG_OPTION_TOTAL                                            199
+#define CFG_OPTION_TOTAL                                            215
 
 /***********************************************************************************************************************************
 Option value constants
@@ -447,6 +460,7 @@ typedef enum
     cfgCmdArchivePush,
     cfgCmdBackup,
     cfgCmdCheck,
+    cfgCmdConsolidate,
     cfgCmdExpire,
     cfgCmdHelp,
     cfgCmdInfo,
@@ -485,8 +499,11 @@ typedef enum
     cfgOptArchiveAsync,
     cfgOptArchiveCheck,
     cfgOptArchiveCopy,
+    cfgOptArchiveDuplicateCheck,
     cfgOptArchiveExpireBefore,
+    cfgOptArchiveGetQueueAdapt,
     cfgOptArchiveGetQueueMax,
+    cfgOptArchiveGetRepoParallel,
     cfgOptArchiveHeaderCheck,
     cfgOptArchiveMissingRetry,
     cfgOptArchiveMode,
@@ -500,9 +517,12 @@ typedef enum
     cfgOptChecksumPage,
     cfgOptCmd,
     cfgOptCmdSsh,
+    cfgOptCmdSshMultiplex,
     cfgOptCompress,
     cfgOptCompressLevel,
+    cfgOptCompressLevelAdapt,
     cfgOptCompressLevelNetwork,
+    cfgOptCompressThread,
     cfgOptCompressType,
     cfgOptConfig,
     cfgOptConfigIncludePath,
@@ -578,6 +598,8 @@ typedef enum
     cfgOptRepoBlock,
     cfgOptRepoBlockAgeMap,
     cfgOptRepoBlockChecksumSizeMap,
+    cfgOptRepoBlockFullSynthetic,
+    cfgOptRepoBlockFullSyntheticDepth,
     cfgOptRepoBlockSizeMap,
     cfgOptRepoBlockSizeSuper,
     cfgOptRepoBlockSizeSuperFull,
@@ -586,6 +608,7 @@ typedef enum
     cfgOptRepoBundleSize,
     cfgOptRepoCipherPass,
     cfgOptRepoCipherType,
+    cfgOptRepoDedup,
     cfgOptRepoGcsBucket,
     cfgOptRepoGcsEndpoint,
     cfgOptRepoGcsKey,
@@ -637,6 +660,7 @@ typedef enum
     cfgOptRepoSftpPrivateKeyFile,
     cfgOptRepoSftpPrivateKeyPassphrase,
     cfgOptRepoSftpPublicKeyFile,
+    cfgOptRepoSftpWindowSize,
     cfgOptRepoStorageCaFile,
     cfgOptRepoStorageCaPath,
     cfgOptRepoStorageHost,
@@ -658,6 +682,8 @@ typedef enum
     cfgOptSpoolPath,
     cfgOptStanza,
     cfgOptStartFast,
+    cfgOptStat,
+    cfgOptStatFile,
     cfgOptStopAuto,
     cfgOptTablespaceMap,
     cfgOptTablespaceMapAll,
@@ -675,9 +701,13 @@ typedef enum
     cfgOptTlsServerCaFile,
     cfgOptTlsServerCertFile,
     cfgOptTlsServerKeyFile,
+    cfgOptTlsServerPool,
     cfgOptTlsServerPort,
+    cfgOptTlsServerResume,
     cfgOptType,
     cfgOptVerbose,
+    cfgOptVerifyIncremental,
+    cfgOptVerifySample,
     cfgOptVersion,
 } ConfigOption;
 
@@ -17,6 +17,7 @@ Configuration Load
 #include "common/io/tls/common.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/stat.h"
 #include "common/user.h"
 #include "config/config.intern.h"
 #include "config/load.h"
@@ -529,6 +530,12 @@ cfgLoad(const unsigned int argListSize, const char *argList[])
         if (cfgOptionValid(cfgOptIoTimeout))
             ioTimeoutMsSet(cfgOptionUInt64(cfgOptIoTimeout));
 
+        // Enable timing stats only when they will be output, i.e. the stat-file option is set or detail logging is enabled. Locals
+        // and remotes are told by the stat option since they can't see the stat-file option and may have logging disabled.
+        statTimeEnabledSet(
+            (cfgOptionValid(cfgOptStat) && cfgOptionBool(cfgOptStat)) ||
+            (cfgOptionValid(cfgOptStatFile) && cfgOptionTest(cfgOptStatFile)) || logAny(logLevelDetail));
+
         // Open the log file if this command logs to a file
         cfgLoadLogFile();
 
@@ -153,7 +153,7 @@ infoNewLoad(
             {
                 Ini *const ini = iniNewP(read, .strict = true);
 
-                MEM_CONTEXT_TEMP_RESET_BEGIN()
+                MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN()
                 {
                     const IniValue *value = iniValueNext(ini);
 
@@ -490,7 +490,8 @@ infoBackupDataAdd(InfoBackup *const this, const Manifest *const manifest)
                 infoBackupData.backupInfoRepoSizeMapDelta = varNewUInt64(backupRepoSizeMapDelta);
             }
 
-            if (manData->backupType != backupTypeFull)
+            // Diff/incr and synthetic full backups have a prior backup
+            if (manData->backupLabelPrior != NULL)
             {
                 // This list may not be sorted for manifests created before the reference list was added. Remove the last reference
                 // since it will always be the current backup. Technically the current backup is always referenced but this is not
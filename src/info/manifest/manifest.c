@@ -362,13 +362,36 @@ manifestBuildValidate(Manifest *const this, const bool delta, const time_t copyS
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN HashMap *
+manifestFilePackMap(const Manifest *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    HashMap *const result = hashMapNewP(sizeof(const ManifestFilePack *), .size = manifestFileTotal(this));
+
+    for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(this); fileIdx++)
+    {
+        // The file pack begins with the file name so it can be used as the key
+        const ManifestFilePack *const filePack = manifestFilePackGet(this, fileIdx);
+        hashMapAdd(result, (const String *)filePack, &filePack);
+    }
+
+    FUNCTION_TEST_RETURN(HASH_MAP, result);
+}
+
 /**********************************************************************************************************************************/
 static void
-manifestDeltaCheck(Manifest *const this, const Manifest *const manifestPrior)
+manifestDeltaCheck(Manifest *const this, const Manifest *const manifestPrior, const HashMap *const filePackPriorMap)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, this);
         FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
+        FUNCTION_LOG_PARAM(HASH_MAP, filePackPriorMap);
     FUNCTION_LOG_END();
 
     MEM_CONTEXT_TEMP_BEGIN()
@@ -381,9 +404,11 @@ manifestDeltaCheck(Manifest *const this, const Manifest *const manifestPrior)
                 const ManifestFile file = manifestFile(this, fileIdx);
 
                 // If file was found in prior manifest then perform checks
-                if (manifestFileExists(manifestPrior, file.name))
+                const ManifestFilePack *const *const filePackPrior = hashMapGet(filePackPriorMap, file.name);
+
+                if (filePackPrior != NULL)
                 {
-                    const ManifestFile filePrior = manifestFileFind(manifestPrior, file.name);
+                    const ManifestFile filePrior = manifestFileUnpack(manifestPrior, *filePackPrior);
 
                     // Check for timestamp earlier than the prior backup
                     if (file.timestamp < filePrior.timestamp)
@@ -431,7 +456,7 @@ manifestBuildIncr(
 
     ASSERT(this != NULL);
     ASSERT(manifestPrior != NULL);
-    ASSERT(type == backupTypeDiff || type == backupTypeIncr);
+    ASSERT(type == backupTypeFull || type == backupTypeDiff || type == backupTypeIncr);
     ASSERT(type != backupTypeDiff || manifestPrior->pub.data.backupType == backupTypeFull);
     ASSERT(archiveStart == NULL || strSize(archiveStart) == 24);
 
@@ -443,7 +468,7 @@ manifestBuildIncr(
         // Copy reference list
         this->pub.referenceList = strLstDup(manifestPrior->pub.referenceList);
 
-        // Set diff/incr backup type
+        // Set backup type
         this->pub.data.backupType = type;
 
         // Bundle raw must not change in a backup set
@@ -453,8 +478,14 @@ manifestBuildIncr(
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Enable delta if timelines differ
-        if (archiveStart != NULL && manifestData(manifestPrior)->archiveStop != NULL &&
+        // Enable delta for a synthetic full since every file must be checked against the prior backup rather than trusting
+        // timestamps
+        if (type == backupTypeFull)
+        {
+            this->pub.data.backupOptionDelta = BOOL_TRUE_VAR;
+        }
+        // Else enable delta if timelines differ
+        else if (archiveStart != NULL && manifestData(manifestPrior)->archiveStop != NULL &&
             !strEq(strSubN(archiveStart, 0, 8), strSubN(manifestData(manifestPrior)->archiveStop, 0, 8)))
         {
             LOG_WARN_FMT(
@@ -474,8 +505,11 @@ manifestBuildIncr(
             this->pub.data.backupOptionDelta = BOOL_TRUE_VAR;
         }
 
+        // Map prior files by name for matching
+        const HashMap *const filePackPriorMap = manifestFilePackMap(manifestPrior);
+
         // Enable delta if/when there are timestamp anomalies
-        manifestDeltaCheck(this, manifestPrior);
+        manifestDeltaCheck(this, manifestPrior, filePackPriorMap);
 
         // Find files to (possibly) reference in the prior manifest
         const bool delta = varBool(this->pub.data.backupOptionDelta);
@@ -485,14 +519,12 @@ manifestBuildIncr(
             ManifestFile file = manifestFile(this, fileIdx);
 
             // Check if a prior file exists for files that will be copied (i.e. not zero-length files when bundling). If a prior
-            // file does exist it may be possible to reference it instead of copying the file. Use the "find or NULL" variant so we
-            // do one binary search instead of the manifestFileExists()/manifestFileFind() pair, which would do two.
-            const ManifestFilePack *const filePackPrior =
-                file.copy ? manifestFilePackFindDefault(manifestPrior, file.name) : NULL;
+            // file does exist it may be possible to reference it instead of copying the file.
+            const ManifestFilePack *const *const filePackPrior = file.copy ? hashMapGet(filePackPriorMap, file.name) : NULL;
 
             if (filePackPrior != NULL)
             {
-                const ManifestFile filePrior = manifestFileUnpack(manifestPrior, filePackPrior);
+                const ManifestFile filePrior = manifestFileUnpack(manifestPrior, *filePackPrior);
 
                 // If file size is equal to prior size then the file can be referenced instead of copied if it has not changed (this
                 // must be determined during the backup).
@@ -504,6 +536,11 @@ manifestBuildIncr(
                 // backup set and the map info will be required to compare against the prior block incremental.
                 const bool fileBlockIncrPreserve = filePrior.blockIncrMapSize > 0 && file.size >= filePrior.blockIncrSize;
 
+                // A synthetic full only references files stored with block incremental in the prior backup. All other files are
+                // copied so the synthetic full depends as little as possible on prior backups.
+                if (type == backupTypeFull && !fileBlockIncrPreserve)
+                    continue;
+
                 // Perform delta if enabled and file size is equal to prior but not zero. Files of unequal length are always
                 // different while zero-length files are always the same, so it wastes time to check them. It is possible for a file
                 // to be truncated down to equal the prior file during backup, but the overhead of checking for such an unlikely
@@ -543,6 +580,7 @@ manifestBuildIncr(
                     file.blockIncrSize = filePrior.blockIncrSize;
                     file.blockIncrChecksumSize = filePrior.blockIncrChecksumSize;
                     file.blockIncrMapSize = filePrior.blockIncrMapSize;
+                    file.dedup = filePrior.dedup;
 
                     ASSERT(file.checksumSha1 != NULL);
                     ASSERT(
@@ -863,3 +901,30 @@ manifestBackupLabelSet(Manifest *const this, const String *const backupLabel)
 
     FUNCTION_TEST_RETURN_VOID();
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+manifestBackupFullSet(Manifest *const this, const String *const backupLabel)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, this);
+        FUNCTION_TEST_PARAM(STRING, backupLabel);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(backupLabel != NULL);
+
+    MEM_CONTEXT_BEGIN(this->pub.memContext)
+    {
+        this->pub.data.backupLabel = strDup(backupLabel);
+        this->pub.data.backupLabelPrior = NULL;
+        this->pub.data.backupType = backupTypeFull;
+
+        strLstFree(this->pub.referenceList);
+        this->pub.referenceList = strLstNew();
+        strLstAdd(this->pub.referenceList, this->pub.data.backupLabel);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
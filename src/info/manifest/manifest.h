@@ -39,6 +39,7 @@ typedef struct Manifest Manifest;
 #include "common/compress/helper.h"
 #include "common/crypto/hash.h"
 #include "common/crypto/spec.h"
+#include "common/type/hashMap.h"
 #include "common/type/object.h"
 #include "common/type/variant.h"
 #include "info/info.h"
@@ -53,7 +54,7 @@ typedef struct ManifestData
     const String *backrestVersion;                                  // pgBackRest version
 
     const String *backupLabel;                                      // Backup label (unique identifier for the backup)
-    const String *backupLabelPrior;                                 // Backup label for backup this diff/incr is based on
+    const String *backupLabelPrior;                                 // Prior backup label for diff/incr/synthetic full
     time_t backupTimestampCopyStart;                                // When did the file copy start?
     time_t backupTimestampStart;                                    // When did the backup start?
     time_t backupTimestampStop;                                     // When did the backup stop?
@@ -142,6 +143,7 @@ typedef struct ManifestFile
     bool resume : 1;                                                // Is the file being resumed (backup only)?
     bool checksumPage : 1;                                          // Does this file have page checksums?
     bool checksumPageError : 1;                                     // Is there an error in the page checksum?
+    bool dedup : 1;                                                 // Is the file stored in the repo dedup store?
     mode_t mode;                                                    // File mode
     const uint8_t *checksumSha1;                                    // SHA1 checksum
     const uint8_t *checksumRepoSha1;                                // SHA1 checksum as stored in repo (including compression, etc.)
@@ -266,13 +268,18 @@ manifestReferenceList(const Manifest *const this)
 // Set backup label
 FN_EXTERN void manifestBackupLabelSet(Manifest *this, const String *backupLabel);
 
+// Make the manifest a full backup with the specified label that does not reference prior backups. File references are stored as an
+// index into the reference list so all files must already have been updated to remove their references.
+FN_EXTERN void manifestBackupFullSet(Manifest *this, const String *backupLabel);
+
 /***********************************************************************************************************************************
 Build functions
 ***********************************************************************************************************************************/
 // Validate the timestamps in the manifest given a copy start time, i.e. all times should be <= the copy start time
 FN_EXTERN void manifestBuildValidate(Manifest *this, bool delta, time_t copyStart, CompressType compressType);
 
-// Create a diff/incr backup by comparing to a previous backup manifest
+// Create a diff/incr backup by comparing to a previous backup manifest. A synthetic full backup is also built this way but only
+// references files stored with block incremental in the previous backup.
 FN_EXTERN void manifestBuildIncr(Manifest *this, const Manifest *prior, BackupType type, const String *archiveStart);
 
 // Set remaining values before the final save
@@ -359,15 +366,9 @@ FN_EXTERN void manifestFileAdd(Manifest *this, ManifestFile *file);
 // Find file in pack format by name
 FN_EXTERN const ManifestFilePack *manifestFilePackFind(const Manifest *this, const String *name);
 
-// Find file in pack format by name, returning NULL when missing. Cheaper than calling manifestFileExists() followed by
-// manifestFilePackFind() because it does only one binary search.
-FN_INLINE_ALWAYS const ManifestFilePack *
-manifestFilePackFindDefault(const Manifest *const this, const String *const name)
-{
-    ASSERT_INLINE(name != NULL);
-    const ManifestFilePack *const *const filePack = lstFindDefault(THIS_PUB(Manifest)->fileList, &name, NULL);
-    return filePack == NULL ? NULL : *filePack;
-}
+// Map file names to file packs so files can be matched without a binary search for each file. The keys reference the file packs
+// so the map must not be used after files have been added, updated, or removed.
+FN_EXTERN HashMap *manifestFilePackMap(const Manifest *this);
 
 // Find file by name
 FN_INLINE_ALWAYS ManifestFile
@@ -13,6 +13,7 @@ Main
 #include "command/backup/backup.h"
 #include "command/check/check.h"
 #include "command/command.h"
+#include "command/consolidate/consolidate.h"
 #include "command/control/start.h"
 #include "command/control/stop.h"
 #include "command/exit.h"
@@ -169,6 +170,12 @@ main(int argListSize, const char *argList[])
                     cmdCheck();
                     break;
 
+                // Consolidate command
+                // -----------------------------------------------------------------------------------------------------------------
+                case cfgCmdConsolidate:
+                    cmdConsolidate();
+                    break;
+
                 // Expire command
                 // -----------------------------------------------------------------------------------------------------------------
                 case cfgCmdExpire:
@@ -524,30 +524,6 @@ pgWalFromBuffer(const Buffer *const walBuffer, const String *const pgVersionForc
     FUNCTION_LOG_RETURN(PG_WAL, result);
 }
 
-FN_EXTERN PgWal
-pgWalFromFile(const String *const walFile, const Storage *const storage, const String *const pgVersionForce)
-{
-    FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(STRING, walFile);
-        FUNCTION_LOG_PARAM(STRING, pgVersionForce);
-    FUNCTION_LOG_END();
-
-    ASSERT(walFile != NULL);
-
-    PgWal result;
-
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        // Read WAL segment header
-        const Buffer *const walBuffer = storageGetP(storageNewReadP(storage, walFile), .exactSize = PG_WAL_HEADER_SIZE);
-
-        result = pgWalFromBuffer(walBuffer, pgVersionForce);
-    }
-    MEM_CONTEXT_TEMP_END();
-
-    FUNCTION_LOG_RETURN(PG_WAL, result);
-}
-
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 pgTablespaceId(const unsigned int pgVersion, const unsigned int pgCatalogVersion)
@@ -5,6 +5,7 @@ Protocol Client
 
 #include "common/debug.h"
 #include "common/log.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
@@ -444,6 +445,28 @@ protocolClientNoOp(ProtocolClient *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolClientStatMerge(ProtocolClient *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    if (this->state == protocolClientStateIdle && lstEmpty(this->sessionList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            statFromPack(protocolClientRequestP(this, PROTOCOL_COMMAND_STAT));
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolClientKeepAlive(ProtocolClient *const this)
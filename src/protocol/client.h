@@ -73,6 +73,7 @@ Constants
 #define PROTOCOL_COMMAND_CONFIG                                     STRID5("config", 0xe9339e30)
 #define PROTOCOL_COMMAND_EXIT                                       STRID5("exit", 0xa27050)
 #define PROTOCOL_COMMAND_NOOP                                       STRID5("noop", 0x83dee0)
+#define PROTOCOL_COMMAND_STAT                                       STRID5("stat", 0xa06930)
 
 /***********************************************************************************************************************************
 This size should be safe for most pack data without wasting a lot of space. If binary data is being transferred then this size can
@@ -131,6 +132,10 @@ FN_EXTERN void protocolClientNoOp(ProtocolClient *this);
 // once per unit of work, which is far more often than the server needs one, so most calls do nothing.
 FN_EXTERN void protocolClientKeepAlive(ProtocolClient *this);
 
+// Get stats from the server and merge them into the stats for this process. Stats are only requested when the client is idle with
+// no open sessions, i.e. it is not in an error state or in the middle of processing.
+FN_EXTERN void protocolClientStatMerge(ProtocolClient *this);
+
 // Simple request that does not require a session or async
 typedef struct ProtocolClientRequestParam
 {
@@ -15,6 +15,7 @@ Protocol Helper
 #include "common/io/tls/client.h"
 #include "common/io/tls/server.h"
 #include "common/memContext.h"
+#include "common/stat.h"
 #include "config/config.intern.h"
 #include "config/exec.h"
 #include "config/load.h"
@@ -30,6 +31,9 @@ Constants
 STRING_EXTERN(PROTOCOL_SERVICE_LOCAL_STR,                           PROTOCOL_SERVICE_LOCAL);
 STRING_EXTERN(PROTOCOL_SERVICE_REMOTE_STR,                          PROTOCOL_SERVICE_REMOTE);
 
+// Seconds that a multiplexed SSH master connection stays open after the last remote exits
+#define PROTOCOL_REMOTE_SSH_PERSIST                                 "60"
+
 /***********************************************************************************************************************************
 Local variables
 ***********************************************************************************************************************************/
@@ -170,6 +174,10 @@ protocolLocalParam(const ProtocolStorageType protocolStorageType, const unsigned
         // Add the remote type
         kvPut(optionReplace, VARSTRDEF(CFGOPT_REMOTE_TYPE), VARSTR(strNewStrId(protocolStorageType)));
 
+        // Enable timing stats on the local when they are enabled here
+        if (statTimeEnabled())
+            kvPut(optionReplace, VARSTRDEF(CFGOPT_STAT), BOOL_TRUE_VAR);
+
         // Only enable file logging on the local when requested
         kvPut(
             optionReplace, VARSTRDEF(CFGOPT_LOG_LEVEL_FILE),
@@ -285,14 +293,33 @@ protocolLocalGet(const ProtocolStorageType protocolStorageType, const unsigned i
 /***********************************************************************************************************************************
 Free the protocol client and underlying exec'd process. Log any errors as warnings since it is not worth terminating the process
 while closing a local/remote that has already completed its work. The warning will be an indication that something is not right.
+
+When terminating, the exec'd process is killed after the exit request is sent so work in progress is not waited on.
 ***********************************************************************************************************************************/
 static void
-protocolHelperClientFree(ProtocolHelperClient *const protocolHelperClient)
+protocolHelperClientFree(ProtocolHelperClient *const protocolHelperClient, const bool terminate)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM_P(VOID, protocolHelperClient);
+        FUNCTION_LOG_PARAM(BOOL, terminate);
     FUNCTION_LOG_END();
 
+    // Merge stats from the local/remote so they are included in the stats for this process. Stats are only requested when timing is
+    // enabled, i.e. when they will be output, to save a round trip per process. Errors are only warned since stats are best effort.
+    // Stats are skipped when terminating since the request would wait on work in progress.
+    if (!terminate && statTimeEnabled())
+    {
+        TRY_BEGIN()
+        {
+            protocolClientStatMerge(protocolHelperClient->client);
+        }
+        CATCH_ANY()
+        {
+            LOG_WARN_FMT("unable to get statistics: %s", errorMessage());
+        }
+        TRY_END();
+    }
+
     // Try to shutdown the protocol but only warn on error
     TRY_BEGIN()
     {
@@ -307,6 +334,9 @@ protocolHelperClientFree(ProtocolHelperClient *const protocolHelperClient)
     // Try to end the child process but only warn on error
     TRY_BEGIN()
     {
+        if (terminate && protocolHelperClient->exec != NULL)
+            execTerminate(protocolHelperClient->exec);
+
         execFree(protocolHelperClient->exec);
     }
     CATCH_ANY()
@@ -588,6 +618,10 @@ protocolRemoteParam(const ProtocolStorageType protocolStorageType, const unsigne
         // Add the remote type
         kvPut(optionReplace, VARSTRDEF(CFGOPT_REMOTE_TYPE), VARSTR(strNewStrId(protocolStorageType)));
 
+        // Enable timing stats on the remote when they are enabled here
+        if (statTimeEnabled())
+            kvPut(optionReplace, VARSTRDEF(CFGOPT_STAT), BOOL_TRUE_VAR);
+
         // Add lock required on the remote
         if (cfgLockRemoteRequired())
             kvPut(optionReplace, VARSTRDEF(CFGOPT_LOCK), varNewVarLst(varLstNewStrLst(cmdLockList())));
@@ -627,6 +661,22 @@ protocolRemoteParamSsh(const ProtocolStorageType protocolStorageType, const unsi
         strLstAddZ(result, "-o");
         strLstAddZ(result, "PasswordAuthentication=no");
 
+        // Share a single connection to the host between all remotes. Each remote gets a separate channel on the connection (with
+        // separate flow control) so only one handshake is required no matter how many processes are running. The master
+        // connection persists for a short time after the last remote exits so that commands do not need to wait for it and so it
+        // can be reused by the next command. The master is created by the first remote to connect and ControlMaster=auto does not
+        // wait for it, so remotes that connect before the master is ready open separate connections. This is not a problem in
+        // practice since the main process generally connects before local processes are started.
+        if (cfgOptionBool(cfgOptCmdSshMultiplex))
+        {
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlMaster=auto");
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlPath=~/.ssh/" PROJECT_BIN "-%C");
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlPersist=" PROTOCOL_REMOTE_SSH_PERSIST);
+        }
+
         // Append port if specified
         const ConfigOption optHostPort = isRepo ? cfgOptRepoHostPort : cfgOptPgHostPort;
 
@@ -849,11 +899,13 @@ protocolRemoteGet(const ProtocolStorageType protocolStorageType, const unsigned
 }
 
 /**********************************************************************************************************************************/
-FN_EXTERN void
-protocolHelperFree(ProtocolClient *const client)
+// Helper to find and free a client
+static void
+protocolHelperFreeClient(ProtocolClient *const client, const bool terminate)
 {
-    FUNCTION_LOG_BEGIN(logLevelDebug);
+    FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+        FUNCTION_LOG_PARAM(BOOL, terminate);
     FUNCTION_LOG_END();
 
     if (client != NULL && protocolHelper.clientList != NULL)
@@ -864,7 +916,7 @@ protocolHelperFree(ProtocolClient *const client)
 
             if (match->client == client)
             {
-                protocolHelperClientFree(match);
+                protocolHelperClientFree(match, terminate);
                 lstRemoveIdx(protocolHelper.clientList, clientIdx);
 
                 break;
@@ -875,6 +927,31 @@ protocolHelperFree(ProtocolClient *const client)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+FN_EXTERN void
+protocolHelperFree(ProtocolClient *const client)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+    FUNCTION_LOG_END();
+
+    protocolHelperFreeClient(client, false);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+protocolHelperTerminate(ProtocolClient *const client)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+    FUNCTION_LOG_END();
+
+    protocolHelperFreeClient(client, true);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 protocolKeepAlive(void)
@@ -905,7 +982,7 @@ protocolFree(void)
     {
         while (lstSize(protocolHelper.clientList) > 0)
         {
-            protocolHelperClientFree(lstGet(protocolHelper.clientList, 0));
+            protocolHelperClientFree(lstGet(protocolHelper.clientList, 0), false);
             lstRemoveIdx(protocolHelper.clientList, 0);
         }
     }
@@ -53,6 +53,9 @@ FN_EXTERN ProtocolClient *protocolRemoteGet(ProtocolStorageType protocolStorageT
 // Free (shutdown) a local/remote client
 FN_EXTERN void protocolHelperFree(ProtocolClient *client);
 
+// Terminate a local/remote client without waiting for the command in progress to complete
+FN_EXTERN void protocolHelperTerminate(ProtocolClient *client);
+
 // Initialize a server
 FN_EXTERN ProtocolServer *protocolServer(IoServer *const tlsServer, IoSession *const socketSession);
 
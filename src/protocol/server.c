@@ -8,6 +8,7 @@ Protocol Server
 #include "common/debug.h"
 #include "common/error/retry.h"
 #include "common/log.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
@@ -470,6 +471,15 @@ protocolServerProcess(ProtocolServer *const this, const VariantList *const retry
                             protocolServerResponseP(this);
                             break;
 
+                        case PROTOCOL_COMMAND_STAT:
+                        {
+                            PackWrite *const data = protocolPackNew();
+
+                            statToPack(data);
+                            protocolServerResponseP(this, .data = data);
+                            break;
+                        }
+
                         default:
                             THROW_FMT(
                                 ProtocolError, "invalid request '%s' (0x%" PRIx64 ")", zNewStrId(request.id), request.id);
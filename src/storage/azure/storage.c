@@ -29,10 +29,16 @@ Defaults
 /***********************************************************************************************************************************
 Azure http headers
 ***********************************************************************************************************************************/
+STRING_STATIC(AZURE_HEADER_ERROR_CODE_STR,                          "x-ms-error-code");
 STRING_STATIC(AZURE_HEADER_TAGS,                                    "x-ms-tags");
 STRING_STATIC(AZURE_HEADER_VERSION_STR,                             "x-ms-version");
 STRING_STATIC(AZURE_HEADER_VERSION_VALUE_STR,                       "2024-08-04");
 
+/***********************************************************************************************************************************
+Azure error codes
+***********************************************************************************************************************************/
+STRING_STATIC(AZURE_ERROR_CODE_BLOB_ALREADY_EXISTS_STR,             "BlobAlreadyExists");
+
 /***********************************************************************************************************************************
 Azure query tokens
 ***********************************************************************************************************************************/
@@ -197,6 +203,7 @@ storageAzureAuth(
             const String *const contentLength = httpHeaderGet(httpHeader, HTTP_HEADER_CONTENT_LENGTH_STR);
             const String *const contentMd5 = httpHeaderGet(httpHeader, HTTP_HEADER_CONTENT_MD5_STR);
             const String *const contentType = httpHeaderGet(httpHeader, HTTP_HEADER_CONTENT_TYPE_STR);
+            const String *const ifNoneMatch = httpHeaderGet(httpHeader, HTTP_HEADER_IF_NONE_MATCH_STR);
             const String *const range = httpHeaderGet(httpHeader, HTTP_HEADER_RANGE_STR);
 
             const String *const stringToSign = strNewFmt(
@@ -209,15 +216,15 @@ storageAzureAuth(
                 "%s\n"                                                  // date
                 "\n"                                                    // If-Modified-Since
                 "\n"                                                    // If-Match
-                "\n"                                                    // If-None-Match
+                "%s\n"                                                  // If-None-Match
                 "\n"                                                    // If-Unmodified-Since
                 "%s\n"                                                  // range
                 "%s"                                                    // Canonicalized headers
                 "/%s%s"                                                 // Canonicalized account/path
                 "%s",                                                   // Canonicalized query
                 strZ(verb), strEq(contentLength, ZERO_STR) ? "" : strZ(contentLength), contentMd5 == NULL ? "" : strZ(contentMd5),
-                contentType == NULL ? "" : strZ(contentType), strZ(dateTime), range == NULL ? "" : strZ(range),
-                strZ(headerCanonical), strZ(this->account), strZ(path), strZ(queryCanonical));
+                contentType == NULL ? "" : strZ(contentType), strZ(dateTime), ifNoneMatch == NULL ? "" : strZ(ifNoneMatch),
+                range == NULL ? "" : strZ(range), strZ(headerCanonical), strZ(this->account), strZ(path), strZ(queryCanonical));
 
             // Generate authorization header
             httpHeaderPut(
@@ -394,6 +401,7 @@ storageAzureResponse(HttpRequest *const request, const StorageAzureResponseParam
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
+        FUNCTION_LOG_PARAM(BOOL, param.allowConflict);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
     FUNCTION_LOG_END();
 
@@ -406,9 +414,20 @@ storageAzureResponse(HttpRequest *const request, const StorageAzureResponseParam
         // Get response
         result = httpRequestResponse(request, !param.contentIo);
 
-        // Error if the request was not successful
-        if (!httpResponseCodeOk(result) && (!param.allowMissing || httpResponseCode(result) != HTTP_RESPONSE_CODE_NOT_FOUND))
+        // Error if the request was not successful. Azure reports a conflict with an error code of BlobAlreadyExists when a write
+        // conditional on the blob not existing finds the blob, but a failed precondition is also allowed since it means the same
+        // thing for these requests. Any other conflict, e.g. a lease on the blob, is an error.
+        if (!httpResponseCodeOk(result) &&
+            (!param.allowMissing || httpResponseCode(result) != HTTP_RESPONSE_CODE_NOT_FOUND) &&
+            (!param.allowConflict ||
+             (httpResponseCode(result) != HTTP_RESPONSE_CODE_PRECONDITION_FAILED &&
+              (httpResponseCode(result) != HTTP_RESPONSE_CODE_CONFLICT ||
+               !strEq(
+                   httpHeaderGet(httpResponseHeader(result), AZURE_HEADER_ERROR_CODE_STR),
+                   AZURE_ERROR_CODE_BLOB_ALREADY_EXISTS_STR)))))
+        {
             httpRequestError(request, result);
+        }
 
         // Move response to the prior context
         httpResponseMove(result, memContextPrior());
@@ -430,6 +449,7 @@ storageAzureRequest(StorageAzure *const this, const String *const verb, const St
         FUNCTION_LOG_PARAM(BUFFER, param.content);
         FUNCTION_LOG_PARAM(LIST, param.contentList);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
+        FUNCTION_LOG_PARAM(BOOL, param.allowConflict);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
         FUNCTION_LOG_PARAM(BOOL, param.tag);
     FUNCTION_LOG_END();
@@ -437,7 +457,8 @@ storageAzureRequest(StorageAzure *const this, const String *const verb, const St
     HttpRequest *const request = storageAzureRequestAsyncP(
         this, verb, .path = param.path, .header = param.header, .query = param.query, .content = param.content,
         .contentList = param.contentList, .tag = param.tag);
-    HttpResponse *const result = storageAzureResponseP(request, .allowMissing = param.allowMissing, .contentIo = param.contentIo);
+    HttpResponse *const result = storageAzureResponseP(
+        request, .allowMissing = param.allowMissing, .allowConflict = param.allowConflict, .contentIo = param.contentIo);
 
     httpRequestFree(request);
 
@@ -724,6 +745,7 @@ storageAzureList(THIS_VOID, const String *const path, const StorageInfoLevel lev
         FUNCTION_LOG_PARAM(ENUM, level);
         FUNCTION_LOG_PARAM(STRING, param.expression);
         FUNCTION_LOG_PARAM(TIME, param.targetTime);
+        FUNCTION_LOG_PARAM(BOOL, param.recurse);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -731,7 +753,8 @@ storageAzureList(THIS_VOID, const String *const path, const StorageInfoLevel lev
 
     StorageList *const result = storageLstNew(level);
 
-    storageAzureListInternal(this, path, level, param.expression, false, param.targetTime, storageAzureListCallback, result);
+    storageAzureListInternal(
+        this, path, level, param.expression, param.recurse, param.targetTime, storageAzureListCallback, result);
 
     FUNCTION_LOG_RETURN(STORAGE_LIST, result);
 }
@@ -765,7 +788,7 @@ storageAzureNewWrite(THIS_VOID, const String *const file, const StorageInterface
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_AZURE, this);
         FUNCTION_LOG_PARAM(STRING, file);
-        (void)param;                                                // No parameters are used
+        FUNCTION_LOG_PARAM(BOOL, param.exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -776,7 +799,8 @@ storageAzureNewWrite(THIS_VOID, const String *const file, const StorageInterface
     ASSERT(param.group == NULL);
     ASSERT(param.timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE_AZURE, storageWriteAzureNew(this, file, this->fileId++, this->blockSize));
+    FUNCTION_LOG_RETURN(
+        STORAGE_WRITE_AZURE, storageWriteAzureNew(this, file, this->fileId++, this->blockSize, param.exclusive));
 }
 
 /**********************************************************************************************************************************/
@@ -983,7 +1007,8 @@ storageAzureRemove(THIS_VOID, const String *const file, const StorageInterfaceRe
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceAzure =
 {
-    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry,
+    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry | 1 << storageFeatureWriteExclusive |
+        1 << storageFeatureListRecurse,
 
     .info = storageAzureInfo,
     .list = storageAzureList,
@@ -56,6 +56,7 @@ typedef struct StorageAzureResponseParam
 {
     VAR_PARAM_HEADER;
     bool allowMissing;                                              // Allow missing files (caller can check response code)
+    bool allowConflict;                                             // Allow blob exists/failed precondition (caller can check code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
 } StorageAzureResponseParam;
 
@@ -73,6 +74,7 @@ typedef struct StorageAzureRequestParam
     const Buffer *content;                                          // Request content
     const List *contentList;                                        // Request content part list
     bool allowMissing;                                              // Allow missing files (caller can check response code)
+    bool allowConflict;                                             // Allow blob exists/failed precondition (caller can check code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
     bool tag;                                                       // Add tags when available?
 } StorageAzureRequestParam;
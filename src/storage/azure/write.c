@@ -52,8 +52,52 @@ struct StorageWriteAzure
     size_t blockSize;                                               // Size of blocks for multi-block upload
     Buffer *blockBuffer;                                            // Block buffer (stores data until blockSize is reached)
     StringList *blockIdList;                                        // List of uploaded block ids
+    bool exclusive;                                                 // Error if the file already exists
 };
 
+/***********************************************************************************************************************************
+Headers for the request that creates the blob. When the write is exclusive the request is conditional on the blob not existing and
+Azure checks the condition when the blob is created so no other writer can create the blob in the meantime.
+***********************************************************************************************************************************/
+static HttpHeader *
+storageWriteAzureHeader(const StorageWriteAzure *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_AZURE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    HttpHeader *const result = httpHeaderNew(NULL);
+
+    if (this->exclusive)
+        httpHeaderAdd(result, HTTP_HEADER_IF_NONE_MATCH_STR, STRDEF("*"));
+
+    FUNCTION_TEST_RETURN(HTTP_HEADER, result);
+}
+
+/***********************************************************************************************************************************
+Error when the response shows that an exclusive write failed because the file already exists
+***********************************************************************************************************************************/
+static void
+storageWriteAzureExists(const StorageWriteAzure *const this, const HttpResponse *const response)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_AZURE, this);
+        FUNCTION_TEST_PARAM(HTTP_RESPONSE, response);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(response != NULL);
+
+    // The only failures that storageAzureResponse() allows through for an exclusive write are a failed precondition and a conflict
+    // reporting that the blob already exists. Other failures have already thrown.
+    if (!httpResponseCodeOk(response))
+        THROW_FMT(FileExistsError, "unable to write '%s' because it already exists", strZ(this->name));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Flush bytes to upload block
 ***********************************************************************************************************************************/
@@ -217,18 +261,24 @@ storageWriteAzureClose(THIS_VOID)
                 }
 
                 // Finalize the multi-block upload
-                storageAzureRequestP(
-                    this->storage, HTTP_VERB_PUT_STR, .path = this->name,
-                    .query = httpQueryAdd(httpQueryNewP(), AZURE_QUERY_COMP_STR, AZURE_QUERY_VALUE_BLOCK_LIST_STR),
-                    .content = xmlDocumentBuf(blockXml), .tag = true);
+                storageWriteAzureExists(
+                    this,
+                    storageAzureRequestP(
+                        this->storage, HTTP_VERB_PUT_STR, .path = this->name,
+                        .header = storageWriteAzureHeader(this),
+                        .query = httpQueryAdd(httpQueryNewP(), AZURE_QUERY_COMP_STR, AZURE_QUERY_VALUE_BLOCK_LIST_STR),
+                        .content = xmlDocumentBuf(blockXml), .allowConflict = this->exclusive, .tag = true));
             }
             // Else upload all the data in a single block
             else
             {
-                storageAzureRequestP(
-                    this->storage, HTTP_VERB_PUT_STR, .path = this->name,
-                    httpHeaderAdd(httpHeaderNew(NULL), AZURE_HEADER_BLOB_TYPE_STR, AZURE_HEADER_VALUE_BLOCK_BLOB_STR),
-                    .content = this->blockBuffer, .tag = true);
+                storageWriteAzureExists(
+                    this,
+                    storageAzureRequestP(
+                        this->storage, HTTP_VERB_PUT_STR, .path = this->name,
+                        .header = httpHeaderAdd(
+                            storageWriteAzureHeader(this), AZURE_HEADER_BLOB_TYPE_STR, AZURE_HEADER_VALUE_BLOCK_BLOB_STR),
+                        .content = this->blockBuffer, .allowConflict = this->exclusive, .tag = true));
             }
 
             bufFree(this->blockBuffer);
@@ -248,13 +298,15 @@ static const StorageWriteInterface storageWriteAzureInterface =
 };
 
 FN_EXTERN StorageWriteAzure *
-storageWriteAzureNew(StorageAzure *const storage, const String *const name, const uint64_t fileId, const size_t blockSize)
+storageWriteAzureNew(
+    StorageAzure *const storage, const String *const name, const uint64_t fileId, const size_t blockSize, const bool exclusive)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_AZURE, storage);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(UINT64, fileId);
         FUNCTION_LOG_PARAM(UINT64, blockSize);
+        FUNCTION_LOG_PARAM(BOOL, exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -270,6 +322,7 @@ storageWriteAzureNew(StorageAzure *const storage, const String *const name, cons
             .fileId = fileId,
             .blockSize = blockSize,
             .blockBuffer = bufNew(0),
+            .exclusive = exclusive,
         };
     }
     OBJ_NEW_END();
@@ -530,6 +530,7 @@ storageGcsResponse(HttpRequest *const request, const StorageGcsResponseParam par
         FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
         FUNCTION_LOG_PARAM(BOOL, param.allowIncomplete);
+        FUNCTION_LOG_PARAM(BOOL, param.allowPreconditionFailed);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
     FUNCTION_LOG_END();
 
@@ -545,8 +546,11 @@ storageGcsResponse(HttpRequest *const request, const StorageGcsResponseParam par
 
         // Error if the request was not successful
         if (!httpResponseCodeOk(result) && (!param.allowMissing || httpResponseCode(result) != HTTP_RESPONSE_CODE_NOT_FOUND) &&
-            (!param.allowIncomplete || httpResponseCode(result) != HTTP_RESPONSE_CODE_PERMANENT_REDIRECT))
+            (!param.allowIncomplete || httpResponseCode(result) != HTTP_RESPONSE_CODE_PERMANENT_REDIRECT) &&
+            (!param.allowPreconditionFailed || httpResponseCode(result) != HTTP_RESPONSE_CODE_PRECONDITION_FAILED))
+        {
             httpRequestError(request, result);
+        }
 
         // Move response to the prior context
         httpResponseMove(result, memContextPrior());
@@ -573,6 +577,7 @@ storageGcsRequest(StorageGcs *const this, const String *const verb, const Storag
         FUNCTION_LOG_PARAM(BUFFER, param.content);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
         FUNCTION_LOG_PARAM(BOOL, param.allowIncomplete);
+        FUNCTION_LOG_PARAM(BOOL, param.allowPreconditionFailed);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
     FUNCTION_LOG_END();
 
@@ -581,7 +586,8 @@ storageGcsRequest(StorageGcs *const this, const String *const verb, const Storag
         .path = param.path, .object = param.object, .header = param.header, .query = param.query, .content = param.content,
         .contentList = param.contentList);
     HttpResponse *const result = storageGcsResponseP(
-        request, .allowMissing = param.allowMissing, .allowIncomplete = param.allowIncomplete, .contentIo = param.contentIo);
+        request, .allowMissing = param.allowMissing, .allowIncomplete = param.allowIncomplete,
+        .allowPreconditionFailed = param.allowPreconditionFailed, .contentIo = param.contentIo);
 
     httpRequestFree(request);
 
@@ -909,6 +915,7 @@ storageGcsList(THIS_VOID, const String *const path, const StorageInfoLevel level
         FUNCTION_LOG_PARAM(ENUM, level);
         FUNCTION_LOG_PARAM(STRING, param.expression);
         FUNCTION_LOG_PARAM(TIME, param.targetTime);
+        FUNCTION_LOG_PARAM(BOOL, param.recurse);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -916,7 +923,7 @@ storageGcsList(THIS_VOID, const String *const path, const StorageInfoLevel level
 
     StorageList *const result = storageLstNew(level);
 
-    storageGcsListInternal(this, path, level, param.expression, false, param.targetTime, storageGcsListCallback, result);
+    storageGcsListInternal(this, path, level, param.expression, param.recurse, param.targetTime, storageGcsListCallback, result);
 
     FUNCTION_LOG_RETURN(STORAGE_LIST, result);
 }
@@ -950,7 +957,7 @@ storageGcsNewWrite(THIS_VOID, const String *const file, const StorageInterfaceNe
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_GCS, this);
         FUNCTION_LOG_PARAM(STRING, file);
-        (void)param;                                                // No parameters are used
+        FUNCTION_LOG_PARAM(BOOL, param.exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -961,7 +968,8 @@ storageGcsNewWrite(THIS_VOID, const String *const file, const StorageInterfaceNe
     ASSERT(param.group == NULL);
     ASSERT(param.timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE_GCS, storageWriteGcsNew(this, file, this->chunkSize, this->tag != NULL));
+    FUNCTION_LOG_RETURN(
+        STORAGE_WRITE_GCS, storageWriteGcsNew(this, file, this->chunkSize, this->tag != NULL, param.exclusive));
 }
 
 /**********************************************************************************************************************************/
@@ -1169,7 +1177,8 @@ storageGcsRemove(THIS_VOID, const String *const file, const StorageInterfaceRemo
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceGcs =
 {
-    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry,
+    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry | 1 << storageFeatureWriteExclusive |
+        1 << storageFeatureListRecurse,
 
     .info = storageGcsInfo,
     .list = storageGcsList,
@@ -81,6 +81,7 @@ typedef struct StorageGcsResponseParam
     VAR_PARAM_HEADER;
     bool allowMissing;                                              // Allow missing files (caller can check response code)
     bool allowIncomplete;                                           // Allow incomplete resume (used for resumable upload)
+    bool allowPreconditionFailed;                                   // Allow failed precondition (caller can check response code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
 } StorageGcsResponseParam;
 
@@ -104,6 +105,7 @@ typedef struct StorageGcsRequestParam
     const List *contentList;                                        // Request content part list
     bool allowMissing;                                              // Allow missing files (caller can check response code)
     bool allowIncomplete;                                           // Allow incomplete resume (used for resumable upload)
+    bool allowPreconditionFailed;                                   // Allow failed precondition (caller can check response code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
 } StorageGcsRequestParam;
 
@@ -25,6 +25,7 @@ GCS query tokens
 STRING_STATIC(GCS_QUERY_UPLOAD_TYPE_STR,                            "uploadType");
 STRING_STATIC(GCS_QUERY_RESUMABLE_STR,                              "resumable");
 STRING_STATIC(GCS_QUERY_FIELDS_VALUE_STR,                           GCS_JSON_MD5_HASH "," GCS_JSON_SIZE);
+STRING_STATIC(GCS_QUERY_IF_GENERATION_MATCH_STR,                    "ifGenerationMatch");
 
 /***********************************************************************************************************************************
 Object type
@@ -39,12 +40,34 @@ struct StorageWriteGcs
     size_t chunkSize;                                               // Size of chunks for resumable upload
     unsigned int chunkTotal;                                        // Total chunks uploaded
     bool tag;                                                       // Are tags available?
+    bool exclusive;                                                 // Error if the file already exists
     Buffer *chunkBuffer;                                            // Block buffer (stores data until chunkSize is reached)
     const String *uploadId;                                         // Id for resumable upload
     uint64_t uploadTotal;                                           // Total bytes uploaded
     IoFilter *md5hash;                                              // MD5 hash of file
 };
 
+/***********************************************************************************************************************************
+Error when the response shows that an exclusive write failed because the file already exists. A generation precondition of zero
+makes GCS create the object only when there is no live generation, i.e. the object does not exist.
+***********************************************************************************************************************************/
+static void
+storageWriteGcsExists(const StorageWriteGcs *const this, const HttpResponse *const response)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_GCS, this);
+        FUNCTION_TEST_PARAM(HTTP_RESPONSE, response);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(response != NULL);
+
+    if (httpResponseCode(response) == HTTP_RESPONSE_CODE_PRECONDITION_FAILED)
+        THROW_FMT(FileExistsError, "unable to write '%s' because it already exists", strZ(this->name));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Verify upload
 ***********************************************************************************************************************************/
@@ -110,11 +133,15 @@ storageWriteGcsBlock(StorageWriteGcs *const this, const bool done)
     // If there is an outstanding async request then wait for the response to ensure the request did not error
     if (this->request != NULL)
     {
-        HttpResponse *const response = storageGcsResponseP(this->request, .allowIncomplete = !done);
+        HttpResponse *const response = storageGcsResponseP(
+            this->request, .allowIncomplete = !done, .allowPreconditionFailed = done && this->exclusive);
 
         // If done then verify the md5 checksum
         if (done)
+        {
+            storageWriteGcsExists(this, response);
             storageWriteGcsVerify(this, response);
+        }
 
         httpResponseFree(response);
         httpRequestFree(this->request);
@@ -148,8 +175,17 @@ storageWriteGcsBlockAsync(StorageWriteGcs *const this, const bool done)
         // Get the upload id
         if (this->uploadId == NULL)
         {
+            // The generation precondition is only added to the request that starts the upload
+            HttpQuery *const queryStart = httpQueryDupP(query);
+
+            if (this->exclusive)
+                httpQueryAdd(queryStart, GCS_QUERY_IF_GENERATION_MATCH_STR, ZERO_STR);
+
             HttpResponse *response = storageGcsRequestP(
-                this->storage, HTTP_VERB_POST_STR, .upload = true, .tag = this->tag, .query = query);
+                this->storage, HTTP_VERB_POST_STR, .upload = true, .tag = this->tag, .query = queryStart,
+                .allowPreconditionFailed = this->exclusive);
+
+            storageWriteGcsExists(this, response);
 
             MEM_CONTEXT_OBJ_BEGIN(this)
             {
@@ -282,12 +318,17 @@ storageWriteGcsClose(THIS_VOID)
                 httpQueryAdd(query, GCS_QUERY_UPLOAD_TYPE_STR, GCS_QUERY_MEDIA_STR);
                 httpQueryAdd(query, GCS_QUERY_FIELDS_STR, GCS_QUERY_FIELDS_VALUE_STR);
 
+                if (this->exclusive)
+                    httpQueryAdd(query, GCS_QUERY_IF_GENERATION_MATCH_STR, ZERO_STR);
+
                 this->uploadTotal = bufUsed(this->chunkBuffer);
 
-                storageWriteGcsVerify(
-                    this,
-                    storageGcsRequestP(
-                        this->storage, HTTP_VERB_POST_STR, .upload = true, .query = query, .content = this->chunkBuffer));
+                HttpResponse *const response = storageGcsRequestP(
+                    this->storage, HTTP_VERB_POST_STR, .upload = true, .query = query, .content = this->chunkBuffer,
+                    .allowPreconditionFailed = this->exclusive);
+
+                storageWriteGcsExists(this, response);
+                storageWriteGcsVerify(this, response);
             }
 
             bufFree(this->chunkBuffer);
@@ -307,13 +348,15 @@ static const StorageWriteInterface storageWriteGcsInterface =
 };
 
 FN_EXTERN StorageWriteGcs *
-storageWriteGcsNew(StorageGcs *const storage, const String *const name, const size_t chunkSize, const bool tag)
+storageWriteGcsNew(
+    StorageGcs *const storage, const String *const name, const size_t chunkSize, const bool tag, const bool exclusive)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_GCS, storage);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(UINT64, chunkSize);
         FUNCTION_LOG_PARAM(BOOL, tag);
+        FUNCTION_LOG_PARAM(BOOL, exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -330,6 +373,7 @@ storageWriteGcsNew(StorageGcs *const storage, const String *const name, const si
             .chunkBuffer = bufNew(0),
             .md5hash = cryptoHashNew(hashTypeMd5),
             .tag = tag,
+            .exclusive = exclusive,
         };
     }
     OBJ_NEW_END();
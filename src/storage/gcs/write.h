@@ -15,7 +15,7 @@ typedef struct StorageWriteGcs StorageWriteGcs;
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN StorageWriteGcs *storageWriteGcsNew(StorageGcs *storage, const String *name, size_t chunkSize, bool tag);
+FN_EXTERN StorageWriteGcs *storageWriteGcsNew(StorageGcs *storage, const String *name, size_t chunkSize, bool tag, bool exclusive);
 
 /***********************************************************************************************************************************
 Macros for function logging
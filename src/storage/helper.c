@@ -27,6 +27,7 @@ STRING_EXTERN(STORAGE_REPO_BACKUP_STR,                              STORAGE_REPO
 
 STRING_EXTERN(STORAGE_PATH_ARCHIVE_STR,                             STORAGE_PATH_ARCHIVE);
 STRING_EXTERN(STORAGE_PATH_BACKUP_STR,                              STORAGE_PATH_BACKUP);
+STRING_EXTERN(STORAGE_PATH_DEDUP_STR,                               STORAGE_PATH_DEDUP);
 
 /***********************************************************************************************************************************
 Error message when writable storage is requested in dry-run mode
@@ -25,6 +25,8 @@ STRING_DECLARE(STORAGE_REPO_BACKUP_STR);
 STRING_DECLARE(STORAGE_PATH_ARCHIVE_STR);
 #define STORAGE_PATH_BACKUP                                         "backup"
 STRING_DECLARE(STORAGE_PATH_BACKUP_STR);
+#define STORAGE_PATH_DEDUP                                          "dedup"
+STRING_DECLARE(STORAGE_PATH_DEDUP_STR);
 
 /***********************************************************************************************************************************
 Functions
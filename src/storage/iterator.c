@@ -6,6 +6,7 @@ Storage Iterator
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/regExp.h"
+#include "common/type/hashMap.h"
 #include "common/type/list.h"
 #include "storage/iterator.h"
 #include "storage/list.h"
@@ -17,15 +18,19 @@ Object type
 struct StorageIterator
 {
     void *driver;                                                   // Storage driver
+    StringId type;                                                  // Storage type
     const String *path;                                             // Path to iterate
     StorageInfoLevel level;                                         // Info level
     bool recurse;                                                   // Recurse into paths
+    bool listRecurse;                                               // Driver lists all paths in a single flat list
     SortOrder sortOrder;                                            // Sort order
     time_t targetTime;                                              // List max version <= time
     const String *expression;                                       // Match expression
     RegExp *regExp;                                                 // Parsed match expression
 
     List *stack;                                                    // Stack of info lists
+    StringList *pathList;                                           // Paths found in the flat list (keys for pathMap)
+    HashMap *pathMap;                                               // Info list for each path found in the flat list
     bool returnedNext;                                              // Next info was returned
     StorageInfo infoNext;                                           // Info to be returned by next
     String *nameNext;                                               // Name for next info
@@ -40,6 +45,108 @@ typedef struct StorageIteratorInfo
     bool pathContentSkip;                                           // Skip reading path content
 } StorageIteratorInfo;
 
+/***********************************************************************************************************************************
+Get the info list for a path found in the flat list, adding the path to the list of its parent when the path is new
+***********************************************************************************************************************************/
+static StorageList *
+storageItrPathList(StorageIterator *const this, StorageList *const root, const String *const path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_ITERATOR, this);
+        FUNCTION_TEST_PARAM(STORAGE_LIST, root);
+        FUNCTION_TEST_PARAM(STRING, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(root != NULL);
+    ASSERT(path != NULL);
+
+    StorageList **const pathList = hashMapGet(this->pathMap, path);
+
+    if (pathList != NULL)
+        FUNCTION_TEST_RETURN(STORAGE_LIST, *pathList);
+
+    // Add the path to the list of the parent path (or the root path when there is no parent)
+    const char *const slash = strrchr(strZ(path), '/');
+    const StorageInfo info =
+    {
+        .name = slash == NULL ? path : STR(slash + 1),
+        .exists = true,
+        .level = this->level,
+        .type = storageTypePath,
+    };
+
+    StorageList *parent = root;
+
+    if (slash != NULL)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            parent = storageItrPathList(this, root, strNewZN(strZ(path), (size_t)(slash - strZ(path))));
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    storageLstAdd(parent, &info);
+
+    // Create the list for the path
+    StorageList *result;
+
+    MEM_CONTEXT_OBJ_BEGIN(this->pathMap)
+    {
+        result = storageLstNew(this->level);
+        hashMapAdd(this->pathMap, strLstAdd(this->pathList, path), &result);
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN(STORAGE_LIST, result);
+}
+
+/***********************************************************************************************************************************
+Split a flat list into an info list per path and return the list for the root path. Paths are inferred from the file names since
+the driver does not return them, so paths without files are not listed.
+***********************************************************************************************************************************/
+static StorageList *
+storageItrPathSplit(StorageIterator *const this, const StorageList *const list)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_ITERATOR, this);
+        FUNCTION_TEST_PARAM(STORAGE_LIST, list);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(list != NULL);
+
+    StorageList *const result = storageLstNew(this->level);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        String *const path = strNew();
+
+        for (unsigned int listIdx = 0; listIdx < storageLstSize(list); listIdx++)
+        {
+            StorageInfo info = storageLstGet(list, listIdx);
+            const char *const slash = strrchr(strZ(info.name), '/');
+
+            // Add files in the root path directly to the root list
+            if (slash == NULL)
+            {
+                storageLstAdd(result, &info);
+                continue;
+            }
+
+            // Else add the file to the list for its path
+            strCatZN(strTrunc(path), strZ(info.name), (size_t)(slash - strZ(info.name)));
+            info.name = STR(slash + 1);
+
+            storageLstAdd(storageItrPathList(this, result, path), &info);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(STORAGE_LIST, result);
+}
+
 /***********************************************************************************************************************************
 Check a path and add it to the stack if it exists and has content
 ***********************************************************************************************************************************/
@@ -63,10 +170,34 @@ storageItrPathAdd(StorageIterator *const this, const String *const pathSub)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get path content
-        StorageList *const list = storageInterfaceListP(
-            this->driver, pathSub == NULL ? this->path : strNewFmt("%s/%s", strZ(this->path), strZ(pathSub)), this->level,
-            .expression = this->expression, .targetTime = this->targetTime);
+        StorageList *list;
+
+        // Get subpath content from the flat list when the driver listed all paths at once
+        if (this->listRecurse && pathSub != NULL)
+        {
+            StorageList **const pathList = hashMapGet(this->pathMap, pathSub);
+            ASSERT(pathList != NULL && *pathList != NULL);
+
+            // The list will be moved to the stack so clear it from the map
+            list = *pathList;
+            *pathList = NULL;
+        }
+        // Else get path content from the driver
+        else
+        {
+            const TimeUSec timeBegin = timeUSec();
+
+            list = storageInterfaceListP(
+                this->driver, pathSub == NULL ? this->path : strNewFmt("%s/%s", strZ(this->path), strZ(pathSub)), this->level,
+                .expression = this->expression, .targetTime = this->targetTime, .recurse = this->listRecurse);
+
+            storageStatTimeAdd(this->type, STORAGE_STAT_LIST, timeUSec() - timeBegin, 0);
+
+            // Split the flat list into a list per path. The list for the root path is processed now and the other lists when their
+            // paths are reached.
+            if (this->listRecurse && list != NULL)
+                list = storageItrPathSplit(this, list);
+        }
 
         // If path exists
         if (list != NULL)
@@ -111,16 +242,19 @@ storageItrPathAdd(StorageIterator *const this, const String *const pathSub)
 /**********************************************************************************************************************************/
 FN_EXTERN StorageIterator *
 storageItrNew(
-    void *const driver, const String *const path, const StorageInfoLevel level, const bool errorOnMissing, const bool nullOnMissing,
-    const bool recurse, const SortOrder sortOrder, const time_t targetTime, const String *const expression)
+    void *const driver, const StringId type, const String *const path, const StorageInfoLevel level, const bool errorOnMissing,
+    const bool nullOnMissing, const bool recurse, const bool listRecurse, const SortOrder sortOrder, const time_t targetTime,
+    const String *const expression)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM_P(VOID, driver);
+        FUNCTION_LOG_PARAM(STRING_ID, type);
         FUNCTION_LOG_PARAM(STRING, path);
         FUNCTION_LOG_PARAM(ENUM, level);
         FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
         FUNCTION_LOG_PARAM(BOOL, nullOnMissing);
         FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(BOOL, listRecurse);
         FUNCTION_LOG_PARAM(ENUM, sortOrder);
         FUNCTION_LOG_PARAM(TIME, targetTime);
         FUNCTION_LOG_PARAM(STRING, expression);
@@ -129,6 +263,7 @@ storageItrNew(
     ASSERT(driver != NULL);
     ASSERT(path != NULL);
     ASSERT(!recurse || level >= storageInfoLevelType);
+    ASSERT(!listRecurse || recurse);
 
     StorageIterator *this = NULL;
 
@@ -141,13 +276,17 @@ storageItrNew(
             *this = (StorageIterator)
             {
                 .driver = driver,
+                .type = type,
                 .path = strDup(path),
                 .level = level,
                 .recurse = recurse,
+                .listRecurse = listRecurse,
                 .sortOrder = sortOrder,
                 .targetTime = targetTime,
                 .expression = strDup(expression),
                 .stack = lstNewP(sizeof(StorageIteratorInfo *)),
+                .pathList = listRecurse ? strLstNew() : NULL,
+                .pathMap = listRecurse ? hashMapNewP(sizeof(StorageList *)) : NULL,
                 .nameNext = strNew(),
                 .returnedNext = true,
             };
@@ -15,9 +15,11 @@ typedef struct StorageIterator StorageIterator;
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+// When listRecurse is set the driver must support storageFeatureListRecurse. All paths are listed with a single flat list and the
+// iterator infers the paths from the file names.
 FN_EXTERN StorageIterator *storageItrNew(
-    void *driver, const String *path, StorageInfoLevel level, bool errorOnMissing, bool nullOnMissing, bool recurse,
-    SortOrder sortOrder, time_t targetTime, const String *expression);
+    void *driver, StringId type, const String *path, StorageInfoLevel level, bool errorOnMissing, bool nullOnMissing, bool recurse,
+    bool listRecurse, SortOrder sortOrder, time_t targetTime, const String *expression);
 
 /***********************************************************************************************************************************
 Functions
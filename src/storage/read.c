@@ -6,6 +6,7 @@ Storage Read Interface
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/stat.h"
 #include "common/wait.h"
 #include "storage/read.h"
 
@@ -18,6 +19,7 @@ struct StorageRead
     const Storage *storage;                                         // Storage
     void *driver;                                                   // Driver
     uint64_t bytesRead;                                             // Bytes that have been successfully read
+    TimeUSec time;                                                  // Time spent in the driver
     bool retry;                                                     // Are read retries allowed?
     bool compressible;                                              // Is the read compressible?
     bool async;                                                     // Async (deferred) open result enabled
@@ -47,6 +49,7 @@ storageReadOpen(THIS_VOID)
     ASSERT(this != NULL);
 
     bool result = false;
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
 
     // Open if not versioned or if versionId is not null
     if (!this->pub.version || this->pub.versionId != NULL)
@@ -66,6 +69,9 @@ storageReadOpen(THIS_VOID)
         }
     }
 
+    if (timeBegin != 0)
+        this->time += timeUSec() - timeBegin;
+
     // Error when the file is missing and missing files are not ignored
     if (!result && !this->pub.ignoreMissing)
         THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(storageReadName(this)));
@@ -90,6 +96,7 @@ storageRead(THIS_VOID, Buffer *const buffer, const bool block)
     ASSERT(this != NULL);
 
     const size_t bufUsedBegin = bufUsed(buffer);
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
     size_t result = 0;
 
     MEM_CONTEXT_TEMP_BEGIN()
@@ -166,6 +173,9 @@ storageRead(THIS_VOID, Buffer *const buffer, const bool block)
     }
     MEM_CONTEXT_TEMP_END();
 
+    if (timeBegin != 0)
+        this->time += timeUSec() - timeBegin;
+
     FUNCTION_LOG_RETURN(SIZE, result);
 }
 
@@ -183,8 +193,13 @@ storageReadClose(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
+
     storageReadDriverInterface(this->driver)->close(this->driver);
 
+    if (timeBegin != 0)
+        storageStatTimeAdd(storageReadType(this), STORAGE_STAT_READ, this->time + timeUSec() - timeBegin, this->bytesRead);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
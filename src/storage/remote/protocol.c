@@ -342,9 +342,11 @@ storageRemoteListProtocol(PackRead *const param)
         const String *const path = pckReadStrP(param);
         const StorageInfoLevel level = (StorageInfoLevel)pckReadU32P(param);
         const time_t targetTime = pckReadTimeP(param);
+        const bool recurse = pckReadBoolP(param);
 
         StorageRemoteInfoProtocolWriteData writeData = {0};
-        StorageList *const list = storageInterfaceListP(storageRemoteProtocolLocal.driver, path, level, .targetTime = targetTime);
+        StorageList *const list = storageInterfaceListP(
+            storageRemoteProtocolLocal.driver, path, level, .targetTime = targetTime, .recurse = recurse);
         PackWrite *const data = protocolServerResultData(result);
 
         // Indicate whether or not the path was found
@@ -572,11 +574,12 @@ storageRemoteWriteOpenProtocol(PackRead *const param)
         const bool syncFile = pckReadBoolP(param);
         const bool syncPath = pckReadBoolP(param);
         const bool atomic = pckReadBoolP(param);
+        const bool exclusive = pckReadBoolP(param);
         const Pack *const filter = pckReadPackP(param);
 
         StorageWrite *const fileWrite = storageWriteNew(
             storageRemoteProtocolLocal.storage, file, modeFile, modePath, user, group, timeModified, createPath, syncFile,
-            syncPath, atomic, true, false);
+            syncPath, atomic, true, exclusive, false);
 
         // Set filter group based on passed filters
         storageRemoteFilterGroup(ioWriteFilterGroup(storageWriteIo(fileWrite)), filter);
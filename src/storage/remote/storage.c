@@ -212,6 +212,7 @@ storageRemoteList(THIS_VOID, const String *const path, const StorageInfoLevel le
         FUNCTION_LOG_PARAM(STRING, path);
         FUNCTION_LOG_PARAM(ENUM, level);
         FUNCTION_LOG_PARAM(TIME, param.targetTime);
+        FUNCTION_LOG_PARAM(BOOL, param.recurse);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -226,6 +227,7 @@ storageRemoteList(THIS_VOID, const String *const path, const StorageInfoLevel le
         pckWriteStrP(commandParam, path);
         pckWriteU32P(commandParam, level);
         pckWriteTimeP(commandParam, param.targetTime);
+        pckWriteBoolP(commandParam, param.recurse);
 
         // Read list
         StorageRemoteInfoData parseData = {.memContext = memContextCurrent()};
@@ -319,6 +321,7 @@ storageRemoteNewWrite(THIS_VOID, const String *const file, const StorageInterfac
         FUNCTION_LOG_PARAM(BOOL, param.syncFile);
         FUNCTION_LOG_PARAM(BOOL, param.syncPath);
         FUNCTION_LOG_PARAM(BOOL, param.atomic);
+        FUNCTION_LOG_PARAM(BOOL, param.exclusive);
         FUNCTION_LOG_PARAM(BOOL, param.compressible);
     FUNCTION_LOG_END();
 
@@ -330,7 +333,7 @@ storageRemoteNewWrite(THIS_VOID, const String *const file, const StorageInterfac
         STORAGE_WRITE_REMOTE,
         storageWriteRemoteNew(
             this, this->client, file, param.modeFile, param.modePath, param.user, param.group, param.timeModified, param.createPath,
-            param.syncFile, param.syncPath, param.atomic, this->compressLevel > 0 ? param.compressible : false,
+            param.syncFile, param.syncPath, param.atomic, param.exclusive, this->compressLevel > 0 ? param.compressible : false,
             this->compressLevel));
 }
 
@@ -689,6 +689,7 @@ storageS3Response(HttpRequest *const request, const StorageS3ResponseParam param
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
+        FUNCTION_LOG_PARAM(BOOL, param.allowPreconditionFailed);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
     FUNCTION_LOG_END();
 
@@ -702,8 +703,12 @@ storageS3Response(HttpRequest *const request, const StorageS3ResponseParam param
         result = httpRequestResponse(request, !param.contentIo);
 
         // Error if the request was not successful
-        if (!httpResponseCodeOk(result) && (!param.allowMissing || httpResponseCode(result) != HTTP_RESPONSE_CODE_NOT_FOUND))
+        if (!httpResponseCodeOk(result) &&
+            (!param.allowMissing || httpResponseCode(result) != HTTP_RESPONSE_CODE_NOT_FOUND) &&
+            (!param.allowPreconditionFailed || httpResponseCode(result) != HTTP_RESPONSE_CODE_PRECONDITION_FAILED))
+        {
             httpRequestError(request, result);
+        }
 
         // Move response to the prior context
         httpResponseMove(result, memContextPrior());
@@ -1039,6 +1044,7 @@ storageS3List(THIS_VOID, const String *const path, const StorageInfoLevel level,
         FUNCTION_LOG_PARAM(ENUM, level);
         FUNCTION_LOG_PARAM(STRING, param.expression);
         FUNCTION_LOG_PARAM(TIME, param.targetTime);
+        FUNCTION_LOG_PARAM(BOOL, param.recurse);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -1047,7 +1053,7 @@ storageS3List(THIS_VOID, const String *const path, const StorageInfoLevel level,
     StorageList *const result = storageLstNew(level);
 
     storageS3ListInternal(
-        this, path, level, param.expression, false, param.targetTime, storageS3ListCallback, result);
+        this, path, level, param.expression, param.recurse, param.targetTime, storageS3ListCallback, result);
 
     FUNCTION_LOG_RETURN(STORAGE_LIST, result);
 }
@@ -1081,7 +1087,7 @@ storageS3NewWrite(THIS_VOID, const String *const file, const StorageInterfaceNew
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_S3, this);
         FUNCTION_LOG_PARAM(STRING, file);
-        (void)param;                                                // No parameters are used
+        FUNCTION_LOG_PARAM(BOOL, param.exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -1092,7 +1098,7 @@ storageS3NewWrite(THIS_VOID, const String *const file, const StorageInterfaceNew
     ASSERT(param.group == NULL);
     ASSERT(param.timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE_S3, storageWriteS3New(this, file, this->partSize));
+    FUNCTION_LOG_RETURN(STORAGE_WRITE_S3, storageWriteS3New(this, file, this->partSize, param.exclusive));
 }
 
 /**********************************************************************************************************************************/
@@ -1277,10 +1283,59 @@ storageS3Remove(THIS_VOID, const String *const file, const StorageInterfaceRemov
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+static void
+storageS3RemoveList(THIS_VOID, const StringList *const fileList, const StorageInterfaceRemoveListParam param)
+{
+    THIS(StorageS3);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageS3PathRemoveData data =
+        {
+            .this = this,
+            .memContext = memContextCurrent(),
+            .path = EMPTY_STR,
+        };
+
+        // Add files to batch delete requests the same way files are added when removing a path
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+            {
+                const StorageInfo info = {.name = strSub(strLstGet(fileList, fileIdx), 1), .type = storageTypeFile};
+
+                storageS3PathRemoveCallback(&data, &info);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        // Call if there is more to be removed
+        if (data.xml != NULL)
+            data.request = storageS3PathRemoveInternal(this, data.request, data.xml);
+
+        // Check response on last async request
+        storageS3PathRemoveInternal(this, data.request, NULL);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 static const StorageInterface storageInterfaceS3 =
 {
-    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry,
+    .feature = 1 << storageFeatureVersioning | 1 << storageFeatureReadRetry | 1 << storageFeatureWriteExclusive |
+        1 << storageFeatureListRecurse,
 
     .info = storageS3Info,
     .list = storageS3List,
@@ -1288,6 +1343,7 @@ static const StorageInterface storageInterfaceS3 =
     .newWrite = storageS3NewWrite,
     .pathRemove = storageS3PathRemove,
     .remove = storageS3Remove,
+    .removeList = storageS3RemoveList,
 };
 
 FN_EXTERN Storage *
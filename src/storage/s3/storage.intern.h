@@ -38,6 +38,7 @@ typedef struct StorageS3ResponseParam
 {
     VAR_PARAM_HEADER;
     bool allowMissing;                                              // Allow missing files (caller can check response code)
+    bool allowPreconditionFailed;                                   // Allow failed precondition (caller can check response code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
 } StorageS3ResponseParam;
 
@@ -40,6 +40,7 @@ struct StorageWriteS3
     const StorageWriteInterface *interface;                         // Interface
     StorageS3 *storage;                                             // Storage that created this object
     const String *name;                                             // File name
+    bool exclusive;                                                 // Error if the file already exists
 
     HttpRequest *request;                                           // Async request
     size_t partSize;
@@ -48,6 +49,50 @@ struct StorageWriteS3
     StringList *uploadPartList;
 };
 
+/***********************************************************************************************************************************
+Header used to make the final write of the file conditional on the file not existing when the write is exclusive. The conditional
+header is checked by S3 when the object is created so no other writer can create the object in the meantime.
+***********************************************************************************************************************************/
+static const HttpHeader *
+storageWriteS3Header(const StorageWriteS3 *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_S3, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    HttpHeader *result = NULL;
+
+    if (this->exclusive)
+    {
+        result = httpHeaderNew(NULL);
+        httpHeaderAdd(result, HTTP_HEADER_IF_NONE_MATCH_STR, STRDEF("*"));
+    }
+
+    FUNCTION_TEST_RETURN(HTTP_HEADER, result);
+}
+
+/***********************************************************************************************************************************
+Error when the response shows that an exclusive write failed because the file already exists
+***********************************************************************************************************************************/
+static void
+storageWriteS3Exists(const StorageWriteS3 *const this, const HttpResponse *const response)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_S3, this);
+        FUNCTION_TEST_PARAM(HTTP_RESPONSE, response);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(response != NULL);
+
+    if (httpResponseCode(response) == HTTP_RESPONSE_CODE_PRECONDITION_FAILED)
+        THROW_FMT(FileExistsError, "unable to write '%s' because it already exists", strZ(this->name));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Flush bytes to upload part
 ***********************************************************************************************************************************/
@@ -218,10 +263,12 @@ storageWriteS3Close(THIS_VOID)
 
                 // Finalize the multi-part upload
                 HttpRequest *const request = storageS3RequestAsyncP(
-                    this->storage, HTTP_VERB_POST_STR, this->name,
+                    this->storage, HTTP_VERB_POST_STR, this->name, .header = storageWriteS3Header(this),
                     .query = httpQueryAdd(httpQueryNewP(), S3_QUERY_UPLOAD_ID_STR, this->uploadId),
                     .content = xmlDocumentBuf(partList));
-                HttpResponse *const response = storageS3ResponseP(request);
+                HttpResponse *const response = storageS3ResponseP(request, .allowPreconditionFailed = this->exclusive);
+
+                storageWriteS3Exists(this, response);
 
                 // Error when no etag in the result. This indicates that the request did not succeed despite the success code.
                 if (xmlNodeChild(
@@ -233,9 +280,11 @@ storageWriteS3Close(THIS_VOID)
             // Else upload all the data in a single put
             else
             {
-                storageS3RequestP(
-                    this->storage, HTTP_VERB_PUT_STR, this->name, .content = this->partBuffer, .sseKms = true,
-                    .sseC = true, .tag = true);
+                HttpRequest *const request = storageS3RequestAsyncP(
+                    this->storage, HTTP_VERB_PUT_STR, this->name, .header = storageWriteS3Header(this),
+                    .content = this->partBuffer, .sseKms = true, .sseC = true, .tag = true);
+
+                storageWriteS3Exists(this, storageS3ResponseP(request, .allowPreconditionFailed = this->exclusive));
             }
 
             bufFree(this->partBuffer);
@@ -255,12 +304,13 @@ static const StorageWriteInterface storageWriteS3Interface =
 };
 
 FN_EXTERN StorageWriteS3 *
-storageWriteS3New(StorageS3 *const storage, const String *const name, const size_t partSize)
+storageWriteS3New(StorageS3 *const storage, const String *const name, const size_t partSize, const bool exclusive)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_S3, storage);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(BOOL, exclusive);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -273,6 +323,7 @@ storageWriteS3New(StorageS3 *const storage, const String *const name, const size
             .interface = &storageWriteS3Interface,
             .storage = storage,
             .name = strDup(name),
+            .exclusive = exclusive,
             .partSize = partSize,
             .partBuffer = bufNew(0),
         };
@@ -39,7 +39,10 @@ storageSftpHelper(const unsigned int repoIdx, const bool write, StoragePathExpre
                 .modePath = STORAGE_MODE_PATH_DEFAULT, .keyPub = cfgOptionIdxStrNull(cfgOptRepoSftpPublicKeyFile, repoIdx),
                 .keyPassphrase = cfgOptionIdxStrNull(cfgOptRepoSftpPrivateKeyPassphrase, repoIdx),
                 .hostKeyCheckType = cfgOptionIdxStrId(cfgOptRepoSftpHostKeyCheckType, repoIdx),
-                .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx), .knownHosts = knownHosts);
+                .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx), .knownHosts = knownHosts,
+                .windowSize =
+                    cfgOptionIdxTest(cfgOptRepoSftpWindowSize, repoIdx) ?
+                        (size_t)cfgOptionIdxUInt64(cfgOptRepoSftpWindowSize, repoIdx) : 0);
         }
         MEM_CONTEXT_PRIOR_END();
     }
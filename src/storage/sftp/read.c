@@ -5,6 +5,8 @@ SFTP Storage Read
 
 #ifdef HAVE_LIBSSH2
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/io/session.h"
 #include "common/log.h"
@@ -27,6 +29,10 @@ struct StorageReadSftp
     LIBSSH2_SFTP_ATTRIBUTES *attr;                                  // LibSsh2 file attributes
     uint64_t current;                                               // Current bytes read from file
     bool eof;                                                       // Did we reach end of file
+
+    size_t windowSize;                                              // Read-ahead window size (0 to disable)
+    Buffer *readAhead;                                              // Read-ahead buffer used when the caller's buffer is small
+    size_t readAheadOffset;                                         // Offset of data not yet returned from the read-ahead buffer
 };
 
 /***********************************************************************************************************************************
@@ -83,6 +89,32 @@ storageReadSftpOpen(THIS_VOID)
     FUNCTION_LOG_RETURN(BOOL, this->sftpHandle != NULL);
 }
 
+/***********************************************************************************************************************************
+Read into the remaining space of a buffer and return the libssh2 result (bytes read, 0 on EOF, or error)
+***********************************************************************************************************************************/
+static ssize_t
+storageReadSftpBuffer(StorageReadSftp *const this, Buffer *const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_SFTP, this);
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+    FUNCTION_TEST_END();
+
+    ssize_t result;
+
+    do
+    {
+        result = libssh2_sftp_read(this->sftpHandle, (char *)bufRemainsPtr(buffer), bufRemains(buffer));
+    }
+    while (storageSftpWaitFd(this->storage, result));
+
+    // Account for bytes read
+    if (result > 0)
+        bufUsedInc(buffer, (size_t)result);
+
+    FUNCTION_TEST_RETURN(SSIZE, result);
+}
+
 /***********************************************************************************************************************************
 Read from a file
 ***********************************************************************************************************************************/
@@ -121,18 +153,57 @@ storageReadSftp(THIS_VOID, Buffer *const buffer, const bool block)
         // Read until EOF or buffer is full
         do
         {
-            do
+            // Return data left in the read-ahead buffer first
+            if (this->readAhead != NULL && this->readAheadOffset < bufUsed(this->readAhead))
             {
-                rc = libssh2_sftp_read(this->sftpHandle, (char *)bufRemainsPtr(buffer), bufRemains(buffer));
+                size_t copySize = bufUsed(this->readAhead) - this->readAheadOffset;
+
+                if (copySize > bufRemains(buffer))
+                    copySize = bufRemains(buffer);
+
+                memcpy(bufRemainsPtr(buffer), bufPtrConst(this->readAhead) + this->readAheadOffset, copySize);
+                bufUsedInc(buffer, copySize);
+                this->readAheadOffset += copySize;
             }
-            while (storageSftpWaitFd(this->storage, rc));
+            else
+            {
+                // libssh2 keeps up to four times the requested size in flight as read-ahead requests, so read a quarter of the
+                // window to keep it full. Do not read past the limit.
+                const uint64_t readRemains = limit - this->current - bufUsed(buffer);
+                size_t readAheadSize = this->windowSize / 4;
 
-            // Break on EOF or error
-            if (rc <= 0)
-                break;
+                if (readAheadSize > readRemains)
+                    readAheadSize = (size_t)readRemains;
 
-            // Account/shift for bytes read
-            bufUsedInc(buffer, (size_t)rc);
+                // Read directly into the buffer when it is large enough to keep the window full
+                if (bufRemains(buffer) >= readAheadSize)
+                {
+                    // Break on EOF or error
+                    if ((rc = storageReadSftpBuffer(this, buffer)) <= 0)
+                        break;
+                }
+                // Else refill the read-ahead buffer. The buffer is allocated when first needed and the read-ahead size never grows
+                // after that since the remaining size only gets smaller.
+                else
+                {
+                    if (this->readAhead == NULL)
+                    {
+                        MEM_CONTEXT_OBJ_BEGIN(this)
+                        {
+                            this->readAhead = bufNew(readAheadSize);
+                        }
+                        MEM_CONTEXT_OBJ_END();
+                    }
+
+                    bufUsedZero(this->readAhead);
+                    bufLimitSet(this->readAhead, readAheadSize);
+                    this->readAheadOffset = 0;
+
+                    // Break on EOF or error
+                    if ((rc = storageReadSftpBuffer(this, this->readAhead)) <= 0)
+                        break;
+                }
+            }
         }
         while (!bufFull(buffer));
 
@@ -252,13 +323,15 @@ static const StorageReadInterface storageReadSftpInterface =
 
 FN_EXTERN StorageReadSftp *
 storageReadSftpNew(
-    StorageSftp *const storage, const String *const name, const uint64_t offset, const Variant *const limit)
+    StorageSftp *const storage, const String *const name, const uint64_t offset, const Variant *const limit,
+    const size_t windowSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_SFTP, storage);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(UINT64, offset);
         FUNCTION_LOG_PARAM(VARIANT, limit);
+        FUNCTION_LOG_PARAM(SIZE, windowSize);
     FUNCTION_LOG_END();
 
     ASSERT(name != NULL);
@@ -272,6 +345,7 @@ storageReadSftpNew(
             .name = strDup(name),
             .offset = offset,
             .limit = varDup(limit),
+            .windowSize = windowSize,
         };
     }
     OBJ_NEW_END();
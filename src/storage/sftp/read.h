@@ -15,7 +15,8 @@ typedef struct StorageReadSftp StorageReadSftp;
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN StorageReadSftp *storageReadSftpNew(StorageSftp *storage, const String *name, uint64_t offset, const Variant *limit);
+FN_EXTERN StorageReadSftp *storageReadSftpNew(
+    StorageSftp *storage, const String *name, uint64_t offset, const Variant *limit, size_t windowSize);
 
 /***********************************************************************************************************************************
 Macros for function logging
@@ -50,6 +50,8 @@ struct StorageSftp
     StringId hostKeyCheckType;                                     // Host key check type
     const String *hostFingerprint;                                 // Configured host fingerprint
     const StringList *knownHosts;                                  // Known hosts file list
+
+    size_t windowSize;                                              // Read-ahead/write-behind window size (0 to disable)
 };
 
 /***********************************************************************************************************************************
@@ -920,7 +922,7 @@ storageSftpNewRead(THIS_VOID, const String *const file, const StorageInterfaceNe
     ASSERT(file != NULL);
     ASSERT(param.versionId == NULL);
 
-    FUNCTION_LOG_RETURN(STORAGE_READ_SFTP, storageReadSftpNew(this, file, param.offset, param.limit));
+    FUNCTION_LOG_RETURN(STORAGE_READ_SFTP, storageReadSftpNew(this, file, param.offset, param.limit, this->windowSize));
 }
 
 /**********************************************************************************************************************************/
@@ -955,7 +957,7 @@ storageSftpNewWrite(THIS_VOID, const String *const file, const StorageInterfaceN
     FUNCTION_LOG_RETURN(
         STORAGE_WRITE_SFTP,
         storageWriteSftpNew(
-            this, file, param.modeFile, param.modePath, param.createPath, param.syncFile, param.atomic));
+            this, file, param.modeFile, param.modePath, param.createPath, param.syncFile, param.atomic, this->windowSize));
 }
 
 /**********************************************************************************************************************************/
@@ -1609,6 +1611,7 @@ storageSftpNew(
         FUNCTION_LOG_PARAM(STRING_ID, param.hostKeyCheckType);
         FUNCTION_LOG_PARAM(STRING, param.hostFingerprint);
         FUNCTION_LOG_PARAM(STRING_LIST, param.knownHosts);
+        FUNCTION_LOG_PARAM(SIZE, param.windowSize);
         FUNCTION_LOG_PARAM(MODE, param.modeFile);
         FUNCTION_LOG_PARAM(MODE, param.modePath);
         FUNCTION_LOG_PARAM(BOOL, param.write);
@@ -1644,6 +1647,7 @@ storageSftpNew(
             .hostKeyCheckType = param.hostKeyCheckType,
             .hostFingerprint = strDup(param.hostFingerprint),
             .knownHosts = strLstDup(param.knownHosts),
+            .windowSize = param.windowSize,
         };
 
         // Init SFTP session
@@ -36,6 +36,7 @@ typedef struct StorageSftpNewParam
     StringId hostKeyCheckType;
     const String *hostFingerprint;
     const StringList *knownHosts;
+    size_t windowSize;                                              // Read-ahead/write-behind window size (0 to disable)
 } StorageSftpNewParam;
 
 #define storageSftpNewP(path, host, port, user, timeout, keyPriv, hostKeyHashType, ...)                                            \
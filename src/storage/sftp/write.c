@@ -5,6 +5,8 @@ SFTP Storage File Write
 
 #ifdef HAVE_LIBSSH2
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/log.h"
 #include "storage/sftp/write.h"
@@ -27,6 +29,9 @@ struct StorageWriteSftp
     const String *nameTmp;                                          // Temporary filename utilized for atomic ops
     const String *path;                                             // Utilized for path operations
     LIBSSH2_SFTP_HANDLE *sftpHandle;                                // LibSsh2 session sftp handle
+
+    size_t windowSize;                                              // Write-behind window size (0 to disable)
+    Buffer *writeBehind;                                            // Data written but not yet acknowledged by the server
 };
 
 /***********************************************************************************************************************************
@@ -100,9 +105,81 @@ storageWriteSftpOpen(THIS_VOID)
             storageSftpEvalLibSsh2Error(rc, sftpErr, &FileOpenError, strNewFmt(STORAGE_ERROR_WRITE_OPEN, strZ(this->name)), NULL);
     }
 
+    // Allocate the write-behind buffer
+    if (this->windowSize != 0)
+    {
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            this->writeBehind = bufNew(this->windowSize);
+        }
+        MEM_CONTEXT_OBJ_END();
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Write data and return the number of bytes acknowledged by the server. libssh2 sends all the data as pipelined requests but returns
+as soon as some of them have been acknowledged, so the data that was not acknowledged must be passed again (optionally followed by
+more data) on the next call.
+***********************************************************************************************************************************/
+static size_t
+storageWriteSftpData(StorageWriteSftp *const this, const unsigned char *const data, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_SFTP, this);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ssize_t rc;
+
+    do
+    {
+        rc = libssh2_sftp_write(this->sftpHandle, (const char *)data, size);
+    }
+    while (storageSftpWaitFd(this->storage, rc));
+
+    if (rc == LIBSSH2_ERROR_EAGAIN)
+        THROW_FMT(FileWriteError, "timeout writing '%s'", strZ(this->nameTmp));
+
+    if (rc < 0)
+    {
+        storageSftpEvalLibSsh2Error(
+            (int)rc, libssh2_sftp_last_error(storageSftpSessionSftp(this->storage)), &FileWriteError,
+            strNewFmt("unable to write '%s'", strZ(this->nameTmp)), NULL);
+    }
+
+    FUNCTION_TEST_RETURN(SIZE, (size_t)rc);
+}
+
+/***********************************************************************************************************************************
+Write the write-behind buffer until at least half of it has been acknowledged, or all of it when flushing. Waiting for only half
+keeps requests in flight while the buffer is refilled and limits how much unacknowledged data is moved to the start of the buffer.
+***********************************************************************************************************************************/
+static void
+storageWriteSftpBehind(StorageWriteSftp *const this, const bool flush)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_SFTP, this);
+        FUNCTION_TEST_PARAM(BOOL, flush);
+    FUNCTION_TEST_END();
+
+    ASSERT(this->writeBehind != NULL);
+
+    const size_t used = bufUsed(this->writeBehind);
+    size_t written = 0;
+
+    while (written < used && (flush || written < bufSize(this->writeBehind) / 2))
+        written += storageWriteSftpData(this, bufPtrConst(this->writeBehind) + written, used - written);
+
+    // Move data that has not been acknowledged to the start of the buffer
+    memmove(bufPtr(this->writeBehind), bufPtrConst(this->writeBehind) + written, used - written);
+    bufUsedSet(this->writeBehind, used - written);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Write to the file
 ***********************************************************************************************************************************/
@@ -120,39 +197,34 @@ storageWriteSftp(THIS_VOID, const Buffer *const buffer)
     ASSERT(buffer != NULL);
     ASSERT(this->sftpHandle != NULL);
 
-    ssize_t rc;
-    size_t remains = bufUsed(buffer);                               // Amount left to write
     size_t offset = 0;                                              // Offset into the buffer
 
-    // Loop until all the data is written
-    do
+    // Without a write-behind buffer loop until all the data is written
+    if (this->writeBehind == NULL)
     {
         do
         {
-            rc = libssh2_sftp_write(this->sftpHandle, (const char *)bufPtrConst(buffer) + offset, remains);
+            offset += storageWriteSftpData(this, bufPtrConst(buffer) + offset, bufUsed(buffer) - offset);
         }
-        while (storageSftpWaitFd(this->storage, rc));
-
-        // Break on error. Error will be thrown below the loop.
-        if (rc < 0)
-            break;
-
-        // Offset for next write start point
-        offset += (size_t)rc;
-
-        // Update amount left to write
-        remains -= (size_t)rc;
+        while (offset < bufUsed(buffer));
     }
-    while (remains);
+    // Else copy the data to the write-behind buffer and write when it is full. The writes complete on later calls or on close so
+    // multiple requests remain in flight.
+    else
+    {
+        while (offset < bufUsed(buffer))
+        {
+            if (bufFull(this->writeBehind))
+                storageWriteSftpBehind(this, false);
 
-    if (rc == LIBSSH2_ERROR_EAGAIN)
-        THROW_FMT(FileWriteError, "timeout writing '%s'", strZ(this->nameTmp));
+            size_t copySize = bufUsed(buffer) - offset;
 
-    if (rc < 0)
-    {
-        storageSftpEvalLibSsh2Error(
-            (int)rc, libssh2_sftp_last_error(storageSftpSessionSftp(this->storage)), &FileWriteError,
-            strNewFmt("unable to write '%s'", strZ(this->nameTmp)), NULL);
+            if (copySize > bufRemains(this->writeBehind))
+                copySize = bufRemains(this->writeBehind);
+
+            bufCatSub(this->writeBehind, buffer, offset, copySize);
+            offset += copySize;
+        }
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -251,6 +323,10 @@ storageWriteSftpClose(THIS_VOID)
     {
         int rc;
 
+        // Write data remaining in the write-behind buffer
+        if (this->writeBehind != NULL)
+            storageWriteSftpBehind(this, true);
+
         if (this->syncFile)
         {
             do
@@ -342,7 +418,7 @@ static const StorageWriteInterface storageWriteSftpInterface =
 FN_EXTERN StorageWriteSftp *
 storageWriteSftpNew(
     StorageSftp *const storage, const String *const name, const mode_t modeFile, const mode_t modePath, const bool createPath,
-    const bool syncFile, const bool atomic)
+    const bool syncFile, const bool atomic, const size_t windowSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_SFTP, storage);
@@ -352,6 +428,7 @@ storageWriteSftpNew(
         FUNCTION_LOG_PARAM(BOOL, createPath);
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(SIZE, windowSize);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -373,6 +450,7 @@ storageWriteSftpNew(
             .storage = storage,
             .nameTmp = atomic ? strNewFmt("%s." STORAGE_FILE_TEMP_EXT, strZ(name)) : strDup(name),
             .path = strPath(name),
+            .windowSize = windowSize,
         };
     }
     OBJ_NEW_END();
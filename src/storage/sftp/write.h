@@ -17,7 +17,8 @@ typedef struct StorageWriteSftp StorageWriteSftp;
 Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN StorageWriteSftp *storageWriteSftpNew(
-    StorageSftp *storage, const String *name, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool atomic);
+    StorageSftp *storage, const String *name, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool atomic,
+    size_t windowSize);
 
 /***********************************************************************************************************************************
 Macros for function logging
@@ -11,6 +11,7 @@ Storage Interface
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/stat.h"
 #include "common/type/list.h"
 #include "common/wait.h"
 #include "storage/storage.h"
@@ -254,6 +255,31 @@ storageGet(StorageRead *const file, const StorageGetParam param)
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageStatTimeAdd(const StringId type, const char *const operation, const TimeUSec time, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, type);
+        FUNCTION_TEST_PARAM(STRINGZ, operation);
+        FUNCTION_TEST_PARAM(UINT64, time);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(operation != NULL);
+
+    if (statTimeEnabled())
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            statTimeAdd(strNewFmt(STORAGE_STAT_PREFIX "%s.%s", strZ(strNewStrId(type)), operation), time, size);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN StorageInfo
 storageInfo(const Storage *const this, const String *const fileExp, StorageInfoParam param)
@@ -326,7 +352,12 @@ storageInfo(const Storage *const this, const String *const fileExp, StorageInfoP
                 }
             }
             else
+            {
+                const TimeUSec timeBegin = timeUSec();
+
                 result = storageInterfaceInfoP(storageDriver(this), file, param.level, .followLink = param.followLink);
+                storageStatTimeAdd(storageType(this), STORAGE_STAT_INFO, timeUSec() - timeBegin, 0);
+            }
         }
 
         // Error if the file missing and not ignoring
@@ -377,8 +408,9 @@ storageNewItr(const Storage *const this, const String *const pathExp, StorageNew
 
         result = storageItrMove(
             storageItrNew(
-                storageDriver(this), storagePathP(this, pathExp), param.level, param.errorOnMissing, param.nullOnMissing,
-                param.recurse, param.sortOrder, this->targetTime, param.expression),
+                storageDriver(this), storageType(this), storagePathP(this, pathExp), param.level, param.errorOnMissing,
+                param.nullOnMissing, param.recurse, param.recurse && storageFeature(this, storageFeatureListRecurse),
+                param.sortOrder, this->targetTime, param.expression),
             memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
@@ -464,7 +496,6 @@ storageMove(const Storage *const this, StorageRead *const source, StorageWrite *
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->pub.interface.move != NULL);
     ASSERT(source != NULL);
     ASSERT(destination != NULL);
     ASSERT(!storageReadIgnoreMissing(source));
@@ -473,8 +504,8 @@ storageMove(const Storage *const this, StorageRead *const source, StorageWrite *
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // If the file can't be moved it will need to be copied
-        if (!storageInterfaceMoveP(storageDriver(this), source, destination))                                       // {vm_covered}
+        // If the storage does not support moves or the file can't be moved it will need to be copied
+        if (this->pub.interface.move == NULL || !storageInterfaceMoveP(storageDriver(this), source, destination))   // {vm_covered}
         {
             // Perform the copy
             storageCopyP(source, destination);                                                                      // {vm_covered}
@@ -482,10 +513,9 @@ storageMove(const Storage *const this, StorageRead *const source, StorageWrite *
             // Remove the source file
             storageInterfaceRemoveP(storageDriver(this), storageReadName(source));                                  // {vm_covered}
 
-            // Sync source path if the destination path was synced. We know the source and destination paths are different because
-            // the move did not succeed. This will need updating when drivers other than Posix/CIFS are implemented because there's
-            // no way to get coverage on it now.
-            if (storageWriteSyncPath(destination))                                                                  // {vm_covered}
+            // Sync source path if the destination path was synced and the storage requires it. The paths may be the same when the
+            // storage does not support moves but syncing the path again does no harm.
+            if (storageWriteSyncPath(destination) && storageFeature(this, storageFeaturePathSync))                  // {vm_covered}
                 storageInterfacePathSyncP(storageDriver(this), strPath(storageReadName(source)));                   // {vm_covered}
         }
     }
@@ -568,6 +598,7 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
         FUNCTION_LOG_PARAM(BOOL, param.noSyncPath);
         FUNCTION_LOG_PARAM(BOOL, param.noAtomic);
         FUNCTION_LOG_PARAM(BOOL, param.noTruncate);
+        FUNCTION_LOG_PARAM(BOOL, param.exclusive);
         FUNCTION_LOG_PARAM(BOOL, param.compressible);
     FUNCTION_LOG_END();
 
@@ -575,6 +606,7 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
     ASSERT(this->write);
     // noTruncate does not work with atomic writes because a new file is always created for atomic writes
     ASSERT(!param.noTruncate || param.noAtomic);
+    ASSERT(!param.exclusive || storageFeature(this, storageFeatureWriteExclusive));
 
     StorageWrite *result;
 
@@ -584,7 +616,7 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
             storageWriteNew(
                 this, storagePathP(this, fileExp), param.modeFile != 0 ? param.modeFile : this->modeFile,
                 param.modePath != 0 ? param.modePath : this->modePath, param.user, param.group, param.timeModified,
-                !param.noCreatePath, !param.noSyncFile, !param.noSyncPath, !param.noAtomic, !param.noTruncate,
+                !param.noCreatePath, !param.noSyncFile, !param.noSyncPath, !param.noAtomic, !param.noTruncate, param.exclusive,
                 param.compressible),
             memContextPrior());
     }
@@ -764,7 +796,12 @@ storagePathRemove(const Storage *const this, const String *const pathExp, const
         const String *const path = storagePathP(this, pathExp);
 
         // Call driver function
-        if (!storageInterfacePathRemoveP(storageDriver(this), path, param.recurse) && param.errorOnMissing)
+        const TimeUSec timeBegin = timeUSec();
+        const bool result = storageInterfacePathRemoveP(storageDriver(this), path, param.recurse);
+
+        storageStatTimeAdd(storageType(this), STORAGE_STAT_PATH_REMOVE, timeUSec() - timeBegin, 0);
+
+        if (!result && param.errorOnMissing)
             THROW_FMT(PathRemoveError, STORAGE_ERROR_PATH_REMOVE_MISSING, strZ(path));
     }
     MEM_CONTEXT_TEMP_END();
@@ -832,7 +869,51 @@ storageRemove(const Storage *const this, const String *const fileExp, const Stor
     MEM_CONTEXT_TEMP_BEGIN()
     {
         // Call driver function
+        const TimeUSec timeBegin = timeUSec();
+
         storageInterfaceRemoveP(storageDriver(this), storagePathP(this, fileExp), .errorOnMissing = param.errorOnMissing);
+        storageStatTimeAdd(storageType(this), STORAGE_STAT_REMOVE, timeUSec() - timeBegin, 0);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageRemoveList(const Storage *const this, const StringList *const fileExpList, const StorageRemoveListParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileExpList);
+        (void)param;                                                // No parameters are used
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->write);
+    ASSERT(fileExpList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Remove the files in batches when the driver supports it
+        if (this->pub.interface.removeList != NULL)
+        {
+            StringList *const fileList = strLstNew();
+
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileExpList); fileIdx++)
+                strLstAdd(fileList, storagePathP(this, strLstGet(fileExpList, fileIdx)));
+
+            const TimeUSec timeBegin = timeUSec();
+
+            storageInterfaceRemoveListP(storageDriver(this), fileList);
+            storageStatTimeAdd(storageType(this), STORAGE_STAT_REMOVE, timeUSec() - timeBegin, 0);
+        }
+        // Else remove the files one at a time
+        else
+        {
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileExpList); fileIdx++)
+                storageRemoveP(this, strLstGet(fileExpList, fileIdx));
+        }
     }
     MEM_CONTEXT_TEMP_END();
 
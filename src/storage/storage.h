@@ -67,11 +67,33 @@ typedef enum
 
     // Can files be detected as missing on remove?
     storageFeatureFileRemoveMissing,
+
+    // Can files be written exclusively, i.e. error when the file already exists rather than overwriting it?
+    storageFeatureWriteExclusive,
+
+    // Can all the files below a path be listed in a single flat listing? Object stores can return a recursive prefix listing in
+    // pages rather than requiring a request per path, so the iterator lists once and infers the paths from the file names.
+    storageFeatureListRecurse,
 } StorageFeature;
 
+/***********************************************************************************************************************************
+Statistics constants
+***********************************************************************************************************************************/
+#define STORAGE_STAT_PREFIX                                         "storage."          // Prefix, e.g. storage.posix.read
+#define STORAGE_STAT_INFO                                           "info"              // Info operations
+#define STORAGE_STAT_LIST                                           "list"              // List operations (one per path)
+#define STORAGE_STAT_PATH_REMOVE                                    "path-remove"       // Path remove operations
+#define STORAGE_STAT_READ                                           "read"              // Reads (open to close)
+#define STORAGE_STAT_REMOVE                                         "remove"            // File remove operations
+#define STORAGE_STAT_WRITE                                          "write"             // Writes (open to close)
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+// Add time and bytes for a storage operation to the stats when timing is enabled. The stat key is storage.<type>.<operation>, e.g.
+// storage.s3.read.
+FN_EXTERN void storageStatTimeAdd(StringId type, const char *operation, TimeUSec time, uint64_t size);
+
 // Copy a file
 #define storageCopyP(source, destination)                                                                                          \
     storageCopy(source, destination)
@@ -148,7 +170,8 @@ typedef struct StorageListParam
 
 FN_EXTERN StringList *storageList(const Storage *this, const String *pathExp, StorageListParam param);
 
-// Move a file
+// Move a file. The file is copied and the source removed when the storage does not support moves or the move fails, e.g. when
+// the source and destination are on different devices.
 #define storageMoveP(this, source, destination)                                                                                    \
     storageMove(this, source, destination)
 
@@ -192,6 +215,10 @@ typedef struct StorageNewWriteParam
     // handle, which should always be the exception and indicates functionality that should be added to the storage interface.
     bool noTruncate;
 
+    // Error with FileExistsError when the file already exists rather than overwriting it. The check is made by the storage when the
+    // file is written so there is no race with other writers. Only valid for storage with storageFeatureWriteExclusive.
+    bool exclusive;
+
     bool compressible;
     mode_t modeFile;
     mode_t modePath;
@@ -274,6 +301,18 @@ typedef struct StorageRemoveParam
 
 FN_EXTERN void storageRemove(const Storage *this, const String *fileExp, StorageRemoveParam param);
 
+// Remove a list of files, ignoring files that are missing. Storage that can remove files in batches (e.g. S3) removes the list with
+// fewer requests, otherwise the files are removed one at a time.
+typedef struct StorageRemoveListParam
+{
+    VAR_PARAM_HEADER;
+} StorageRemoveListParam;
+
+#define storageRemoveListP(this, fileExpList, ...)                                                                                 \
+    storageRemoveList(this, fileExpList, (StorageRemoveListParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN void storageRemoveList(const Storage *this, const StringList *fileExpList, StorageRemoveListParam param);
+
 // Create a hard or symbolic link
 typedef struct StorageLinkCreateParam
 {
@@ -169,6 +169,9 @@ typedef struct StorageInterfaceNewWriteParam
     // which should always be the exception and shows functionality that should be added to the storage interface.
     bool truncate;
 
+    // Error with FileExistsError when the file already exists. Only set for storage with storageFeatureWriteExclusive.
+    bool exclusive;
+
     // Is the file compressible? This is used when the file must be moved across a network and temporary compression is helpful.
     bool compressible;
 } StorageInterfaceNewWriteParam;
@@ -197,6 +200,10 @@ typedef struct StorageInterfaceListParam
 
     // Target max version <= the specified time
     time_t targetTime;
+
+    // List all files below the path with names relative to the path, e.g. path/file. Paths are not returned since they will be
+    // inferred from the file names. Only set for storage with storageFeatureListRecurse.
+    bool recurse;
 } StorageInterfaceListParam;
 
 typedef StorageList *StorageInterfaceList(
@@ -264,6 +271,19 @@ typedef void StorageInterfacePathCreate(
     STORAGE_COMMON_INTERFACE(thisVoid).pathCreate(                                                                                 \
         thisVoid, path, errorOnExists, noParentCreate, mode, (StorageInterfacePathCreateParam){VAR_PARAM_INIT, __VA_ARGS__})
 
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Remove a list of files in batches. Missing files are ignored.
+typedef struct StorageInterfaceRemoveListParam
+{
+    VAR_PARAM_HEADER;
+} StorageInterfaceRemoveListParam;
+
+typedef void StorageInterfaceRemoveList(void *thisVoid, const StringList *fileList, StorageInterfaceRemoveListParam param);
+
+#define storageInterfaceRemoveListP(thisVoid, fileList, ...)                                                                       \
+    STORAGE_COMMON_INTERFACE(thisVoid).removeList(                                                                                 \
+        thisVoid, fileList, (StorageInterfaceRemoveListParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 // ---------------------------------------------------------------------------------------------------------------------------------
 // Sync a path
 typedef struct StorageInterfacePathSyncParam
@@ -319,6 +339,7 @@ typedef struct StorageInterface
     StorageInterfaceNewReadMulti *newReadMulti;
     StorageInterfacePathCreate *pathCreate;
     StorageInterfacePathSync *pathSync;
+    StorageInterfaceRemoveList *removeList;
 } StorageInterface;
 
 #define storageNewP(type, path, modeFile, modePath, write, pathExpressionFunction, driver, ...)                                    \
@@ -6,6 +6,7 @@ Storage Write Interface
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/stat.h"
 #include "storage/write.h"
 
 /***********************************************************************************************************************************
@@ -15,6 +16,8 @@ struct StorageWrite
 {
     StorageWritePub pub;                                            // Publicly accessible variables
     void *driver;                                                   // Driver
+    uint64_t bytesWritten;                                          // Bytes that have been written
+    TimeUSec time;                                                  // Time spent in the driver
 };
 
 /***********************************************************************************************************************************
@@ -31,8 +34,13 @@ storageWriteOpen(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
+
     storageWriteDriverInterface(this->driver)->open(this->driver);
 
+    if (timeBegin != 0)
+        this->time += timeUSec() - timeBegin;
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -51,8 +59,15 @@ storageWrite(THIS_VOID, const Buffer *const buffer)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
+
     storageWriteDriverInterface(this->driver)->write(this->driver, buffer);
 
+    if (timeBegin != 0)
+        this->time += timeUSec() - timeBegin;
+
+    this->bytesWritten += bufUsed(buffer);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -70,8 +85,13 @@ storageWriteClose(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    const TimeUSec timeBegin = statTimeEnabled() ? timeUSec() : 0;
+
     storageWriteDriverInterface(this->driver)->close(this->driver);
 
+    if (timeBegin != 0)
+        storageStatTimeAdd(storageWriteType(this), STORAGE_STAT_WRITE, this->time + timeUSec() - timeBegin, this->bytesWritten);
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -126,7 +146,7 @@ FN_EXTERN StorageWrite *
 storageWriteNew(
     const Storage *const storage, const String *const name, const mode_t modeFile, const mode_t modePath, const String *const user,
     const String *const group, const time_t timeModified, const bool createPath, const bool syncFile, const bool syncPath,
-    const bool atomic, const bool truncate, const bool compressible)
+    const bool atomic, const bool truncate, const bool exclusive, const bool compressible)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE, storage);
@@ -141,6 +161,7 @@ storageWriteNew(
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
         FUNCTION_LOG_PARAM(BOOL, truncate);
+        FUNCTION_LOG_PARAM(BOOL, exclusive);
         FUNCTION_LOG_PARAM(BOOL, compressible);
     FUNCTION_LOG_END();
 
@@ -156,7 +177,7 @@ storageWriteNew(
             .driver = storageInterfaceNewWriteP(
                 storageDriver(storage), name, .modeFile = modeFile, .modePath = modePath, .user = user, .group = group,
                 .timeModified = timeModified, .createPath = createPath, .syncFile = syncFile, .syncPath = syncPath,
-                .atomic = atomic, .truncate = truncate, .compressible = compressible),
+                .atomic = atomic, .truncate = truncate, .exclusive = exclusive, .compressible = compressible),
             .pub =
             {
                 .type = storageType(storage),
@@ -29,6 +29,8 @@ _BLOCK_MACRO = {
     "MEM_CONTEXT_NEW_BEGIN": "MEM_CONTEXT_NEW_END",
     "MEM_CONTEXT_TEMP_BEGIN": "MEM_CONTEXT_TEMP_END",
     "MEM_CONTEXT_TEMP_RESET_BEGIN": "MEM_CONTEXT_TEMP_END",
+    "MEM_CONTEXT_TEMP_ARENA_BEGIN": "MEM_CONTEXT_TEMP_END",
+    "MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN": "MEM_CONTEXT_TEMP_END",
     "OBJ_NEW_BEGIN": "OBJ_NEW_END",
     "OBJ_NEW_BASE_BEGIN": "OBJ_NEW_END",
     "OBJ_NEW_EXTRA_BEGIN": "OBJ_NEW_END",
@@ -52,6 +52,7 @@ hrnManifestFileAdd(Manifest *const manifest, const HrnManifestFile hrnManifestFi
         FUNCTION_HARNESS_PARAM(BOOL, hrnManifestFile.resume);
         FUNCTION_HARNESS_PARAM(BOOL, hrnManifestFile.checksumPage);
         FUNCTION_HARNESS_PARAM(BOOL, hrnManifestFile.checksumPageError);
+        FUNCTION_HARNESS_PARAM(BOOL, hrnManifestFile.dedup);
         FUNCTION_HARNESS_PARAM(MODE, hrnManifestFile.mode);
         FUNCTION_HARNESS_PARAM(STRINGZ, hrnManifestFile.checksumSha1);
         FUNCTION_HARNESS_PARAM(STRINGZ, hrnManifestFile.checksumRepoSha1);
@@ -82,6 +83,7 @@ hrnManifestFileAdd(Manifest *const manifest, const HrnManifestFile hrnManifestFi
             .checksumPage = hrnManifestFile.checksumPage,
             .checksumPageError = hrnManifestFile.checksumPageError,
             .checksumPageErrorList = hrnManifestFile.checksumPageErrorList,
+            .dedup = hrnManifestFile.dedup,
             .bundleId = hrnManifestFile.bundleId,
             .bundleOffset = hrnManifestFile.bundleOffset,
             .blockIncrSize = hrnManifestFile.blockIncrSize,
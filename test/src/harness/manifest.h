@@ -33,6 +33,7 @@ typedef struct HrnManifestFile
     bool resume : 1;
     bool checksumPage : 1;
     bool checksumPageError : 1;
+    bool dedup : 1;
     mode_t mode;
     const char *checksumSha1;
     const char *checksumRepoSha1;
@@ -248,6 +248,8 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
         FUNCTION_HARNESS_PARAM(STRING, param.certificate);
         FUNCTION_HARNESS_PARAM(STRING, param.key);
         FUNCTION_HARNESS_PARAM(STRING, param.address);
+        FUNCTION_HARNESS_PARAM(UINT, param.tlsErrorTotal);
+        FUNCTION_HARNESS_PARAM(BOOL, param.resume);
     FUNCTION_HARNESS_END();
 
     ASSERT(read != NULL);
@@ -267,7 +269,7 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
             param.key = strNewFmt("%s/" HRN_SERVER_CERT_PREFIX "server.key", hrnPathRepo());
         }
 
-        tlsServer = tlsServerNew(STRDEF(HRN_SERVER_HOST), param.ca, param.key, param.certificate, 5000);
+        tlsServer = tlsServerNewP(STRDEF(HRN_SERVER_HOST), param.ca, param.key, param.certificate, 5000, .resume = param.resume);
     }
 
     IoServer *socketServer = sckServerNew(param.address == NULL ? STRDEF("127.0.0.1") : param.address, port, 5000);
@@ -70,6 +70,7 @@ typedef struct HrnServerRunParam
     const String *key;                                              // TLS key when protocol = hrnServerProtocolTls
     const String *address;                                          // Use address other than 127.0.0.1
     unsigned int tlsErrorTotal;                                     // Total TLS errors to cause before success
+    bool resume;                                                    // Allow TLS session resumption
 } HrnServerRunParam;
 
 #define hrnServerRunP(read, protocol, port, ...)                                                                                   \
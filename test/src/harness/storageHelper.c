@@ -31,6 +31,9 @@ typedef struct HrnStorageWriteTest
     const StorageWriteInterface *interface;                         // Interface
     void *base;                                                     // Posix driver for base file
     void *version;                                                  // Posix driver for version file
+    Storage *storagePosix;                                          // Posix storage
+    const String *name;                                             // File name
+    bool exclusive;                                                 // Error when the file already exists
 } HrnStorageWriteTest;
 
 typedef struct HrnStorageReadTest
@@ -246,6 +249,10 @@ hrnStorageWriteTestOpen(THIS_VOID)
 
     ASSERT(this != NULL);
 
+    // Error when the file already exists and the write is exclusive
+    if (this->exclusive && storageExistsP(this->storagePosix, this->name))
+        THROW_FMT(FileExistsError, "unable to write '%s' because it already exists", strZ(this->name));
+
     storageWriteDriverInterface(this->base)->open(this->base);
     storageWriteDriverInterface(this->version)->open(this->version);
 
@@ -314,7 +321,7 @@ static HrnStorageWriteTest *
 hrnStorageWriteTestNew(
     Storage *const storagePosix, const String *const name, const mode_t modeFile, const mode_t modePath,
     const String *const user, const String *const group, time_t timeModified, const bool createPath, const bool syncFile,
-    const bool syncPath, const bool atomic, const bool truncate)
+    const bool syncPath, const bool atomic, const bool truncate, const bool exclusive)
 {
     FUNCTION_HARNESS_BEGIN();
         FUNCTION_HARNESS_PARAM(STORAGE_POSIX, storagePosix);
@@ -329,6 +336,7 @@ hrnStorageWriteTestNew(
         FUNCTION_HARNESS_PARAM(BOOL, syncPath);
         FUNCTION_HARNESS_PARAM(BOOL, atomic);
         FUNCTION_HARNESS_PARAM(BOOL, truncate);
+        FUNCTION_HARNESS_PARAM(BOOL, exclusive);
     FUNCTION_HARNESS_END();
 
     ASSERT(storagePosix != NULL);
@@ -353,6 +361,9 @@ hrnStorageWriteTestNew(
             .version = storageWritePosixNew(
                 storageDriver(storagePosix), hrnStorageTestVersionFind(storagePosix, name), modeFile, modePath, user, group,
                 timeModified, createPath, false, false, false, truncate),
+            .storagePosix = storagePosix,
+            .name = strDup(name),
+            .exclusive = exclusive,
         };
     }
     OBJ_NEW_END();
@@ -513,6 +524,7 @@ hrnStorageTestNewWrite(THIS_VOID, const String *const file, const StorageInterfa
         FUNCTION_HARNESS_PARAM(BOOL, param.syncPath);
         FUNCTION_HARNESS_PARAM(BOOL, param.atomic);
         FUNCTION_HARNESS_PARAM(BOOL, param.truncate);
+        FUNCTION_HARNESS_PARAM(BOOL, param.exclusive);
     FUNCTION_HARNESS_END();
 
     ASSERT(this != NULL);
@@ -523,7 +535,7 @@ hrnStorageTestNewWrite(THIS_VOID, const String *const file, const StorageInterfa
         HRN_STORAGE_WRITE_TEST,
         hrnStorageWriteTestNew(
             this->storagePosix, file, param.modeFile, param.modePath, param.user, param.group, param.timeModified,
-            param.createPath, param.syncFile, param.syncPath, param.atomic, param.truncate));
+            param.createPath, param.syncFile, param.syncPath, param.atomic, param.truncate, param.exclusive));
 }
 
 static void
@@ -652,7 +664,7 @@ hrnStorageTestNew(
     {
         .feature =
             1 << storageFeaturePath | 1 << storageFeaturePathSync | 1 << storageFeatureInfoDetail | 1 << storageFeatureVersioning |
-            1 << storageFeatureFileRemoveMissing,
+            1 << storageFeatureFileRemoveMissing | 1 << storageFeatureWriteExclusive,
 
         .info = hrnStorageTestInfo,
         .list = hrnStorageTestList,
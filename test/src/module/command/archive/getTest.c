@@ -11,6 +11,30 @@ Test Archive Get Command
 #include "harness/protocol.h"
 #include "harness/storage.h"
 
+/***********************************************************************************************************************************
+Find handler that is slow for processes at or above a process id to test searches that are still running when files are selected
+***********************************************************************************************************************************/
+static unsigned int testArchiveGetSlowProcess = 0;
+
+static ProtocolServerResult *
+testArchiveGetFindProtocol(PackRead *const param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(PACK_READ, param);
+    FUNCTION_HARNESS_END();
+
+    if (testArchiveGetSlowProcess != 0 && cfgOptionUInt(cfgOptProcess) >= testArchiveGetSlowProcess)
+        sleepMSec(1000);
+
+    FUNCTION_HARNESS_RETURN(PROTOCOL_SERVER_RESULT, archiveGetFindProtocol(param));
+}
+
+static const ProtocolServerHandler testLocalHandlerList[] =
+{
+    {.command = PROTOCOL_COMMAND_ARCHIVE_GET_FILE, .process = archiveGetFileProtocol},
+    {.command = PROTOCOL_COMMAND_ARCHIVE_GET_FIND, .process = testArchiveGetFindProtocol},
+};
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -36,7 +60,7 @@ testRun(void)
         TEST_TITLE("path missing");
 
         TEST_ERROR(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize),
+            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, 0, NULL),
             PathMissingError, "unable to list file info for missing path '" TEST_PATH "/spool/archive/test1/in'");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -45,7 +69,7 @@ testRun(void)
         HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN);
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize),
+            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, 0, NULL),
             "000000010000000100000001\n000000010000000100000002\n", "queue size smaller than min");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -54,7 +78,7 @@ testRun(void)
         queueSize = (16 * 1024 * 1024) * 3;
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize),
+            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, 0, NULL),
             "000000010000000100000001\n000000010000000100000002\n000000010000000100000003\n", "empty queue");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -83,12 +107,174 @@ testRun(void)
         HRN_STORAGE_PUT_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000B00000000.ok");
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000A00000FFD"), true, queueSize, walSegmentSize),
+            queueNeed(STRDEF("000000010000000A00000FFD"), true, queueSize, walSegmentSize, 0, NULL),
             "000000010000000B00000000\n000000010000000B00000001\n000000010000000B00000002\n", "queue has wal");
 
         TEST_STORAGE_LIST(
             storageSpool(), STORAGE_SPOOL_ARCHIVE_IN,
             "000000010000000A00000FFE\n000000010000000A00000FFF\n000000010000000A00000FFF.ok\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("queue depth and timeline switches");
+
+        // Queued on a timeline that recovery will not request
+        HRN_STORAGE_PUT(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000020000000B00000002", walSegmentBuffer);
+
+        // Queued beyond the queue depth
+        HRN_STORAGE_PUT(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000030000000B00000002", walSegmentBuffer);
+
+        TEST_RESULT_STRLST_Z(
+            queueNeed(
+                STRDEF("000000010000000A00000FFD"), true, queueSize, walSegmentSize, 4,
+                strLstNewSplitZ(STRDEF("000000020000000B00000001,000000030000000B00000002"), ",")),
+            "000000010000000B00000000\n000000020000000B00000001\n", "queue has wal");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000A00000FFE\n000000010000000A00000FFF\n000000010000000A00000FFF.ok\n000000030000000B00000002\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("queue depth larger than queue");
+
+        TEST_RESULT_STRLST_Z(
+            queueNeed(STRDEF("000000010000000A00000FFD"), true, queueSize, walSegmentSize, 6, NULL),
+            "000000010000000B00000000\n000000010000000B00000001\n000000010000000B00000002\n", "queue has wal");
+
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000A00000FFE\n000000010000000A00000FFF\n000000010000000A00000FFF.ok\n", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("timeline switches from history files in pg_wal");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        walSegmentSize = 16 * 1024 * 1024;
+
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000010000000000000001"), PG_VERSION_10, walSegmentSize), NULL, "no pg_wal");
+
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_wal/00000002.history", "1\t0/5000100\tno recovery target specified\n");
+        HRN_STORAGE_PUT_Z(
+            storagePgWrite(), "pg_wal/00000003.history",
+            "1\t0/5000100\tno recovery target specified\n"
+            "\n"
+            "2\t0/9000000\tno recovery target specified\n");
+
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000010000000000000001"), PG_VERSION_10, walSegmentSize),
+            "000000020000000000000005\n000000030000000000000009\n", "switches from newest history");
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000010000000000000005"), PG_VERSION_10, walSegmentSize), NULL, "not before switch");
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000030000000000000001"), PG_VERSION_10, walSegmentSize), NULL, "no newer timeline");
+
+        // Newer timeline that branched from timeline 1 before timeline 2
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_wal/00000004.history", "1\t0/3000000\tno recovery target specified\n");
+
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000020000000000000006"), PG_VERSION_10, walSegmentSize),
+            "000000030000000000000009\n", "skip history that does not descend");
+
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_wal/00000002.history");
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_wal/00000003.history");
+
+        TEST_RESULT_STRLST_Z(
+            queueTimelineSwitch(STRDEF("000000020000000000000006"), PG_VERSION_10, walSegmentSize), NULL, "no history descends");
+
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), "pg_wal", .recurse = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("queue statistics");
+
+        TimeMSec value1 = 0;
+        TimeMSec value2 = 0;
+
+        TEST_RESULT_BOOL(queueStatRead("in.fetch", &value1, &value2), false, "missing");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "1");
+        TEST_RESULT_BOOL(queueStatRead("in.fetch", &value1, &value2), false, "missing line");
+        TEST_RESULT_LOG("P00 DETAIL: ignore invalid queue statistics: in.fetch content must have two lines");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "100\n");
+        TEST_RESULT_BOOL(queueStatRead("in.fetch", &value1, &value2), false, "truncated");
+        TEST_RESULT_LOG("P00 DETAIL: ignore invalid queue statistics: unable to convert base 10 string '' to uint64");
+        TEST_RESULT_UINT(value1, 0, "value1 not set");
+        TEST_RESULT_UINT(value2, 0, "value2 not set");
+
+        // Invalid replay statistics are replaced
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "1000\nBOGUS");
+        TEST_RESULT_VOID(queueStatReplayUpdate(1000, true), "found with invalid prior");
+        TEST_RESULT_LOG("P00 DETAIL: ignore invalid queue statistics: unable to convert base 10 string 'BOGUS' to uint64");
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "1000\n0", .remove = true);
+
+        harnessLogLevelReset();
+
+        // Fetch statistics
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch");
+
+        TEST_RESULT_VOID(queueStatFetchUpdate(1000, 1100, 1100, 1), "single segment with no prior");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "100\n0");
+
+        TEST_RESULT_VOID(queueStatFetchUpdate(0, 200, 600, 3), "multiple segments");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "200\n200");
+
+        TEST_RESULT_VOID(queueStatFetchUpdate(1000, 1300, 1300, 1), "single segment keeps prior segment time");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "300\n200");
+
+        // Replay statistics
+        TEST_RESULT_VOID(queueStatReplayUpdate(1000, false), "not found with no prior");
+        TEST_STORAGE_LIST(storageSpool(), STORAGE_SPOOL_ARCHIVE, "in/\nin.fetch\n");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(1000, true), "found with no prior");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "1000\n0");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(1500, true), "first interval");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "1500\n500");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(2300, true), "average interval");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "2300\n575");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(2400, true), "short interval");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "2400\n456");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(2300, true), "time earlier than last is ignored");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "2300\n456");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(9000, false), "not found");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n456");
+
+        TEST_RESULT_VOID(queueStatReplayUpdate(9500, true), "found after not found does not update interval");
+        TEST_STORAGE_GET(storageSpool(), STORAGE_SPOOL_ARCHIVE "/in.replay", "9500\n456");
+
+        // Queue depth
+        queueSize = walSegmentSize * 10;
+
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 5, "depth from statistics");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n150");
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 10, "replay no faster than fetch");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "3000\n0");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n100");
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 10, "depth limited to queue size");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "10\n0");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n1000");
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 2, "depth at least 2");
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay");
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 10, "no replay statistics");
+
+        HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch");
+        TEST_RESULT_UINT(queueDepth(queueSize, walSegmentSize), 10, "no fetch statistics");
     }
 
     // *****************************************************************************************************************************
@@ -97,7 +283,6 @@ testRun(void)
         harnessLogLevelSet(logLevelDetail);
 
         // Install local command handler shim
-        static const ProtocolServerHandler testLocalHandlerList[] = {PROTOCOL_SERVER_HANDLER_ARCHIVE_GET_LIST};
         hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
 
         // Arguments that must be included
@@ -207,6 +392,10 @@ testRun(void)
         HRN_STORAGE_PUT_EMPTY(
             storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd.gz");
 
+        StringList *argListAdapt = strLstDup(argList);
+        hrnCfgArgRawBool(argListAdapt, cfgOptArchiveGetQueueAdapt, true);
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListAdapt, .role = cfgCmdRoleAsync);
+
         TEST_RESULT_VOID(cmdArchiveGetAsync(), "get async");
 
         TEST_RESULT_LOG(
@@ -224,10 +413,16 @@ testRun(void)
             .remove = true);
         TEST_STORAGE_LIST(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000100000001.pgbackrest.tmp\n");
 
+        TEST_RESULT_BOOL(
+            storageExistsP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE "/in.fetch")), false,
+            "no fetch statistics when nothing was fetched");
+
         TEST_STORAGE_EXISTS(
             storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd.gz",
             .remove = true);
 
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("single segment");
 
@@ -554,6 +749,235 @@ testRun(void)
         TEST_STORAGE_LIST(
             storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000200000000.pgbackrest.tmp\n", .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("search repos in parallel");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(0),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz",
+            .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(1),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz",
+            .errorOnMissing = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1", .mode = 0400);
+
+        // Search repo3 first so all repos must be searched before the first file can be selected
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", "1=2\n2=3\n3=1");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRepoParallel, true);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetQueueAdapt, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        strLstAddZ(argList, "000000010000000200000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000200000001\n"
+            "P00   WARN: repo3: [ArchiveMismatchError] raised from local-2 shim protocol: unable to retrieve the archive id for"
+            " database version '10' and system-id '" HRN_PG_SYSTEMID_10_Z "'\n"
+            "P00   WARN: repo1: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo/archive/test2/10-1"
+            "/0000000100000002': [13] Permission denied\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo2: 10-1 archive\n"
+            "P00 DETAIL: unable to find 000000010000000200000001 in the archive");
+
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] raised from local-2 shim protocol: unable to retrieve the archive id for database"
+            " version '10' and system-id '" HRN_PG_SYSTEMID_10_Z "'\n"
+            "repo1: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo/archive/test2/10-1/0000000100000002':"
+            " [13] Permission denied",
+            .remove = true);
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000001.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] raised from local-2 shim protocol: unable to retrieve the archive id for database"
+            " version '10' and system-id '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", .remove = true);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", .remove = true);
+
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid search times");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", "1=2\nbogus");
+        testArchiveGetSlowProcess = 4;
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRepoParallel, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        // Repos are searched in the configured order so repo3 is searched last and is still running when the file is selected
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P00 DETAIL: ignore invalid search times: in.latency line 'bogus' must be key=time\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo2: 10-1 archive");
+
+        testArchiveGetSlowProcess = 0;
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("select files once the highest priority repo with the first file has been searched");
+
+        // Search repo3 first (it has no search time) and repo1 last. Searching repo1 is slow so it is still running when files are
+        // selected.
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", "2=4\n1=100");
+        HRN_STORAGE_PATH_CREATE(storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/0000000100000003", .mode = 0200);
+        testArchiveGetSlowProcess = 4;
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRepoParallel, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        strLstAddZ(argList, "000000010000000300000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000300000000\n"
+            "P00   WARN: repo3: [ArchiveMismatchError] raised from local-2 shim protocol: unable to retrieve the archive id for"
+            " database version '10' and system-id '" HRN_PG_SYSTEMID_10_Z "'\n"
+            "P00   WARN: repo2: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo2/archive/test2/10-1"
+            "/0000000100000003': [13] Permission denied\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo2: 10-1 archive");
+
+        // The second file is not reported missing since it may be in repo1
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] raised from local-2 shim protocol: unable to retrieve the archive id for database"
+            " version '10' and system-id '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/0000000100000003");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file cannot be copied from searched repos or found in repos still being searched");
+
+        // Search repo2 first. Searching repo1 and repo3 is slow so they are still running when files are selected.
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", "1=100\n2=4\n3=100");
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            .errorOnMissing = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoIdxWrite(1),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz");
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1", .mode = 0400);
+        testArchiveGetSlowProcess = 3;
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRepoParallel, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "            repo2: 10-1/0000000100000002/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data\n"
+            "            repo1: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo/archive/test2/10-1"
+            "/0000000100000002': [13] Permission denied\n"
+            "            repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'");
+
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.error",
+            "42\n"
+            "raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "repo2: 10-1/0000000100000002/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data\n"
+            "repo1: [PathOpenError] unable to list file info for path '" TEST_PATH "/repo/archive/test2/10-1/0000000100000002':"
+            " [13] Permission denied\n"
+            "repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000200000000.pgbackrest.tmp\n", .remove = true);
+
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file cannot be copied from searched repos but is found in a repo still being searched");
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P01   WARN: repo2: 10-1/0000000100000002/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok",
+            "0\n"
+            "repo2: 10-1/0000000100000002/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data",
+            .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("search times are stored when there are none");
+
+        // Repos are searched in priority order. Searching repo2 and repo3 is slow so they are still running when the file is
+        // selected.
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.latency", .remove = true);
+
+        testArchiveGetSlowProcess = 0;
+
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(1),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz",
+            .errorOnMissing = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("order repos by search time");
+
+        List *const repoOrderList = lstNewP(sizeof(ArchiveGetCheckRepo), .comparator = archiveGetCheckRepoComparator);
+        lstAdd(repoOrderList, &(ArchiveGetCheckRepo){.repoIdx = 0, .latency = 5});
+        lstAdd(repoOrderList, &(ArchiveGetCheckRepo){.repoIdx = 2, .latency = 2});
+        lstAdd(repoOrderList, &(ArchiveGetCheckRepo){.repoIdx = 1, .latency = 2});
+
+        TEST_RESULT_VOID(lstSort(repoOrderList, sortOrderAsc), "sort");
+        TEST_RESULT_UINT(((ArchiveGetCheckRepo *)lstGet(repoOrderList, 0))->repoIdx, 1, "fastest repo with highest priority");
+        TEST_RESULT_UINT(((ArchiveGetCheckRepo *)lstGet(repoOrderList, 1))->repoIdx, 2, "fastest repo with lower priority");
+        TEST_RESULT_UINT(((ArchiveGetCheckRepo *)lstGet(repoOrderList, 2))->repoIdx, 0, "slowest repo");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("global error on invalid executable");
 
@@ -774,6 +1198,42 @@ testRun(void)
         TEST_STORAGE_LIST(storagePgWrite(), "pg_wal", "RECOVERYXLOG\n", .remove = true);
         TEST_STORAGE_LIST(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000100000002\n", .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("write WAL segments for success - adapt queue");
+
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetQueueAdapt, true);
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .exeBogus = true);
+
+        // Statistics show that two segments are enough to keep up with replay
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", "10\n0");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n1000");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", "SHOULD-BE-A-REAL-WAL-FILE");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000002", "SHOULD-BE-A-REAL-WAL-FILE");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000003", "SHOULD-BE-A-REAL-WAL-FILE");
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "successful get with queue full");
+
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000001 in the archive asynchronously");
+
+        TEST_STORAGE_LIST(storagePgWrite(), "pg_wal", "RECOVERYXLOG\n", .remove = true);
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000100000002\n000000010000000100000003\n", .remove = true);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay");
+
+        // The queue needs refilling so the async process is launched
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", "SHOULD-BE-A-REAL-WAL-FILE");
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000002", "SHOULD-BE-A-REAL-WAL-FILE");
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "successful get with queue not full");
+
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000001 in the archive asynchronously");
+
+        TEST_STORAGE_LIST(storagePgWrite(), "pg_wal", "RECOVERYXLOG\n", .remove = true);
+        TEST_STORAGE_LIST(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000100000002\n", .remove = true);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", .remove = true);
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", .remove = true);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("foreign lock forces a synchronous get");
 
@@ -922,7 +1382,7 @@ testRun(void)
 
         StringList *argListTemp = strLstDup(argList);
         hrnCfgArgRawZ(argListTemp, cfgOptPgVersionForce, "10");
-        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argListTemp);
 
         TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
 
@@ -1147,6 +1607,60 @@ testRun(void)
             " [FormatError] unexpected eof in compressed data\n"
             "P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo2: 10-1 archive");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("unable to get from one repo when searching in parallel");
+
+        hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
+
+        // Locals do not get the cipher type from the command line so it must be set in the environment
+        StringList *argParallelList = strLstDup(argList);
+        hrnCfgArgRawBool(argParallelList, cfgOptArchiveGetRepoParallel, true);
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherType, 2, CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC_Z);
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, TEST_CIPHER_PASS);
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argParallelList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: repo1: 10-2/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data\n"
+            "P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo2: 10-1 archive");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("search of repo2 is terminated when the file is selected from repo1");
+
+        // Searching repo2 is slow so it is still running when the file is selected. The file in repo1 is invalid so repo2 is
+        // searched again directly.
+        testArchiveGetSlowProcess = 3;
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: repo1: 10-2/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"
+            " [FormatError] unexpected eof in compressed data\n"
+            "P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo2: 10-1 archive");
+
+        testArchiveGetSlowProcess = 0;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file is not in any repo when searching in parallel");
+
+        argParallelList = strLstDup(argList);
+        strLstRemoveIdx(argParallelList, strLstSize(argParallelList) - 2);
+        strLstInsert(argParallelList, strLstSize(argParallelList) - 1, STRDEF("01ABCDEF01ABCDEF01ABCDF0"));
+        hrnCfgArgRawBool(argParallelList, cfgOptArchiveGetRepoParallel, true);
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argParallelList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 1, "get");
+
+        TEST_RESULT_LOG("P00   INFO: unable to find 01ABCDEF01ABCDEF01ABCDF0 in the archive");
+
+        hrnProtocolLocalShimUninstall();
+
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherType, 2);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("unable to get from all repos");
 
@@ -1168,9 +1682,10 @@ testRun(void)
             STORAGE_REPO_ARCHIVE "/10-1/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz");
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_TITLE("repo is specified so invalid repo is skipped");
+        TEST_TITLE("repo is specified so invalid repo is skipped and search is not parallel");
 
         hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRepoParallel, true);
         hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, TEST_CIPHER_PASS);
         HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
@@ -1223,6 +1738,7 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
         hrnCfgArgRawBool(argList, cfgOptArchiveAsync, true);
         hrnCfgArgRawBool(argList, cfgOptArchiveMissingRetry, false);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetQueueAdapt, true);
         strLstAddZ(argList, "000000010000000100000001");
         strLstAddZ(argList, "pg_wal/RECOVERYXLOG");
         HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
@@ -1246,6 +1762,10 @@ testRun(void)
 
         // Check that the ok file was removed
         TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        // Check that queue statistics were recorded and that the time spent waiting for the missing segment was not
+        TEST_STORAGE_EXISTS(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.fetch", .remove = true);
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/in.replay", "0\n0", .remove = true);
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
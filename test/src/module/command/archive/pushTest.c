@@ -12,6 +12,25 @@ Test Archive Push Command
 #include "harness/info.h"
 #include "harness/postgres.h"
 #include "harness/protocol.h"
+#include "harness/storageHelper.h"
+
+/***********************************************************************************************************************************
+Push handler that is slow for one process to test the archive timeout
+***********************************************************************************************************************************/
+static unsigned int testArchivePushSlowProcess = 0;
+
+static ProtocolServerResult *
+testArchivePushFileProtocol(PackRead *const param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(PACK_READ, param);
+    FUNCTION_HARNESS_END();
+
+    if (cfgOptionUInt(cfgOptProcess) == testArchivePushSlowProcess)
+        sleepMSec(3000);
+
+    FUNCTION_HARNESS_RETURN(PROTOCOL_SERVER_RESULT, archivePushFileProtocol(param));
+}
 
 /***********************************************************************************************************************************
 Test Run
@@ -314,6 +333,15 @@ testRun(void)
             "[db:history]\n"
             "1={\"db-id\":" HRN_PG_SYSTEMID_11_Z ",\"db-version\":\"11\"}\n");
 
+        // WAL too short to contain a header
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_wal/000000010000000100000001", "SHORT");
+
+        THROW_ON_SYS_ERROR(chdir(strZ(cfgOptionStr(cfgOptPgPath))) != 0, PathMissingError, "unable to chdir()");
+
+        TEST_ERROR(
+            cmdArchivePush(), FileReadError,
+            "unable to read 512 byte(s) from '" TEST_PATH "/pg/pg_wal/000000010000000100000001'");
+
         // Generate WAL with incorrect headers and try to push them
         Buffer *walBuffer1 = bufNew((size_t)16 * 1024 * 1024);
         bufUsedSet(walBuffer1, bufSize(walBuffer1));
@@ -322,8 +350,6 @@ testRun(void)
 
         HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000001", walBuffer1);
 
-        THROW_ON_SYS_ERROR(chdir(strZ(cfgOptionStr(cfgOptPgPath))) != 0, PathMissingError, "unable to chdir()");
-
         TEST_ERROR(
             cmdArchivePush(), ArchiveMismatchError,
             "WAL file '" TEST_PATH "/pg/pg_wal/000000010000000100000001' version 10, system-id " HRN_PG_SYSTEMID_10_Z " do not"
@@ -430,6 +456,105 @@ testRun(void)
                 strNewFmt("repo/archive/test/11-1/0000000100000001/000000010000000100000002-%s.gz.pgbackrest.tmp", walBuffer2Sha1)),
             false, "check WAL tmp file is gone");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("WAL too large to keep in memory is read again to copy it to the repo");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptCompressLevel, "1");
+        strLstAddZ(argListTemp, "pg_wal/000000010000000100000004");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        Buffer *walBuffer3 = bufNew((size_t)20 * 1024 * 1024);
+        memset(bufPtr(walBuffer3), 0, bufSize(walBuffer3));
+        bufUsedSet(walBuffer3, bufSize(walBuffer3));
+
+        HRN_PG_WAL_TO_BUFFER(walBuffer3, PG_VERSION_11);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000004", walBuffer3);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000004' to the archive");
+
+        StorageRead *walRead = storageNewReadP(
+            storageRepoIdx(0),
+            strNewFmt(
+                STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000004-%s.gz",
+                strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, walBuffer3)))));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walRead)), decompressFilterP(compressTypeGz));
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(walRead), walBuffer3), true, "check repo for WAL file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compressed WAL shared with the jobs pushing to other repos");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptCompressLevel, "1");
+        hrnCfgArgRawZ(argListTemp, cfgOptIoTimeout, "100ms");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        List *const repoList = lstNewP(sizeof(ArchivePushFileRepoData));
+        lstAdd(repoList, &(ArchivePushFileRepoData){.archiveId = STRDEF("11-1"), .cipherSpecArchive = cipherSpecNewNone()});
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000007", walBuffer2);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000008", walBuffer2);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/000000010000000100000009", walBuffer2);
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/00000001000000010000000A", walBuffer3);
+
+        // Write the compressed WAL from memory
+        TEST_RESULT_VOID(
+            archivePushFile(
+                STRDEF(TEST_PATH "/pg/pg_wal/000000010000000100000007"), false, true, true, PG_VERSION_11, 0,
+                STRDEF("000000010000000100000007"), compressTypeGz, 1, 0, STRDEF(TEST_PATH "/shared-07.gz"), true, repoList),
+            "write compressed WAL");
+
+        walRead = storageNewReadP(storageTest, STRDEF("shared-07.gz"));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walRead)), decompressFilterP(compressTypeGz));
+        TEST_RESULT_BOOL(bufEq(storageGetP(walRead), walBuffer2), true, "check compressed WAL");
+
+        walRead = storageNewReadP(
+            storageRepoIdx(0),
+            strNewFmt(STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000007-%s.gz", walBuffer2Sha1));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walRead)), decompressFilterP(compressTypeGz));
+        TEST_RESULT_BOOL(bufEq(storageGetP(walRead), walBuffer2), true, "check repo for WAL file");
+
+        // Use the compressed WAL written by another job
+        HRN_STORAGE_PUT_Z(storageTest, "shared-08.gz", "SHARED");
+
+        TEST_RESULT_VOID(
+            archivePushFile(
+                STRDEF(TEST_PATH "/pg/pg_wal/000000010000000100000008"), false, true, true, PG_VERSION_11, 0,
+                STRDEF("000000010000000100000008"), compressTypeGz, 1, 0, STRDEF(TEST_PATH "/shared-08.gz"), false, repoList),
+            "use compressed WAL");
+
+        TEST_STORAGE_GET(
+            storageRepoIdx(0),
+            zNewFmt(STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000008-%s.gz", walBuffer2Sha1), "SHARED",
+            .comment = "check repo for compressed WAL");
+
+        // Compress the WAL when the compressed WAL is not written by another job in time
+        TEST_RESULT_VOID(
+            archivePushFile(
+                STRDEF(TEST_PATH "/pg/pg_wal/000000010000000100000009"), false, true, true, PG_VERSION_11, 0,
+                STRDEF("000000010000000100000009"), compressTypeGz, 1, 0, STRDEF(TEST_PATH "/shared-09.gz"), false, repoList),
+            "compress WAL");
+
+        walRead = storageNewReadP(
+            storageRepoIdx(0),
+            strNewFmt(STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/000000010000000100000009-%s.gz", walBuffer2Sha1));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walRead)), decompressFilterP(compressTypeGz));
+        TEST_RESULT_BOOL(bufEq(storageGetP(walRead), walBuffer2), true, "check repo for WAL file");
+
+        // Write the compressed WAL from a segment too large to keep in memory
+        TEST_RESULT_VOID(
+            archivePushFile(
+                STRDEF(TEST_PATH "/pg/pg_wal/00000001000000010000000A"), false, true, true, PG_VERSION_11, 0,
+                STRDEF("00000001000000010000000A"), compressTypeGz, 1, 0, STRDEF(TEST_PATH "/shared-0A.gz"), true, repoList),
+            "write compressed WAL");
+
+        walRead = storageNewReadP(storageTest, STRDEF("shared-0A.gz"));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walRead)), decompressFilterP(compressTypeGz));
+        TEST_RESULT_BOOL(bufEq(storageGetP(walRead), walBuffer3), true, "check compressed WAL");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("push a history file");
 
@@ -658,6 +783,61 @@ testRun(void)
             .remove = true);
 
         HRN_STORAGE_MODE(storageTest, "repo2/archive/test/11-1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL with exclusive writes when the duplicate check is disabled");
+
+        hrnStorageHelperRepoShimSet(true);
+
+        argList = strLstDup(argListTemp);
+        hrnCfgArgRawBool(argList, cfgOptArchiveDuplicateCheck, false);
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, "badpassphrase");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000002' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo2/archive/test/11-1/0000000100000001/000000010000000100000002-%s", walBuffer2Sha1),
+            .comment = "check repo2 for WAL file");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/11-1/0000000100000001/000000010000000100000002-%s", walBuffer2Sha1),
+            .comment = "check repo3 for WAL file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("exclusive writes find the WAL already in both repos");
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG(
+            "P00   WARN: WAL file '000000010000000100000002' already exists in the repo2 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P00   WARN: WAL file '000000010000000100000002' already exists in the repo3 archive with the same checksum\n"
+            "            HINT: this is valid in some recovery scenarios but may also indicate a problem.\n"
+            "P00   INFO: pushed WAL file '000000010000000100000002' to the archive");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("no warning when the exclusive write finds the WAL and the mode check is disabled");
+
+        hrnCfgArgRawBool(argList, cfgOptArchiveModeCheck, false);
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, "badpassphrase");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000002' to the archive");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("repos that cannot write exclusively are listed when the duplicate check is disabled");
+
+        hrnStorageHelperRepoShimSet(false);
+
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, "badpassphrase");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '000000010000000100000002' to the archive");
     }
 
     // *****************************************************************************************************************************
@@ -666,7 +846,10 @@ testRun(void)
         harnessLogLevelSet(logLevelDetail);
 
         // Install local command handler shim
-        static const ProtocolServerHandler testLocalHandlerList[] = {PROTOCOL_SERVER_HANDLER_ARCHIVE_PUSH_LIST};
+        static const ProtocolServerHandler testLocalHandlerList[] =
+        {
+            {.command = PROTOCOL_COMMAND_ARCHIVE_PUSH_FILE, .process = testArchivePushFileProtocol},
+        };
         hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1196,20 +1379,17 @@ testRun(void)
         argListTemp = strLstDup(argList);
         HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
 
-        // The job that errors and the one already in flight (process-max is 1) both complete, then scheduling stops
+        // The job that errors and the one already in flight (process-max is 1), which pushes the same WAL to repo3, both complete,
+        // then scheduling stops
         TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
         TEST_RESULT_LOG_FMT(
             "P00   INFO: push 6 WAL file(s) to archive: 000000010000000100000004...000000010000000100000009\n"
             "P01   WARN: could not push WAL file '000000010000000100000004' to the archive (will be retried): "
-            "[104] raised from local-1 shim protocol: archive-push command encountered error(s):\n"
+            "[104] archive-push command encountered error(s):\n"
             "            repo1: [FileOpenError] unable to open file '" TEST_PATH
             "/repo/archive/test/18-1/0000000100000001/000000010000000100000004-%s' for write: [13] Permission denied\n"
-            "P01   WARN: could not push WAL file '000000010000000100000005' to the archive (will be retried): "
-            "[104] raised from local-1 shim protocol: archive-push command encountered error(s):\n"
-            "            repo1: [FileOpenError] unable to open file '" TEST_PATH
-            "/repo/archive/test/18-1/0000000100000001/000000010000000100000005-%s' for write: [13] Permission denied\n"
             "P00   WARN: stopped archive-push after an error, remaining WAL will be processed on the next run",
-            walBufferBatchSha1, walBufferBatchSha1);
+            walBufferBatchSha1);
 
         // Restore the repo mode so later tests can write
         HRN_STORAGE_MODE(storageTest, "repo/archive/test/18-1/0000000100000001");
@@ -1217,10 +1397,184 @@ testRun(void)
         // Only the segments processed before stopping have status files; the rest are left for the next run
         TEST_STORAGE_LIST(
             storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT,
-            "000000010000000100000004.error\n"
-            "000000010000000100000005.error\n",
+            "000000010000000100000004.error\n",
+            .comment = "check status files");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push WAL to each repo in a separate job");
+
+        // Remove status and ready files to get a clean state
+        HRN_STORAGE_PATH_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT, .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT);
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), "pg_xlog/archive_status", .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storagePgWrite(), "pg_xlog/archive_status");
+
+        for (unsigned int walIdx = 0xA0; walIdx <= 0xA1; walIdx++)
+        {
+            HRN_STORAGE_PUT(storagePgWrite(), zNewFmt("pg_xlog/0000000100000001%08X", walIdx), walBufferBatch);
+            HRN_STORAGE_PUT_EMPTY(storagePgWrite(), zNewFmt("pg_xlog/archive_status/0000000100000001%08X.ready", walIdx));
+        }
+
+        // With two processes the first WAL is pushed to repo1 and repo3 at the same time. After that jobs are scheduled as
+        // processes free up so the order the WAL are completed in is not deterministic and the detail log is not checked.
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptProcessMax, "2");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        harnessLogLevelSet(logLevelInfo);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG("P00   INFO: push 2 WAL file(s) to archive: 0000000100000001000000A0...0000000100000001000000A1");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo/archive/test/18-1/0000000100000001/0000000100000001000000A0-%s", walBufferBatchSha1),
+            .comment = "check repo1 for WAL file");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/18-1/0000000100000001/0000000100000001000000A0-%s", walBufferBatchSha1),
+            .comment = "check repo3 for WAL file");
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo/archive/test/18-1/0000000100000001/0000000100000001000000A1-%s", walBufferBatchSha1),
+            .comment = "check repo1 for WAL file");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/18-1/0000000100000001/0000000100000001000000A1-%s", walBufferBatchSha1),
+            .comment = "check repo3 for WAL file");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT,
+            "0000000100000001000000A0.ok\n"
+            "0000000100000001000000A1.ok\n",
             .comment = "check status files");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("WAL pushed to all valid repos is not acknowledged when a repo fails the archive check");
+
+        HRN_STORAGE_PATH_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT, .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT);
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/0000000100000001000000A0.ready", .errorOnMissing = true);
+
+        // Add repo4 without archive.info
+        argListTemp = strLstDup(argList);
+        hrnCfgArgKeyRawZ(argListTemp, cfgOptRepoPath, 4, TEST_PATH "/repo4");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segment");
+        TEST_RESULT_LOG(
+            "P00   INFO: push 1 WAL file(s) to archive: 0000000100000001000000A1\n"
+            "P01   WARN: could not push WAL file '0000000100000001000000A1' to the archive (will be retried): [104] archive-push"
+            " command encountered error(s):\n"
+            "            repo4: [FileMissingError] unable to load info file '" TEST_PATH "/repo4/archive/test/archive.info' or '"
+            TEST_PATH "/repo4/archive/test/archive.info.copy':\n"
+            "            FileMissingError: unable to open missing file '" TEST_PATH "/repo4/archive/test/archive.info' for read\n"
+            "            FileMissingError: unable to open missing file '" TEST_PATH "/repo4/archive/test/archive.info.copy'"
+            " for read\n"
+            "            HINT: archive.info cannot be opened but is required to push/get WAL segments.\n"
+            "            HINT: is archive_command configured correctly in postgresql.conf?\n"
+            "            HINT: has a stanza-create been performed?\n"
+            "            HINT: use --no-archive-check to disable archive checks during backup if you have an alternate archiving"
+            " scheme.\n"
+            "P00   WARN: stopped archive-push after an error, remaining WAL will be processed on the next run");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT, "0000000100000001000000A1.error\n", .comment = "check status files");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("WAL compressed once and shared by the jobs pushing to each repo");
+
+        HRN_STORAGE_PATH_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT, .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT);
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), "pg_xlog/archive_status", .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storagePgWrite(), "pg_xlog/archive_status");
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/0000000100000001000000A2", walBufferBatch);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/0000000100000001000000A2.ready");
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_xlog/00000002.history", "HISTORY");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/00000002.history.ready");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptProcessMax, "2");
+        strLstRemove(argListTemp, STRDEF("--" CFGOPT_COMPRESS_TYPE "=none"));
+        hrnCfgArgRawZ(argListTemp, cfgOptCompressType, "gz");
+        hrnCfgArgRawZ(argListTemp, cfgOptCompressLevel, "1");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        harnessLogLevelSet(logLevelInfo);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segment and history file");
+        TEST_RESULT_LOG("P00   INFO: push 2 WAL file(s) to archive: 0000000100000001000000A2...00000002.history");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo/archive/test/18-1/0000000100000001/0000000100000001000000A2-%s.gz", walBufferBatchSha1),
+            .comment = "check repo1 for WAL file");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/18-1/0000000100000001/0000000100000001000000A2-%s.gz", walBufferBatchSha1),
+            .comment = "check repo3 for WAL file");
+
+        TEST_STORAGE_GET(storageTest, "repo/archive/test/18-1/00000002.history", "HISTORY", .comment = "check repo1 for history");
+        TEST_STORAGE_GET(storageTest, "repo3/archive/test/18-1/00000002.history", "HISTORY", .comment = "check repo3 for history");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT, "0000000100000001000000A2.ok\n00000002.history.ok\n",
+            .comment = "compressed WAL is removed from the spool");
+
+        // The compressed WAL is not shared when there is only one repo
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), "pg_xlog/archive_status", .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storagePgWrite(), "pg_xlog/archive_status");
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/0000000100000001000000A4", walBufferBatch);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/0000000100000001000000A4.ready");
+
+        strLstRemove(argListTemp, STRDEF("--repo3-path=" TEST_PATH "/repo3"));
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segment");
+        TEST_RESULT_LOG(
+            "P00   INFO: push 1 WAL file(s) to archive: 0000000100000001000000A4\n"
+            "P01 DETAIL: pushed WAL file '0000000100000001000000A4' to the archive");
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo/archive/test/18-1/0000000100000001/0000000100000001000000A4-%s.gz", walBufferBatchSha1),
+            .comment = "check repo1 for WAL file");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT, "0000000100000001000000A4.ok\n", .comment = "check status files");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error status written when a repo does not push the WAL within the archive timeout");
+
+        HRN_STORAGE_PATH_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT, .recurse = true);
+        HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_OUT);
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/0000000100000001000000A4.ready", .errorOnMissing = true);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/0000000100000001000000A3", walBufferBatch);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/0000000100000001000000A3.ready");
+
+        // The second process pushes to repo3 and is slower than the archive timeout
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptProcessMax, "2");
+        hrnCfgArgRawZ(argListTemp, cfgOptArchiveTimeout, "1500ms");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        testArchivePushSlowProcess = 2;
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segment");
+        TEST_RESULT_LOG(
+            "P00   INFO: push 1 WAL file(s) to archive: 0000000100000001000000A3\n"
+            "P02   WARN: could not push WAL file '0000000100000001000000A3' to the archive (will be retried): [104] archive-push"
+            " command encountered error(s):\n"
+            "            repo3: [ArchiveTimeoutError] unable to push WAL file '0000000100000001000000A3' to the repo after 1.5"
+            " second(s)\n"
+            "P00   WARN: stopped archive-push after an error, remaining WAL will be processed on the next run");
+
+        testArchivePushSlowProcess = 0;
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_OUT, "0000000100000001000000A3.error\n", .comment = "check status files");
+
         // Uninstall local command handler shim
         hrnProtocolLocalShimUninstall();
     }
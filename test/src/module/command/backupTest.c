@@ -13,6 +13,7 @@ Test Backup Command
 #include "harness/backup.h"
 #include "harness/blockIncr.h"
 #include "harness/config.h"
+#include "harness/info.h"
 #include "harness/manifest.h"
 #include "harness/pack.h"
 #include "harness/postgres.h"
@@ -731,6 +732,94 @@ testRun(void)
         TEST_RESULT_UINT(segmentNumber(STRDEF("999.123")), 123, "Segment number");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("backupCompressAdaptLevel(), backupCompressAdaptUpdate(), and backupFileCopy()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("level is not changed when not adaptive");
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(false, 22), 22, "configured level");
+        TEST_RESULT_VOID(backupCompressAdaptUpdate(false, 0, 1000), "update");
+        TEST_RESULT_INT(backupCompressAdapt.level, 0, "level not set");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("first level is limited to adaptive range");
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, -7), 1, "min level");
+        backupCompressAdapt.level = 0;
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 22), 19, "max level");
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 19, "level is not reset");
+        backupCompressAdapt.level = 0;
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 3, "configured level");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("level is raised when writing is slower");
+
+        for (unsigned int bufferIdx = 0; bufferIdx < BACKUP_COMPRESS_ADAPT_WINDOW - 1; bufferIdx++)
+            backupCompressAdaptUpdate(true, 10, 20);
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 3, "level not changed before window is complete");
+        TEST_RESULT_VOID(backupCompressAdaptUpdate(true, 10, 20), "complete window");
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 4, "level raised");
+        TEST_RESULT_UINT(backupCompressAdapt.bufferTotal, 0, "window reset");
+        TEST_RESULT_UINT(backupCompressAdapt.readTime, 0, "read time reset");
+        TEST_RESULT_UINT(backupCompressAdapt.writeTime, 0, "write time reset");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("level is not changed when times are close");
+
+        for (unsigned int bufferIdx = 0; bufferIdx < BACKUP_COMPRESS_ADAPT_WINDOW; bufferIdx++)
+            backupCompressAdaptUpdate(true, 10, 11);
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 4, "level not changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("level is lowered when reading is slower");
+
+        for (unsigned int bufferIdx = 0; bufferIdx < BACKUP_COMPRESS_ADAPT_WINDOW; bufferIdx++)
+            backupCompressAdaptUpdate(true, 20, 10);
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), 3, "level lowered");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("level does not go outside the adaptive range");
+
+        backupCompressAdapt.level = BACKUP_COMPRESS_ADAPT_LEVEL_MAX;
+
+        for (unsigned int bufferIdx = 0; bufferIdx < BACKUP_COMPRESS_ADAPT_WINDOW; bufferIdx++)
+            backupCompressAdaptUpdate(true, 10, 20);
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), BACKUP_COMPRESS_ADAPT_LEVEL_MAX, "level at max");
+
+        backupCompressAdapt.level = BACKUP_COMPRESS_ADAPT_LEVEL_MIN;
+
+        for (unsigned int bufferIdx = 0; bufferIdx < BACKUP_COMPRESS_ADAPT_WINDOW; bufferIdx++)
+            backupCompressAdaptUpdate(true, 20, 10);
+
+        TEST_RESULT_INT(backupCompressAdaptLevel(true, 3), BACKUP_COMPRESS_ADAPT_LEVEL_MIN, "level at min");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy measures each buffer");
+
+        const size_t bufferSize = ioBufferSize();
+        ioBufferSizeSet(4);
+
+        Buffer *const destination = bufNew(0);
+        IoWrite *const write = ioBufferWriteNew(destination);
+        ioWriteOpen(write);
+
+        IoRead *const read = ioBufferReadNew(BUFSTRDEF("0123456789"));
+        ioReadOpen(read);
+
+        TEST_RESULT_VOID(backupFileCopy(read, write, true), "copy");
+        TEST_RESULT_UINT(backupCompressAdapt.bufferTotal, 3, "buffers measured");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+        TEST_RESULT_STR_Z(strNewBuf(destination), "0123456789", "check copy");
+
+        backupCompressAdapt = (struct BackupCompressAdapt){0};
+        ioBufferSizeSet(bufferSize);
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("BlockMap"))
     {
@@ -1677,6 +1766,54 @@ testRun(void)
         dbFree(backupData->dbPrimary);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("backupBuildIncrPrior()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("synthetic full depth stops at a prior backup missing from backup.info");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoBlockFullSynthetic, true);
+        hrnCfgArgRawZ(argList, cfgOptRepoBlockFullSyntheticDepth, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        const InfoBackup *const infoBackup = infoBackupNewLoad(
+            ioBufferReadNew(
+                harnessInfoChecksumZ(
+                    "[backup:current]\n"
+                    "20191103-165320F={"
+                    "\"backrest-format\":5,\"backrest-version\":\"2.60.0dev\","
+                    "\"backup-archive-start\":\"000000010000000000000002\",\"backup-archive-stop\":\"000000010000000000000002\","
+                    "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":346,"
+                    "\"backup-info-size\":20162900,\"backup-info-size-delta\":8428,"
+                    "\"backup-prior\":\"20191102-165320F\",\"backup-reference\":[\"20191102-165320F\"],"
+                    "\"backup-timestamp-start\":1572800000,\"backup-timestamp-stop\":1572800100,\"backup-type\":\"full\","
+                    "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+                    "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+                    "\n"
+                    "[db]\n"
+                    "db-catalog-version=201409291\n"
+                    "db-control-version=942\n"
+                    "db-id=1\n"
+                    "db-system-id=6625592122879095702\n"
+                    "db-version=\"9.4\"\n"
+                    "\n"
+                    "[db:history]\n"
+                    "1={\"db-catalog-version\":201409291,\"db-control-version\":942,\"db-system-id\":6625592122879095702"
+                    ",\"db-version\":\"9.4\"}\n")),
+            cipherSpecNewNone());
+
+        TEST_RESULT_PTR(backupBuildIncrPrior(infoBackup), NULL, "no prior");
+        TEST_RESULT_LOG("P00   INFO: synthetic full depth 1 reached, full backup will not reference prior backups");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupResumeFind()"))
     {
@@ -1815,6 +1952,24 @@ testRun(void)
 
         TEST_STORAGE_LIST_EMPTY(storageRepo(), STORAGE_REPO_BACKUP, .comment = "check backup path removed");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("cannot resume synthetic full backup");
+
+        manifest->pub.data.backupLabelPrior = STRDEF("20191003-105320F");
+
+        manifestSave(
+            manifestResume,
+            storageWriteIo(
+                storageNewWriteP(
+                    storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
+
+        TEST_RESULT_PTR(backupResumeFind(manifest, cipherSpecNewNone()), NULL, "find resumable backup");
+
+        TEST_RESULT_LOG("P00   WARN: backup '20191003-105320F' cannot be resumed: resume not valid for synthetic full backup");
+
+        TEST_STORAGE_LIST_EMPTY(storageRepo(), STORAGE_REPO_BACKUP, .comment = "check backup path removed");
+
+        manifest->pub.data.backupLabelPrior = NULL;
         manifestResume->pub.data.backupLabelPrior = NULL;
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -2155,6 +2310,329 @@ testRun(void)
             strLstSize(storageListP(storageRepoIdx(1), strNewFmt(STORAGE_PATH_BACKUP "/test1"))), backupCount + 1,
             "new backup repo2");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline full backups with zst and adaptive compress level");
+
+        // Set log level to warn
+        harnessLogLevelSet(logLevelWarn);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg1");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        hrnCfgArgRawZ(argList, cfgOptCompressType, "zst");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        hrnCfgArgRawBool(argList, cfgOptCompressLevelAdapt, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // Start the adaptive level at the max so the level used to compress a file can be distinguished from the configured level.
+        // The file is compressed at both levels to compare with the file stored in the repo.
+        String *const adaptContent = strNew();
+
+        for (unsigned int lineIdx = 0; lineIdx < 4096; lineIdx++)
+            strCatFmt(adaptContent, "line %u of the file used to check the adaptive compress level\n", lineIdx % 97);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "adapt", BUFSTR(adaptContent));
+
+        Buffer *adaptLevel[2];
+        const int adaptLevelList[2] = {BACKUP_COMPRESS_ADAPT_LEVEL_MAX, 3};
+
+        for (unsigned int levelIdx = 0; levelIdx < LENGTH_OF(adaptLevel); levelIdx++)
+        {
+            adaptLevel[levelIdx] = bufNew(0);
+            IoWrite *const adaptWrite = ioBufferWriteNew(adaptLevel[levelIdx]);
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(adaptWrite),
+                compressFilterP(compressTypeZst, adaptLevelList[levelIdx], .size = strSize(adaptContent)));
+            ioWriteOpen(adaptWrite);
+            ioWrite(adaptWrite, BUFSTR(adaptContent));
+            ioWriteClose(adaptWrite);
+        }
+
+        TEST_RESULT_BOOL(bufEq(adaptLevel[0], adaptLevel[1]), false, "levels compress differently");
+
+        backupCompressAdapt.level = BACKUP_COMPRESS_ADAPT_LEVEL_MAX;
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        TEST_RESULT_BOOL(
+            bufEq(storageGetP(storageNewReadP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest/pg_data/adapt.zst"))),
+            adaptLevel[0]), true, "file compressed at adaptive level");
+
+        backupCompressAdapt = (struct BackupCompressAdapt){0};
+        HRN_STORAGE_REMOVE(storagePgWrite(), "adapt", .errorOnMissing = true);
+
+        TEST_RESULT_LOG("");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline full backup with dedup");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        // Create stanzas that share the dedup store
+        HRN_PG_CONTROL_PUT(storagePosixNewP(STRDEF(TEST_PATH "/pg-dedup"), .write = true), PG_VERSION_18);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        HRN_CFG_LOAD(cfgCmdStanzaCreate, argList);
+
+        cmdStanzaCreate();
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test2");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        HRN_CFG_LOAD(cfgCmdStanzaCreate, argList);
+
+        cmdStanzaCreate();
+
+        TEST_RESULT_LOG(
+            "P00   INFO: stanza-create for stanza 'test1' on repo1\n"
+            "P00   INFO: stanza-create for stanza 'test2' on repo1");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawBool(argList, cfgOptCompress, false);
+        hrnCfgArgRawBool(argList, cfgOptChecksumPage, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoDedup, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        const Storage *const storagePgDedup = storagePosixNewP(STRDEF(TEST_PATH "/pg-dedup"), .write = true);
+
+        HRN_STORAGE_PUT_Z(storagePgDedup, PG_FILE_PGVERSION, "18");
+        HRN_STORAGE_PUT_Z(storagePgDedup, "postgresql.conf", "CONFIG");
+
+        // Identical relations are stored once
+        Buffer *relation = bufNew(pgPageSize8);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        bufUsedSet(relation, bufSize(relation));
+
+        HRN_STORAGE_PUT(storagePgDedup, PG_PATH_BASE "/1/1", relation);
+        HRN_STORAGE_PUT(storagePgDedup, PG_PATH_BASE "/1/2", relation);
+        HRN_STORAGE_PUT_Z(storagePgDedup, "changed", "AFTER!");
+        HRN_STORAGE_PUT_Z(storagePgDedup, "removed", "REMOVED");
+
+        // Remove a file before it is copied
+        HRN_BACKUP_SCRIPT_SET(
+            {.op = hrnBackupScriptOpRemove, .file = STRDEF(TEST_PATH "/pg-dedup/removed")});
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        TEST_RESULT_LOG(
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/base/1/1 (8KB, 33.30%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/base/1/2 (8KB, 66.61%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/global/pg_control (8KB, 99.91%) checksum"
+            " 807d4464138ef085e41844a9f488f067b3d46d46\n"
+            "P01 DETAIL: skip file removed by database " TEST_PATH "/pg-dedup/removed\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/changed (6B, 99.97%) checksum"
+            " a9838cd726170dd9d3717880a1814ee0d30884ed\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/postgresql.conf (6B, 99.99%) checksum"
+            " 2fb60054b43a25d7a958d3d19bdb1aa7809577a8\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/PG_VERSION (2B, 100.00%) checksum"
+            " 9e6a55b6b4563e652a23be9d623ca5055c356940\n"
+            "P00   INFO: new backup label = [FULL-3]\n"
+            "P00   INFO: full backup size = 24KB, file total = 6");
+
+        TEST_STORAGE_LIST(
+            storageTest, "repo-dedup/dedup",
+            "06/\n"
+            "06/0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "2f/\n"
+            "2f/2fb60054b43a25d7a958d3d19bdb1aa7809577a8\n"
+            "9e/\n"
+            "9e/9e6a55b6b4563e652a23be9d623ca5055c356940\n"
+            "a9/\n"
+            "a9/a9838cd726170dd9d3717880a1814ee0d30884ed\n",
+            .comment = "dedup store");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline full backup with dedup and hardlink on another stanza");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test2");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawBool(argList, cfgOptCompress, false);
+        hrnCfgArgRawBool(argList, cfgOptRepoHardlink, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoDedup, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        HRN_STORAGE_TIME(storagePgDedup, "postgresql.conf", 1482182860);
+
+        // An expire that has finished leaves the expire path empty
+        HRN_STORAGE_PATH_CREATE(storageTest, "repo-dedup/dedup/expire");
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        TEST_RESULT_LOG(
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/base/1/1 (8KB, 33.31%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/base/1/2 (8KB, 66.63%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/global/pg_control (8KB, 99.94%) checksum"
+            " 807d4464138ef085e41844a9f488f067b3d46d46\n"
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/changed (6B, 99.97%) checksum"
+            " a9838cd726170dd9d3717880a1814ee0d30884ed\n"
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/postgresql.conf (6B, 99.99%) checksum"
+            " 2fb60054b43a25d7a958d3d19bdb1aa7809577a8\n"
+            "P01 DETAIL: match dedup file " TEST_PATH "/pg-dedup/PG_VERSION (2B, 100.00%) checksum"
+            " 9e6a55b6b4563e652a23be9d623ca5055c356940\n"
+            "P00   INFO: new backup label = [FULL-3]\n"
+            "P00   INFO: full backup size = 24KB, file total = 6");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline incr backup with dedup and hardlink");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test2");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawBool(argList, cfgOptCompress, false);
+        hrnCfgArgRawBool(argList, cfgOptRepoHardlink, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoDedup, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // Timestamp changes but the content does not
+        HRN_STORAGE_TIME(storagePgDedup, "postgresql.conf", 1482182861);
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: last backup label = [FULL-3], version = " PROJECT_VERSION "\n"
+            "P01 DETAIL: match file from prior backup " TEST_PATH "/pg-dedup/postgresql.conf (6B, 100.00%) checksum"
+            " 2fb60054b43a25d7a958d3d19bdb1aa7809577a8\n"
+            "P00 DETAIL: reference pg_data/PG_VERSION to [FULL-3]\n"
+            "P00 DETAIL: reference pg_data/base/1/1 to [FULL-3]\n"
+            "P00 DETAIL: reference pg_data/base/1/2 to [FULL-3]\n"
+            "P00 DETAIL: reference pg_data/changed to [FULL-3]\n"
+            "P00 DETAIL: hardlink pg_data/global/pg_control to [FULL-3]\n"
+            "P00 DETAIL: reference pg_data/postgresql.conf to [FULL-3]\n"
+            "P00   INFO: new backup label = [INCR-2]\n"
+            "P00   INFO: incr backup size = 0B, file total = 6");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline incr backup with dedup and delta");
+
+        hrnCfgArgRawBool(argList, cfgOptDelta, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // Same size with different content and different size
+        HRN_STORAGE_PUT_Z(storagePgDedup, "changed", "AFTER?", .timeModified = 1482182862);
+        HRN_STORAGE_PUT_Z(storagePgDedup, PG_FILE_PGVERSION, "180", .timeModified = 1482182862);
+
+        // File that grows after the manifest is built
+        HRN_BACKUP_SCRIPT_SET(
+            {.op = hrnBackupScriptOpUpdate, .file = STRDEF(TEST_PATH "/pg-dedup/postgresql.conf"),
+             .content = BUFSTRDEF("CONFIG2")});
+
+        // An expire in another stanza is removing files from the dedup store so the changed files are not stored there
+        HRN_STORAGE_PUT_EMPTY(storageTest, "repo-dedup/dedup/expire/test1");
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: last backup label = [INCR-2], version = " PROJECT_VERSION "\n"
+            "P01 DETAIL: match file from prior backup " TEST_PATH "/pg-dedup/base/1/1 (8KB, 33.31%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: match file from prior backup " TEST_PATH "/pg-dedup/base/1/2 (8KB, 66.63%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: match file from prior backup " TEST_PATH "/pg-dedup/global/pg_control (8KB, 99.94%) checksum"
+            " 807d4464138ef085e41844a9f488f067b3d46d46\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/changed (6B, 99.96%) checksum"
+            " 04c0036b00fcc2f3cb849ea2cf7eb23b4cc37d0e\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/postgresql.conf (6B->7B, 99.99%) checksum"
+            " 8aa613eaf9938d2796937ef885c7df74b025a21f\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/PG_VERSION (3B, 100.00%) checksum"
+            " ec7f1f65067126f3b2bd1037de8a18d0db2ec84b\n"
+            "P00 DETAIL: reference pg_data/base/1/1 to [FULL-3]\n"
+            "P00 DETAIL: reference pg_data/base/1/2 to [FULL-3]\n"
+            "P00 DETAIL: hardlink pg_data/global/pg_control to [FULL-3]\n"
+            "P00   INFO: new backup label = [INCR-3]\n"
+            "P00   INFO: incr backup size = 16B, file total = 6");
+
+        TEST_STORAGE_LIST(
+            storageTest, "repo-dedup/dedup",
+            "06/\n"
+            "06/0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "2f/\n"
+            "2f/2fb60054b43a25d7a958d3d19bdb1aa7809577a8\n"
+            "9e/\n"
+            "9e/9e6a55b6b4563e652a23be9d623ca5055c356940\n"
+            "a9/\n"
+            "a9/a9838cd726170dd9d3717880a1814ee0d30884ed\n"
+            "expire/\n"
+            "expire/test1\n",
+            .comment = "dedup store unchanged");
+
+        HRN_STORAGE_REMOVE(storageTest, "repo-dedup/dedup/expire/test1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("offline full backup with dedup and block incremental");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo-dedup");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg-dedup");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "2");
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        hrnCfgArgRawBool(argList, cfgOptCompress, false);
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+        hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "8KiB");
+        hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoDedup, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        relation = bufNew(pgPageSize8 * 3);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        bufUsedSet(relation, bufSize(relation));
+
+        HRN_STORAGE_PUT(storagePgDedup, PG_PATH_BASE "/1/3", relation);
+
+        TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+        // Bundled and block incremental files are not stored in the dedup store
+        TEST_RESULT_LOG(
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/base/1/3 (24KB, 49.98%) checksum"
+            " ebdd38b69cd5b9f2d00d273c981e16960fbbb4f7\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/PG_VERSION (bundle 1/0, 3B, 49.99%) checksum"
+            " ec7f1f65067126f3b2bd1037de8a18d0db2ec84b\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/changed (bundle 1/3, 6B, 50.00%) checksum"
+            " 04c0036b00fcc2f3cb849ea2cf7eb23b4cc37d0e\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/postgresql.conf (bundle 1/9, 7B, 50.02%) checksum"
+            " 8aa613eaf9938d2796937ef885c7df74b025a21f\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/base/1/1 (bundle 1/16, 8KB, 66.68%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/base/1/2 (bundle 1/8208, 8KB, 83.34%) checksum"
+            " 0631457264ff7f8d5fb1edc2c0211992a67c73e6\n"
+            "P01 DETAIL: backup file " TEST_PATH "/pg-dedup/global/pg_control (bundle 1/16400, 8KB, 100.00%) checksum"
+            " 807d4464138ef085e41844a9f488f067b3d46d46\n"
+            "P00   INFO: new backup label = [FULL-4]\n"
+            "P00   INFO: full backup size = 48KB, file total = 7");
+
         // Cleanup
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
         harnessLogLevelReset();
@@ -3463,6 +3941,7 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "b=" STRINGIFY(BLOCK_MAX_SIZE) "b");
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockFullSynthetic, true);
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // File that uses block incr and will grow
@@ -3490,6 +3969,9 @@ testRun(void)
                 "raised from local-1 shim protocol: unable to open missing file '" TEST_PATH "/pg1/global/pg_control' for read");
 
             TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191030-014640F_20191101-092000D, version = " PROJECT_VERSION "\n"
+                "P00   INFO: prior backup 20191030-014640F_20191101-092000D does not use block incremental, full backup will not"
+                " reference prior backups\n"
                 "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
                 "P00   INFO: backup start archive = 0000000105DBF06000000000, lsn = 5dbf060/0\n"
                 "P00   INFO: check archive for segment 0000000105DBF06000000000\n"
@@ -3503,6 +3985,9 @@ testRun(void)
             TEST_RESULT_VOID(hrnCmdBackup(), "backup");
 
             TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191030-014640F_20191101-092000D, version = " PROJECT_VERSION "\n"
+                "P00   INFO: prior backup 20191030-014640F_20191101-092000D does not use block incremental, full backup will not"
+                " reference prior backups\n"
                 "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
                 "P00   INFO: backup start archive = 0000000105DBF06000000000, lsn = 5dbf060/0\n"
                 "P00   INFO: check archive for segment 0000000105DBF06000000000\n"
@@ -3817,6 +4302,171 @@ testRun(void)
                 "[backup:target]\n"
                 "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
                 "compare file list");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 synthetic full backup with block incr");
+
+        backupTimeStart = BACKUP_EPOCH + 3100000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawZ(argList, cfgOptCompressType, "none");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "23kB");
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockFullSynthetic, true);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Change a single block in a large file
+            Buffer *file = bufNew(BLOCK_MAX_FILE_SIZE);
+            memset(bufPtr(file), 0, bufSize(file));
+            memset(bufPtr(file) + BLOCK_MAX_SIZE * 3, 2, BLOCK_MAX_SIZE);
+            bufUsedSet(file, bufSize(file));
+
+            HRN_STORAGE_PUT(storagePgWrite(), "block-incr-larger", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191103-165320F_20191106-002640D, version = " PROJECT_VERSION "\n"
+                "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC399000000000, lsn = 5dc3990/0\n"
+                "P00   INFO: check archive for segment 0000000105DC399000000000\n"
+                "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/truncate-to-zero\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-larger (1.4MB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/block-incr-grow (128KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/block-incr-same (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/grow-to-block-incr (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/block-incr-shrink-block (8KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/block-incr-shrink (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/PG_VERSION (bundle 1/0, 2B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/normal-same (bundle 1/2, 4B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-shrink-below (bundle 1/6, 8B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/14, 8KB, [PCT]) checksum [SHA1]\n"
+                "P00 DETAIL: reference pg_data/block-incr-grow to 20191103-165320F_20191106-002640D\n"
+                "P00 DETAIL: reference pg_data/block-incr-same to 20191103-165320F\n"
+                "P00 DETAIL: reference pg_data/block-incr-shrink to 20191103-165320F_20191106-002640D\n"
+                "P00 DETAIL: reference pg_data/block-incr-shrink-block to 20191103-165320F_20191106-002640D\n"
+                "P00 DETAIL: reference pg_data/grow-to-block-incr to 20191103-165320F_20191106-002640D\n"
+                "P00   INFO: execute backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC399000000001, lsn = 5dc3990/300000\n"
+                "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC399000000000:0000000105DC399000000001\n"
+                "P00   INFO: new backup label = 20191107-041320F\n"
+                "P00   INFO: full backup size = [SIZE], file total = 12");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191107-041320F}\n"
+                "bundle/1/pg_data/PG_VERSION {s=2, ts=-300000}\n"
+                "bundle/1/pg_data/block-incr-shrink-below {s=8, ts=-100000}\n"
+                "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                "bundle/1/pg_data/normal-same {s=4, ts=-100000}\n"
+                "pg_data/backup_label {s=17, ts=+2}\n"
+                "pg_data/block-incr-larger.pgbi"
+                " {s=1507328, m=1:{0,1,2},2:{0},1:{4,5,6,7,8,9,10,11,12,13,14,15},1:{0,1,2,3,4,5,6}}\n"
+                "20191103-165320F_20191106-002640D/pg_data/block-incr-grow.pgbi"
+                " {s=131072, m=0:{0},1:{0},0:{2},1:{1,2,3,4,5,6,7,8,9,10,11,12,13}, ts=-100000}\n"
+                "20191103-165320F/bundle/1/pg_data/block-incr-same {s=16384, m=0:{0,1}, ts=-100000}\n"
+                "20191103-165320F_20191106-002640D/bundle/1/pg_data/block-incr-shrink {s=16383, m=0:{0},1:{0}, ts=-100000}\n"
+                "20191103-165320F_20191106-002640D/bundle/1/pg_data/block-incr-shrink-block {s=8192, m=0:{0}, ts=-100000}\n"
+                "20191103-165320F_20191106-002640D/bundle/1/pg_data/grow-to-block-incr {s=16385, m=1:{0,1,2}, ts=-100000}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            const InfoBackup *const infoBackup = infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherSpecNewNone());
+            const InfoBackupData *const backupData = infoBackupDataByLabel(infoBackup, STRDEF("20191107-041320F"));
+
+            TEST_RESULT_UINT(backupData->backupType, backupTypeFull, "backup type");
+            TEST_RESULT_STR_Z(backupData->backupPrior, "20191103-165320F_20191106-002640D", "backup prior");
+            TEST_RESULT_STRLST_Z(
+                backupData->backupReference, "20191103-165320F\n20191103-165320F_20191106-002640D\n", "backup reference");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 full backup when synthetic full depth is reached");
+
+        backupTimeStart = BACKUP_EPOCH + 3150000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+            hrnCfgArgRawZ(argList, cfgOptCompressType, "none");
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "23kB");
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MAX_FILE_SIZE) "=" STRINGIFY(BLOCK_MAX_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockFullSynthetic, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockFullSyntheticDepth, "1");
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Run backup
+            hrnBackupPqScriptP(PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .walSwitch = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: synthetic full depth 1 reached, full backup will not reference prior backups\n"
+                "P00   INFO: execute backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DC45D000000000, lsn = 5dc45d0/0\n"
+                "P00   INFO: check archive for segment 0000000105DC45D000000000\n"
+                "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/truncate-to-zero\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-larger (1.4MB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-grow (128KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-same (bundle 1/0, 16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/grow-to-block-incr (bundle 1/16403, 16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/PG_VERSION (bundle 1/32817, 2B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/normal-same (bundle 1/32819, 4B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-shrink-below (bundle 1/32823, 8B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-shrink-block (bundle 1/32831, 8KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-shrink (bundle 1/41023, 16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/57406, 8KB, [PCT]) checksum [SHA1]\n"
+                "P00   INFO: execute backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DC45D000000001, lsn = 5dc45d0/300000\n"
+                "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
+                "P00   INFO: check archive for segment(s) 0000000105DC45D000000000:0000000105DC45D000000001\n"
+                "P00   INFO: new backup label = 20191107-180640F\n"
+                "P00   INFO: full backup size = [SIZE], file total = 12");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")),
+                ".> {d=20191107-180640F}\n"
+                "bundle/1/pg_data/PG_VERSION {s=2, ts=-350000}\n"
+                "bundle/1/pg_data/block-incr-same {s=16384, m=0:{0,1}, ts=-150000}\n"
+                "bundle/1/pg_data/block-incr-shrink {s=16383, ts=-150000}\n"
+                "bundle/1/pg_data/block-incr-shrink-below {s=8, ts=-150000}\n"
+                "bundle/1/pg_data/block-incr-shrink-block {s=8192, ts=-150000}\n"
+                "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                "bundle/1/pg_data/grow-to-block-incr {s=16385, m=0:{0,1,2}, ts=-150000}\n"
+                "bundle/1/pg_data/normal-same {s=4, ts=-150000}\n"
+                "pg_data/backup_label {s=17, ts=+2}\n"
+                "pg_data/block-incr-grow.pgbi {s=131072, m=0:{0,1,2,3,4,5,6,7}, ts=-150000}\n"
+                "pg_data/block-incr-larger.pgbi"
+                " {s=1507328, m=0:{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},0:{0,1,2,3,4,5,6}, ts=-50000}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
 
             HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-grow");
             HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-larger");
@@ -5,9 +5,11 @@ Test Common Command Routines
 #include <unistd.h>
 
 #include "common/stat.h"
+#include "storage/posix/storage.h"
 #include "version.h"
 
 #include "harness/config.h"
+#include "harness/storage.h"
 
 /***********************************************************************************************************************************
 Test Run
@@ -17,6 +19,9 @@ testRun(void)
 {
     FUNCTION_HARNESS_VOID();
 
+    // Create default storage object for testing
+    const Storage *const storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+
     // *****************************************************************************************************************************
     if (testBegin("cmdBegin() and cmdEnd()"))
     {
@@ -127,6 +132,29 @@ testRun(void)
             "P00 DETAIL: statistics: {\"test\":{\"total\":1}}\n"
             "P00   INFO: restore command end: completed successfully");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("command end with stat file");
+
+        harnessLogLevelReset();
+        cfgOptionSet(cfgOptStatFile, cfgSourceParam, VARSTRDEF(TEST_PATH "/stat.json"));
+
+        TEST_RESULT_VOID(cmdEnd(NULL), "command end");
+        TEST_RESULT_LOG("P00   INFO: restore command end: completed successfully");
+        TEST_STORAGE_GET(storageTest, "stat.json", "{\"test\":{\"total\":1}}", .comment = "check stat file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("command end with stat file error");
+
+        cfgOptionSet(cfgOptStatFile, cfgSourceParam, VARSTRDEF(TEST_PATH "/stat.json/stat.json"));
+
+        TEST_RESULT_VOID(cmdEnd(NULL), "command end");
+        TEST_RESULT_LOG(
+            "P00   WARN: unable to write statistics: unable to open file '" TEST_PATH "/stat.json/stat.json' for write:"
+            " [20] Not a directory\n"
+            "P00   INFO: restore command end: completed successfully");
+
+        cfgOptionSet(cfgOptStatFile, cfgSourceDefault, NULL);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("switch to a new command so some options are not valid");
 
@@ -0,0 +1,780 @@
+/***********************************************************************************************************************************
+Test Consolidate Command
+***********************************************************************************************************************************/
+#include "command/backup/blockMap.h"
+#include "command/backup/protocol.h"
+#include "command/lock.h"
+#include "command/restore/blockDelta.h"
+#include "command/stanza/create.h"
+#include "common/compress/helper.h"
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/common.h"
+#include "common/crypto/hash.h"
+#include "postgres/interface.h"
+#include "postgres/version.h"
+#include "storage/helper.h"
+#include "storage/posix/storage.h"
+
+#include "harness/backup.h"
+#include "harness/blockIncr.h"
+#include "harness/config.h"
+#include "harness/postgres.h"
+#include "harness/pq.h"
+#include "harness/protocol.h"
+#include "harness/storage.h"
+
+/***********************************************************************************************************************************
+Run consolidate while holding the lock
+***********************************************************************************************************************************/
+static void
+testCmdConsolidate(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    lockInit(STR(testPath()), cfgOptionStr(cfgOptExecId));
+    cmdLockAcquireP();
+
+    TRY_BEGIN()
+    {
+        cmdConsolidate();
+    }
+    FINALLY()
+    {
+        cmdLockReleaseP();
+    }
+    TRY_END();
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Validate that all files in a backup are stored in the backup and that their contents match the manifest
+***********************************************************************************************************************************/
+static String *
+testConsolidateValidate(const String *const backupLabel, const CipherSpec *const cipherSpecMain)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(STRING, backupLabel);
+        FUNCTION_HARNESS_PARAM(CIPHER_SPEC, cipherSpecMain);
+    FUNCTION_HARNESS_END();
+
+    String *const result = strNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const InfoBackup *const infoBackup = infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherSpecMain);
+        const Manifest *const manifest = manifestLoadFile(
+            storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)),
+            infoBackupCipherSpec(infoBackup));
+        const ManifestData *const data = manifestData(manifest);
+        const CipherSpec *const cipherSpec = manifestCipherSpec(manifest);
+
+        if (data->backupLabelPrior != NULL || strLstSize(manifestReferenceList(manifest)) != 1)
+            THROW_FMT(AssertError, "backup '%s' references prior backups", strZ(backupLabel));
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            const ManifestFile file = manifestFile(manifest, fileIdx);
+
+            if (file.reference != NULL)
+                THROW_FMT(AssertError, "'%s' references '%s'", strZ(file.name), strZ(file.reference));
+
+            // Zero-length files are not stored when bundling
+            if (file.size == 0 && data->bundle)
+            {
+                strCatFmt(result, "%s {s=0}\n", strZ(file.name));
+                continue;
+            }
+
+            const String *const repoFile = backupFileRepoPathP(
+                backupLabel, .manifestName = file.name, .bundleId = file.bundleId, .compressType = data->backupOptionCompressType,
+                .blockIncr = file.blockIncrMapSize != 0, .dedupChecksum = file.dedup ? file.checksumSha1 : NULL);
+
+            // Output location and size
+            if (file.dedup)
+                strCatFmt(result, "dedup/%s {s=%" PRIu64, strZ(file.name), file.size);
+            else
+            {
+                strCatFmt(
+                    result, "%s%s {s=%" PRIu64, file.bundleId != 0 ? strZ(strNewFmt("bundle/%" PRIu64 "/", file.bundleId)) : "",
+                    strZ(file.name), file.size);
+            }
+
+            // Validate repo checksum
+            if (file.checksumRepoSha1 != NULL)
+            {
+                const Buffer *const checksum = cryptoHashOne(
+                    hashTypeSha1,
+                    storageGetP(
+                        storageNewReadP(
+                            storageRepo(), repoFile, .offset = file.bundleOffset, .limit = VARUINT64(file.sizeRepo))));
+
+                if (!bufEq(checksum, BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)))
+                    THROW_FMT(AssertError, "'%s' repo checksum does not match manifest", strZ(file.name));
+            }
+
+            // Calculate checksum and size
+            uint64_t size = 0;
+            const Buffer *checksum = NULL;
+
+            if (file.blockIncrMapSize != 0)
+            {
+                StorageRead *const read = storageNewReadP(
+                    storageRepo(), repoFile, .offset = file.bundleOffset + file.sizeRepo - file.blockIncrMapSize,
+                    .limit = VARUINT64(file.blockIncrMapSize));
+
+                if (cipherSpecType(cipherSpec) != cipherTypeNone)
+                {
+                    ioFilterGroupAdd(
+                        ioReadFilterGroup(storageReadIo(read)), cipherBlockNewP(cipherModeDecrypt, cipherSpec, .raw = true));
+                }
+
+                ioReadOpen(storageReadIo(read));
+
+                const BlockMap *const blockMap = blockMapNewRead(
+                    storageReadIo(read), file.blockIncrSize, file.blockIncrChecksumSize);
+                String *const mapLog = strNew();
+                const BlockMapItem *blockMapItemLast = NULL;
+
+                for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
+                {
+                    const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+
+                    if (blockMapItem->reference != 0 || blockMapItem->bundleId != file.bundleId)
+                        THROW_FMT(AssertError, "'%s' block map references another repo file", strZ(file.name));
+
+                    const bool superBlockChange = blockMapItemLast == NULL || blockMapItemLast->offset != blockMapItem->offset;
+
+                    if (superBlockChange && blockMapIdx != 0)
+                        strCatChr(mapLog, '}');
+
+                    if (!strEmpty(mapLog))
+                        strCatChr(mapLog, ',');
+
+                    if (superBlockChange)
+                        strCatChr(mapLog, '{');
+
+                    strCatFmt(mapLog, "%" PRIu64, blockMapItem->block);
+
+                    blockMapItemLast = blockMapItem;
+                }
+
+                strCatFmt(result, ", m=%s}}", strZ(mapLog));
+
+                // Rebuild the file from the blocks
+                Buffer *const fileBuffer = bufNew((size_t)file.size);
+                bufUsedSet(fileBuffer, bufSize(fileBuffer));
+
+                BlockDelta *const blockDelta = blockDeltaNew(
+                    blockMap, file.blockIncrSize, file.blockIncrChecksumSize, NULL, cipherSpec, data->backupOptionCompressType);
+
+                for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
+                {
+                    const BlockDeltaRead *const blockDeltaRead = blockDeltaReadGet(blockDelta, readIdx);
+                    IoRead *const blockRead = storageReadIo(
+                        storageNewReadP(
+                            storageRepo(), repoFile, .offset = blockDeltaRead->offset, .limit = VARUINT64(blockDeltaRead->size)));
+                    ioReadOpen(blockRead);
+
+                    const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, blockDeltaRead, blockRead);
+
+                    while (deltaWrite != NULL)
+                    {
+                        size += bufUsed(deltaWrite->block);
+                        memcpy(bufPtr(fileBuffer) + deltaWrite->offset, bufPtr(deltaWrite->block), bufUsed(deltaWrite->block));
+
+                        deltaWrite = blockDeltaNext(blockDelta, blockDeltaRead, blockRead);
+                    }
+                }
+
+                checksum = cryptoHashOne(hashTypeSha1, fileBuffer);
+            }
+            else
+            {
+                StorageRead *const read = storageNewReadP(
+                    storageRepo(), repoFile, .offset = file.bundleOffset, .limit = VARUINT64(file.sizeRepo));
+                const bool raw = file.bundleId != 0 && data->bundleRaw;
+
+                if (cipherSpecType(cipherSpec) != cipherTypeNone)
+                {
+                    ioFilterGroupAdd(
+                        ioReadFilterGroup(storageReadIo(read)), cipherBlockNewP(cipherModeDecrypt, cipherSpec, .raw = raw));
+                }
+
+                if (data->backupOptionCompressType != compressTypeNone)
+                {
+                    ioFilterGroupAdd(
+                        ioReadFilterGroup(storageReadIo(read)), decompressFilterP(data->backupOptionCompressType, .raw = raw));
+                }
+
+                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), cryptoHashNew(hashTypeSha1));
+
+                size = bufUsed(storageGetP(read));
+                checksum = pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(storageReadIo(read)), CRYPTO_HASH_FILTER_TYPE));
+
+                strCatChr(result, '}');
+            }
+
+            if (!bufEq(checksum, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)))
+                THROW_FMT(AssertError, "'%s' checksum does not match manifest", strZ(file.name));
+
+            if (size != file.size)
+                THROW_FMT(AssertError, "'%s' size does not match manifest", strZ(file.name));
+
+            strCatChr(result, '\n');
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_HARNESS_RETURN(STRING, result);
+}
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // Shim backupFileComparator to place pg_control at end of bundle
+    hrnBackupFileComparatorShim();
+
+    // Install local command handler shim
+    static const ProtocolServerHandler testLocalHandlerList[] = {
+        PROTOCOL_SERVER_HANDLER_BACKUP_LIST
+        PROTOCOL_SERVER_HANDLER_CONSOLIDATE_LIST
+    };
+    hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
+
+    // *****************************************************************************************************************************
+    if (testBegin("consolidateFile()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on short read");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList, .role = cfgCmdRoleLocal);
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), "src", "ABCDEF");
+
+        List *fileList = lstNewP(sizeof(ConsolidateFile));
+        lstAdd(fileList, &(ConsolidateFile){.manifestFile = STRDEF("file"), .repoFile = STRDEF("src"), .offset = 4, .sizeRepo = 3});
+
+        TEST_ERROR(
+            consolidateFile(STRDEF("dst"), 0, 0, cipherSpecNewNone(), strLstNew(), fileList), FileReadError,
+            "expected 3 byte(s) from '" TEST_PATH "/repo/src' at offset 4 but read 2");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy files into a bundle");
+
+        fileList = lstNewP(sizeof(ConsolidateFile));
+        lstAdd(
+            fileList, &(ConsolidateFile){.manifestFile = STRDEF("file1"), .repoFile = STRDEF("src"), .offset = 4, .sizeRepo = 2});
+        lstAdd(fileList, &(ConsolidateFile){.manifestFile = STRDEF("file2"), .repoFile = STRDEF("src"), .sizeRepo = 3});
+
+        const List *resultList = NULL;
+
+        TEST_ASSIGN(resultList, consolidateFile(STRDEF("dst"), 0, 1, cipherSpecNewNone(), strLstNew(), fileList), "consolidate");
+        TEST_RESULT_UINT(lstSize(resultList), 2, "result size");
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 0))->bundleOffset, 0, "file1 offset");
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 0))->sizeRepo, 2, "file1 size");
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 1))->bundleOffset, 2, "file2 offset");
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 1))->sizeRepo, 3, "file2 size");
+        TEST_RESULT_PTR(((ConsolidateFileResult *)lstGet(resultList, 1))->repoChecksum, NULL, "file2 checksum");
+        TEST_STORAGE_GET(storageRepo(), "dst", "EFABC");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("copy block incremental file into a bundle");
+
+        // Super blocks in the prior backup
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191002-070640F/bundle/1", "AAABBBCCCDDD");
+
+        // Map with a super block split across blocks, contiguous super blocks, a super block stored in the current backup, and a
+        // super block after a gap in the prior backup
+        BlockMap *blockMap = blockMapNew();
+        blockMapAdd(
+            blockMap, &(BlockMapItem){.superBlockSize = 2, .bundleId = 1, .size = 3, .checksum = {0xee, 0xee, 0x01, 0xff, 0xff}});
+        blockMapAdd(
+            blockMap,
+            &(BlockMapItem){.superBlockSize = 2, .bundleId = 1, .size = 3, .block = 1, .checksum = {0xee, 0xee, 0x02, 0xff, 0xff}});
+        blockMapAdd(
+            blockMap,
+            &(BlockMapItem){
+                .superBlockSize = 1, .bundleId = 1, .offset = 3, .size = 3, .checksum = {0xee, 0xee, 0x03, 0xff, 0xff}});
+        blockMapAdd(
+            blockMap,
+            &(BlockMapItem){
+                .reference = 1, .superBlockSize = 1, .bundleId = 1, .size = 2, .checksum = {0xee, 0xee, 0x04, 0xff, 0xff}});
+        blockMapAdd(
+            blockMap,
+            &(BlockMapItem){
+                .superBlockSize = 1, .bundleId = 1, .offset = 9, .size = 3, .checksum = {0xee, 0xee, 0x05, 0xff, 0xff}});
+
+        Buffer *buffer = bufNew(0);
+        IoWrite *write = ioBufferWriteNewOpen(buffer);
+        blockMapWrite(blockMap, write, 1, 5);
+        ioWriteClose(write);
+
+        const size_t mapSize = bufUsed(buffer);
+
+        HRN_STORAGE_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20191002-070640F_20191003-105320D/bundle/1",
+            bufCat(bufDup(BUFSTRDEF("XX")), buffer));
+
+        StringList *const referenceList = strLstNew();
+        strLstAddZ(referenceList, "20191002-070640F");
+        strLstAddZ(referenceList, "20191002-070640F_20191003-105320D");
+
+        fileList = lstNewP(sizeof(ConsolidateFile));
+        lstAdd(
+            fileList,
+            &(ConsolidateFile){
+                .manifestFile = STRDEF("pg_data/file"),
+                .repoFile = STRDEF(STORAGE_REPO_BACKUP "/20191002-070640F_20191003-105320D/bundle/1"),
+                .sizeRepo = 2 + mapSize, .blockIncrMapSize = mapSize, .blockIncrSize = 1, .blockIncrChecksumSize = 5});
+
+        TEST_ASSIGN(resultList, consolidateFile(STRDEF("dst"), 0, 5, cipherSpecNewNone(), referenceList, fileList), "consolidate");
+        TEST_RESULT_UINT(lstSize(resultList), 1, "result size");
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 0))->bundleOffset, 0, "offset");
+        TEST_RESULT_BOOL(((ConsolidateFileResult *)lstGet(resultList, 0))->repoChecksum != NULL, true, "checksum");
+
+        const uint64_t blockIncrMapSize = ((ConsolidateFileResult *)lstGet(resultList, 0))->blockIncrMapSize;
+
+        TEST_RESULT_UINT(((ConsolidateFileResult *)lstGet(resultList, 0))->sizeRepo, 11 + blockIncrMapSize, "size");
+        TEST_RESULT_STR_Z(
+            strNewBuf(storageGetP(storageNewReadP(storageRepo(), STRDEF("dst"), .limit = VARUINT64(11)))), "AAABBBXXDDD",
+            "super blocks");
+        IoRead *const mapRead = storageReadIo(
+            storageNewReadP(storageRepo(), STRDEF("dst"), .offset = 11, .limit = VARUINT64(blockIncrMapSize)));
+        ioReadOpen(mapRead);
+
+        TEST_RESULT_STR_Z(hrnBlockDeltaRender(blockMapNewRead(mapRead, 1, 5), 1, 5),
+            "read {reference: 0, bundleId: 5, offset: 0, size: 11}\n"
+            "  super block {max: 2, size: 3}\n"
+            "    block {no: 0, offset: 0}\n"
+            "    block {no: 1, offset: 1}\n"
+            "  super block {max: 1, size: 3}\n"
+            "    block {no: 0, offset: 2}\n"
+            "  super block {max: 1, size: 2}\n"
+            "    block {no: 0, offset: 3}\n"
+            "  super block {max: 1, size: 3}\n"
+            "    block {no: 0, offset: 4}\n",
+            "block map");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("cmdConsolidate()"))
+    {
+        // The test expects the timezone to be UTC
+        hrnTzSet("UTC");
+        // Replace checksums since they can differ between architectures (e.g. 32/64 bit)
+        hrnLogReplaceAdd("\\) checksum [a-f0-9]{40}", "[a-f0-9]{40}$", "SHA1", false);
+
+        const Storage *const storagePg = storagePosixNewP(STRDEF(TEST_PATH "/pg1"), .write = true);
+
+        StringList *const argListBase = strLstNew();
+        hrnCfgArgRawZ(argListBase, cfgOptStanza, "db");
+        hrnCfgArgRawZ(argListBase, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgKeyRawZ(argListBase, cfgOptRepoPath, 2, TEST_PATH "/repo2");
+        hrnCfgArgKeyRawStrId(argListBase, cfgOptRepoCipherType, 2, cipherTypeAes256Cbc);
+        hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, 2, TEST_CIPHER_PASS);
+
+        // Options common to the backups and stanza-create
+        StringList *const argListPg = strLstDup(argListBase);
+        hrnCfgArgRawZ(argListPg, cfgOptPgPath, TEST_PATH "/pg1");
+
+        StringList *const argListBackup = strLstDup(argListPg);
+        hrnCfgArgKeyRawZ(argListBackup, cfgOptRepoRetentionFull, 1, "9");
+        hrnCfgArgKeyRawZ(argListBackup, cfgOptRepoRetentionFull, 2, "9");
+        hrnCfgArgKeyRawBool(argListBackup, cfgOptRepoBundle, 1, true);
+        hrnCfgArgKeyRawBool(argListBackup, cfgOptRepoBundle, 2, true);
+        hrnCfgArgKeyRawBool(argListBackup, cfgOptRepoBlock, 1, true);
+        hrnCfgArgKeyRawBool(argListBackup, cfgOptRepoBlock, 2, true);
+
+        StringList *argList = strLstDup(argListPg);
+        hrnCfgArgRawBool(argList, cfgOptOnline, false);
+        HRN_CFG_LOAD(cfgCmdStanzaCreate, argList);
+
+        HRN_PG_CONTROL_PUT(storagePg, PG_VERSION_11);
+        HRN_STORAGE_PUT_Z(storagePg, PG_FILE_PGVERSION, PG_VERSION_11_Z, .timeModified = BACKUP_EPOCH - 10);
+
+        TEST_RESULT_VOID(cmdStanzaCreate(), "stanza create");
+        TEST_RESULT_LOG(
+            "P00   INFO: stanza-create for stanza 'db' on repo1\n"
+            "P00   INFO: stanza-create for stanza 'db' on repo2");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error when there are no backups");
+
+        HRN_CFG_LOAD(cfgCmdConsolidate, argListBase);
+        TEST_ERROR(testCmdConsolidate(), BackupSetInvalidError, "no backup set to consolidate found");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("full and diff backup with block incr");
+
+        Buffer *relation = bufNew(256 * 1024);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        bufUsedSet(relation, bufSize(relation));
+        HRN_STORAGE_PUT(storagePg, PG_PATH_BASE "/1/2", relation, .timeModified = BACKUP_EPOCH - 2);
+
+        relation = bufNew(16 * 1024);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        bufUsedSet(relation, bufSize(relation));
+        HRN_STORAGE_PUT(storagePg, PG_PATH_BASE "/1/44", relation, .timeModified = BACKUP_EPOCH - 2);
+
+        HRN_STORAGE_PUT_EMPTY(storagePg, PG_FILE_POSTGRESQLAUTOCONF, .timeModified = BACKUP_EPOCH - 1);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH);
+        TEST_RESULT_VOID(hrnCmdBackup(), "full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191002-070640F");
+
+        // Change blocks at the beginning and end of the large relation so the map references both backups
+        relation = bufNew(256 * 1024);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        memset(bufPtr(relation), 1, 1024);
+        memset(bufPtr(relation) + bufSize(relation) - 1024, 1, 1024);
+        bufUsedSet(relation, bufSize(relation));
+        HRN_STORAGE_PUT(storagePg, PG_PATH_BASE "/1/2", relation, .timeModified = BACKUP_EPOCH);
+
+        // New files that are stored in the same bundle. Random data is used so the file does not compress and makes up most of the
+        // size of the consolidate.
+        Buffer *const random = bufNew(64 * 1024);
+        cryptoRandomBytes(bufPtr(random), bufSize(random));
+        bufUsedSet(random, bufSize(random));
+
+        HRN_STORAGE_PUT(storagePg, PG_PATH_BASE "/1/3", random, .timeModified = BACKUP_EPOCH);
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/4", "BBBB", .timeModified = BACKUP_EPOCH);
+        HRN_STORAGE_PUT_EMPTY(storagePg, PG_PATH_BASE "/1/5", .timeModified = BACKUP_EPOCH);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeDiff);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 100000);
+        TEST_RESULT_VOID(hrnCmdBackup(), "diff backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191002-070640F_20191003-105320D");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on invalid backup set");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptSet, "20191002-070640F_20191002-070641I");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+        TEST_ERROR(testCmdConsolidate(), BackupSetInvalidError, "backup set 20191002-070640F_20191002-070641I is not valid");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("full backup does not reference prior backups");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptSet, "20191002-070640F");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG("P00   INFO: repo1: backup set 20191002-070640F does not reference prior backups");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("consolidate diff into a new full backup");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+
+        // Leftover path from a consolidate that did not complete
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/20191003-105320F/bundle/9");
+
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: consolidate backup set 20191002-070640F_20191003-105320D into full backup 20191003-105320F\n"
+            "P00   INFO: repo1: consolidated backup set 20191003-105320F");
+
+        TEST_RESULT_STR_Z(
+            testConsolidateValidate(STRDEF("20191003-105320F"), cipherSpecNewNone()),
+            "bundle/1/pg_data/PG_VERSION {s=2}\n"
+            "pg_data/backup_label {s=17}\n"
+            "bundle/2/pg_data/base/1/2 {s=262144, m={0},{1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,"
+            "28,29,30},{1}}\n"
+            "bundle/3/pg_data/base/1/3 {s=65536, m={0,1,2,3,4,5,6,7}}\n"
+            "bundle/4/pg_data/base/1/4 {s=4}\n"
+            "bundle/5/pg_data/base/1/44 {s=16384, m={0,1}}\n"
+            "pg_data/base/1/5 {s=0}\n"
+            "bundle/4/pg_data/global/pg_control {s=8192}\n"
+            "pg_data/postgresql.auto.conf {s=0}\n",
+            "validate");
+
+        const InfoBackup *infoBackup = infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherSpecNewNone());
+        const InfoBackupData *backupData = infoBackupDataByLabel(infoBackup, STRDEF("20191003-105320F"));
+
+        TEST_RESULT_UINT(infoBackupDataTotal(infoBackup), 3, "backup total");
+        TEST_RESULT_UINT(backupData->backupType, backupTypeFull, "backup type");
+        TEST_RESULT_PTR(backupData->backupPrior, NULL, "backup prior");
+        TEST_RESULT_PTR(backupData->backupReference, NULL, "backup reference");
+        TEST_RESULT_STR_Z(
+            backupData->backupArchiveStart, "0000000105D95D3000000000", "archive start");
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_REPO_BACKUP "/backup.history/2019/20191003-105320F.manifest.gz");
+        TEST_RESULT_BOOL(
+            storageExistsP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/20191002-070640F_20191003-105320D/" BACKUP_MANIFEST_FILE)),
+            true, "diff is preserved");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error when diff is not the latest backup");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptSet, "20191002-070640F_20191003-105320D");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+        TEST_ERROR(
+            testCmdConsolidate(), BackupSetInvalidError,
+            "backup set 20191002-070640F_20191003-105320D must be the most recent backup to consolidate into a full backup");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("consolidate synthetic full in place");
+
+        relation = bufNew(256 * 1024);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        memset(bufPtr(relation) + 128 * 1024, 2, 1024);
+        bufUsedSet(relation, bufSize(relation));
+        HRN_STORAGE_PUT(storagePg, PG_PATH_BASE "/1/2", relation, .timeModified = BACKUP_EPOCH + 200000);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlockFullSynthetic, 1, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 200000);
+        TEST_RESULT_VOID(hrnCmdBackup(), "synthetic full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191004-144000F");
+
+        HRN_CFG_LOAD(cfgCmdConsolidate, argListBase);
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: consolidate backup set 20191004-144000F\n"
+            "P00   INFO: repo1: consolidated backup set 20191004-144000F");
+
+        TEST_RESULT_STR_Z(
+            testConsolidateValidate(STRDEF("20191004-144000F"), cipherSpecNewNone()),
+            "bundle/1/pg_data/PG_VERSION {s=2}\n"
+            "pg_data/backup_label {s=17}\n"
+            "bundle/2/pg_data/base/1/2 {s=262144, m={0},{1,2,3,4,5,6,7,8,9,10,11,12,13,14,15},{1},{17,18,19,20,21,22,23,24,25,26,"
+            "27,28,29,30},{2}}\n"
+            "bundle/3/pg_data/base/1/3 {s=65536, m={0,1,2,3,4,5,6,7}}\n"
+            "bundle/1/pg_data/base/1/4 {s=4}\n"
+            "bundle/4/pg_data/base/1/44 {s=16384, m={0,1}}\n"
+            "pg_data/base/1/5 {s=0}\n"
+            "bundle/1/pg_data/global/pg_control {s=8192}\n"
+            "pg_data/postgresql.auto.conf {s=0}\n",
+            "validate");
+        TEST_STORAGE_LIST(storageRepo(), STORAGE_REPO_BACKUP "/20191004-144000F/bundle", "1\n2\n3\n4\n");
+
+        infoBackup = infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherSpecNewNone());
+        backupData = infoBackupDataByLabel(infoBackup, STRDEF("20191004-144000F"));
+
+        TEST_RESULT_UINT(infoBackupDataTotal(infoBackup), 4, "backup total");
+        TEST_RESULT_UINT(backupData->backupType, backupTypeFull, "backup type");
+        TEST_RESULT_PTR(backupData->backupPrior, NULL, "backup prior");
+        TEST_RESULT_PTR(backupData->backupReference, NULL, "backup reference");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("consolidate incr on encrypted repo");
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 300000, .cipherSpecMain = TEST_CIPHER_SPEC);
+        TEST_RESULT_VOID(hrnCmdBackup(), "full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191005-182640F");
+
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/45", "NEW", .timeModified = BACKUP_EPOCH + 400000);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 400000, .cipherSpecMain = TEST_CIPHER_SPEC);
+        TEST_RESULT_VOID(hrnCmdBackup(), "incr backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191005-182640F_20191006-221320I");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+
+        // Error when a file in a prior backup is missing
+        HRN_STORAGE_MOVE(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20191005-182640F/bundle/1", STORAGE_REPO_BACKUP "/20191005-182640F/bundle/X");
+
+        TEST_ERROR_FMT(
+            testCmdConsolidate(), FileMissingError,
+            "raised from local-1 shim protocol: unable to open missing file '" TEST_PATH "/repo2/backup/db/20191005-182640F"
+            "/bundle/1' for read");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo2: consolidate backup set 20191005-182640F_20191006-221320I into full backup 20191006-221320F");
+
+        HRN_STORAGE_MOVE(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20191005-182640F/bundle/X", STORAGE_REPO_BACKUP "/20191005-182640F/bundle/1");
+
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo2: consolidate backup set 20191005-182640F_20191006-221320I into full backup 20191006-221320F\n"
+            "P00   INFO: repo2: consolidated backup set 20191006-221320F");
+
+        TEST_RESULT_STR_Z(
+            testConsolidateValidate(STRDEF("20191006-221320F"), TEST_CIPHER_SPEC),
+            "bundle/1/pg_data/PG_VERSION {s=2}\n"
+            "pg_data/backup_label {s=17}\n"
+            "bundle/2/pg_data/base/1/2 {s=262144, m={0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,"
+            "29,30,31}}\n"
+            "bundle/3/pg_data/base/1/3 {s=65536, m={0,1,2,3,4,5,6,7}}\n"
+            "bundle/1/pg_data/base/1/4 {s=4}\n"
+            "bundle/4/pg_data/base/1/44 {s=16384, m={0,1}}\n"
+            "bundle/5/pg_data/base/1/45 {s=3}\n"
+            "pg_data/base/1/5 {s=0}\n"
+            "bundle/5/pg_data/global/pg_control {s=8192}\n"
+            "pg_data/postgresql.auto.conf {s=0}\n",
+            "validate");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("synthetic full without block incremental files has nothing to copy");
+
+        HRN_STORAGE_REMOVE(storagePg, PG_PATH_BASE "/1/2");
+        HRN_STORAGE_REMOVE(storagePg, PG_PATH_BASE "/1/3");
+        HRN_STORAGE_REMOVE(storagePg, PG_PATH_BASE "/1/44");
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlockFullSynthetic, 2, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 500000, .cipherSpecMain = TEST_CIPHER_SPEC);
+        TEST_RESULT_VOID(hrnCmdBackup(), "synthetic full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191008-020000F");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo2: consolidate backup set 20191008-020000F\n"
+            "P00   INFO: repo2: consolidated backup set 20191008-020000F");
+
+        TEST_RESULT_STR_Z(
+            testConsolidateValidate(STRDEF("20191008-020000F"), TEST_CIPHER_SPEC),
+            "bundle/1/pg_data/PG_VERSION {s=2}\n"
+            "pg_data/backup_label {s=17}\n"
+            "bundle/1/pg_data/base/1/4 {s=4}\n"
+            "bundle/1/pg_data/base/1/45 {s=3}\n"
+            "pg_data/base/1/5 {s=0}\n"
+            "bundle/1/pg_data/global/pg_control {s=8192}\n"
+            "pg_data/postgresql.auto.conf {s=0}\n",
+            "validate");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("consolidate incr with files in the dedup store");
+
+        argList = strLstDup(argListPg);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 1, "9");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 600000);
+        TEST_RESULT_VOID(hrnCmdBackup(), "full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191009-054640F");
+
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/46", "NEWER", .timeModified = BACKUP_EPOCH + 700000);
+
+        argList = strLstDup(argListPg);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 1, "9");
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoDedup, 1, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 700000);
+        TEST_RESULT_VOID(hrnCmdBackup(), "incr backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191009-054640F_20191010-093320I");
+
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/47", "NEWEST", .timeModified = BACKUP_EPOCH + 800000);
+
+        argList = strLstDup(argListPg);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 1, "9");
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoDedup, 1, true);
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 800000);
+        TEST_RESULT_VOID(hrnCmdBackup(), "incr backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191009-054640F_20191011-132000I");
+
+        HRN_CFG_LOAD(cfgCmdConsolidate, argListBase);
+
+        TEST_RESULT_VOID(testCmdConsolidate(), "consolidate");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: consolidate backup set 20191009-054640F_20191011-132000I into full backup 20191011-132000F\n"
+            "P00   INFO: repo1: consolidated backup set 20191011-132000F");
+
+        TEST_RESULT_STR_Z(
+            testConsolidateValidate(STRDEF("20191011-132000F"), cipherSpecNewNone()),
+            "pg_data/PG_VERSION {s=2}\n"
+            "pg_data/backup_label {s=17}\n"
+            "pg_data/base/1/4 {s=4}\n"
+            "pg_data/base/1/45 {s=3}\n"
+            "dedup/pg_data/base/1/46 {s=5}\n"
+            "dedup/pg_data/base/1/47 {s=6}\n"
+            "pg_data/base/1/5 {s=0}\n"
+            "pg_data/global/pg_control {s=8192}\n"
+            "pg_data/postgresql.auto.conf {s=0}\n",
+            "validate");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error when backups depend on a synthetic full consolidated in place");
+
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/48", "LATEST", .timeModified = BACKUP_EPOCH + 900000);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeFull);
+        hrnCfgArgKeyRawBool(argList, cfgOptRepoBlockFullSynthetic, 2, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 900000, .cipherSpecMain = TEST_CIPHER_SPEC);
+        TEST_RESULT_VOID(hrnCmdBackup(), "synthetic full backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191012-170640F");
+
+        HRN_STORAGE_PUT_Z(storagePg, PG_PATH_BASE "/1/49", "LAST", .timeModified = BACKUP_EPOCH + 1000000);
+
+        argList = strLstDup(argListBackup);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        hrnBackupPqScriptP(PG_VERSION_11, BACKUP_EPOCH + 1000000, .cipherSpecMain = TEST_CIPHER_SPEC);
+        TEST_RESULT_VOID(hrnCmdBackup(), "incr backup");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("new backup label = 20191012-170640F_20191013-205320I");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawZ(argList, cfgOptSet, "20191012-170640F");
+        HRN_CFG_LOAD(cfgCmdConsolidate, argList);
+
+        TEST_ERROR(
+            testCmdConsolidate(), BackupSetInvalidError,
+            "backup set 20191012-170640F cannot be consolidated in place while other backups depend on it");
+
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
@@ -6,11 +6,13 @@ NOTE: references to 9.4 are intentionally included in this test to ensure that e
 #include <unistd.h>
 
 #include "command/backup/common.h"
+#include "command/expire/protocol.h"
 #include "common/io/bufferRead.h"
 #include "storage/posix/storage.h"
 
 #include "harness/config.h"
 #include "harness/info.h"
+#include "harness/protocol.h"
 #include "harness/storage.h"
 #include "harness/time.h"
 
@@ -65,6 +67,10 @@ testRun(void)
 {
     FUNCTION_HARNESS_VOID();
 
+    // Install local command handler shim
+    static const ProtocolServerHandler testLocalHandlerList[] = {PROTOCOL_SERVER_HANDLER_EXPIRE_LIST};
+    hrnProtocolLocalShimInstall(LSTDEF(testLocalHandlerList));
+
     StringList *argListBase = strLstNew();
     hrnCfgArgRawZ(argListBase, cfgOptStanza, "db");
     hrnCfgArgRawZ(argListBase, cfgOptRepoPath, TEST_PATH "/repo");
@@ -144,6 +150,75 @@ testRun(void)
 
     const Buffer *backupInfoBase = harnessInfoChecksumZ(strZ(backupInfoContent));
 
+    // Backup set where synthetic full backups reference prior backups
+    #define TEST_BACKUP_INFO_SYNTHETIC_OPTION                                                                                      \
+        "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"                 \
+        "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+
+    const Buffer *backupInfoSynthetic = harnessInfoChecksumZ(
+        "[backup:current]\n"
+        "20181119-152000F={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000001\",\"backup-archive-stop\":\"000000010000000000000001\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+        "\"backup-timestamp-start\":1542640000,\"backup-timestamp-stop\":1542640100,\"backup-type\":\"full\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "20181119-152138F={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000002\",\"backup-archive-stop\":\"000000010000000000000002\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+        "\"backup-timestamp-start\":1542640200,\"backup-timestamp-stop\":1542640300,\"backup-type\":\"full\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "20181119-152138F_20181119-152152D={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000003\",\"backup-archive-stop\":\"000000010000000000000003\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":346,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":8428,"
+        "\"backup-prior\":\"20181119-152138F\",\"backup-reference\":[\"20181119-152138F\"],"
+        "\"backup-timestamp-start\":1542640400,\"backup-timestamp-stop\":1542640500,\"backup-type\":\"diff\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "20181119-152800F={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000004\",\"backup-archive-stop\":\"000000010000000000000004\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":346,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":8428,"
+        "\"backup-prior\":\"20181119-152138F_20181119-152152D\","
+        "\"backup-reference\":[\"20181119-152138F\",\"20181119-152138F_20181119-152152D\"],"
+        "\"backup-timestamp-start\":1542640600,\"backup-timestamp-stop\":1542640700,\"backup-type\":\"full\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "20181119-152900F={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000005\",\"backup-archive-stop\":\"000000010000000000000005\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":346,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":8428,"
+        "\"backup-prior\":\"20181119-152800F\","
+        "\"backup-reference\":[\"20181119-152138F\",\"20181119-152138F_20181119-152152D\",\"20181119-152800F\"],"
+        "\"backup-timestamp-start\":1542640800,\"backup-timestamp-stop\":1542640900,\"backup-type\":\"full\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "20181119-152900F_20181119-152600D={"
+        "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+        "\"backup-archive-start\":\"000000010000000000000006\",\"backup-archive-stop\":\"000000010000000000000006\","
+        "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":346,"
+        "\"backup-info-size\":20162900,\"backup-info-size-delta\":8428,"
+        "\"backup-prior\":\"20181119-152900F\","
+        "\"backup-reference\":[\"20181119-152138F\",\"20181119-152138F_20181119-152152D\",\"20181119-152800F\","
+        "\"20181119-152900F\"],"
+        "\"backup-timestamp-start\":1542641000,\"backup-timestamp-stop\":1542641100,\"backup-type\":\"diff\","
+        TEST_BACKUP_INFO_SYNTHETIC_OPTION
+        "\n"
+        "[db]\n"
+        "db-catalog-version=201409291\n"
+        "db-control-version=942\n"
+        "db-id=1\n"
+        "db-system-id=6625592122879095702\n"
+        "db-version=\"9.4\"\n"
+        "\n"
+        "[db:history]\n"
+        "1={\"db-catalog-version\":201409291,\"db-control-version\":942,\"db-system-id\":6625592122879095702"
+        ",\"db-version\":\"9.4\"}");
+
     // Sleep the remainder of the current second. If cmdExpire() gets the same time as timeNow then expiration won't work as
     // expected in the tests.
     hrnSleepRemainder();
@@ -244,6 +319,24 @@ testRun(void)
         TEST_RESULT_STRLST_Z(
             infoBackupDataLabelList(infoBackup, NULL), "20181119-152900F\n20181119-152900F_20181119-152600D\n",
             "remaining backups correct");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("retention-full set - full backups referenced by retained synthetic full not expired");
+
+        TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoSynthetic), cipherSpecNewNone()), "get backup.info");
+
+        TEST_RESULT_UINT(expireFullBackup(infoBackup, 0), 1, "retention-full=1 - only unreferenced full backup expired");
+        TEST_RESULT_STRLST_Z(
+            infoBackupDataLabelList(infoBackup, NULL),
+            "20181119-152138F\n20181119-152138F_20181119-152152D\n20181119-152800F\n20181119-152900F\n"
+            "20181119-152900F_20181119-152600D\n",
+            "remaining backups correct");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: expire full backup 20181119-152000F\n"
+            "P00   INFO: repo1: full backup 20181119-152138F is referenced by synthetic full backup 20181119-152900F and will not"
+            " be expired\n"
+            "P00   INFO: repo1: full backup 20181119-152800F is referenced by synthetic full backup 20181119-152900F and will not"
+            " be expired");
     }
 
     // *****************************************************************************************************************************
@@ -347,6 +440,17 @@ testRun(void)
             infoBackupDataLabelList(infoBackup, NULL), "20181119-152800F\n20181119-152800F_20181119-152155D\n",
             "remaining backups correct");
         TEST_RESULT_LOG("P00   INFO: repo1: expire diff backup 20181119-152800F_20181119-152152D");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("retention-diff set - diff referenced by synthetic full not expired");
+
+        TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoSynthetic), cipherSpecNewNone()), "get backup.info");
+
+        TEST_RESULT_UINT(expireDiffBackup(infoBackup, 0), 0, "retention-diff=1 - diff not expired");
+        TEST_RESULT_UINT(infoBackupDataTotal(infoBackup), 6, "current backups not expired");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: diff backup 20181119-152138F_20181119-152152D is referenced by synthetic full backup"
+            " 20181119-152800F and will not be expired");
     }
 
     // *****************************************************************************************************************************
@@ -2793,6 +2897,22 @@ testRun(void)
             "P00   INFO: repo2: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000003");
 
         harnessLogLevelReset();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stop at full backup referenced by retained synthetic full");
+
+        TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoSynthetic), cipherSpecNewNone()), "get backup.info");
+
+        TEST_RESULT_UINT(expireTimeBasedBackup(infoBackup, 1542640950, 0), 1, "expire unreferenced full backup");
+        TEST_RESULT_STRLST_Z(
+            infoBackupDataLabelList(infoBackup, NULL),
+            "20181119-152138F\n20181119-152138F_20181119-152152D\n20181119-152800F\n20181119-152900F\n"
+            "20181119-152900F_20181119-152600D\n",
+            "remaining backups correct");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: expire time-based backup 20181119-152000F\n"
+            "P00   INFO: repo1: full backup 20181119-152138F is referenced by synthetic full backup 20181119-152900F and will not"
+            " be expired");
     }
 
     // *****************************************************************************************************************************
@@ -3067,5 +3187,279 @@ testRun(void)
         harnessLogLevelReset();
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("removeExpiredDedup()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("no dedup store");
+
+        StringList *argList = strLstDup(argListAvoidWarn);
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "no dedup store");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove unreferenced files (dry-run)");
+
+        #define TEST_BACKUP_INFO_DB                                                                                                \
+            "\n"                                                                                                                   \
+            "[db]\n"                                                                                                               \
+            "db-catalog-version=202506291\n"                                                                                       \
+            "db-control-version=1800\n"                                                                                            \
+            "db-id=1\n"                                                                                                            \
+            "db-system-id=7577015877005525116\n"                                                                                   \
+            "db-version=\"18\"\n"                                                                                                  \
+            "\n"                                                                                                                   \
+            "[db:history]\n"                                                                                                       \
+            "1={\"db-catalog-version\":202506291,\"db-control-version\":1800,\"db-system-id\":7577015877005525116"                 \
+            ",\"db-version\":\"18\"}\n"
+
+        // Stanza with a current backup that references the dedup store
+        HRN_INFO_PUT(
+            storageRepoWrite(), INFO_BACKUP_PATH_FILE,
+            "[backup:current]\n"
+            "20251127-101431F={"
+            "\"backrest-format\":5,\"backrest-version\":\"2.60.0dev\","
+            "\"backup-archive-start\":\"000000010000000000000003\",\"backup-archive-stop\":\"000000010000000000000003\","
+            "\"backup-info-repo-size\":7,\"backup-info-repo-size-delta\":7,"
+            "\"backup-info-size\":7,\"backup-info-size-delta\":7,"
+            "\"backup-timestamp-start\":1764234871,\"backup-timestamp-stop\":1764234872,\"backup-type\":\"full\","
+            "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+            "\"option-checksum-page\":true,\"option-compress\":false,\"option-hardlink\":false,\"option-online\":true}\n"
+            TEST_BACKUP_INFO_DB);
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20251127-101431F/" BACKUP_MANIFEST_FILE,
+            "[backup]\n"
+            "backup-label=\"20251127-101431F\"\n"
+            "backup-timestamp-copy-start=1764234871\n"
+            "backup-timestamp-start=1764234871\n"
+            "backup-timestamp-stop=1764234872\n"
+            "backup-type=\"full\"\n"
+            "\n"
+            "[backup:db]\n"
+            "db-catalog-version=202506291\n"
+            "db-control-version=1800\n"
+            "db-id=1\n"
+            "db-system-id=7577015877005525116\n"
+            "db-version=\"18\"\n"
+            "\n"
+            "[backup:option]\n"
+            "option-archive-check=true\n"
+            "option-archive-copy=false\n"
+            "option-checksum-page=false\n"
+            "option-compress=false\n"
+            "option-compress-type=\"none\"\n"
+            "option-hardlink=false\n"
+            "option-online=true\n"
+            "\n"
+            "[backup:target]\n"
+            "pg_data={\"path\":\"/pg/base\",\"type\":\"path\"}\n"
+            "\n"
+            "[target:file]\n"
+            "pg_data/PG_VERSION={\"checksum\":\"184473f470864e067ee3a22e64b47b0a1c356f29\",\"size\":4,\"timestamp\":1565282114}\n"
+            "pg_data/postgresql.conf={\"checksum\":\"6721d92c9fcdf4248acff1f9a1377127d9064807\",\"dd\":true,\"size\":3"
+            ",\"timestamp\":1565282114}\n"
+            "\n"
+            "[target:file:default]\n"
+            "group=\"group1\"\n"
+            "mode=\"0600\"\n"
+            "user=\"user1\"\n"
+            "\n"
+            "[target:path]\n"
+            "pg_data={}\n"
+            "\n"
+            "[target:path:default]\n"
+            "group=\"group1\"\n"
+            "mode=\"0700\"\n"
+            "user=\"user1\"\n");
+
+        // Stanza with only backup.info.copy and no backups
+        HRN_INFO_PUT(storageRepoWrite(), STORAGE_PATH_BACKUP "/other/" INFO_BACKUP_FILE INFO_COPY_EXT, TEST_BACKUP_INFO_DB);
+
+        // Stanza without backup.info or backups
+        HRN_STORAGE_PATH_CREATE(storageRepoWrite(), STORAGE_PATH_BACKUP "/empty");
+
+        // Referenced file, unreferenced file, and a file left behind by a failed write
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_PATH_DEDUP "/67/6721d92c9fcdf4248acff1f9a1377127d9064807", "REF");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29", "UNREF");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_PATH_DEDUP "/aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.pgbackrest.tmp", "TMP");
+
+        hrnCfgArgRawBool(argList, cfgOptDryRun, true);
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        harnessLogLevelSet(logLevelDetail);
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, true), "unreferenced (dry-run)");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: [DRY-RUN] repo1: dedup file dedup/18/184473f470864e067ee3a22e64b47b0a1c356f29 is unreferenced and will be"
+            " removed by the next expire\n"
+            "P00 DETAIL: [DRY-RUN] repo1: dedup file dedup/aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.pgbackrest.tmp is"
+            " unreferenced and will be removed by the next expire");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_DEDUP,
+            "18/\n"
+            "18/184473f470864e067ee3a22e64b47b0a1c356f29\n"
+            "67/\n"
+            "67/6721d92c9fcdf4248acff1f9a1377127d9064807\n"
+            "aa/\n"
+            "aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.pgbackrest.tmp\n",
+            .comment = "no files removed and no candidates saved");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("unreferenced files are removed by the next expire");
+
+        argList = strLstDup(argListAvoidWarn);
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        // The referenced file was unreferenced in the prior expire but a backup has referenced it since
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_PATH_DEDUP "/expire.candidate", "dedup/67/6721d92c9fcdf4248acff1f9a1377127d9064807");
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "unreferenced");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: repo1: dedup file dedup/18/184473f470864e067ee3a22e64b47b0a1c356f29 is unreferenced and will be removed"
+            " by the next expire\n"
+            "P00 DETAIL: repo1: dedup file dedup/aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.pgbackrest.tmp is unreferenced and"
+            " will be removed by the next expire");
+
+        TEST_STORAGE_GET(
+            storageRepo(), STORAGE_PATH_DEDUP "/expire.candidate",
+            "dedup/18/184473f470864e067ee3a22e64b47b0a1c356f29\n"
+            "dedup/aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.pgbackrest.tmp",
+            .comment = "candidates saved");
+
+        // An expire in another stanza left its expire file behind, which is not in the store
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), BACKUP_DEDUP_EXPIRE_PATH "/other");
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "remove unreferenced");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: repo1: remove unreferenced dedup file dedup/18/184473f470864e067ee3a22e64b47b0a1c356f29\n"
+            "P00 DETAIL: repo1: remove unreferenced dedup file dedup/aa/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+            ".pgbackrest.tmp");
+
+        TEST_STORAGE_LIST(
+            storageRepo(), STORAGE_PATH_DEDUP,
+            "18/\n"
+            "67/\n"
+            "67/6721d92c9fcdf4248acff1f9a1377127d9064807\n"
+            "aa/\n"
+            "expire/\n"
+            "expire/other\n",
+            .comment = "only referenced file and other expire file remain");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("skip when a backup starts while references are read");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29", "UNREF");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_PATH_DEDUP "/expire.candidate", "dedup/18/184473f470864e067ee3a22e64b47b0a1c356f29");
+
+        // Read the references
+        const StringList *const backupList = expireDedupBackupList(storageRepo());
+        StringList *const referenceList = strLstNew();
+
+        TEST_RESULT_STRLST_Z(backupList, "db/20251127-101431F\n", "backup list");
+        TEST_RESULT_STR(expireDedupReference(storageRepo(), 0, backupList, referenceList), NULL, "no backup in progress");
+        TEST_RESULT_STRLST_Z(referenceList, "dedup/67/6721d92c9fcdf4248acff1f9a1377127d9064807\n", "reference list");
+
+        // A backup in another stanza starts and finds the unreferenced file in the store
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20251127-101442F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT);
+
+        TEST_RESULT_VOID(expireDedupSweep(0, false, backupList, referenceList), "skip");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip dedup store expiration since a backup started while references were being read");
+
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29");
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_DEDUP "/expire.candidate");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("skip when a backup is in progress");
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "skip");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip dedup store expiration while backup other/20251127-101442F is in progress or resumable");
+
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29");
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_PATH_BACKUP "/other/20251127-101442F", .recurse = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_PATH_BACKUP "/empty/20251127-101442F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT);
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "skip");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip dedup store expiration while backup empty/20251127-101442F is in progress or resumable");
+
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29");
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_PATH_BACKUP "/empty/20251127-101442F", .recurse = true);
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20251127-101431F_20251127-101442I/" BACKUP_MANIFEST_FILE INFO_COPY_EXT);
+
+        TEST_RESULT_VOID(removeExpiredDedup(0, false), "skip");
+        TEST_RESULT_LOG(
+            "P00   INFO: repo1: skip dedup store expiration while backup db/20251127-101431F_20251127-101442I is in progress or"
+            " resumable");
+
+        TEST_STORAGE_EXISTS(storageRepo(), STORAGE_PATH_DEDUP "/18/184473f470864e067ee3a22e64b47b0a1c356f29");
+
+        harnessLogLevelReset();
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("expireRemove()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove paths and files in local processes");
+
+        StringList *argList = strLstDup(argListAvoidWarn);
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        HRN_CFG_LOAD(cfgCmdExpire, argList);
+
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F/" BACKUP_MANIFEST_FILE);
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152800F/" BACKUP_MANIFEST_FILE);
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/0000000100000000/000000010000000000000001");
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/0000000100000000/000000010000000000000002");
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/0000000100000000/000000010000000000000003");
+
+        ExpireRemove removeList = {.pathList = strLstNew(), .fileList = strLstNew()};
+
+        strLstAddZ(removeList.pathList, STORAGE_REPO_BACKUP "/20181119-152138F");
+        strLstAddZ(removeList.pathList, STORAGE_REPO_BACKUP "/20181119-152800F");
+
+        // Add more files than fit in a single job. Files that do not exist are ignored.
+        for (unsigned int fileIdx = 0; fileIdx <= EXPIRE_FILE_JOB_MAX; fileIdx++)
+        {
+            strLstAddFmt(
+                removeList.fileList, STORAGE_REPO_ARCHIVE "/10-1/0000000100000000/0000000100000000%08X",
+                fileIdx == 0 ? 1 : fileIdx);
+        }
+
+        TEST_RESULT_VOID(expireRemove(&removeList, 0), "remove");
+        TEST_STORAGE_LIST(
+            storageRepo(), NULL,
+            "archive/\n"
+            "archive/db/\n"
+            "archive/db/10-1/\n"
+            "archive/db/10-1/0000000100000000/\n"
+            "backup/\n"
+            "backup/db/\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error in local process");
+
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F");
+
+        removeList = (ExpireRemove){.pathList = strLstNew(), .fileList = strLstNew()};
+        strLstAddZ(removeList.pathList, STORAGE_REPO_BACKUP "/20181119-152138F");
+
+        TEST_ERROR(expireRemove(&removeList, 0), PathOpenError,
+            "raised from local-1 shim protocol: unable to list file info for path '" TEST_PATH "/repo/backup/db/20181119-152138F'"
+            ": [20] Not a directory");
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -53,6 +53,7 @@ testRun(void)
         "    archive-push    push a WAL segment to the archive\n"
         "    backup          backup a database cluster\n"
         "    check           check the configuration\n"
+        "    consolidate     consolidate a backup into a self-contained backup\n"
         "    expire          expire backups that exceed retention\n"
         "    help            get help\n"
         "    info            retrieve information about backups\n"
@@ -252,6 +253,8 @@ testRun(void)
             "  --cmd                               pgBackRest command\n"
             "                                      [default=/path/to/pgbackrest]\n"
             "  --cmd-ssh                           SSH client command [default=ssh]\n"
+            "  --cmd-ssh-multiplex                 share one SSH connection between remote\n"
+            "                                      processes [default=n]\n"
             "  --compress-level-network            network compression level [default=1]\n"
             "  --config                            pgBackRest configuration file\n"
             "                                      [default=/etc/pgbackrest/pgbackrest.conf]\n"
@@ -287,6 +290,7 @@ testRun(void)
             "                                      [default=/var/log/pgbackrest]\n"
             "  --log-subprocess                    enable logging in subprocesses [default=n]\n"
             "  --log-timestamp                     enable timestamp in logging [default=y]\n"
+            "  --stat-file                         file where statistics are written\n"
             "\n",
             "Maintainer Options:\n"
             "\n"
@@ -358,6 +362,7 @@ testRun(void)
             "  --repo-sftp-private-key-file        SFTP private key file\n"
             "  --repo-sftp-private-key-passphrase  SFTP private key passphrase\n"
             "  --repo-sftp-public-key-file         SFTP public key file\n"
+            "  --repo-sftp-window-size             SFTP read-ahead/write-behind window size\n"
             "  --repo-storage-ca-file              repository storage CA file\n"
             "  --repo-storage-ca-path              repository storage CA path\n"
             "  --repo-storage-host                 repository storage host\n"
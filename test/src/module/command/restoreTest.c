@@ -16,6 +16,7 @@ Test Restore Command
 #include "harness/blockIncr.h"
 #include "harness/config.h"
 #include "harness/info.h"
+#include "harness/pack.h"
 #include "harness/manifest.h"
 #include "harness/postgres.h"
 #include "harness/protocol.h"
@@ -315,6 +316,64 @@ testRun(void)
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
             " 'ffffffffffffffffffffffffffffffffffffffff'");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files from multiple bundles");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20190509F/bundle/1", "XXaaaXbb");
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/20190509F/bundle/2", "cccc");
+
+        fileList = lstNewP(sizeof(RestoreFile));
+
+        file = (RestoreFile)
+        {
+            .name = STRDEF("bundle-a"),
+            .checksum = bufNewDecode(encodingHex, STRDEF("7e240de74fb1ed08fa08d38063f6a6a91462a815")),
+            .size = 3,
+            .mode = 0600,
+            .offset = 2,
+            .limit = VARUINT64(3),
+            .manifestFile = STRDEF("pg_data/bundle-a"),
+        };
+
+        lstAdd(fileList, &file);
+
+        file = (RestoreFile)
+        {
+            .name = STRDEF("bundle-b"),
+            .checksum = bufNewDecode(encodingHex, STRDEF("9a900f538965a426994e1e90600920aff0b4e8d2")),
+            .size = 2,
+            .mode = 0600,
+            .offset = 6,
+            .limit = VARUINT64(2),
+            .manifestFile = STRDEF("pg_data/bundle-b"),
+        };
+
+        lstAdd(fileList, &file);
+
+        file = (RestoreFile)
+        {
+            .name = STRDEF("bundle-c"),
+            .checksum = bufNewDecode(encodingHex, STRDEF("4beaad6292b7db0f9354e0d8b915ec0dbbc03a5a")),
+            .size = 4,
+            .mode = 0600,
+            .offset = 0,
+            .limit = VARUINT64(4),
+            .manifestFile = STRDEF("pg_data/bundle-c"),
+            .repoFile = STRDEF(STORAGE_REPO_BACKUP "/20190509F/bundle/2"),
+        };
+
+        lstAdd(fileList, &file);
+
+        TEST_RESULT_VOID(
+            restoreFile(
+                STRDEF(STORAGE_REPO_BACKUP "/20190509F/bundle/1"), repoIdx, compressTypeNone, 0, false, false, false,
+                cipherSpecNew(cipherTypeNone, NULL), NULL, fileList),
+            "restore");
+
+        TEST_STORAGE_GET(storageTest, "pg/bundle-a", "aaa", .remove = true);
+        TEST_STORAGE_GET(storageTest, "pg/bundle-b", "bb", .remove = true);
+        TEST_STORAGE_GET(storageTest, "pg/bundle-c", "cccc", .remove = true);
     }
 
     // *****************************************************************************************************************************
@@ -2160,6 +2219,161 @@ testRun(void)
             "HINT: was the target timeline created by promoting from a timeline < latest?");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("restoreJobCallback()"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("max bundles per job includes the bundles prefetched by the repo storage");
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 1, TEST_PATH "/repo");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoType, 2, "s3");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoS3Bucket, 2, "bucket");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoS3Endpoint, 2, "endpoint");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoS3Region, 2, "region");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoStoragePrefetch, 2, "2");
+        hrnCfgEnvKeyRawZ(cfgOptRepoS3Key, 2, "key");
+        hrnCfgEnvKeyRawZ(cfgOptRepoS3KeySecret, 2, "secret");
+        HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+        TEST_RESULT_UINT(restoreJobBundleMax(0), 1, "posix repo");
+        TEST_RESULT_UINT(restoreJobBundleMax(1), 3, "s3 repo");
+
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoS3Key, 2);
+        hrnCfgEnvKeyRemoveRaw(cfgOptRepoS3KeySecret, 2);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("non-bundled files are jobs by themselves and dedup files are read from the dedup store");
+
+        // Owners are only passed to the job when running as root
+        userLocalData.userRoot = true;
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+        Manifest *manifest = NULL;
+
+        OBJ_NEW_BASE_BEGIN(Manifest, .childQty = MEM_CONTEXT_QTY_MAX)
+        {
+            manifest = manifestNewInternal();
+            manifest->pub.data.backupLabel = strNewZ("20161219-212741F");
+            manifest->pub.referenceList = strLstNew();
+            strLstAddZ(manifest->pub.referenceList, "20161218-101010F");
+            strLstAddZ(manifest->pub.referenceList, "20161219-212741F");
+
+            HRN_MANIFEST_TARGET_ADD(manifest, .name = MANIFEST_TARGET_PGDATA, .path = TEST_PATH "/pg");
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/a", .size = 1, .sizeRepo = 1, .bundleId = 1,
+                .bundleOffset = 0, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/b", .size = 1, .sizeRepo = 1, .bundleId = 1,
+                .bundleOffset = 1, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/c", .size = 1, .sizeRepo = 1, .bundleId = 2,
+                .bundleOffset = 0, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/d", .size = 1, .sizeRepo = 1, .bundleId = 3,
+                .bundleOffset = 0, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/e", .size = 2, .sizeRepo = 2, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/f", .size = 3, .sizeRepo = 3, .dedup = true, .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/g", .size = 1, .sizeRepo = 1, .bundleId = 3, .bundleOffset = 0,
+                .reference = "20161218-101010F", .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/h", .size = 1, .sizeRepo = 1, .bundleId = 1, .bundleOffset = 0,
+                .reference = "20161218-101010F", .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/i", .checksumSha1 = HASH_TYPE_SHA1_ZERO);
+        }
+        OBJ_NEW_END();
+
+        RestoreJobData jobData =
+        {
+            .manifest = manifest,
+            .cipherSpecBackup = cipherSpecNew(cipherTypeNone, NULL),
+            .bundleMax = 2,
+        };
+
+        TEST_RESULT_UINT(restoreProcessQueue(manifest, &jobData.queueList), 11, "process queue");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: restore plan for pg_data/: 2 file(s), bundles 20161218-101010F/1, 20161218-101010F/3,"
+            " 20161219-212741F/1-3");
+
+        ProtocolParallelJob *job = NULL;
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_STR_Z(varStr(protocolParallelJobKey(job)), "pg_data/f", "job key");
+
+        PackWrite *param = protocolParallelJobParam(job);
+        pckWriteEndP(param);
+
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(pckWriteResult(param)),
+            "1:str:" STORAGE_PATH_DEDUP "/da/" HASH_TYPE_SHA1_ZERO ", 8:strid:none,"
+            " 9:array:[1:str:20161218-101010F, 2:str:20161219-212741F],"
+            " 10:str:" TEST_PATH "/pg/f, 11:bin:" HASH_TYPE_SHA1_ZERO ", 12:u64:3, 14:mode:0600, 16:str:" TEST_USER ","
+            " 17:str:" TEST_GROUP ", 20:str:pg_data/f",
+            "job param");
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_STR_Z(varStr(protocolParallelJobKey(job)), "pg_data/e", "job key");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundles are ordered by reference and the next bundle is added to job");
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_UINT(varUInt64(protocolParallelJobKey(job)), 1, "job key");
+
+        param = protocolParallelJobParam(job);
+        pckWriteEndP(param);
+
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(pckWriteResult(param)),
+            "1:str:" STORAGE_REPO_BACKUP "/20161218-101010F/bundle/1, 8:strid:none,"
+            " 9:array:[1:str:20161218-101010F, 2:str:20161219-212741F],"
+            " 10:str:" TEST_PATH "/pg/h, 11:bin:" HASH_TYPE_SHA1_ZERO ", 12:u64:1, 14:mode:0600, 16:str:" TEST_USER ","
+            " 17:str:" TEST_GROUP ", 18:bool:true, 20:u64:1, 22:str:pg_data/h,"
+            " 24:str:" TEST_PATH "/pg/g, 25:bin:" HASH_TYPE_SHA1_ZERO ", 26:u64:1, 28:mode:0600, 30:str:" TEST_USER ","
+            " 31:str:" TEST_GROUP ", 32:bool:true, 34:u64:1, 36:str:pg_data/g,"
+            " 37:str:" STORAGE_REPO_BACKUP "/20161218-101010F/bundle/3",
+            "job param");
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_UINT(varUInt64(protocolParallelJobKey(job)), 1, "job key");
+
+        param = protocolParallelJobParam(job);
+        pckWriteEndP(param);
+
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(pckWriteResult(param)),
+            "1:str:" STORAGE_REPO_BACKUP "/20161219-212741F/bundle/1, 8:strid:none,"
+            " 9:array:[1:str:20161218-101010F, 2:str:20161219-212741F],"
+            " 10:str:" TEST_PATH "/pg/a, 11:bin:" HASH_TYPE_SHA1_ZERO ", 12:u64:1, 14:mode:0600, 16:str:" TEST_USER ","
+            " 17:str:" TEST_GROUP ", 18:bool:true, 20:u64:1, 22:str:pg_data/a,"
+            " 24:str:" TEST_PATH "/pg/b, 25:bin:" HASH_TYPE_SHA1_ZERO ", 26:u64:1, 28:mode:0600, 30:str:" TEST_USER ","
+            " 31:str:" TEST_GROUP ", 32:bool:true, 33:u64:1, 34:u64:1, 36:str:pg_data/b,"
+            " 38:str:" TEST_PATH "/pg/c, 39:bin:" HASH_TYPE_SHA1_ZERO ", 40:u64:1, 42:mode:0600, 44:str:" TEST_USER ","
+            " 45:str:" TEST_GROUP ", 46:bool:true, 48:u64:1, 50:str:pg_data/c,"
+            " 51:str:" STORAGE_REPO_BACKUP "/20161219-212741F/bundle/2",
+            "job param");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("last bundle");
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_UINT(varUInt64(protocolParallelJobKey(job)), 3, "job key");
+
+        TEST_ASSIGN(job, restoreJobCallback(&jobData, 0), "get job");
+        TEST_RESULT_STR_Z(varStr(protocolParallelJobKey(job)), "pg_data/i", "job key");
+
+        TEST_RESULT_PTR(restoreJobCallback(&jobData, 0), NULL, "no more jobs");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("restoreJobResult()"))
     {
@@ -2350,6 +2564,7 @@ testRun(void)
                 "P00 DETAIL: check '" TEST_PATH "/pg' exists\n"
                 "P00 DETAIL: create path '" TEST_PATH "/pg/global'\n"
                 "P00 DETAIL: create path '" TEST_PATH "/pg/pg_tblspc'\n"
+                "P00 DETAIL: restore plan for pg_data/: 1 file(s)\n"
                 "P01 DETAIL: restore file " TEST_PATH "/pg/PG_VERSION (3B, 100.00%%) checksum"
                 " dd71038f3463f511ee7403dbcbc87195302d891c\n"
                 "P00   INFO: write " TEST_PATH "/pg/recovery.conf\n"
@@ -2414,6 +2629,9 @@ testRun(void)
         // Add a bogus file that will be removed
         HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "bogus-file");
 
+        // Add a tablespace_map that will be removed since it is skipped during restore
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), PG_FILE_TABLESPACEMAP);
+
         // Add a special file that will be removed
         HRN_SYSTEM_FMT("mkfifo %s/pipe", strZ(pgPath));
 
@@ -2507,8 +2725,11 @@ testRun(void)
             "P00 DETAIL: remove invalid file '" TEST_PATH "/pg/bogus-file'\n"
             "P00 DETAIL: remove link '" TEST_PATH "/pg/pg_tblspc/1' because destination changed\n"
             "P00 DETAIL: remove special file '" TEST_PATH "/pg/pipe'\n"
+            "P00 DETAIL: remove invalid file '" TEST_PATH "/pg/tablespace_map'\n"
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/pg_tblspc/1' to '" TEST_PATH "/ts/1'\n"
             "P00 DETAIL: create path '" TEST_PATH "/pg/pg_tblspc/1/16384'\n"
+            "P00 DETAIL: restore plan for pg_data/: 4 file(s)\n"
+            "P00 DETAIL: restore plan for pg_tblspc/1/: 1 file(s)\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/postgresql.auto.conf (15B, 46.88%)"
             " checksum 37a0c84d42c3ec3d08c311cec2cef2a7ab55a7c3\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/postgresql.conf (10B, 78.13%) checksum"
@@ -2581,6 +2802,8 @@ testRun(void)
             "P00 DETAIL: skip 'tablespace_map' -- tablespace links will be created based on mappings\n"
             "P00   INFO: remove invalid files/links/paths from '" TEST_PATH "/pg'\n"
             "P00   INFO: remove invalid files/links/paths from '" TEST_PATH "/ts/1/PG_11_201809051'\n"
+            "P00 DETAIL: restore plan for pg_data/: 4 file(s)\n"
+            "P00 DETAIL: restore plan for pg_tblspc/1/: 1 file(s)\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/postgresql.auto.conf (15B, [PCT]) checksum"
             " 37a0c84d42c3ec3d08c311cec2cef2a7ab55a7c3\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/postgresql.conf (10B, [PCT]) checksum"
@@ -2990,6 +3213,8 @@ testRun(void)
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/pg_xact' to '../xact'\n"
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/pg_hba.conf' to '../config/pg_hba.conf'\n"
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/postgresql.conf' to '../config/postgresql.conf'\n"
+            "P00 DETAIL: restore plan for pg_data/: 10 file(s), bundles 20161219-212741F/1, 20161219-212741F_20161219-212800D/2,"
+            " 20161219-212741F_20161219-212900I/2, 20161219-212741F_20161219-212918I/1\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-unused-ref (bi 24KB/48KB, [PCT]) checksum"
             " febd680181d4cd315dce942348862c25fbd731f3\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/32768/32769 (32KB, [PCT]) checksum"
@@ -3011,6 +3236,14 @@ testRun(void)
             " checksum dd71038f3463f511ee7403dbcbc87195302d891c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/10 (bundle 20161219-212741F/1/1, 8KB, [PCT])"
             " checksum 28757c756c03c37aca13692cb719c18d1510c190\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/20 (bundle 20161219-212741F_20161219-212800D/2/1, 1B, [PCT]) checksum"
+            " c032adc1ff629c9b66f22749ad667e6beadf144b\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/21 (bundle 20161219-212741F_20161219-212800D/2/2, 1B, [PCT]) checksum"
+            " e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/30 (bundle 20161219-212741F_20161219-212900I/2/1, 1B, [PCT]) checksum"
+            " c032adc1ff629c9b66f22749ad667e6beadf144b\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/31 (bundle 20161219-212741F_20161219-212900I/2/2, 1B, [PCT]) checksum"
+            " e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/PG_VERSION (bundle 1/0, 3B, [PCT]) checksum"
             " f5b7e6d36dc0113f61b36c700817d42b96f7b037\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/PG_VERSION (bundle 1/4, 3B, [PCT]) checksum"
@@ -3021,14 +3254,6 @@ testRun(void)
             " 9addbf544119efa4a64223b649750a510f0d463f\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zz (bundle 1/17, 2B, [PCT]) checksum"
             " d7dacae2c968388960bf8970080a980ed5c5dcb7\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/20 (bundle 20161219-212741F_20161219-212800D/2/1, 1B, [PCT]) checksum"
-            " c032adc1ff629c9b66f22749ad667e6beadf144b\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/21 (bundle 20161219-212741F_20161219-212800D/2/2, 1B, [PCT]) checksum"
-            " e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/30 (bundle 20161219-212741F_20161219-212900I/2/1, 1B, [PCT]) checksum"
-            " c032adc1ff629c9b66f22749ad667e6beadf144b\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/31 (bundle 20161219-212741F_20161219-212900I/2/2, 1B, [PCT]) checksum"
-            " e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/999 (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/888 (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zero-length (bundle 1/16, 0B, [PCT])\n"
@@ -3185,6 +3410,8 @@ testRun(void)
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/pg_wal' to '../wal'\n"
             "P00 DETAIL: create path '" TEST_PATH "/pg/pg_xact'\n"
             "P00 DETAIL: create symlink '" TEST_PATH "/pg/pg_hba.conf' to '../config/pg_hba.conf'\n"
+            "P00 DETAIL: restore plan for pg_data/: 10 file(s), bundles 20161219-212741F/1, 20161219-212741F_20161219-212800D/2,"
+            " 20161219-212741F_20161219-212900I/2, 20161219-212741F_20161219-212918I/1\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/bi-unused-ref - exists and matches backup (48KB, [PCT]) checksum"
             " febd680181d4cd315dce942348862c25fbd731f3\n"
             "P01 DETAIL: restore zeroed file " TEST_PATH "/pg/base/32768/32769 (32KB, [PCT])\n"
@@ -3205,6 +3432,14 @@ testRun(void)
             " checksum dd71038f3463f511ee7403dbcbc87195302d891c\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/10 - exists and matches backup (bundle 20161219-212741F/1/1, 8KB,"
             " [PCT]) checksum 28757c756c03c37aca13692cb719c18d1510c190\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/20 - exists and matches backup (bundle"
+            " 20161219-212741F_20161219-212800D/2/1, 1B, [PCT]) checksum c032adc1ff629c9b66f22749ad667e6beadf144b\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/21 - exists and matches backup (bundle"
+            " 20161219-212741F_20161219-212800D/2/2, 1B, [PCT]) checksum e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/30 - exists and matches backup (bundle"
+            " 20161219-212741F_20161219-212900I/2/1, 1B, [PCT]) checksum c032adc1ff629c9b66f22749ad667e6beadf144b\n"
+            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/31 - exists and matches backup (bundle"
+            " 20161219-212741F_20161219-212900I/2/2, 1B, [PCT]) checksum e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/PG_VERSION - exists and matches backup (bundle 1/0, 3B, [PCT])"
             " checksum f5b7e6d36dc0113f61b36c700817d42b96f7b037\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/PG_VERSION - exists and matches backup (bundle 1/4, 3B, [PCT])"
@@ -3215,14 +3450,6 @@ testRun(void)
             " 9addbf544119efa4a64223b649750a510f0d463f\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zz - exists and matches backup (bundle 1/17, 2B, [PCT]) checksum"
             " d7dacae2c968388960bf8970080a980ed5c5dcb7\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/20 - exists and matches backup (bundle"
-            " 20161219-212741F_20161219-212800D/2/1, 1B, [PCT]) checksum c032adc1ff629c9b66f22749ad667e6beadf144b\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/21 - exists and matches backup (bundle"
-            " 20161219-212741F_20161219-212800D/2/2, 1B, [PCT]) checksum e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/30 - exists and matches backup (bundle"
-            " 20161219-212741F_20161219-212900I/2/1, 1B, [PCT]) checksum c032adc1ff629c9b66f22749ad667e6beadf144b\n"
-            "P01 DETAIL: restore file " TEST_PATH "/pg/base/1/31 - exists and matches backup (bundle"
-            " 20161219-212741F_20161219-212900I/2/2, 1B, [PCT]) checksum e9d71f5ee7c92d6dc9e92ffdad17b8bd49418f98\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/999 - exists and is zero size (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/888 - exists and is zero size (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zero-length - exists and is zero size (bundle 1/16, 0B, [PCT])\n"
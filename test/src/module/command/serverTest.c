@@ -2,6 +2,9 @@
 Test Server Command
 ***********************************************************************************************************************************/
 #include "command/exit.h"
+#include "common/io/socket/client.h"
+#include "common/io/tls/client.h"
+#include "common/stat.h"
 #include "storage/posix/storage.h"
 #include "storage/remote/storage.h"
 
@@ -11,6 +14,32 @@ Test Server Command
 #include "harness/storage.h"
 #include "harness/systemd.h"
 
+/***********************************************************************************************************************************
+Ping the server with a TLS client that may be reused so the session can be resumed
+***********************************************************************************************************************************/
+static void
+testServerPing(IoClient *const tlsClient)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_CLIENT, tlsClient);
+    FUNCTION_HARNESS_END();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        IoSession *const tlsSession = ioClientOpen(tlsClient);
+        ProtocolClient *const protocolClient = protocolClientNew(
+            STRDEF("test"), PROTOCOL_SERVICE_REMOTE_STR, ioSessionIoReadP(tlsSession), ioSessionIoWrite(tlsSession));
+
+        protocolClientNoExit(protocolClient);
+        protocolClientNoOp(protocolClient);
+        protocolClientFree(protocolClient);
+        ioSessionClose(tlsSession);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -151,8 +180,7 @@ testRun(void)
                         // Add a fake pid to ensure SIGTERM is sent to unterminated children
                         cmdServerInit();
 
-                        int fakePid = INT_MAX;
-                        lstAdd(serverLocal.processList, &fakePid);
+                        lstAdd(serverLocal.processList, &(ServerProcess){.pid = INT_MAX});
 
                         // Get pid of this process to identify child process later
                         pid_t pid = getpid();
@@ -209,6 +237,122 @@ testRun(void)
         HRN_FORK_END();
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("cmdServer() with pool"))
+    {
+        TEST_TITLE("pool with session resumption");
+
+        HRN_FORK_BEGIN(.timeout = 15000)
+        {
+            const unsigned int testPort = hrnServerPortNext();
+
+            HRN_FORK_CHILD_BEGIN(.prefix = "client")
+            {
+                IoClient *const tlsClient = tlsClientNewP(
+                    sckClientNew(STRDEF("127.0.0.1"), testPort, 5000, 5000), STRDEF("127.0.0.1"), 5000, 5000, false,
+                    .resume = true);
+
+                TEST_RESULT_VOID(testServerPing(tlsClient), "ping");
+                TEST_RESULT_VOID(testServerPing(tlsClient), "ping with resumed session");
+                TEST_RESULT_BOOL(strstr(strZ(statToJson()), "\"" TLS_STAT_RESUME "\"") != NULL, true, "session resumed");
+
+                // Ping again after the server has reloaded the configuration
+                HRN_FORK_CHILD_NOTIFY_GET();
+                TEST_RESULT_VOID(testServerPing(tlsClient), "ping after reload");
+
+                // Notify parent on exit
+                HRN_FORK_CHILD_NOTIFY_PUT();
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN(.prefix = "client control")
+            {
+                // Save the client write since it is hidden by the server fork
+                IoWrite *const clientWrite = HRN_FORK_PARENT_WRITE(0);
+
+                HRN_FORK_BEGIN(.timeout = 15000)
+                {
+                    HRN_FORK_CHILD_BEGIN(.prefix = "server")
+                    {
+                        StringList *argList = strLstNew();
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerAddress, "127.0.0.1");
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerCaFile, HRN_SERVER_CA);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerCertFile, HRN_SERVER_CERT);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerKeyFile, HRN_SERVER_KEY);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerAuth, "bogus=*");
+                        hrnCfgArgRawFmt(argList, cfgOptTlsServerPort, "%u", testPort);
+                        hrnCfgArgRawZ(argList, cfgOptTlsServerPool, "2");
+                        hrnCfgArgRawBool(argList, cfgOptTlsServerResume, true);
+                        hrnCfgArgRawZ(argList, cfgOptLogLevelStderr, "off");
+                        HRN_CFG_LOAD(cfgCmdServer, argList);
+
+                        // Init exit signal handlers
+                        exitInit();
+
+                        // No log testing needed
+                        harnessLogLevelSet(logLevelError);
+
+                        // Add a fake pid to ensure SIGTERM is sent to unterminated children that are not in the pool
+                        cmdServerInit();
+
+                        lstAdd(serverLocal.processList, &(ServerProcess){.pid = INT_MAX});
+
+                        // Get pid of this process to identify child process later
+                        pid_t pid = getpid();
+
+                        // Add parameters to arg list required for a reload
+                        strLstInsert(argList, 0, cfgBin());
+                        strLstAddZ(argList, CFGCMD_SERVER);
+
+                        TEST_RESULT_VOID(cmdServer(strLstSize(argList), strLstPtr(argList)), "server");
+
+                        // If this is a child process then exit immediately. Call exitSafe() before notifying the parent so a
+                        // signal sent in response to the notification cannot arrive before the exit in progress flag is set.
+                        if (pid != getpid())
+                        {
+                            const int result = exitSafe(0, false);
+
+                            HRN_FORK_CHILD_NOTIFY_PUT();
+                            exit(result);
+                        }
+
+                        // Check that sd_notify calls were made
+#ifdef HAVE_LIBSYSTEMD
+                        hrnSystemDCheck();
+#endif
+                    }
+                    HRN_FORK_CHILD_END();
+
+                    HRN_FORK_PARENT_BEGIN(.prefix = "server control")
+                    {
+                        // Wait for pool processes to serve pings
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                        // Reload and wait for the pool processes waiting for a connection to exit
+                        kill(HRN_FORK_PROCESS_ID(0), SIGHUP);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                        // Notify the client to ping again and wait for a pool process started after the reload to serve it
+                        HRN_FORK_NOTIFY_PUT(clientWrite);
+                        HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                        // Send term to server processes
+                        kill(HRN_FORK_PROCESS_ID(0), SIGTERM);
+                    }
+                    HRN_FORK_PARENT_END();
+                }
+                HRN_FORK_END();
+
+                // Wait for child process to exit
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("cmdServerPing()"))
     {
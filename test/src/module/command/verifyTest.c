@@ -3,6 +3,7 @@ Test Verify Command
 ***********************************************************************************************************************************/
 #include "command/backup/protocol.h"
 #include "command/stanza/create.h"
+#include "command/verify/ledger.h"
 #include "common/io/bufferRead.h"
 #include "postgres/interface.h"
 #include "postgres/version.h"
@@ -691,6 +692,24 @@ testRun(void)
             "  backup: test-backup-label, status: invalid, total files checked: 1, total valid files: 0\n"
             "    missing: 1", "archive file missing, backup file missing, no text, no verbose");
 
+        VerifyBackupResult backupValidResult =
+        {
+            .backupLabel = strNewZ("test-backup-valid"),
+            .status = backupValid,
+            .totalFileVerify = 1,
+            .totalFileValid = 1,
+            .invalidFileList = lstNewP(sizeof(VerifyInvalidFile), .comparator = lstComparatorStr),
+        };
+        lstAdd(backupResultList, &backupValidResult);
+
+        TEST_RESULT_STR_Z(
+            verifyRender(archiveIdResultList, backupResultList, cfgOptionBool(cfgOptVerbose)),
+            "\n"
+            "  archiveId: 9.6-1, total WAL checked: 1, total valid WAL: 0\n"
+            "    missing: 1\n"
+            "  backup: test-backup-label, status: invalid, total files checked: 1, total valid files: 0\n"
+            "    missing: 1", "valid backup not rendered without verbose");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("verifyAddInvalidWalFile() - file missing (coverage test)");
 
@@ -909,7 +928,7 @@ testRun(void)
         String *filePathName = strNewZ(STORAGE_REPO_ARCHIVE "/testfile");
         HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), strZ(filePathName));
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, HASH_TYPE_SHA1_ZERO_BUF, 0, cipherSpecNewNone()),
+            verifyFile(filePathName, compressTypeNone, HASH_TYPE_SHA1_ZERO_BUF, 0, cipherSpecNewNone()),
             verifyOk, "file ok");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -917,7 +936,7 @@ testRun(void)
 
         HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(filePathName), fileContents);
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, fileChecksum, 0, cipherSpecNewNone()),
+            verifyFile(filePathName, compressTypeNone, fileChecksum, 0, cipherSpecNewNone()),
             verifySizeInvalid, "file size invalid");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -925,7 +944,7 @@ testRun(void)
 
         TEST_RESULT_UINT(
             verifyFile(
-                strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), 0, NULL, compressTypeNone, fileChecksum, 0, cipherSpecNewNone()),
+                strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), compressTypeNone, fileChecksum, 0, cipherSpecNewNone()),
             verifyFileMissing, "file missing");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -940,16 +959,346 @@ testRun(void)
         strCatZ(filePathName, ".gz");
         TEST_RESULT_UINT(
             verifyFile(
-                filePathName, 0, NULL, compressTypeGz, fileChecksum, fileSize,
+                filePathName, compressTypeGz, fileChecksum, fileSize,
                 cipherSpecNew(cipherTypeAes256Cbc, BUFSTRDEF("pass"))),
             verifyOk, "file encrypted compressed ok");
         TEST_RESULT_UINT(
             verifyFile(
-                filePathName, 0, NULL, compressTypeGz, bufNewDecode(encodingHex, STRDEF("aa")), fileSize,
+                filePathName, compressTypeGz, bufNewDecode(encodingHex, STRDEF("aa")), fileSize,
                 cipherSpecNew(cipherTypeAes256Cbc, BUFSTRDEF("pass"))),
             verifyChecksumMismatch, "file encrypted compressed checksum mismatch");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("verifyBundle()"))
+    {
+        // Load Parameters
+        StringList *argList = strLstDup(argListBase);
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        List *fileList = lstNewP(sizeof(VerifyBundleFile));
+
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file1"), .offset = 3, .sizeRepo = fileSize, .checksumRepo = true, .checksum = fileChecksum,
+                .size = fileSize});
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file2"), .offset = 13, .sizeRepo = fileSize, .checksum = bufNewDecode(encodingHex, STRDEF("aa")),
+                .size = fileSize});
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){.name = STRDEF("file3"), .offset = 20, .sizeRepo = fileSize, .checksum = fileChecksum, .size = 1});
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle missing");
+
+        const List *resultList = NULL;
+
+        TEST_ASSIGN(
+            resultList, verifyBundle(STRDEF(STORAGE_REPO_BACKUP "/bundle/1"), compressTypeNone, cipherSpecNewNone(), fileList),
+            "verify bundle");
+        TEST_RESULT_UINT(lstSize(resultList), 3, "result size");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 0))->result, verifyFileMissing, "file1 missing");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 1))->result, verifyFileMissing, "file2 missing");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 2))->result, verifyFileMissing, "file3 missing");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle with gap between files");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/bundle/1",
+            zNewFmt("XXX%sYYY%s%sZZZ", fileContents, fileContents, fileContents));
+
+        TEST_ASSIGN(
+            resultList, verifyBundle(STRDEF(STORAGE_REPO_BACKUP "/bundle/1"), compressTypeNone, cipherSpecNewNone(), fileList),
+            "verify bundle");
+        TEST_RESULT_UINT(lstSize(resultList), 3, "result size");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 0))->result, verifyOk, "file1 ok");
+        TEST_RESULT_UINT(
+            ((const VerifyBundleResult *)lstGet(resultList, 1))->result, verifyChecksumMismatch, "file2 checksum mismatch");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 2))->result, verifySizeInvalid, "file3 size invalid");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle with corrupt compressed files");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/file", fileContents, .compressType = compressTypeGz);
+        const Buffer *const fileCompressed = storageGetP(storageNewReadP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/file.gz")));
+        const uint64_t fileCompressedSize = bufUsed(fileCompressed);
+
+        Buffer *const bundle = bufNew(0);
+        bufCat(bundle, fileCompressed);
+        bufCat(bundle, BUFSTRDEF("CORRUPT"));
+        bufCat(bundle, fileCompressed);
+        bufCat(bundle, BUFSTRDEF("CORRUPT"));
+
+        HRN_STORAGE_PUT(storageRepoWrite(), STORAGE_REPO_BACKUP "/bundle/2", bundle);
+
+        fileList = lstNewP(sizeof(VerifyBundleFile));
+
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file1"), .offset = 0, .sizeRepo = fileCompressedSize, .checksum = fileChecksum,
+                .size = fileSize});
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file2"), .offset = fileCompressedSize, .sizeRepo = 7, .checksum = fileChecksum, .size = fileSize});
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file3"), .offset = fileCompressedSize + 7, .sizeRepo = fileCompressedSize,
+                .checksum = fileChecksum, .size = fileSize});
+        lstAdd(
+            fileList,
+            &(VerifyBundleFile){
+                .name = STRDEF("file4"), .offset = fileCompressedSize * 2 + 7, .sizeRepo = 7, .checksum = fileChecksum,
+                .size = fileSize});
+
+        TEST_ASSIGN(
+            resultList, verifyBundle(STRDEF(STORAGE_REPO_BACKUP "/bundle/2"), compressTypeGz, cipherSpecNewNone(), fileList),
+            "verify bundle");
+        TEST_RESULT_UINT(lstSize(resultList), 4, "result size");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 0))->result, verifyOk, "file1 ok");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 1))->result, verifyOtherError, "file2 error");
+        TEST_RESULT_STR_Z(
+            ((const VerifyBundleResult *)lstGet(resultList, 1))->error, "[29] zlib threw error: [-3] data error", "file2 error");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 2))->result, verifyOk, "file3 ok after error");
+        TEST_RESULT_UINT(((const VerifyBundleResult *)lstGet(resultList, 3))->result, verifyOtherError, "last file error");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("VerifyLedger"))
+    {
+        // Load Parameters
+        StringList *argList = strLstDup(argListBase);
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        #define TEST_LEDGER_WAL                                                                                                    \
+            "11-2/0000000200000000/000000020000000000000001-d1cd8a7d11daa26814b93eb604e1d49ab4b43770"
+
+        const Buffer *const checksumOther = bufNewDecode(encodingHex, STRDEF("da39a3ee5e6b4b0d3255bfef95601890afd80709"));
+        VerifyLedger *ledger = NULL;
+        char logBuf[STACK_TRACE_PARAM_MAX];
+
+        harnessLogLevelSet(logLevelDetail);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("missing ledger");
+
+        #define TEST_LEDGER_REPO_FILE(file)                                                                                        \
+            STRDEF(STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/" file)
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/" TEST_LEDGER_WAL, fileContents, .timeModified = 1565282100);
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/11-2/0000000200000000/bogus", fileContents);
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/file1", fileContents, .timeModified = 1565282100);
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/file2", fileContents, .timeModified = 1565282100);
+        HRN_STORAGE_PATH_CREATE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/base");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 0), "load missing ledger");
+        TEST_RESULT_LOG("P00 DETAIL: verify ledger contains 0 archive and 0 backup file(s)");
+
+        TEST_RESULT_STRLST_Z(
+            verifyLedgerRepoList(ledger, STRDEF(STORAGE_REPO_ARCHIVE "/11-2/0000000200000000"), WAL_SEGMENT_FILE_REGEXP_STR),
+            "000000020000000000000001-d1cd8a7d11daa26814b93eb604e1d49ab4b43770\n", "list WAL path");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeArchive, STRDEF(TEST_LEDGER_WAL), STRDEF(STORAGE_REPO_ARCHIVE "/" TEST_LEDGER_WAL),
+                fileChecksum, fileSize),
+            false, "new archive file not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file1"), TEST_LEDGER_REPO_FILE("file1"),
+                fileChecksum, fileSize),
+            false, "new backup file not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file2"), TEST_LEDGER_REPO_FILE("file2"),
+                fileChecksum, fileSize),
+            false, "new backup file not skipped");
+        TEST_RESULT_VOID(verifyLedgerValid(ledger, verifyLedgerTypeArchive, STRDEF(TEST_LEDGER_WAL)), "archive file valid");
+        TEST_RESULT_VOID(
+            verifyLedgerValid(ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file1")), "backup file valid");
+        TEST_RESULT_VOID(verifyLedgerSave(ledger, true), "save ledger");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 0), "load ledger");
+        TEST_RESULT_LOG("P00 DETAIL: verify ledger contains 1 archive and 1 backup file(s)");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeArchive, STRDEF(TEST_LEDGER_WAL), STRDEF(STORAGE_REPO_ARCHIVE "/" TEST_LEDGER_WAL),
+                fileChecksum, fileSize),
+            true, "valid archive file skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file2"), TEST_LEDGER_REPO_FILE("file2"),
+                fileChecksum, fileSize),
+            false, "backup file not valid so not saved");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file1"), TEST_LEDGER_REPO_FILE("file1"),
+                fileChecksum, fileSize),
+            true, "valid backup file skipped");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("skip files in ledger");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/file3", fileContents, .timeModified = 1565282100);
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/file6", fileContents, .timeModified = 1565282200);
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/file7", fileContents, .timeModified = 1565282100);
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), VERIFY_LEDGER_PATH_FILE,
+            "[backup]\n"
+            "20201119-163000F/pg_data/file1={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282114}\n"
+            "20201119-163000F/pg_data/file2={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282115}\n"
+            "20201119-163000F/pg_data/file3={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282116}\n"
+            "20201119-163000F/pg_data/file4={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282117}\n"
+            "20201119-163000F/pg_data/file6={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282118}\n"
+            "20201119-163000F/pg_data/file7={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":8"
+            ",\"repo-time\":1565282100,\"size\":7,\"time\":1565282119}\n");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 0), "load ledger");
+        TEST_RESULT_LOG("P00 DETAIL: verify ledger contains 0 archive and 6 backup file(s)");
+
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file1"), TEST_LEDGER_REPO_FILE("file1"),
+                fileChecksum, fileSize),
+            true, "backup file skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file2"), TEST_LEDGER_REPO_FILE("file2"),
+                fileChecksum, 8),
+            false, "backup file with different size not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file3"), TEST_LEDGER_REPO_FILE("file3"),
+                checksumOther, fileSize),
+            false, "backup file with different checksum not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file5"), TEST_LEDGER_REPO_FILE("file5"),
+                fileChecksum, fileSize),
+            false, "backup file not in ledger not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file5"), TEST_LEDGER_REPO_FILE("file5"),
+                fileChecksum, fileSize),
+            false, "backup file referenced again not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file6"), TEST_LEDGER_REPO_FILE("file6"),
+                fileChecksum, fileSize),
+            false, "backup file replaced in the repo not skipped");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file7"), TEST_LEDGER_REPO_FILE("file7"),
+                fileChecksum, fileSize),
+            false, "backup file with different repo size not skipped");
+        TEST_RESULT_UINT(verifyLedgerSkipTotal(ledger), 1, "skip total");
+
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(ledger, verifyLedgerToLog, logBuf, sizeof(logBuf)), "verifyLedgerToLog");
+        TEST_RESULT_Z(logBuf, "{archive: 0, backup: 6, skipTotal: 1}", "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("save ledger without pruning");
+
+        TEST_RESULT_VOID(verifyLedgerSave(ledger, false), "save ledger");
+        TEST_STORAGE_GET(
+            storageRepo(), VERIFY_LEDGER_PATH_FILE,
+            strZ(
+                strNewBuf(
+                    harnessInfoChecksumZ(
+                        "[backup]\n"
+                        "20201119-163000F/pg_data/file1={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\""
+                        ",\"repo-size\":7,\"repo-time\":1565282100,\"size\":7,\"time\":1565282114}\n"
+                        "20201119-163000F/pg_data/file4={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\""
+                        ",\"repo-size\":7,\"repo-time\":1565282100,\"size\":7,\"time\":1565282117}\n"))));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("save ledger with pruning");
+
+        TEST_RESULT_VOID(verifyLedgerSave(ledger, true), "save ledger");
+        TEST_STORAGE_GET(
+            storageRepo(), VERIFY_LEDGER_PATH_FILE,
+            strZ(
+                strNewBuf(
+                    harnessInfoChecksumZ(
+                        "[backup]\n"
+                        "20201119-163000F/pg_data/file1={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\""
+                        ",\"repo-size\":7,\"repo-time\":1565282100,\"size\":7,\"time\":1565282114}\n"))));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("save ledger error is a warning");
+
+        HRN_STORAGE_MODE(storageRepoWrite(), STORAGE_REPO_BACKUP, .mode = 0500);
+
+        TEST_RESULT_VOID(verifyLedgerSave(ledger, true), "save ledger");
+        TEST_RESULT_LOG(
+            "P00   WARN: unable to save verify ledger: unable to open file '" TEST_PATH "/repo/backup/db/verify.ledger."
+            "1-test.tmp' for write: [13] Permission denied");
+
+        HRN_STORAGE_MODE(storageRepoWrite(), STORAGE_REPO_BACKUP);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sample all files");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 100), "load ledger");
+        TEST_RESULT_LOG("P00 DETAIL: verify ledger contains 0 archive and 1 backup file(s)");
+        TEST_RESULT_BOOL(
+            verifyLedgerSkip(
+                ledger, verifyLedgerTypeBackup, STRDEF("20201119-163000F/pg_data/file1"), TEST_LEDGER_REPO_FILE("file1"),
+                fileChecksum, fileSize),
+            false, "backup file sampled");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid ledger");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), VERIFY_LEDGER_PATH_FILE,
+            "[archive]\n"
+            TEST_LEDGER_WAL "={\"checksum\":\"d1cd8a7d11daa26814b93eb604e1d49ab4b43770\",\"repo-size\":7,\"repo-time\":1565282100"
+            ",\"size\":7,\"time\":1565282114}\n"
+            "\n"
+            "[bogus]\n"
+            "key=\"value\"\n");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 0), "load ledger");
+        TEST_RESULT_LOG(
+            "P00   WARN: unable to load verify ledger, all files will be verified: invalid section 'bogus'\n"
+            "P00 DETAIL: verify ledger contains 0 archive and 0 backup file(s)");
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), VERIFY_LEDGER_PATH_FILE,
+            "[backup]\n"
+            "20201119-163000F/pg_data/file1={\"checksum\":\"d1cd\",\"size\":7,\"time\":1565282114}\n");
+
+        TEST_ASSIGN(ledger, verifyLedgerNewLoad(cipherSpecNewNone(), 0), "load ledger");
+        TEST_RESULT_LOG(
+            "P00   WARN: unable to load verify ledger, all files will be verified: invalid checksum for"
+            " '20201119-163000F/pg_data/file1'\n"
+            "P00 DETAIL: verify ledger contains 0 archive and 0 backup file(s)");
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_ARCHIVE "/11-2", .recurse = true);
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F", .recurse = true);
+        HRN_STORAGE_REMOVE(storageRepoWrite(), VERIFY_LEDGER_PATH_FILE);
+
+        harnessLogLevelReset();
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("cmdVerify(), verifyProcess() - errors"))
     {
@@ -1650,7 +1999,14 @@ testRun(void)
             TEST_MANIFEST_DB
             "\n"
             "[target:file]\n"
+            "pg_data/bundle2file={\"bni\":2,\"checksum\":\"%s\",\"size\":%u,\"timestamp\":1565282114}\n"
+            "pg_data/dedupfile={\"checksum\":\"%s\",\"dd\":true,\"size\":%u,\"timestamp\":1565282114}\n"
+            "pg_data/dedupmissing={\"checksum\":\"9865d483bc5a94f2e30056fc256ed3066af54d04\",\"dd\":true,\"size\":4"
+            ",\"timestamp\":1565282114}\n"
+            "pg_data/invalidfile={\"bni\":1,\"bno\":10,\"checksum\":\"da39a3ee5e6b4b0d3255bfef95601890afd80709\",\"size\":%u"
+            ",\"timestamp\":1565282114}\n"
             "pg_data/validfile={\"bni\":1,\"bno\":3,\"checksum\":\"%s\",\"size\":%u,\"timestamp\":1565282114}\n"
+            "pg_data/validfile2={\"bni\":2,\"bno\":%u,\"checksum\":\"%s\",\"size\":%u,\"timestamp\":1565282114}\n"
             "pg_data/zerofile={\"size\":0,\"timestamp\":1565282114}\n"
             "pg_data/biind={\"bi\":1,\"bim\":3,\"checksum\":\"9865d483bc5a94f2e30056fc256ed3066af54d04\",\"size\":4"
             ",\"timestamp\":1565282114}\n"
@@ -1659,6 +2015,9 @@ testRun(void)
             TEST_MANIFEST_LINK_DEFAULT
             TEST_MANIFEST_PATH
             TEST_MANIFEST_PATH_DEFAULT,
+            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize,
+            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize, (unsigned int)fileSize,
+            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize, (unsigned int)fileSize,
             strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize);
 
         HRN_INFO_PUT(
@@ -1669,10 +2028,16 @@ testRun(void)
             .comment = "valid manifest copy - full");
 
         HRN_STORAGE_PUT_Z(
-            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/bundle/1", zNewFmt("XXX%s", fileContents),
-            .comment = "valid file");
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/bundle/1", zNewFmt("XXX%s%s", fileContents, fileContents),
+            .comment = "valid and invalid file");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/bundle/2", zNewFmt("%s%s", fileContents, fileContents),
+            .comment = "valid files");
         HRN_STORAGE_PUT_Z(
             storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/pg_data/biind.pgbi", "ZZZZ", .comment = "pgbi file");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_PATH_DEDUP "/d1/d1cd8a7d11daa26814b93eb604e1d49ab4b43770", fileContents,
+            .comment = "dedup file");
 
         // Create WAL file with just header info and small WAL size
         Buffer *walBuffer = bufNew((size_t)(1024 * 1024));
@@ -1704,13 +2069,77 @@ testRun(void)
             "P01   INFO: invalid checksum '20181119-152900F/pg_data/PG_VERSION'\n"
             "P01   INFO: invalid size '20181119-152900F/pg_data/base/1/555_init'\n"
             "P01   INFO: file missing '20181119-152900F/pg_data/base/1/555_init.1'\n"
+            "P01   INFO: file missing 'dedup/98/9865d483bc5a94f2e30056fc256ed3066af54d04'\n"
+            "P01   INFO: invalid checksum '20201119-163000F/pg_data/invalidfile'\n"
             "P00   INFO: stanza: db\n"
             "            status: error\n"
             "              backup: 20181119-152900F, status: invalid, total files checked: 3, total valid files: 0\n"
             "                missing: 1, checksum invalid: 1, size invalid: 1\n"
             "              backup: 20181119-152900F_20181119-152909D, status: invalid, total files checked: 1,"
             " total valid files: 0\n"
-            "                checksum invalid: 1");
+            "                checksum invalid: 1\n"
+            "              backup: 20201119-163000F, status: invalid, total files checked: 8, total valid files: 6\n"
+            "                missing: 1, checksum invalid: 1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("corrupt compressed file in bundle");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), STORAGE_REPO_BACKUP "/file", fileContents, .compressType = compressTypeGz);
+        const Buffer *const fileCompressed = storageGetP(storageNewReadP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/file.gz")));
+
+        Buffer *const bundle = bufDup(BUFSTRDEF("CORRUPT"));
+        bufCat(bundle, fileCompressed);
+
+        HRN_STORAGE_PUT(storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/bundle/1", bundle);
+
+        manifestContent = strNewFmt(
+            TEST_MANIFEST_HEADER
+            "backup-bundle=true\n"
+            "\n"
+            "[backup:db]\n"
+            TEST_BACKUP_DB2_11
+            "\n"
+            "[backup:option]\n"
+            "option-archive-check=false\n"
+            "option-archive-copy=false\n"
+            "option-checksum-page=false\n"
+            "option-compress=true\n"
+            "option-compress-type=\"gz\"\n"
+            "option-hardlink=false\n"
+            "option-online=false\n"
+            TEST_MANIFEST_TARGET
+            TEST_MANIFEST_DB
+            "\n"
+            "[target:file]\n"
+            "pg_data/corruptfile={\"bni\":1,\"checksum\":\"%s\",\"size\":%u,\"timestamp\":1565282114}\n"
+            "pg_data/validfile={\"bni\":1,\"bno\":7,\"checksum\":\"%s\",\"repo-size\":%zu,\"size\":%u,\"timestamp\":1565282114}\n"
+            TEST_MANIFEST_FILE_DEFAULT
+            TEST_MANIFEST_LINK
+            TEST_MANIFEST_LINK_DEFAULT
+            TEST_MANIFEST_PATH
+            TEST_MANIFEST_PATH_DEFAULT,
+            strZ(strNewEncode(encodingHex, fileChecksum)), (unsigned int)fileSize,
+            strZ(strNewEncode(encodingHex, fileChecksum)), bufUsed(fileCompressed), (unsigned int)fileSize);
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20201119-163000F/" BACKUP_MANIFEST_FILE, strZ(manifestContent),
+            .comment = "manifest with compressed bundle");
+
+        argList = strLstDup(argListBase);
+        hrnCfgArgRawZ(argList, cfgOptSet, "20201119-163000F");
+        hrnCfgArgRawBool(argList, cfgOptVerifyIncremental, true);
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        // The error only invalidates the corrupt file and the file after it in the bundle is still verified
+        TEST_RESULT_STR_Z(
+            verifyProcess(false),
+            "stanza: db\n"
+            "status: error\n"
+            "  backup: 20201119-163000F, status: invalid, total files checked: 2, total valid files: 1\n"
+            "    other: 1",
+            "verify");
+        TEST_RESULT_LOG(
+            "P01   INFO: invalid result 20201119-163000F/pg_data/corruptfile: [29] zlib threw error: [-3] data error");
     }
 
     // *****************************************************************************************************************************
@@ -2581,6 +3010,43 @@ testRun(void)
         TEST_RESULT_LOG(
             "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D9758F000000FF, wal stop: 0000000105D9759000000000");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("verify encrypted repo2 incrementally");
+
+        argList = strLstDup(argListMulti);
+        hrnCfgArgRawZ(argList, cfgOptRepo, "2");
+        hrnCfgArgRawZ(argList, cfgOptOutput, "text");
+        hrnCfgArgRawZ(argList, cfgOptVerbose, "y");
+        hrnCfgArgRawBool(argList, cfgOptVerifyIncremental, true);
+        hrnCfgArgRawZ(argList, cfgOptVerifySample, "0");
+        HRN_CFG_LOAD(cfgCmdVerify, argList);
+
+        TEST_RESULT_STR_Z(
+            verifyProcess(cfgOptionBool(cfgOptVerbose)),
+            "stanza: db\n"
+            "status: ok\n"
+            "  archiveId: 11-1, total WAL checked: 2, total valid WAL: 2\n"
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0\n"
+            "  backup: 20191004-144000F, status: valid, total files checked: 6, total valid files: 6\n"
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0", "all files verified");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: verify ledger contains 0 archive and 0 backup file(s)\n"
+            "P00 DETAIL: skipped 0 file(s) found in the verify ledger\n"
+            "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D9758F000000FF, wal stop: 0000000105D9759000000000");
+
+        TEST_RESULT_STR_Z(
+            verifyProcess(cfgOptionBool(cfgOptVerbose)),
+            "stanza: db\n"
+            "status: ok\n"
+            "  archiveId: 11-1, total WAL checked: 2, total valid WAL: 2\n"
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0\n"
+            "  backup: 20191004-144000F, status: valid, total files checked: 6, total valid files: 6\n"
+            "    missing: 0, checksum invalid: 0, size invalid: 0, other: 0", "all files skipped");
+        TEST_RESULT_LOG(
+            "P00 DETAIL: verify ledger contains 2 archive and 5 backup file(s)\n"
+            "P00 DETAIL: skipped 7 file(s) found in the verify ledger\n"
+            "P00 DETAIL: archiveId: 11-1, wal start: 0000000105D9758F000000FF, wal stop: 0000000105D9759000000000");
+
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
     }
 
@@ -349,14 +349,16 @@ testRun(void)
 
         char buffer[STACK_TRACE_PARAM_MAX];
 
-        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNew(14, false));
+        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNewP(14, false));
 
         compress->inputSame = true;
         compress->inputOffset = 49;
         compress->flushing = true;
 
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(compress, zstCompressToLog, buffer, sizeof(buffer)), "zstCompressToLog");
-        TEST_RESULT_Z(buffer, "{level: 14, inputSame: true, inputOffset: 49, flushing: true}", "check log");
+        TEST_RESULT_Z(
+            buffer, "{level: 14, thread: 0, windowLog: 0, longDistance: false, inputSame: true, inputOffset: 49, flushing: true}",
+            "check log");
 
         ZstDecompress *decompress = (ZstDecompress *)ioFilterDriver(zstDecompressNew(false));
 
@@ -366,6 +368,71 @@ testRun(void)
 
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(decompress, zstDecompressToLog, buffer, sizeof(buffer)), "zstDecompressToLog");
         TEST_RESULT_Z(buffer, "{inputSame: true, inputOffset: 999, frameDone false, done: true}", "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("advanced parameters selected by size");
+
+        IoFilter *filter = NULL;
+
+        TEST_ASSIGN(filter, compressFilterP(compressTypeZst, 3, .size = 64 * 1024 * 1024 - 1, .threadMax = 4), "small file");
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(ioFilterDriver(filter), zstCompressToLog, buffer, sizeof(buffer)), "log");
+        TEST_RESULT_Z(
+            buffer, "{level: 3, thread: 0, windowLog: 0, longDistance: false, inputSame: false, inputOffset: 0, flushing: false}",
+            "check log");
+
+        TEST_ASSIGN(filter, compressFilterP(compressTypeZst, 3, .size = 64 * 1024 * 1024, .threadMax = 4), "large file");
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(ioFilterDriver(filter), zstCompressToLog, buffer, sizeof(buffer)), "log");
+        TEST_RESULT_Z(
+            buffer, "{level: 3, thread: 0, windowLog: 24, longDistance: true, inputSame: false, inputOffset: 0, flushing: false}",
+            "check log");
+
+        TEST_ASSIGN(filter, compressFilterP(compressTypeZst, 3, .size = 1024 * 1024 * 1024, .threadMax = 4), "very large file");
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(ioFilterDriver(filter), zstCompressToLog, buffer, sizeof(buffer)), "log");
+        TEST_RESULT_Z(
+            buffer, "{level: 3, thread: 4, windowLog: 25, longDistance: true, inputSame: false, inputOffset: 0, flushing: false}",
+            "check log");
+
+        // Advanced parameters are not used when threads are disabled so the default output is unchanged
+        IoFilter *const filterNoThread = compressFilterP(compressTypeZst, 3, .size = 1024 * 1024 * 1024);
+
+        TEST_RESULT_VOID(
+            FUNCTION_LOG_OBJECT_FORMAT(ioFilterDriver(filterNoThread), zstCompressToLog, buffer, sizeof(buffer)),
+            "very large file without threads");
+        TEST_RESULT_Z(
+            buffer, "{level: 3, thread: 0, windowLog: 0, longDistance: false, inputSame: false, inputOffset: 0, flushing: false}",
+            "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("advanced parameters are passed by compressFilterPack()");
+
+        TEST_ASSIGN(
+            filter, compressFilterPack(ZST_COMPRESS_FILTER_TYPE, ioFilterParamList(filter)), "filter from param list");
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(ioFilterDriver(filter), zstCompressToLog, buffer, sizeof(buffer)), "log");
+        TEST_RESULT_Z(
+            buffer, "{level: 3, thread: 4, windowLog: 25, longDistance: true, inputSame: false, inputOffset: 0, flushing: false}",
+            "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with worker threads");
+
+        // Use a small window so the data is split into several jobs
+        Buffer *decompressed = bufNew(8 * 1024 * 1024);
+
+        for (size_t chrIdx = 0; chrIdx < bufSize(decompressed); chrIdx++)
+            bufPtr(decompressed)[chrIdx] = (uint8_t)(((chrIdx / 7 * 2654435761U) >> 24) % 94 + 32);
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed,
+            testCompress(
+                zstCompressNewP(1, false, .thread = 2, .windowLog = 17, .longDistance = true), decompressed, 1024 * 1024, 1024),
+            "compress");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(decompressFilterP(compressTypeZst), compressed, 1024 * 1024, 1024 * 1024)), true,
+            "decompress");
 #else
         TEST_ERROR(compressTypePresent(compressTypeZst), OptionInvalidValueError, "pgBackRest not built with zst support");
 #endif // HAVE_LIBZST
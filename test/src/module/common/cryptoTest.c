@@ -448,6 +448,12 @@ testRun(void)
         TEST_RESULT_STR_Z(strNewEncode(encodingHex, xxHashOne(5, BUFSTRDEF(""))), "99aa06d301", "check empty hash 5");
         TEST_RESULT_STR_Z(strNewEncode(encodingHex, xxHashOne(5, BUFSTRDEF("12345\n"))), "1a3e11127b", "check small hash 5");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("xxHash64");
+
+        TEST_RESULT_UINT(xxHash64(NULL, 0), 0x2d06800538d394c2, "check empty hash");
+        TEST_RESULT_UINT(xxHash64("12345\n", 6), 0xbcaed5cf0445e790, "check small hash");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("XxHash");
 
@@ -108,6 +108,24 @@ testRun(void)
 
         sleepMSec(500);
         TEST_RESULT_VOID(execFree(exec), "sleep exited as expected");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("terminate exec");
+
+        TEST_ASSIGN(exec, execNew(STRDEF("sleep"), option, STRDEF("sleep"), 1000), "new sleep exec");
+        TEST_RESULT_VOID(execOpen(exec), "open sleep exec");
+
+        const pid_t processId = exec->processId;
+
+        exec->processId = INT_MAX;
+        TEST_ERROR(execTerminate(exec), ExecuteError, "unable to terminate sleep: [3] No such process");
+
+        exec->processId = 0;
+        TEST_RESULT_VOID(execTerminate(exec), "skip exited exec");
+
+        exec->processId = processId;
+        TEST_RESULT_VOID(execTerminate(exec), "terminate sleep exec");
+        TEST_RESULT_VOID(execFree(exec), "free exec");
     }
 
     // *****************************************************************************************************************************
@@ -361,6 +361,9 @@ testRun(void)
             "1:strid:size, 3:strid:double, 4:pack:<1:strid:double, 2:u32:2, 3:u32:3>, 5:strid:size, 7:strid:buffer",
             "    check filter params");
 
+        // Time filters so stats are added when the group is closed
+        statTimeEnabledSet(true);
+
         TEST_RESULT_BOOL(ioReadOpen(bufferRead), true, "    open");
         TEST_RESULT_INT(ioReadFd(bufferRead), -1, "    fd invalid");
         TEST_RESULT_BOOL(ioReadEof(bufferRead), false, "    not eof");
@@ -385,6 +388,12 @@ testRun(void)
         TEST_RESULT_UINT(ioBufferRead(ioReadDriver(bufferRead), buffer, true), 0, "    eof from driver");
         TEST_RESULT_UINT(ioRead(bufferRead, buffer), 0, "    read 0 bytes");
         TEST_RESULT_VOID(ioReadClose(bufferRead), " close buffer read object");
+        TEST_RESULT_BOOL(
+            strstr(strZ(statToJson()), "\"" IO_FILTER_STAT_PREFIX "double\":{\"histogram\"") != NULL, true,
+            "    check filter stat");
+
+        statTimeEnabledSet(false);
+
         TEST_RESULT_STR_Z(
             hrnPackToStr(ioFilterGroupResultAll(ioReadFilterGroup(bufferRead))),
             "1:strid:size, 2:pack:<1:u64:3>, 3:strid:double, 5:strid:size, 6:pack:<1:u64:9>, 7:strid:buffer",
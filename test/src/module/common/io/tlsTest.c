@@ -543,6 +543,13 @@ testRun(void)
                     buffer, zNewFmt("{type: socket, driver: {address: 127.0.0.1, port: %u, timeout: 5000}}", testPort),
                     "check log");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("sckServerAccept() returns NULL when non-blocking and no connection is waiting");
+
+                TEST_RESULT_INT(fcntl(ioServerFd(server), F_SETFL, O_NONBLOCK), 0, "set non-blocking");
+                TEST_RESULT_PTR(ioServerAccept(server, NULL), NULL, "no connection");
+                TEST_RESULT_INT(fcntl(ioServerFd(server), F_SETFL, 0), 0, "set blocking");
+
                 HRN_FORK_CHILD_NOTIFY_PUT();
                 TEST_RESULT_PTR(ioServerAccept(server, NULL), NULL, "connection interrupted");
             }
@@ -1040,7 +1047,7 @@ testRun(void)
             {
                 // TLS server to accept connections
                 IoServer *socketServer = sckServerNew(STRDEF("127.0.0.1"), testPort, 5000);
-                IoServer *tlsServer = tlsServerNew(
+                IoServer *tlsServer = tlsServerNewP(
                     STRDEF("127.0.0.1"), STRDEF(HRN_SERVER_CA), STRDEF(TEST_PATH "/server-root-perm-link"),
                     STRDEF(TEST_PATH "/server-cn-only.crt"), 5000);
                 IoSession *socketSession = NULL;
@@ -1048,6 +1055,7 @@ testRun(void)
                 TEST_RESULT_STR(
                     ioServerName(socketServer), strNewFmt("127.0.0.1:%u", testPort), "socket server name");
                 TEST_RESULT_STR_Z(ioServerName(tlsServer), "127.0.0.1", "tls server name");
+                TEST_RESULT_INT(ioServerFd(tlsServer), -1, "no fd for tls server");
 
                 // Invalid client cert
                 socketSession = ioServerAccept(socketServer, NULL);
@@ -1365,6 +1373,89 @@ testRun(void)
         }
         HRN_FORK_END();
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("session resumption");
+
+        HRN_FORK_BEGIN()
+        {
+            const unsigned int testPort = hrnServerPortNext();
+
+            HRN_FORK_CHILD_BEGIN(.prefix = "test server", .timeout = 5000)
+            {
+                TEST_RESULT_VOID(
+                    hrnServerRunP(HRN_FORK_CHILD_READ(), hrnServerProtocolTls, testPort, .resume = true), "tls server");
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN(.prefix = "test client", .timeout = 1000)
+            {
+                IoWrite *tls = hrnServerScriptBegin(HRN_FORK_PARENT_WRITE(0));
+
+                TEST_ASSIGN(
+                    client,
+                    tlsClientNewP(
+                        sckClientNew(hrnServerHost(), testPort, 5000, 5000), hrnServerHost(), 5000, 5000, TEST_IN_CONTAINER,
+                        .resume = true),
+                    "new client");
+
+                // The session is stored when it is received from the server, which may be after the handshake
+                hrnServerScriptAccept(tls);
+                hrnServerScriptExpectZ(tls, "ping");
+                hrnServerScriptReplyZ(tls, "pong\n");
+                hrnServerScriptClose(tls);
+
+                TEST_ASSIGN(session, ioClientOpen(client), "open client");
+                TEST_RESULT_BOOL(SSL_session_reused(((TlsSession *)session->pub.driver)->session), false, "session not reused");
+                TEST_RESULT_VOID(ioWrite(ioSessionIoWrite(session), BUFSTRDEF("ping")), "write");
+                TEST_RESULT_VOID(ioWriteFlush(ioSessionIoWrite(session)), "flush");
+                TEST_RESULT_STR_Z(ioReadLine(ioSessionIoReadP(session)), "pong", "read");
+                TEST_RESULT_BOOL(((TlsClient *)client->pub.driver)->session != NULL, true, "session stored");
+
+                // A session that is freed without a shutdown cannot be resumed
+                TEST_RESULT_VOID(ioSessionClose(session), "close session");
+
+                // Second session resumes the first
+                hrnServerScriptAccept(tls);
+                hrnServerScriptExpectZ(tls, "ping");
+                hrnServerScriptReplyZ(tls, "pong\n");
+                hrnServerScriptClose(tls);
+
+                TEST_ASSIGN(session, ioClientOpen(client), "open client");
+                TEST_RESULT_BOOL(SSL_session_reused(((TlsSession *)session->pub.driver)->session), true, "session reused");
+                TEST_RESULT_VOID(ioWrite(ioSessionIoWrite(session), BUFSTRDEF("ping")), "write");
+                TEST_RESULT_VOID(ioWriteFlush(ioSessionIoWrite(session)), "flush");
+                TEST_RESULT_STR_Z(ioReadLine(ioSessionIoReadP(session)), "pong", "read");
+                TEST_RESULT_VOID(ioSessionClose(session), "close session");
+
+                TEST_RESULT_VOID(ioClientFree(client), "free client");
+
+                // Session is not stored when resume is not enabled
+                TEST_ASSIGN(
+                    client,
+                    tlsClientNewP(
+                        sckClientNew(hrnServerHost(), testPort, 5000, 5000), hrnServerHost(), 5000, 5000, TEST_IN_CONTAINER),
+                    "new client");
+
+                hrnServerScriptAccept(tls);
+                hrnServerScriptExpectZ(tls, "ping");
+                hrnServerScriptReplyZ(tls, "pong\n");
+                hrnServerScriptClose(tls);
+
+                TEST_ASSIGN(session, ioClientOpen(client), "open client");
+                TEST_RESULT_VOID(ioWrite(ioSessionIoWrite(session), BUFSTRDEF("ping")), "write");
+                TEST_RESULT_VOID(ioWriteFlush(ioSessionIoWrite(session)), "flush");
+                TEST_RESULT_STR_Z(ioReadLine(ioSessionIoReadP(session)), "pong", "read");
+                TEST_RESULT_VOID(ioSessionClose(session), "close session");
+                TEST_RESULT_PTR(((TlsClient *)client->pub.driver)->session, NULL, "session not stored");
+
+                TEST_RESULT_VOID(ioClientFree(client), "free client");
+
+                hrnServerScriptEnd(tls);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("stastistics exist");
 
@@ -627,6 +627,163 @@ testRun(void)
         TEST_RESULT_PTR(memContextChildOne(memContextParent2)->context, memContextChild, "check parent2");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("memContextNew() with arena"))
+    {
+        TEST_TITLE("arena owner");
+
+        MemContext *owner;
+        TEST_ASSIGN(
+            owner, memContextNewP("arena", .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX, .arena = true), "new");
+        memContextKeep();
+
+        TEST_RESULT_UINT(owner->arena, memArenaOwner, "arena owner");
+        TEST_RESULT_PTR(memContextArena(owner)->chunk, NULL, "no chunk yet");
+        TEST_RESULT_UINT(memContextArena(owner)->chunkSize, MEM_ARENA_CHUNK_SIZE_MIN, "min chunk size");
+
+        const size_t sizeOwner = memContextSize(owner);
+        memContextSwitch(owner);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("allocate, resize, and free");
+
+        char *buffer1 = memNew(16);
+        memcpy(buffer1, "ABCDEFGHIJKLMNO", 16);
+
+        MemContextArena *const arena = memContextArena(owner);
+        TEST_RESULT_UINT(arena->chunk->size, MEM_ARENA_CHUNK_SIZE_MIN, "first chunk");
+        TEST_RESULT_UINT(arena->chunk->used, MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + 16), "chunk used");
+        TEST_RESULT_UINT(arena->chunkSize, MEM_ARENA_CHUNK_SIZE_MIN * 2, "next chunk size doubled");
+        TEST_RESULT_UINT(memContextSize(owner), sizeOwner + MEM_ARENA_CHUNK_SIZE_MIN, "owner size includes chunk");
+
+        TEST_RESULT_PTR(memResize(buffer1, 64), buffer1, "last allocation grows in place");
+        TEST_RESULT_UINT(arena->chunk->used, MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + 64), "chunk used");
+        TEST_RESULT_PTR(memResize(buffer1, 32), buffer1, "last allocation shrinks in place");
+        TEST_RESULT_UINT(arena->chunk->used, MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + 32), "chunk used");
+
+        char *const buffer2 = memNew(8);
+        const size_t used = arena->chunk->used;
+
+        TEST_ASSIGN(buffer1, memResize(buffer1, 128), "resize copies when not the last allocation");
+        TEST_RESULT_BOOL(buffer1 == buffer2 + 8 + sizeof(MemContextAlloc), true, "copied after last allocation");
+        TEST_RESULT_Z(buffer1, "ABCDEFGHIJKLMNO", "contents copied");
+        TEST_RESULT_UINT(arena->chunk->used, used + MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + 128), "chunk used");
+
+        char *const buffer3 = memNew(8);
+        TEST_ASSIGN(buffer1, memResize(buffer1, 4), "shrink copies when not the last allocation");
+        TEST_RESULT_BOOL(buffer1 > buffer3, true, "copied after last allocation");
+        TEST_RESULT_BOOL(memcmp(buffer1, "ABCD", 4) == 0, true, "contents copied");
+
+        const size_t usedFree = arena->chunk->used;
+        TEST_RESULT_VOID(memFree(buffer3), "free allocation that is not last");
+        TEST_RESULT_UINT(arena->chunk->used, usedFree, "chunk used unchanged");
+        TEST_RESULT_VOID(memFree(buffer1), "free last allocation");
+        TEST_RESULT_UINT(arena->chunk->used, usedFree - MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + 4), "chunk used reduced");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("resize last allocation with no room in chunk");
+
+        MemArenaChunk *const chunkFirst = arena->chunk;
+        char *buffer4 = memNew(64);
+        memcpy(buffer4, "XYZ", 4);
+
+        TEST_ASSIGN(buffer4, memResize(buffer4, MEM_ARENA_CHUNK_SIZE_MIN), "resize");
+        TEST_RESULT_Z(buffer4, "XYZ", "contents copied");
+        TEST_RESULT_PTR(arena->chunk, chunkFirst, "dedicated chunk does not replace current chunk");
+        TEST_RESULT_UINT(
+            arena->chunk->prior->size, sizeof(MemArenaChunk) + MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + MEM_ARENA_CHUNK_SIZE_MIN),
+            "dedicated chunk");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("chunks grow to max");
+
+        for (unsigned int allocIdx = 0; allocIdx < 1024; allocIdx++)
+            memNew(4096);
+
+        TEST_RESULT_UINT(arena->chunkSize, MEM_ARENA_CHUNK_SIZE_MAX, "chunk size at max");
+        TEST_RESULT_UINT(arena->chunk->size, MEM_ARENA_CHUNK_SIZE_MAX, "chunk at max");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("arena members");
+
+        MemContext *member1;
+        TEST_ASSIGN(member1, memContextNewP("member1", .childQty = MEM_CONTEXT_QTY_MAX, .arena = true), "new member");
+        memContextKeep();
+        TEST_RESULT_UINT(member1->arena, memArenaMember, "arena member");
+
+        MemContext *member2;
+        TEST_ASSIGN(member2, memContextNewP("member2", .childQty = 1), "new member");
+        memContextKeep();
+
+        MemContext *member3;
+        memContextSwitch(member1);
+        TEST_ASSIGN(member3, memContextNewP("member3", .allocQty = 1, .callbackQty = 1), "new member of member");
+        memContextKeep();
+        TEST_RESULT_UINT(member3->arena, memArenaMember, "arena member");
+        memContextSwitchBack();
+
+        memContextSwitch(member3);
+        char *const buffer5 = memNew(16);
+        TEST_RESULT_BOOL(
+            (uint8_t *)buffer5 > (uint8_t *)arena->chunk && (uint8_t *)buffer5 < (uint8_t *)arena->chunk + arena->chunk->size, true,
+            "member allocation in arena");
+        TEST_RESULT_UINT(memContextSize(member3), 0, "member size is included in owner");
+        memContextSwitchBack();
+
+        TEST_RESULT_VOID(memContextMove(member3, member2), "move member inside arena");
+        TEST_RESULT_PTR(member3->contextParent, member2, "moved");
+        TEST_RESULT_VOID(memContextMove(member3, owner), "move member to owner");
+        TEST_ERROR(
+            memContextMove(member3, memContextTop()), AssertError,
+            "cannot move context allocated from an arena out of the arena");
+        TEST_RESULT_VOID(memContextFree(member1), "free member");
+
+        memContextSwitchBack();
+        TEST_RESULT_VOID(memContextFree(owner), "free owner");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("first allocation too large for a chunk");
+
+        MEM_CONTEXT_NEW_BEGIN("arena", .allocQty = 1, .arena = true)
+        {
+            memNew(MEM_ARENA_CHUNK_SIZE_MIN);
+
+            TEST_RESULT_UINT(
+                memContextArena(MEM_CONTEXT_NEW())->chunk->size,
+                sizeof(MemArenaChunk) + MEM_ARENA_ALIGN(sizeof(MemContextAlloc) + MEM_ARENA_CHUNK_SIZE_MIN), "dedicated chunk");
+            TEST_RESULT_UINT(memContextArena(MEM_CONTEXT_NEW())->chunkSize, MEM_ARENA_CHUNK_SIZE_MIN, "chunk size unchanged");
+        }
+        MEM_CONTEXT_NEW_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("temp arena context is recreated as an arena on reset");
+
+        MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN()
+        {
+            for (unsigned int loopIdx = 0; loopIdx < 3; loopIdx++)
+            {
+                memNew(16);
+                TEST_RESULT_UINT(MEM_CONTEXT_TEMP()->arena, memArenaOwner, "temp context is arena owner");
+
+                MEM_CONTEXT_TEMP_RESET(2);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("arena context is a regular context when arenas are disabled");
+
+        memArenaDisabled = true;
+
+        MEM_CONTEXT_NEW_BEGIN(TestArena, .arena = true)
+        {
+            TEST_RESULT_UINT(memContextCurrent()->arena, memArenaNone, "context is not an arena");
+        }
+        MEM_CONTEXT_NEW_END();
+
+        memArenaDisabled = false;
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("memContextAudit*s()"))
     {
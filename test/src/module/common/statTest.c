@@ -30,6 +30,72 @@ testRun(void)
 
         TEST_RESULT_STR_Z(
             statToJson(), "{\"http.session\":{\"total\":1},\"tls.client\":{\"total\":2}}", "stat output");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("timed stats");
+
+        TEST_RESULT_BOOL(statTimeEnabled(), false, "timing disabled by default");
+        TEST_RESULT_VOID(statTimeEnabledSet(true), "enable timing");
+        TEST_RESULT_BOOL(statTimeEnabled(), true, "timing enabled");
+        TEST_RESULT_VOID(statTimeEnabledSet(false), "disable timing");
+
+        const String *statStorageRead = STRDEF("storage.posix.read");
+
+        TEST_RESULT_VOID(statTimeAdd(statStorageRead, 999, 8192), "add 999us");
+        TEST_RESULT_VOID(statTimeAdd(statStorageRead, 1000, 0), "add 1ms");
+        TEST_RESULT_VOID(statTimeAdd(statStorageRead, 10000000, 1), "add 10s");
+        TEST_RESULT_VOID(statTimeAdd(statStorageRead, 250000, 65536), "add 250ms");
+
+        TEST_RESULT_STR_Z(
+            statToJson(),
+            "{\"http.session\":{\"total\":1},"
+            "\"storage.posix.read\":{\"histogram\":[1,1,0,1,0,1],\"size\":73729,\"time\":10251999,\"timeMax\":10000000,"
+            "\"total\":4},"
+            "\"tls.client\":{\"total\":2}}",
+            "stat output");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("merge stats from pack");
+
+        PackWrite *const pack = pckWriteNewP();
+        TEST_RESULT_VOID(statToPack(pack), "stats to pack");
+        pckWriteEndP(pack);
+
+        // Add a stat that will only be in the pack and a timed stat with a smaller max
+        PackWrite *const packOther = pckWriteNewP();
+        pckWriteArrayBeginP(packOther);
+        pckWriteObjBeginP(packOther);
+        pckWriteStrP(packOther, STRDEF("filter.gz-cmp"));
+        pckWriteU64P(packOther, 1);
+        pckWriteBoolP(packOther, true);
+        pckWriteU64P(packOther, 500);
+        pckWriteU64P(packOther, 500);
+        pckWriteU64P(packOther, 1024);
+        pckWriteU64P(packOther, 1);
+        pckWriteObjEndP(packOther);
+        pckWriteObjBeginP(packOther);
+        pckWriteStrP(packOther, statStorageRead);
+        pckWriteU64P(packOther, 1);
+        pckWriteBoolP(packOther, true);
+        pckWriteU64P(packOther, 1);
+        pckWriteU64P(packOther, 1);
+        pckWriteU64P(packOther, 0);
+        pckWriteU64P(packOther, 1);
+        pckWriteObjEndP(packOther);
+        pckWriteArrayEndP(packOther);
+        pckWriteEndP(packOther);
+
+        TEST_RESULT_VOID(statFromPack(pckReadNew(pckWriteResult(pack))), "merge stats");
+        TEST_RESULT_VOID(statFromPack(pckReadNew(pckWriteResult(packOther))), "merge other stats");
+
+        TEST_RESULT_STR_Z(
+            statToJson(),
+            "{\"filter.gz-cmp\":{\"histogram\":[1,0,0,0,0,0],\"size\":1024,\"time\":500,\"timeMax\":500,\"total\":1},"
+            "\"http.session\":{\"total\":2},"
+            "\"storage.posix.read\":{\"histogram\":[3,2,0,2,0,2],\"size\":147458,\"time\":20503999,\"timeMax\":10000000,"
+            "\"total\":9},"
+            "\"tls.client\":{\"total\":4}}",
+            "stat output");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
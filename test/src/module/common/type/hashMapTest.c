@@ -0,0 +1,109 @@
+/***********************************************************************************************************************************
+Test Hash Map Data Type
+***********************************************************************************************************************************/
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+static void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // -----------------------------------------------------------------------------------------------------------------------------
+    if (testBegin("HashMap"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("new hash map");
+
+        char logBuf[STACK_TRACE_PARAM_MAX];
+        HashMap *map = NULL;
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            TEST_ASSIGN(map, hashMapMove(hashMapNewP(sizeof(unsigned int)), memContextPrior()), "new map");
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_RESULT_UINT(map->slotMax, 16, "slot max");
+        TEST_RESULT_BOOL(hashMapEmpty(map), true, "map empty");
+        TEST_RESULT_PTR(hashMapGet(map, STRDEF("missing")), NULL, "get missing key");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("missing")), false, "missing key does not exist");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("add keys and resize");
+
+        StringList *keyList = strLstNew();
+
+        for (unsigned int keyIdx = 0; keyIdx < 1000; keyIdx++)
+        {
+            strLstAddFmt(keyList, "key%u", keyIdx);
+            hashMapAdd(map, strLstGet(keyList, keyIdx), &keyIdx);
+        }
+
+        TEST_RESULT_UINT(hashMapSize(map), 1000, "map size");
+        TEST_RESULT_UINT(map->slotMax, 2048, "slot max");
+        TEST_RESULT_BOOL(hashMapEmpty(map), false, "map not empty");
+
+        for (unsigned int keyIdx = 0; keyIdx < 1000; keyIdx++)
+        {
+            const unsigned int *const item = hashMapGet(map, strNewFmt("key%u", keyIdx));
+
+            if (item == NULL || *item != keyIdx)
+                THROW_FMT(AssertError, "invalid item for 'key%u'", keyIdx);
+        }
+
+        TEST_RESULT_PTR(hashMapGet(map, STRDEF("key1000")), NULL, "get missing key");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key999")), true, "key exists");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key1000")), false, "key does not exist");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("key with the same hash as another key is not matched");
+
+        TEST_RESULT_PTR(
+            map->slotList[hashMapSlotFind(map, STRDEF("key1000"), hashMapHash(STRDEF("key0")))].key, NULL, "empty slot found");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("replace item");
+
+        unsigned int item = 7777;
+
+        TEST_RESULT_UINT(*(unsigned int *)hashMapAdd(map, STRDEF("key5"), &item), 7777, "replace item");
+        TEST_RESULT_UINT(*(unsigned int *)hashMapGet(map, STRDEF("key5")), 7777, "get replaced item");
+        TEST_RESULT_UINT(hashMapSize(map), 1000, "map size unchanged");
+
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(map, hashMapToLog, logBuf, sizeof(logBuf)), "hashMapToLog");
+        TEST_RESULT_Z(logBuf, "{size: 1000}", "check log");
+
+        TEST_RESULT_VOID(hashMapFree(map), "free map");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("size hint");
+
+        TEST_ASSIGN(map, hashMapNewP(sizeof(unsigned int), .size = 1000), "new map");
+        TEST_RESULT_UINT(map->slotMax, 2048, "slot max");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("new from string list");
+
+        TEST_ASSIGN(map, hashMapNewStrLst(keyList), "new map");
+        TEST_RESULT_UINT(hashMapSize(map), 1000, "map size");
+        TEST_RESULT_PTR(hashMapAdd(map, STRDEF("key1000"), NULL), NULL, "add key");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key0")), true, "key exists");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key1000")), true, "key exists");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key1001")), false, "key does not exist");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("resize map without items");
+
+        for (unsigned int keyIdx = 1001; keyIdx < 2000; keyIdx++)
+            hashMapAdd(map, strNewFmt("key%u", keyIdx), NULL);
+
+        TEST_RESULT_UINT(hashMapSize(map), 2000, "map size");
+        TEST_RESULT_UINT(map->slotMax, 4096, "slot max");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key0")), true, "key exists");
+        TEST_RESULT_BOOL(hashMapExists(map, STRDEF("key1999")), true, "key exists");
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
@@ -71,6 +71,11 @@ testRun(void)
 
         TEST_ERROR(jsonReadStr(jsonReadNew(STRDEF("\""))), JsonFormatError, "expected '\"' but found null delimiter");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("empty string");
+
+        TEST_RESULT_STR_Z(jsonReadStr(jsonReadNew(STRDEF("\"\""))), "", "empty str");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("error on invalid bool");
 
@@ -236,6 +236,7 @@ testRun(void)
         TEST_RESULT_BOOL(strEq(NULL, STRDEF("bstring")), false, "null is not equal to bstring");
         TEST_RESULT_BOOL(strEq(STRDEF("astring"), NULL), false, "null is not equal to astring");
         TEST_RESULT_BOOL(strEq(NULL, NULL), true, "null is equal to null");
+        TEST_RESULT_BOOL(strEq(TEST_STRING, TEST_STRING), true, "string is equal to itself");
 
         TEST_RESULT_INT(strCmp(STRDEF("equalstring"), STRDEF("equalstring")), 0, "strings equal");
         TEST_RESULT_BOOL(strCmp(STRDEF("a"), STRDEF("b")) < 0, true, "a < b");
@@ -36,26 +36,37 @@ testRun(void)
 
         // Positive cache-hit path -- the current uid/gid was already cached by userInit() above so this exercises the cache-hit
         // branch in userNameFromId() / groupNameFromId().
-        TEST_RESULT_INT(userLocalData.userNameCache[0].id, userId(), "user id is cached");
-        TEST_RESULT_STR(userLocalData.userNameCache[0].name, userName(), "user name is cached");
-        TEST_RESULT_STR(userNameFromId(userId()), userName(), "user name from id (cache hit, repeated)");
-        TEST_RESULT_INT(userLocalData.groupNameCache[0].id, groupId(), "group id is cached");
-        TEST_RESULT_STR(userLocalData.groupNameCache[0].name, groupName(), "group name is cached");
-        TEST_RESULT_STR(groupNameFromId(groupId()), groupName(), "group name from id (cache hit, repeated)");
+        TEST_RESULT_INT(((UserNameCache *)lstGet(userLocalData.userNameCache, 0))->id, userId(), "user id is cached");
+        TEST_RESULT_STR(((UserNameCache *)lstGet(userLocalData.userNameCache, 0))->name, userName(), "user name is cached");
+        TEST_RESULT_PTR(userNameFromId(userId()), userName(), "user name from id (cache hit, repeated)");
+        TEST_RESULT_INT(((GroupNameCache *)lstGet(userLocalData.groupNameCache, 0))->id, groupId(), "group id is cached");
+        TEST_RESULT_STR(((GroupNameCache *)lstGet(userLocalData.groupNameCache, 0))->name, groupName(), "group name is cached");
+        TEST_RESULT_PTR(groupNameFromId(groupId()), groupName(), "group name from id (cache hit, repeated)");
 
         // Negative cache-hit path -- the invalid id was cached as NULL by the earlier negative test; repeating it now exercises
         // the same cache-hit branch returning NULL.
         TEST_RESULT_STR_Z(userNameFromId(77777), NULL, "invalid user name (negative cache hit)");
         TEST_RESULT_STR_Z(groupNameFromId(77777), NULL, "invalid group name (negative cache hit)");
 
-        // Cache overflow -- look up enough distinct invalid ids to exceed the 16-entry fixed cache and exercise the "table full,
-        // fall through uncached" branch in both userNameFromId() and groupNameFromId().
+        // Every distinct id is cached
         for (unsigned int idx = 1; idx <= 20; idx++)
         {
-            TEST_RESULT_STR_Z(userNameFromId(70000 + idx), NULL, "fill and overflow user cache");
-            TEST_RESULT_STR_Z(groupNameFromId(70000 + idx), NULL, "fill and overflow group cache");
+            TEST_RESULT_STR_Z(userNameFromId(70000 + idx), NULL, "fill user cache");
+            TEST_RESULT_STR_Z(groupNameFromId(70000 + idx), NULL, "fill group cache");
         }
 
+        TEST_RESULT_UINT(lstSize(userLocalData.userNameCache), 22, "user cache size");
+        TEST_RESULT_UINT(lstSize(userLocalData.groupNameCache), 22, "group cache size");
+
+        // Names added after many ids are cached are still shared
+        const String *const rootUser = userNameFromId(0);
+        const String *const rootGroup = groupNameFromId(0);
+
+        TEST_RESULT_STR_Z(rootUser, "root", "user name");
+        TEST_RESULT_PTR(userNameFromId(0), rootUser, "user name is shared");
+        TEST_RESULT_STR_Z(rootGroup, "root", "group name");
+        TEST_RESULT_PTR(groupNameFromId(0), rootGroup, "group name is shared");
+
 #ifdef HAVE_LIBSSH2
         TEST_RESULT_STR(userHome(), STRDEF("/home/" TEST_USER), "check user home directory");
         TEST_RESULT_STR_Z(userHomeFromId(userId()), "/home/" TEST_USER, "user home by id");
@@ -812,6 +812,7 @@ testRun(void)
         TEST_RESULT_VOID(cfgLoad(strLstSize(argList), strLstPtr(argList)), "load config for neutral-umask");
         TEST_RESULT_INT(umask(0111), 0000, "umask was reset");
         TEST_RESULT_UINT(ioTimeoutMs(), 95500, "check io timeout");
+        TEST_RESULT_BOOL(statTimeEnabled(), false, "stat timing disabled");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("umask is reset, neutral-umask=n");
@@ -949,6 +950,7 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptTcpKeepAliveIdle, "2222");
         hrnCfgArgRawZ(argList, cfgOptTcpKeepAliveInterval, "888");
         hrnCfgArgRawZ(argList, cfgOptPriority, "19");
+        hrnCfgArgRawZ(argList, cfgOptStatFile, TEST_PATH "/stat.json");
         strLstAddZ(argList, CFGCMD_BACKUP);
 
         TEST_RESULT_VOID(cfgLoad(strLstSize(argList), strLstPtr(argList)), "lock and open log file");
@@ -961,6 +963,7 @@ testRun(void)
         TEST_RESULT_INT(socketLocal.tcpKeepAliveIdle, 2222, "check socketLocal.tcpKeepAliveIdle");
         TEST_RESULT_INT(socketLocal.tcpKeepAliveInterval, 888, "check socketLocal.tcpKeepAliveInterval");
         TEST_RESULT_INT(getpriority(PRIO_PROCESS, (id_t)getpid()), 19, "check priority");
+        TEST_RESULT_BOOL(statTimeEnabled(), true, "stat timing enabled by stat-file");
 
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 2);
 
@@ -984,13 +987,14 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptPgPath, "/path/to");
         hrnCfgArgRawZ(argList, cfgOptProcess, "1");
         hrnCfgArgRawStrId(argList, cfgOptRemoteType, protocolStorageTypeRepo);
-        hrnCfgArgRawZ(argList, cfgOptLogLevelFile, "warn");
+        hrnCfgArgRawZ(argList, cfgOptLogLevelFile, "detail");
         hrnCfgArgRawZ(argList, cfgOptExecId, "1111-fe70d611");
         strLstAddZ(argList, CFGCMD_BACKUP ":" CONFIG_COMMAND_ROLE_LOCAL);
 
         TEST_RESULT_VOID(cfgLoad(strLstSize(argList), strLstPtr(argList)), "open log file");
         TEST_RESULT_INT(lstat(TEST_PATH "/db-backup-local-001.log", &statLog), 0, "check log file exists");
         TEST_RESULT_STR_Z(cfgOptionStr(cfgOptExecId), "1111-fe70d611", "exec-id is preserved");
+        TEST_RESULT_BOOL(statTimeEnabled(), true, "stat timing enabled by detail logging");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("remote command opens log file with special filename");
@@ -1002,10 +1006,12 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptLogLevelFile, "info");
         hrnCfgArgRawBool(argList, cfgOptLogSubprocess, true);
         hrnCfgArgRawZ(argList, cfgOptProcess, "0");
+        hrnCfgArgRawBool(argList, cfgOptStat, true);
         strLstAddZ(argList, CFGCMD_INFO ":" CONFIG_COMMAND_ROLE_REMOTE);
 
         TEST_RESULT_VOID(cfgLoad(strLstSize(argList), strLstPtr(argList)), "open log file");
         TEST_RESULT_INT(lstat(TEST_PATH "/all-info-remote-000.log", &statLog), 0, "check log file exists");
+        TEST_RESULT_BOOL(statTimeEnabled(), true, "stat timing enabled by stat option");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("remote command without archive-async option");
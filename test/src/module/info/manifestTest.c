@@ -1402,6 +1402,58 @@ testRun(void)
                     TEST_MANIFEST_PATH_DEFAULT)),
             "check manifest");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("synthetic full only references block incr files");
+
+        manifest->pub.data.backupOptionDelta = BOOL_FALSE_VAR;
+
+        lstClear(manifest->pub.fileList);
+        lstClear(manifestPrior->pub.fileList);
+
+        // Prior file was not block incr so it is copied
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/normal", .copy = true, .size = 4, .sizeRepo = 4, .timestamp = 1482182860,
+            .group = "test", .user = "test");
+        HRN_MANIFEST_FILE_ADD(
+            manifestPrior, .name = MANIFEST_TARGET_PGDATA "/normal", .size = 4, .sizeRepo = 4, .timestamp = 1482182860,
+            .checksumSha1 = "ddddddddddbbbbbbbbbbccccccccccaaaaaaaaaa");
+
+        // Prior file was block incr so the map is preserved
+        HRN_MANIFEST_FILE_ADD(
+            manifest, .name = MANIFEST_TARGET_PGDATA "/block-incr", .copy = true, .size = 16384, .sizeRepo = 6,
+            .blockIncrSize = 8192, .blockIncrChecksumSize = 6, .timestamp = 1482182861, .group = "test", .user = "test");
+        HRN_MANIFEST_FILE_ADD(
+            manifestPrior, .name = MANIFEST_TARGET_PGDATA "/block-incr", .size = 16384, .sizeRepo = 4, .blockIncrSize = 8192,
+            .blockIncrChecksumSize = 6, .blockIncrMapSize = 31, .timestamp = 1482182860,
+            .checksumSha1 = "ddddddddddbbbbbbbbbbccccccccccaaaaaaaaaa");
+
+        TEST_RESULT_VOID(manifestBuildIncr(manifest, manifestPrior, backupTypeFull, NULL), "synthetic full manifest");
+        TEST_RESULT_UINT(manifestData(manifest)->backupType, backupTypeFull, "backup type");
+        TEST_RESULT_STR_Z(manifestData(manifest)->backupLabelPrior, "20190101-010101F", "backup prior");
+        TEST_RESULT_BOOL(varBool(manifestData(manifest)->backupOptionDelta), true, "delta enabled");
+
+        ManifestFile file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/normal"));
+        TEST_RESULT_STR(file.reference, NULL, "normal file not referenced");
+        TEST_RESULT_BOOL(file.delta, false, "normal file no delta");
+
+        file = manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/block-incr"));
+        TEST_RESULT_STR_Z(file.reference, "20190101-010101F", "block incr file referenced");
+        TEST_RESULT_UINT(file.blockIncrMapSize, 31, "block incr map size");
+        TEST_RESULT_BOOL(file.delta, true, "block incr file delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("consolidated backup is a full backup without references");
+
+        file.reference = NULL;
+        manifestFileUpdate(manifest, &file);
+
+        TEST_RESULT_VOID(manifestBackupFullSet(manifest, STRDEF("20190103-010101F")), "full backup set");
+        TEST_RESULT_UINT(manifestData(manifest)->backupType, backupTypeFull, "backup type");
+        TEST_RESULT_STR_Z(manifestData(manifest)->backupLabel, "20190103-010101F", "backup label");
+        TEST_RESULT_STR(manifestData(manifest)->backupLabelPrior, NULL, "backup prior");
+        TEST_RESULT_STRLST_Z(manifestReferenceList(manifest), "20190103-010101F\n", "reference list");
+        TEST_RESULT_STR(manifestFileFind(manifest, STRDEF(MANIFEST_TARGET_PGDATA "/block-incr")).reference, NULL, "file reference");
+
         #undef TEST_MANIFEST_HEADER_PRE
         #undef TEST_MANIFEST_HEADER_MID
         #undef TEST_MANIFEST_HEADER_POST
@@ -1569,7 +1621,7 @@ testRun(void)
             "\n"                                                                                                                   \
             "[target:file]\n"                                                                                                      \
             "pg_data/=equal=more=={\"mode\":\"0640\",\"size\":0,\"timestamp\":1565282120}\n"                                       \
-            "pg_data/PG_VERSION={\"checksum\":\"184473f470864e067ee3a22e64b47b0a1c356f29\""                                        \
+            "pg_data/PG_VERSION={\"checksum\":\"184473f470864e067ee3a22e64b47b0a1c356f29\",\"dd\":true"                            \
                 ",\"rck\":\"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\",\"reference\":\"20190818-084502F_20190819-084506D\""        \
                 ",\"size\":4,\"timestamp\":1565282114}\n"                                                                          \
             "pg_data/base/16384/17000={\"bi\":4,\"bni\":1,\"checksum\":\"e0101dd8ffb910c9c202ca35b5f828bcb9697bed\""               \
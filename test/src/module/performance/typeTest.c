@@ -16,6 +16,7 @@ running out of memory on the test systems or taking an undue amount of time. It
 #include "common/io/socket/client.h"
 #include "common/stat.h"
 #include "common/time.h"
+#include "common/type/hashMap.h"
 #include "common/type/list.h"
 #include "common/type/object.h"
 #include "info/manifest/manifest.h"
@@ -182,6 +183,38 @@ testRun(void)
             ASSERT(*(int *)lstFind(list, &listIdx) == listIdx);
 
         TEST_LOG_FMT("desc search completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        // Generate a large list of strings similar to manifest file names (1M at scale 10)
+        StringList *const strList = strLstNew();
+
+        for (int listIdx = 0; listIdx < testMax; listIdx++)
+            strLstAddFmt(strList, "pg_data/base/16384/%d", listIdx);
+
+        TEST_LOG_FMT("generated %d item string list", testMax);
+
+        // Search for all strings with an ascending sort
+        strLstSort(strList, sortOrderAsc);
+
+        timeBegin = timeMSec();
+
+        for (unsigned int listIdx = 0; listIdx < strLstSize(strList); listIdx++)
+            ASSERT(strLstExists(strList, strLstGet(strList, listIdx)));
+
+        TEST_LOG_FMT("string asc search completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        // Search for all strings in a hash map
+        timeBegin = timeMSec();
+
+        const HashMap *const strMap = hashMapNewStrLst(strList);
+
+        TEST_LOG_FMT("string hash map built in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        timeBegin = timeMSec();
+
+        for (unsigned int listIdx = 0; listIdx < strLstSize(strList); listIdx++)
+            ASSERT(hashMapExists(strMap, strLstGet(strList, listIdx)));
+
+        TEST_LOG_FMT("string hash map search completed in %ums", (unsigned int)(timeMSec() - timeBegin));
     }
 
     // *****************************************************************************************************************************
@@ -240,6 +273,51 @@ testRun(void)
         TEST_LOG_FMT("parse completed in %ums", (unsigned int)(timeMSec() - timeBegin));
     }
 
+    // Compare allocating many small objects in temp contexts with and without an arena
+    // *****************************************************************************************************************************
+    if (testBegin("MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN()"))
+    {
+        ASSERT(TEST_SCALE <= 10000);
+
+        const unsigned int loopMax = 1000000 * (unsigned int)TEST_SCALE;
+        unsigned int total = 0;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("temp context");
+
+        TimeMSec timeBegin = timeMSec();
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            for (unsigned int loopIdx = 0; loopIdx < loopMax; loopIdx++)
+            {
+                total += (unsigned int)strSize(strNewFmt("key%u=\"value%u\"", loopIdx, loopIdx));
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("temp arena context");
+
+        timeBegin = timeMSec();
+
+        MEM_CONTEXT_TEMP_ARENA_RESET_BEGIN()
+        {
+            for (unsigned int loopIdx = 0; loopIdx < loopMax; loopIdx++)
+            {
+                total -= (unsigned int)strSize(strNewFmt("key%u=\"value%u\"", loopIdx, loopIdx));
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+        TEST_RESULT_UINT(total, 0, "same strings created");
+    }
+
     // Build/load/save a larger manifest to test performance and memory usage. The default sizing is for a "typical" large cluster
     // but this can be scaled to test larger cluster sizes.
     // *****************************************************************************************************************************
@@ -299,6 +377,21 @@ testRun(void)
 
         TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("save manifest without arena");
+
+        Buffer *contentSaveNoArena = bufNew(0);
+        memArenaDisabled = true;
+        timeBegin = timeMSec();
+
+        manifestSave(manifest, ioBufferWriteNew(contentSaveNoArena));
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+        memArenaDisabled = false;
+
+        TEST_RESULT_BOOL(bufEq(contentSaveNoArena, contentSave), true, "   check content");
+
+        bufFree(contentSaveNoArena);
         memContextFree(testContext);
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -319,6 +412,28 @@ testRun(void)
 
         TEST_RESULT_UINT(manifestFileTotal(manifest), driver->fileTotal, "   check file total");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("load manifest without arena");
+
+        MemContext *testContextNoArena = memContextNewP("test", .childQty = MEM_CONTEXT_QTY_MAX);
+        memContextKeep();
+        Manifest *manifestNoArena = NULL;
+        memArenaDisabled = true;
+        timeBegin = timeMSec();
+
+        MEM_CONTEXT_BEGIN(testContextNoArena)
+        {
+            manifestNoArena = manifestNewLoad(ioBufferReadNew(contentSave), cipherSpecNewNone());
+        }
+        MEM_CONTEXT_END();
+
+        TEST_LOG_FMT("completed in %ums", (unsigned int)(timeMSec() - timeBegin));
+        memArenaDisabled = false;
+
+        TEST_RESULT_UINT(manifestFileTotal(manifestNoArena), driver->fileTotal, "   check file total");
+
+        memContextFree(testContextNoArena);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("find all files");
 
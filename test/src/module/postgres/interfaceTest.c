@@ -457,10 +457,8 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("pgWalFromBuffer() and pgWalFromFile()"))
+    if (testBegin("pgWalFromBuffer()"))
     {
-        const String *walFile = STRDEF(TEST_PATH "/0000000F0000000F0000000F");
-
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("unknown WAL magic");
 
@@ -485,10 +483,9 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         memset(bufPtr(result), 0, bufSize(result));
         HRN_PG_WAL_TO_BUFFER(result, PG_VERSION_11, .systemId = 0xECAFECAF, .size = HRN_PG_WAL_SEGMENT_SIZE_DEFAULT * 2);
-        storagePutP(storageNewWriteP(storageTest, walFile), result);
 
         PgWal info = {0};
-        TEST_ASSIGN(info, pgWalFromFile(walFile, storageTest, NULL), "get wal info v11");
+        TEST_ASSIGN(info, pgWalFromBuffer(result, NULL), "get wal info v11");
         TEST_RESULT_UINT(info.systemId, 0xECAFECAF, "   check system id");
         TEST_RESULT_UINT(info.version, PG_VERSION_11, "   check version");
         TEST_RESULT_UINT(info.size, HRN_PG_WAL_SEGMENT_SIZE_DEFAULT * 2, "   check size");
@@ -496,9 +493,8 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         memset(bufPtr(result), 0, bufSize(result));
         HRN_PG_WAL_TO_BUFFER(result, PG_VERSION_96, .systemId = 0xEAEAEAEA, .size = HRN_PG_WAL_SEGMENT_SIZE_DEFAULT);
-        storagePutP(storageNewWriteP(storageTest, walFile), result);
 
-        TEST_ASSIGN(info, pgWalFromFile(walFile, storageTest, NULL), "get wal info v9.6");
+        TEST_ASSIGN(info, pgWalFromBuffer(result, NULL), "get wal info v9.6");
         TEST_RESULT_UINT(info.systemId, 0xEAEAEAEA, "   check system id");
         TEST_RESULT_UINT(info.version, PG_VERSION_96, "   check version");
         TEST_RESULT_UINT(info.size, HRN_PG_WAL_SEGMENT_SIZE_DEFAULT, "   check size");
@@ -508,7 +504,6 @@ testRun(void)
 
         memset(bufPtr(result), 0, bufSize(result));
         HRN_PG_WAL_OVERRIDE_TO_BUFFER(result, PG_VERSION_15, 777, .systemId = 0xFAFAFAFA, .size = HRN_PG_WAL_SEGMENT_SIZE_DEFAULT);
-        storagePutP(storageNewWriteP(storageTest, walFile), result);
 
         TEST_ERROR(
             pgWalFromBuffer(result, NULL), VersionNotSupportedError,
@@ -516,7 +511,7 @@ testRun(void)
             "HINT: is this version of PostgreSQL supported?\n"
             "HINT: is pgBackRest up to date on all hosts?");
 
-        TEST_ASSIGN(info, pgWalFromFile(walFile, storageTest, STRDEF(PG_VERSION_15_Z)), "force wal info v15");
+        TEST_ASSIGN(info, pgWalFromBuffer(result, STRDEF(PG_VERSION_15_Z)), "force wal info v15");
         TEST_RESULT_UINT(info.systemId, 0xFAFAFAFA, "check system id");
         TEST_RESULT_UINT(info.version, PG_VERSION_15, "   check version");
         TEST_RESULT_UINT(info.size, HRN_PG_WAL_SEGMENT_SIZE_DEFAULT, "   check size");
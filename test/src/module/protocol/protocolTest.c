@@ -347,12 +347,18 @@ testRun(void)
         }
         OBJ_NEW_END();
 
-        TEST_RESULT_VOID(protocolHelperClientFree(&protocolHelperClient), "free");
+        // Enable timing so stats are requested before the exit
+        statTimeEnabledSet(true);
+
+        TEST_RESULT_VOID(protocolHelperClientFree(&protocolHelperClient, false), "free");
+
+        statTimeEnabledSet(false);
 
         hrnLogReplaceAdd(" \\[10\\] No child process(es){0,1}", "process(es){0,1}", "processes", false);
 
         TEST_RESULT_LOG(
-            "P00   WARN: unable to finish write to invalid (wrote 0/12 bytes): [9] Bad file descriptor\n"
+            "P00   WARN: unable to get statistics: unable to finish write to invalid (wrote 0/12 bytes): [9] Bad file descriptor\n"
+            "P00   WARN: unable to finish write to invalid (wrote 0/25 bytes): [9] Bad file descriptor\n"
             "P00   WARN: unable to wait on child process: [10] No child [processes]");
     }
 
@@ -383,11 +389,15 @@ testRun(void)
         hrnCfgArgRawBool(argList, cfgOptLogSubprocess, true);
         HRN_CFG_LOAD(cfgCmdBackup, argList, .noStd = true);
 
+        statTimeEnabledSet(true);
+
         TEST_RESULT_STRLST_Z(
             protocolLocalParam(protocolStorageTypePg, 0, 1),
             "--exec-id=1-test\n--log-level-console=off\n--log-level-file=info\n--log-level-stderr=error\n--log-subprocess\n--pg=1\n"
-            "--pg1-path=/pg\n--process=1\n--remote-type=pg\n--stanza=test1\nbackup:local\n",
+            "--pg1-path=/pg\n--process=1\n--remote-type=pg\n--stanza=test1\n--stat\nbackup:local\n",
             "check config");
+
+        statTimeEnabledSet(false);
     }
 
     // *****************************************************************************************************************************
@@ -434,14 +444,18 @@ testRun(void)
                                                                     // because there might be validation errors
         HRN_CFG_LOAD(cfgCmdCheck, argList, .noStd = true);
 
+        statTimeEnabledSet(true);
+
         TEST_RESULT_STRLST_Z(
             protocolRemoteParamSsh(protocolStorageTypeRepo, 0),
             "-o\nLogLevel=error\n-o\nCompression=no\n-o\nPasswordAuthentication=no\n-p\n444\nrepo-host-user@repo-host\n"
             TEST_PROJECT_EXE " --config=/path/pgbackrest.conf --config-include-path=/path/include --config-path=/path/config"
             " --exec-id=1-test --log-level-console=off --log-level-file=info --log-level-stderr=error --log-subprocess"
-            " --pg1-path=/unused --process=0 --remote-type=repo --repo=1 --stanza=test1 check:remote\n",
+            " --pg1-path=/unused --process=0 --remote-type=repo --repo=1 --stanza=test1 --stat check:remote\n",
             "check config");
 
+        statTimeEnabledSet(false);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("remote repo protocol params for archive-get");
 
@@ -500,6 +514,20 @@ testRun(void)
             " --log-level-stderr=error --pg1-path=/path/to/2 --process=4 --remote-type=pg --stanza=test1 backup:remote\n",
             "check config");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("multiplexed ssh connection");
+
+        hrnCfgArgRawBool(argList, cfgOptCmdSshMultiplex, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList, .role = cfgCmdRoleLocal, .noStd = true);
+
+        TEST_RESULT_STRLST_Z(
+            protocolRemoteParamSsh(protocolStorageTypePg, 1),
+            "-o\nLogLevel=error\n-o\nCompression=no\n-o\nPasswordAuthentication=no\n-o\nControlMaster=auto\n"
+            "-o\nControlPath=~/.ssh/pgbackrest-%C\n-o\nControlPersist=60\npostgres@pg2-host\n"
+            TEST_PROJECT_EXE " --exec-id=1-test --lock=test1-backup-1.lock --log-level-console=off --log-level-file=off"
+            " --log-level-stderr=error --pg1-path=/path/to/2 --process=4 --remote-type=pg --stanza=test1 backup:remote\n",
+            "check config");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("local and remote pg servers, params for remote including additional params");
 
@@ -963,7 +991,7 @@ testRun(void)
 
             HRN_FORK_PARENT_BEGIN()
             {
-                IoServer *const tlsServer = tlsServerNew(
+                IoServer *const tlsServer = tlsServerNewP(
                     STRDEF("127.0.0.1"), STRDEF(HRN_SERVER_CA), STRDEF(HRN_SERVER_KEY), STRDEF(HRN_SERVER_CERT), 5000);
                 IoServer *const socketServer = sckServerNew(STRDEF("127.0.0.1"), testPort, 5000);
                 ProtocolServer *server = NULL;
@@ -1443,6 +1471,12 @@ testRun(void)
         TEST_RESULT_PTR(protocolLocalGet(protocolStorageTypeRepo, 0, 1), client, "get local cached protocol");
 
         TEST_RESULT_VOID(protocolFree(), "free local and remote protocol objects");
+
+        // Terminate local protocol
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(client, protocolLocalGet(protocolStorageTypeRepo, 0, 1), "get local protocol");
+        TEST_RESULT_VOID(protocolHelperTerminate(client), "terminate local protocol");
+        TEST_RESULT_UINT(lstSize(protocolHelper.clientList), 0, "local protocol removed");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
@@ -37,6 +37,7 @@ typedef struct TestRequestParam
     const char *blobType;
     const char *range;
     const char *tag;
+    bool ifNoneMatch;
     bool multiPart;
 } TestRequestParam;
 
@@ -104,6 +105,10 @@ testRequest(IoWrite *write, const char *verb, const char *path, TestRequestParam
     // Add host
     strCatFmt(request, "host:%s\r\n", strZ(hrnServerHost()));
 
+    // Add if-none-match
+    if (param.ifNoneMatch)
+        strCatZ(request, "if-none-match:*\r\n");
+
     // Add range
     if (param.range != NULL)
         strCatFmt(request, "range:bytes=%s\r\n", param.range);
@@ -456,6 +461,21 @@ testRun(void)
             ", authorization: 'SharedKey account:GrE62U88ziaAGq+chejwUKmaBOAsyj+QCjrykcE+O+c='}",
             "check headers");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("auth with if-none-match");
+
+        header = httpHeaderAdd(httpHeaderNew(NULL), HTTP_HEADER_CONTENT_LENGTH_STR, ZERO_STR);
+        httpHeaderAdd(header, HTTP_HEADER_IF_NONE_MATCH_STR, STRDEF("*"));
+
+        TEST_RESULT_VOID(storageAzureAuth(storage, HTTP_VERB_PUT_STR, STRDEF("/path"), NULL, dateTime, header, false), "auth");
+        TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(header, httpHeaderToLog, logBuf, sizeof(logBuf)), "httpHeaderToLog");
+        TEST_RESULT_Z(
+            logBuf,
+            "{content-length: '0', if-none-match: '*', host: 'account.blob.core.windows.net'"
+            ", date: 'Sun, 21 Jun 2020 12:46:19 GMT', x-ms-version: '2024-08-04'"
+            ", authorization: 'SharedKey account:YxRNvcw+mSDIyW03SJDeTuRJ9REcE7oST8NeeM2Ngxc='}",
+            "check headers");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("SAS auth");
 
@@ -755,6 +775,102 @@ testRun(void)
                 // Stop writing tags
                 driver->tag = NULL;
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("write file exclusively");
+
+                testRequestP(service, HTTP_VERB_PUT, "/file.txt", .blobType = "BlockBlob", .content = "ABCD", .ifNoneMatch = true);
+                testResponseP(service);
+
+                TEST_RESULT_VOID(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")), "write");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write when file exists");
+
+                testRequestP(service, HTTP_VERB_PUT, "/file.txt", .blobType = "BlockBlob", .content = "ABCD", .ifNoneMatch = true);
+                testResponseP(service, .code = 409, .header = "x-ms-error-code:BlobAlreadyExists");
+
+                TEST_ERROR(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")),
+                    FileExistsError, "unable to write '/file.txt' because it already exists");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write for a conflict other than the file existing");
+
+                testRequestP(service, HTTP_VERB_PUT, "/file.txt", .blobType = "BlockBlob", .content = "ABCD", .ifNoneMatch = true);
+                testResponseP(service, .code = 409, .header = "x-ms-error-code:LeaseIdMissing");
+
+                TEST_ERROR_FMT(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")),
+                    ProtocolError,
+                    "HTTP request failed with 409:\n"
+                    "*** Path/Query ***:\n"
+                    "PUT /account/container/file.txt\n"
+                    "*** Request Headers ***:\n"
+                    "authorization: <redacted>\n"
+                    "content-length: 4\n"
+                    "content-md5: ywjKSnu1+Wg8GRM6hIcspw==\n"
+                    "date: <redacted>\n"
+                    "host: %s\n"
+                    "if-none-match: *\n"
+                    "x-ms-blob-type: BlockBlob\n"
+                    "x-ms-version: 2024-08-04\n"
+                    "*** Response Headers ***:\n"
+                    "x-ms-error-code: LeaseIdMissing",
+                    strZ(hrnServerHost()));
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write for a reason other than the file existing");
+
+                testRequestP(service, HTTP_VERB_PUT, "/file.txt", .blobType = "BlockBlob", .content = "ABCD", .ifNoneMatch = true);
+                testResponseP(service, .code = 403);
+
+                TEST_ERROR_FMT(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")),
+                    ProtocolError,
+                    "HTTP request failed with 403 (Forbidden):\n"
+                    "*** Path/Query ***:\n"
+                    "PUT /account/container/file.txt\n"
+                    "*** Request Headers ***:\n"
+                    "authorization: <redacted>\n"
+                    "content-length: 4\n"
+                    "content-md5: ywjKSnu1+Wg8GRM6hIcspw==\n"
+                    "date: <redacted>\n"
+                    "host: %s\n"
+                    "if-none-match: *\n"
+                    "x-ms-blob-type: BlockBlob\n"
+                    "x-ms-version: 2024-08-04",
+                    strZ(hrnServerHost()));
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive multi-block write when file exists");
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?blockid=0AAAAAAACCCCCCCCx0000000&comp=block", .content = "1234567890123456");
+                testResponseP(service);
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?blockid=0AAAAAAACCCCCCCCx0000001&comp=block", .content = "7890123456789012");
+                testResponseP(service);
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, "/file.txt?comp=blocklist", .ifNoneMatch = true,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<BlockList>"
+                        "<Uncommitted>0AAAAAAACCCCCCCCx0000000</Uncommitted>"
+                        "<Uncommitted>0AAAAAAACCCCCCCCx0000001</Uncommitted>"
+                        "</BlockList>\n");
+                testResponseP(service, .code = 412);
+
+                driver->fileId = 0x0AAAAAAACCCCCCCC;
+
+                TEST_ERROR(
+                    storagePutP(
+                        storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true),
+                        BUFSTRDEF("12345678901234567890123456789012")),
+                    FileExistsError, "unable to write '/file.txt' because it already exists");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("info for / does not exist");
 
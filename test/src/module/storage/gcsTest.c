@@ -757,6 +757,85 @@ testRun(void)
                     "host: %s",
                     strZ(hrnServerHost()));
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("write file exclusively");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .query = "fields=md5Hash%2Csize&ifGenerationMatch=0&name=file.txt&uploadType=media",
+                    .upload = true, .content = "ABCD");
+                testResponseP(service, .content = "{\"md5Hash\":\"ywjKSnu1+Wg8GRM6hIcspw==\"}");
+
+                TEST_RESULT_VOID(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")), "write");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write when file exists");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .query = "fields=md5Hash%2Csize&ifGenerationMatch=0&name=file.txt&uploadType=media",
+                    .upload = true, .content = "ABCD");
+                testResponseP(service, .code = 412);
+
+                TEST_ERROR(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")),
+                    FileExistsError, "unable to write '/file.txt' because it already exists");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write for a reason other than the file existing");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .query = "fields=md5Hash%2Csize&ifGenerationMatch=0&name=file.txt&uploadType=media",
+                    .upload = true, .content = "ABCD");
+                testResponseP(service, .code = 403);
+
+                TEST_ERROR_FMT(
+                    storagePutP(storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("ABCD")),
+                    ProtocolError,
+                    "HTTP request failed with 403 (Forbidden):\n"
+                    "*** Path/Query ***:\n"
+                    "POST /upload/storage/v1/b/bucket/o?fields=md5Hash%%2Csize&ifGenerationMatch=0&name=file.txt&uploadType=media\n"
+                    "*** Request Headers ***:\n"
+                    "authorization: <redacted>\n"
+                    "content-length: 4\n"
+                    "host: %s",
+                    strZ(hrnServerHost()));
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive resumable upload start when file exists");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .upload = true, .query = "ifGenerationMatch=0&name=file.txt&uploadType=resumable");
+                testResponseP(service, .code = 412);
+
+                TEST_ERROR(
+                    storagePutP(
+                        storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("12345678901234567")),
+                    FileExistsError, "unable to write '/file.txt' because it already exists");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive resumable upload finish when file exists");
+
+                testRequestP(
+                    service, HTTP_VERB_POST, .upload = true, .query = "ifGenerationMatch=0&name=file.txt&uploadType=resumable");
+                testResponseP(service, .header = "x-guploader-uploadid:ulid4");
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, .upload = true, .noAuth = true,
+                    .query = "name=file.txt&uploadType=resumable&upload_id=ulid4", .contentRange = "0-15/*",
+                    .content = "1234567890123456");
+                testResponseP(service, .code = 308);
+
+                testRequestP(
+                    service, HTTP_VERB_PUT, .upload = true, .noAuth = true,
+                    .query = "fields=md5Hash%2Csize&name=file.txt&uploadType=resumable&upload_id=ulid4", .contentRange = "16-16/17",
+                    .content = "7");
+                testResponseP(service, .code = 412);
+
+                TEST_ERROR(
+                    storagePutP(
+                        storageNewWriteP(storage, STRDEF("file.txt"), .exclusive = true), BUFSTRDEF("12345678901234567")),
+                    FileExistsError, "unable to write '/file.txt' because it already exists");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("info for / does not exist");
 
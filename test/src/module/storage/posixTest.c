@@ -2,6 +2,7 @@
 Test Posix/CIFS Storage
 ***********************************************************************************************************************************/
 #include "common/io/io.h"
+#include "common/stat.h"
 #include "common/time.h"
 #include "storage/read.h"
 #include "storage/write.h"
@@ -32,6 +33,60 @@ storageTestPathExpression(const String *expression, const String *path)
     return result;
 }
 
+/***********************************************************************************************************************************
+Test list function that lists recursively in a single flat list without paths, the same as an object store
+***********************************************************************************************************************************/
+static void
+storageTestListFlat(
+    void *const driver, StorageList *const result, const String *const path, const String *const pathSub,
+    const StorageInfoLevel level)
+{
+    const StorageList *const list = storagePosixList(
+        driver, pathSub == NULL ? path : strNewFmt("%s/%s", strZ(path), strZ(pathSub)), level, (StorageInterfaceListParam){0});
+
+    for (unsigned int listIdx = 0; listIdx < storageLstSize(list); listIdx++)
+    {
+        StorageInfo info = storageLstGet(list, listIdx);
+
+        if (strEq(info.name, DOT_STR))
+            continue;
+
+        if (pathSub != NULL)
+            info.name = strNewFmt("%s/%s", strZ(pathSub), strZ(info.name));
+
+        if (info.type == storageTypePath)
+            storageTestListFlat(driver, result, path, info.name, level);
+        else
+            storageLstAdd(result, &info);
+    }
+}
+
+static StorageList *
+storageTestList(void *const driver, const String *const path, const StorageInfoLevel level, const StorageInterfaceListParam param)
+{
+    StorageList *result = storagePosixList(driver, path, level, param);
+
+    if (param.recurse && result != NULL)
+    {
+        result = storageLstNew(level);
+        storageTestListFlat(driver, result, path, NULL, level);
+    }
+
+    return result;
+}
+
+/***********************************************************************************************************************************
+Test remove list function that removes files one at a time, since posix does not support batch removal
+***********************************************************************************************************************************/
+static void
+storageTestRemoveList(void *const driver, const StringList *const fileList, const StorageInterfaceRemoveListParam param)
+{
+    (void)param;
+
+    for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+        storagePosixRemove(driver, strLstGet(fileList, fileIdx), (StorageInterfaceRemoveParam){0});
+}
+
 /***********************************************************************************************************************************
 Macro to create a path and file that cannot be accessed
 ***********************************************************************************************************************************/
@@ -519,6 +574,80 @@ testRun(void)
             storageTest, "pg",
             "path/file {s=8, t=1656434296}\n",
             .level = storageInfoLevelBasic, .expression = "\\/file$");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("flat list - paths inferred from files");
+
+        StoragePosix *const driver = (StoragePosix *)storageDriver(storageTest);
+
+        storageTest->pub.interface.feature ^= 1 << storageFeatureListRecurse;
+        driver->interface.list = storageTestList;
+
+        storagePutP(
+            storageNewWriteP(storageTest, STRDEF("pg/zzz/yyy/xxx/file"), .modeFile = 0600, .timeModified = 1656434296),
+            BUFSTRDEF("TESTDATA"));
+        storagePutP(
+            storageNewWriteP(storageTest, STRDEF("pg/zzz/file"), .modeFile = 0600, .timeModified = 1656434296),
+            BUFSTRDEF("TESTDATA"));
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "file {s=8, t=1656433838}\n"
+            "link> {d=../file}\n"
+            "path/\n"
+            "path/file {s=8, t=1656434296}\n"
+            "pipe*\n"
+            "zzz/\n"
+            "zzz/file {s=8, t=1656434296}\n"
+            "zzz/yyy/\n"
+            "zzz/yyy/xxx/\n"
+            "zzz/yyy/xxx/file {s=8, t=1656434296}\n",
+            .level = storageInfoLevelBasic);
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "zzz/yyy/xxx/file {s=8, t=1656434296}\n"
+            "zzz/yyy/xxx/\n"
+            "zzz/yyy/\n"
+            "zzz/file {s=8, t=1656434296}\n"
+            "zzz/\n"
+            "pipe*\n"
+            "path/file {s=8, t=1656434296}\n"
+            "path/\n"
+            "link> {d=../file}\n"
+            "file {s=8, t=1656433838}\n",
+            .level = storageInfoLevelBasic, .sortOrder = sortOrderDesc);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("flat list - filter");
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "path/file {s=8, t=1656434296}\n"
+            "zzz/file {s=8, t=1656434296}\n"
+            "zzz/yyy/xxx/file {s=8, t=1656434296}\n",
+            .level = storageInfoLevelBasic, .expression = "\\/file$");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("flat list - no recurse");
+
+        TEST_STORAGE_LIST(
+            storageTest, "pg",
+            "empty/\n"
+            "file {s=8, t=1656433838}\n"
+            "link> {d=../file}\n"
+            "path/\n"
+            "pipe*\n"
+            "zzz/\n",
+            .level = storageInfoLevelBasic, .noRecurse = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("flat list - path missing");
+
+        TEST_RESULT_PTR(storageNewItrP(storageTest, STRDEF(BOGUS_STR), .recurse = true, .nullOnMissing = true), NULL, "missing");
+
+        storageTest->pub.interface.feature ^= 1 << storageFeatureListRecurse;
+        driver->interface.list = storagePosixList;
     }
 
     // *****************************************************************************************************************************
@@ -705,7 +834,21 @@ testRun(void)
         TEST_RESULT_BOOL(storageExistsP(storageTmp, sourceFile), false, "check source file not exists");
         TEST_RESULT_BOOL(storageExistsP(storageTest, destinationFile), true, "check destination file exists");
 
-        storageRemoveP(storageTest, destinationFile, .errorOnMissing = true);
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("move - storage without move");
+
+        sourceFile = destinationFile;
+        source = storageNewReadP(storageTest, sourceFile);
+        destinationFile = STRDEF(TEST_PATH "/sub/destination.txt");
+        destination = storageNewWriteP(storageTest, destinationFile);
+
+        storageTest->pub.interface.move = NULL;
+
+        TEST_RESULT_VOID(storageMoveP(storageTest, source, destination), "copy file and remove source");
+        TEST_RESULT_BOOL(storageExistsP(storageTest, sourceFile), false, "check source file not exists");
+        TEST_STORAGE_GET(storageTest, strZ(destinationFile), "TESTFILE", .remove = true);
+
+        storageTest->pub.interface.move = storageInterface(storageTmp).move;
     }
 
     // *****************************************************************************************************************************
@@ -1192,6 +1335,22 @@ testRun(void)
             storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"), .offset = 4, .limit = VARUINT64(4))), "get");
         TEST_RESULT_UINT(bufSize(buffer), 4, "check size");
         TEST_RESULT_BOOL(memcmp(bufPtrConst(buffer), "FILE", bufSize(buffer)) == 0, true, "check content");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("put and get with timing enabled");
+
+        statTimeEnabledSet(true);
+
+        TEST_RESULT_VOID(storagePutP(storageNewWriteP(storageTest, STRDEF(TEST_PATH "/test.txt")), buffer), "put test file");
+        TEST_ASSIGN(buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"))), "get text");
+        TEST_RESULT_BOOL(
+            strstr(strZ(statToJson()), "\"" STORAGE_STAT_PREFIX "posix." STORAGE_STAT_READ "\":{\"histogram\"") != NULL, true,
+            "check read stat");
+        TEST_RESULT_BOOL(
+            strstr(strZ(statToJson()), "\"" STORAGE_STAT_PREFIX "posix." STORAGE_STAT_WRITE "\":{\"histogram\"") != NULL, true,
+            "check write stat");
+
+        statTimeEnabledSet(false);
     }
 
     // *****************************************************************************************************************************
@@ -1217,6 +1376,32 @@ testRun(void)
 
         TEST_RESULT_VOID(storageRemoveP(storageTest, fileExists), "remove exists file");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove list - one at a time");
+
+        HRN_STORAGE_PUT_EMPTY(storageTest, "exists1");
+        HRN_STORAGE_PUT_EMPTY(storageTest, "exists2");
+
+        TEST_RESULT_VOID(storageRemoveListP(storageTest, strLstNewSplitZ(STRDEF("exists1,missing,exists2"), ",")), "remove list");
+        TEST_STORAGE_LIST_EMPTY(storageTest, NULL, .level = storageInfoLevelType, .expression = "^exists");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("remove list - driver");
+
+        StoragePosix *const driver = (StoragePosix *)storageDriver(storageTest);
+
+        storageTest->pub.interface.removeList = storageTestRemoveList;
+        driver->interface.removeList = storageTestRemoveList;
+
+        HRN_STORAGE_PUT_EMPTY(storageTest, "exists1");
+        HRN_STORAGE_PUT_EMPTY(storageTest, "exists2");
+
+        TEST_RESULT_VOID(storageRemoveListP(storageTest, strLstNewSplitZ(STRDEF("exists1,missing,exists2"), ",")), "remove list");
+        TEST_STORAGE_LIST_EMPTY(storageTest, NULL, .level = storageInfoLevelType, .expression = "^exists");
+
+        storageTest->pub.interface.removeList = NULL;
+        driver->interface.removeList = NULL;
+
 #ifdef TEST_CONTAINER_REQUIRED
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("remove - permission denied");
@@ -82,6 +82,7 @@ typedef struct TestRequestParam
     const char *ttl;
     const char *token;
     const char *tag;
+    bool ifNoneMatch;
     bool requesterPays;
 } TestRequestParam;
 
@@ -122,6 +123,9 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
 
         strCatZ(request, "host;");
 
+        if (param.ifNoneMatch)
+            strCatZ(request, "if-none-match;");
+
         if (param.range != NULL)
             strCatZ(request, "range;");
 
@@ -175,6 +179,10 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
     else
         strCatFmt(request, "host:%s\r\n", strZ(hrnServerHost()));
 
+    // Add if-none-match
+    if (param.ifNoneMatch)
+        strCatZ(request, "if-none-match:*\r\n");
+
     // Add range
     if (param.range != NULL)
         strCatFmt(request, "range:bytes=%s\r\n", param.range);
@@ -1340,6 +1348,83 @@ testRun(void)
                 TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt")), "new write");
                 TEST_RESULT_VOID(storagePutP(write, NULL), "write");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("write file exclusively");
+
+                testRequestP(service, s3, HTTP_VERB_PUT, "/file.txt", .content = "ABC", .ifNoneMatch = true);
+                testResponseP(service);
+
+                TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt"), .exclusive = true), "new write");
+                TEST_RESULT_VOID(storagePutP(write, BUFSTRDEF("ABC")), "write");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write when file exists");
+
+                testRequestP(service, s3, HTTP_VERB_PUT, "/file.txt", .content = "ABC", .ifNoneMatch = true);
+                testResponseP(service, .code = 412);
+
+                TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt"), .exclusive = true), "new write");
+                TEST_ERROR(
+                    storagePutP(write, BUFSTRDEF("ABC")), FileExistsError,
+                    "unable to write '/file.txt' because it already exists");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive write for a reason other than the file existing");
+
+                testRequestP(service, s3, HTTP_VERB_PUT, "/file.txt", .content = "ABC", .ifNoneMatch = true);
+                testResponseP(service, .code = 403);
+
+                TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt"), .exclusive = true), "new write");
+                TEST_ERROR(
+                    storagePutP(write, BUFSTRDEF("ABC")), ProtocolError,
+                    "HTTP request failed with 403:\n"
+                    "*** Path/Query ***:\n"
+                    "PUT /file.txt\n"
+                    "*** Request Headers ***:\n"
+                    "authorization: <redacted>\n"
+                    "content-length: 3\n"
+                    "content-md5: kC+90rHfDE9wtKXSNSXpMg==\n"
+                    "host: bucket.s3.amazonaws.com\n"
+                    "if-none-match: *\n"
+                    "x-amz-content-sha256: b5d4045c3f466fa91fe2cc6abe79232a1a57cdf104f7a26e716e0a1e2789df78\n"
+                    "x-amz-date: <redacted>\n"
+                    "x-amz-security-token: <redacted>");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on exclusive multipart write when file exists");
+
+                testRequestP(service, s3, HTTP_VERB_POST, "/file.txt?uploads=");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<InitiateMultipartUploadResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "<Bucket>bucket</Bucket>"
+                        "<Key>file.txt</Key>"
+                        "<UploadId>WxRt</UploadId>"
+                        "</InitiateMultipartUploadResult>");
+
+                testRequestP(service, s3, HTTP_VERB_PUT, "/file.txt?partNumber=1&uploadId=WxRt", .content = "1234567890123456");
+                testResponseP(service, .header = "etag:WxRt1");
+
+                testRequestP(service, s3, HTTP_VERB_PUT, "/file.txt?partNumber=2&uploadId=WxRt", .content = "7890123456789012");
+                testResponseP(service, .header = "eTag:WxRt2");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/file.txt?uploadId=WxRt", .ifNoneMatch = true,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<CompleteMultipartUpload>"
+                        "<Part><PartNumber>1</PartNumber><ETag>WxRt1</ETag></Part>"
+                        "<Part><PartNumber>2</PartNumber><ETag>WxRt2</ETag></Part>"
+                        "</CompleteMultipartUpload>\n");
+                testResponseP(service, .code = 412);
+
+                TEST_ASSIGN(write, storageNewWriteP(s3, STRDEF("file.txt"), .exclusive = true), "new write");
+                TEST_ERROR(
+                    storagePutP(write, BUFSTRDEF("12345678901234567890123456789012")), FileExistsError,
+                    "unable to write '/file.txt' because it already exists");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("info check existence only");
 
@@ -1706,6 +1791,41 @@ testRun(void)
                     "test3.txt\n",
                     .level = storageInfoLevelExists, .noRecurse = true, .expression = "^test(1|3)");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("list files recursively with a single flat listing");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/?list-type=2&prefix=path%2Fto%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/to/path1/sub/test2.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/to/path1/test1.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/to/path2/test3.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/to/test4.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                TEST_STORAGE_LIST(
+                    s3, "/path/to",
+                    "test4.txt\n"
+                    "path2/test3.txt\n"
+                    "path2/\n"
+                    "path1/test1.txt\n"
+                    "path1/sub/test2.txt\n"
+                    "path1/sub/\n"
+                    "path1/\n",
+                    .level = storageInfoLevelType, .sortOrder = sortOrderDesc);
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to path-style URIs");
 
@@ -1880,6 +2000,47 @@ testRun(void)
 
                 TEST_RESULT_VOID(storageRemoveP(s3, STRDEF("/path/to/test.txt")), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove file list");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/to/test1.txt</Key></Object>"
+                        "<Object><Key>path/test2.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>test3.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(
+                    storageRemoveListP(s3, strLstNewSplitZ(STRDEF("/path/to/test1.txt,/path/test2.txt,/test3.txt"), ",")),
+                    "remove list");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove file list that fills the last batch");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>test1.txt</Key></Object>"
+                        "<Object><Key>test2.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storageRemoveListP(s3, strLstNewSplitZ(STRDEF("/test1.txt,/test2.txt"), ",")), "remove list");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to time limited");
 
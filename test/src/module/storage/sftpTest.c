@@ -3358,6 +3358,7 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptPgPath, "/path/to/pg");
         hrnCfgArgRawZ(argList, cfgOptBufferSize, "64KiB");
         hrnCfgArgRawZ(argList, cfgOptRepo, "1");
+        hrnCfgArgRawZ(argList, cfgOptRepoSftpWindowSize, "64KiB");
         hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH);
         hrnCfgArgRawZ(argList, cfgOptRepoSftpHostUser, TEST_USER);
         hrnCfgArgRawZ(argList, cfgOptRepoType, "sftp");
@@ -3783,6 +3784,85 @@ testRun(void)
             "timeout reading '" TEST_PATH "/test.txt'");
 
         storageHelperFree();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("put/get with a window smaller than the file");
+
+        Storage *storageWindow;
+
+        HRN_LIBSSH2_SCRIPT_SET(
+            HRNLIBSSH2_MACRO_STARTUP(),
+            // Writes start when the write-behind buffer is full and continue until half of it has been acknowledged
+            HRN_LIBSSH2_OPEN_WRITE(TEST_PATH "/test.txt.pgbackrest.tmp"),
+            HRN_LIBSSH2_WRITE(8, .resultInt = 3),
+            HRN_LIBSSH2_WRITE(5, .resultInt = 2),
+            HRN_LIBSSH2_WRITE(4),
+            HRN_LIBSSH2_FSYNC(),
+            HRN_LIBSSH2_CLOSE(),
+            HRN_LIBSSH2_RENAME(TEST_PATH "/test.txt.pgbackrest.tmp", TEST_PATH "/test.txt"),
+            // Reads go directly into the buffer while it is as large as the read-ahead buffer, otherwise the read-ahead buffer is
+            // used
+            HRN_LIBSSH2_OPEN_READ(TEST_PATH "/test.txt"),
+            HRN_LIBSSH2_READ(2, .readBuffer = STRDEF("TE")),
+            HRN_LIBSSH2_READ(2, .readBuffer = STRDEF("ST")),
+            HRN_LIBSSH2_READ(2, .readBuffer = STRDEF("FI")),
+            HRN_LIBSSH2_READ(2, .readBuffer = STRDEF("LE")),
+            HRN_LIBSSH2_READ(2, .readBuffer = STRDEF("\n")),
+            HRN_LIBSSH2_READ(2),
+            HRN_LIBSSH2_CLOSE(),
+            HRNLIBSSH2_MACRO_SHUTDOWN());
+
+        TEST_ASSIGN(
+            storageWindow,
+            storageSftpNewP(
+                TEST_PATH_STR, STRDEF("localhost"), 22, TEST_USER_STR, 1000, KEYPRIV, hashTypeSha1, .keyPub = KEYPUB,
+                .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, 0)), .write = true, .windowSize = 8),
+            "new storage");
+
+        ioBufferSizeSet(3);
+
+        TEST_RESULT_VOID(
+            storagePutP(storageNewWriteP(storageWindow, STRDEF(TEST_PATH "/test.txt")), BUFSTRDEF("TESTFILE\n")), "put");
+
+        ioBufferSizeSet(2);
+        TEST_RESULT_STR_Z(
+            strNewBuf(storageGetP(storageNewReadP(storageWindow, STRDEF(TEST_PATH "/test.txt")))), "TESTFILE\n", "get");
+
+        objFree(storageWindow);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get with read-ahead");
+
+        HRN_LIBSSH2_SCRIPT_SET(
+            HRNLIBSSH2_MACRO_STARTUP(),
+            // The read-ahead buffer is used when the buffer is smaller than a quarter of the window
+            HRN_LIBSSH2_OPEN_READ(TEST_PATH "/test.txt"),
+            HRN_LIBSSH2_READ(4, .readBuffer = STRDEF("TEST")),
+            HRN_LIBSSH2_READ(4, .readBuffer = STRDEF("FILE")),
+            HRN_LIBSSH2_READ(4, .readBuffer = STRDEF("\n")),
+            HRN_LIBSSH2_READ(4),
+            HRN_LIBSSH2_CLOSE(),
+            // The read-ahead stops at the limit
+            HRN_LIBSSH2_OPEN_READ(TEST_PATH "/test.txt"),
+            HRN_LIBSSH2_READ(4, .readBuffer = STRDEF("TEST")),
+            HRN_LIBSSH2_READ(3, .readBuffer = STRDEF("FIL")),
+            HRN_LIBSSH2_CLOSE(),
+            HRNLIBSSH2_MACRO_SHUTDOWN());
+
+        TEST_ASSIGN(
+            storageWindow,
+            storageSftpNewP(
+                TEST_PATH_STR, STRDEF("localhost"), 22, TEST_USER_STR, 1000, KEYPRIV, hashTypeSha1, .keyPub = KEYPUB,
+                .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, 0)), .windowSize = 16),
+            "new storage");
+
+        TEST_RESULT_STR_Z(
+            strNewBuf(storageGetP(storageNewReadP(storageWindow, STRDEF(TEST_PATH "/test.txt")))), "TESTFILE\n", "get");
+        TEST_RESULT_STR_Z(
+            strNewBuf(storageGetP(storageNewReadP(storageWindow, STRDEF(TEST_PATH "/test.txt"), .limit = VARUINT64(7)))),
+            "TESTFIL", "get with limit");
+
+        objFree(storageWindow);
 #else
         TEST_LOG(PROJECT_NAME " not built with sftp support");
 #endif // HAVE_LIBSSH2